@@ -0,0 +1,308 @@
+/*
+ * Copyright 2011-2014, EDF. This software was developed with the collaboration of INRIA (Bastien Pietropaoli)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "Arena.h"
+#include "config.h"
+
+/**
+ * @file Arena.c
+ * @author Bastien Pietropaoli (bastien.pietropaoli@inria.fr)
+ * @brief UTILITY: Arenas from which the library
+ * draws its temporary memory.
+ */
+
+/*
+  +-------------------+
+  | PRIVATE FUNCTIONS |
+  +-------------------+
+*/
+
+/*
+ * Alignment of the allocations (enough for any type, including SSE vectors).
+ */
+#define ARENA_ALIGNMENT 16
+#define ARENA_ALIGN(size) (((size) + ARENA_ALIGNMENT - 1) & ~((size_t) ARENA_ALIGNMENT - 1))
+
+/*
+ * Every allocation is preceded by a header storing its size (for realloc()).
+ */
+#define ARENA_HEADER_SIZE ARENA_ALIGN(sizeof(size_t))
+
+#if defined(__GNUC__)
+#define ARENA_THREAD_LOCAL __thread
+#elif defined(_MSC_VER)
+#define ARENA_THREAD_LOCAL __declspec(thread)
+#else
+#define ARENA_THREAD_LOCAL
+#endif
+
+/*
+ * A block of an arena. The allocations are stacked in data.
+ */
+typedef struct ArenaBlock {
+	struct ArenaBlock* next;
+	unsigned char* data;
+	size_t size;
+	size_t used;
+} ArenaBlock;
+
+/*
+ * The blocks from first to current are in use, the following ones
+ * are kept from a previous cycle. last is the last allocation (NULL if released).
+ * blockSize is the size of the next block to create.
+ */
+struct BF_Arena {
+	ArenaBlock* first;
+	ArenaBlock* current;
+	unsigned char* last;
+	size_t blockSize;
+};
+
+/*
+ * The arena used by each thread.
+ */
+static ARENA_THREAD_LOCAL BF_Arena* currentArena = NULL;
+
+static ArenaBlock* createBlock(const size_t size){
+	ArenaBlock* block = malloc(ARENA_ALIGN(sizeof(ArenaBlock)) + size);
+	DEBUG_CHECK_MALLOC_OR_RETURN(block, NULL);
+
+	block->next = NULL;
+	block->data = (unsigned char*) block + ARENA_ALIGN(sizeof(ArenaBlock));
+	block->size = size;
+	block->used = 0;
+	return block;
+}
+
+/*
+ * Stacks an allocation of the given size in the arena.
+ * Moves to the next kept block or creates a new one if the current block is full.
+ */
+static void* arenaAllocate(BF_Arena* arena, const size_t size){
+	size_t needed = ARENA_HEADER_SIZE + ARENA_ALIGN(size);
+	ArenaBlock* block = arena->current;
+	unsigned char* ptr = NULL;
+
+	if(block == NULL || block->used + needed > block->size){
+		if(block != NULL && block->next != NULL && block->next->size >= needed){
+			block = block->next;
+			block->used = 0;
+		}
+		else {
+			block = createBlock(needed > arena->blockSize ? needed : arena->blockSize);
+			if(block == NULL){
+				return NULL;
+			}
+			/* The blocks grow geometrically so that there are few of them to search: */
+			arena->blockSize *= 2;
+			if(arena->current == NULL){
+				block->next = arena->first;
+				arena->first = block;
+			}
+			else {
+				block->next = arena->current->next;
+				arena->current->next = block;
+			}
+		}
+		arena->current = block;
+	}
+
+	ptr = block->data + block->used + ARENA_HEADER_SIZE;
+	*(size_t*) (ptr - ARENA_HEADER_SIZE) = size;
+	block->used += needed;
+	arena->last = ptr;
+	return ptr;
+}
+
+/*
+ * Tests if the pointer has been drawn from the arena since the last reset.
+ * An allocation of 0 byte points right at the end of the used part of its block.
+ */
+static int arenaOwns(const BF_Arena* arena, const void* ptr){
+	const unsigned char* p = ptr;
+	const ArenaBlock* block = NULL;
+
+	if(arena->current == NULL){
+		return 0;
+	}
+	for(block = arena->first; block != arena->current->next; block = block->next){
+		if(p > block->data && p <= block->data + block->used){
+			return 1;
+		}
+	}
+	return 0;
+}
+
+
+/*
+  +-----------+
+  | FUNCTIONS |
+  +-----------+
+*/
+
+BF_Arena* BF_createArena(const size_t blockSize){
+	BF_Arena* arena = malloc(sizeof(BF_Arena));
+	DEBUG_CHECK_MALLOC_OR_RETURN(arena, NULL);
+
+	arena->first = NULL;
+	arena->current = NULL;
+	arena->last = NULL;
+	arena->blockSize = (blockSize == 0 ? BF_ARENA_DEFAULT_BLOCK_SIZE : blockSize);
+	return arena;
+}
+
+
+
+BF_Arena* BF_useArena(BF_Arena* arena){
+	BF_Arena* previous = currentArena;
+	currentArena = arena;
+	return previous;
+}
+
+
+
+BF_Arena* BF_getArena(void){
+	return currentArena;
+}
+
+
+
+void BF_arenaReset(BF_Arena* arena){
+	if(arena->first != NULL){
+		arena->first->used = 0;
+	}
+	arena->current = arena->first;
+	arena->last = NULL;
+}
+
+
+
+size_t BF_arenaUsage(const BF_Arena* arena){
+	const ArenaBlock* block = NULL;
+	size_t usage = 0;
+
+	if(arena->current == NULL){
+		return 0;
+	}
+	for(block = arena->first; block != arena->current->next; block = block->next){
+		usage += block->used;
+	}
+	return usage;
+}
+
+
+
+void BF_freeArena(BF_Arena* arena){
+	ArenaBlock* block = NULL;
+
+	if(arena == NULL){
+		return;
+	}
+	if(currentArena == arena){
+		currentArena = NULL;
+	}
+	while(arena->first != NULL){
+		block = arena->first;
+		arena->first = block->next;
+		free(block);
+	}
+	free(arena);
+}
+
+
+
+void* BF_arenaMalloc(const size_t size){
+	if(currentArena == NULL){
+		return malloc(size);
+	}
+	return arenaAllocate(currentArena, size);
+}
+
+
+
+void* BF_arenaCalloc(const size_t nb, const size_t size){
+	void* ptr = NULL;
+
+	if(currentArena == NULL){
+		return calloc(nb, size);
+	}
+	if(size != 0 && nb > (size_t) -1 / size){
+		return NULL;
+	}
+	ptr = arenaAllocate(currentArena, nb * size);
+	if(ptr != NULL){
+		memset(ptr, 0, nb * size);
+	}
+	return ptr;
+}
+
+
+
+void* BF_arenaRealloc(void* ptr, const size_t size){
+	BF_Arena* arena = currentArena;
+	ArenaBlock* block = NULL;
+	size_t oldSize = 0;
+	size_t offset = 0;
+	void* newPtr = NULL;
+
+	if(arena == NULL || (ptr != NULL && !arenaOwns(arena, ptr))){
+		return realloc(ptr, size);
+	}
+	if(ptr == NULL){
+		return arenaAllocate(arena, size);
+	}
+
+	oldSize = *(size_t*) ((unsigned char*) ptr - ARENA_HEADER_SIZE);
+	/* The last allocation grows (or shrinks) in place if its block is large enough: */
+	block = arena->current;
+	if((unsigned char*) ptr == arena->last){
+		offset = (unsigned char*) ptr - block->data;
+		if(offset + ARENA_ALIGN(size) <= block->size){
+			block->used = offset + ARENA_ALIGN(size);
+			*(size_t*) ((unsigned char*) ptr - ARENA_HEADER_SIZE) = size;
+			return ptr;
+		}
+	}
+
+	newPtr = arenaAllocate(arena, size);
+	if(newPtr != NULL){
+		memcpy(newPtr, ptr, oldSize < size ? oldSize : size);
+	}
+	return newPtr;
+}
+
+
+
+void BF_arenaFree(void* ptr){
+	BF_Arena* arena = currentArena;
+
+	if(ptr == NULL){
+		return;
+	}
+	if(arena == NULL || !arenaOwns(arena, ptr)){
+		free(ptr);
+		return;
+	}
+	/* Only the last allocation can be given back: */
+	if((unsigned char*) ptr == arena->last){
+		arena->current->used = (unsigned char*) ptr - ARENA_HEADER_SIZE - arena->current->data;
+		arena->last = NULL;
+	}
+}
@@ -26,9 +26,779 @@
  */
 
 
+#include <float.h>
+#include <math.h>
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
 #include "BeliefCombinations.h"
+#include "LatticeTransforms.h"
+#include "ArenaAllocation.h"
+
+
+
+/*
+  +-------------------+
+  | PRIVATE FUNCTIONS |
+  +-------------------+
+*/
 
+/*
+ * Relative cost of a step of a transform on the lattice of subsets compared to
+ * the combination of a pair of focal elements (see preferCommonalities()).
+ */
+#define COMMONALITY_TRANSFORM_COST 1
 
+/*
+ * Memory (in bytes) of the commonality functions computed at once by several threads.
+ */
+#define COMMONALITY_BATCH_BYTES (1 << 24)
+
+/*
+ * Mass of the void element (same as BF_m() with the void element, without allocating it).
+ */
+static BF_Mass getVoidMass(const BF_BeliefFunction m) {
+	int i = 0;
+	for(i = 0; i < m.nbFocals; i++){
+		if(m.focals[i].element.card == 0){
+			return m.focals[i].beliefValue;
+		}
+	}
+	return 0;
+}
+
+static BF_BeliefFunction packedSmetsCombination(const BF_BeliefFunction m1, const BF_BeliefFunction m2) {
+	BF_PackedBeliefFunction packed1, packed2, packedCombined;
+	BF_BeliefFunction combined;
+
+	/*Pack, combine and unpack:*/
+	packed1 = BF_packBeliefFunction(m1);
+	packed2 = BF_packBeliefFunction(m2);
+	packedCombined = BF_packedSmetsCombination(packed1, packed2);
+	combined = BF_unpackBeliefFunction(packedCombined);
+
+	BF_freePackedBeliefFunction(&packed1);
+	BF_freePackedBeliefFunction(&packed2);
+	BF_freePackedBeliefFunction(&packedCombined);
+
+	return combined;
+}
+
+
+static BF_BeliefFunction wideSmetsCombination(const BF_BeliefFunction m1, const BF_BeliefFunction m2) {
+	BF_BeliefFunction combined = {NULL, 0, 0};
+	Sets_WideElement conj = {NULL, 0};
+	uint64_t *packed1 = NULL, *packed2 = NULL, *focals = NULL;
+	double *sums = NULL;
+	int *slots = NULL;
+	unsigned int mask = 7, slot = 0;
+	int nbWords = SETS_WIDE_NB_WORDS(m1.elementSize);
+	int i = 0, j = 0, k = 0;
+
+	combined.elementSize = m1.elementSize;
+	if(m1.nbFocals == 0 || m2.nbFocals == 0){
+		return combined;
+	}
+
+	/*Memory allocation (there cannot be more than nb1*nb2 focals):*/
+	packed1 = malloc(sizeof(uint64_t) * nbWords * m1.nbFocals);
+	DEBUG_CHECK_MALLOC_OR_RETURN(packed1, combined);
+	packed2 = malloc(sizeof(uint64_t) * nbWords * m2.nbFocals);
+	DEBUG_CHECK_MALLOC_OR_RETURN(packed2, combined);
+	focals = malloc(sizeof(uint64_t) * nbWords * m1.nbFocals * m2.nbFocals);
+	DEBUG_CHECK_MALLOC_OR_RETURN(focals, combined);
+	sums = malloc(sizeof(double) * m1.nbFocals * m2.nbFocals);
+	DEBUG_CHECK_MALLOC_OR_RETURN(sums, combined);
+	/*Open addressing hash table of the positions (+1) of the focals (at most one half of the slots are used):*/
+	while(mask < 2 * (unsigned int)(m1.nbFocals * m2.nbFocals)){
+		mask = 2 * mask + 1;
+	}
+	slots = calloc(mask + 1, sizeof(int));
+	DEBUG_CHECK_MALLOC_OR_RETURN(slots, combined);
+
+	/*Pack the focal elements once:*/
+	for(i = 0; i < m1.nbFocals; i++){
+		Sets_packWords(packed1 + i * nbWords, m1.focals[i].element, combined.elementSize);
+	}
+	for(j = 0; j < m2.nbFocals; j++){
+		Sets_packWords(packed2 + j * nbWords, m2.focals[j].element, combined.elementSize);
+	}
+
+	/*Combine (the conjunction is computed in the next free slot):*/
+	for(i = 0; i < m1.nbFocals; i++){
+		for(j = 0; j < m2.nbFocals; j++){
+			conj.words = focals + combined.nbFocals * nbWords;
+			Sets_wordsConjunction(conj.words, packed1 + i * nbWords, packed2 + j * nbWords, nbWords);
+			/* Check if already in the focals */
+			slot = (unsigned int)Sets_wordsHash(conj.words, nbWords) & mask;
+			while(slots[slot] != 0 && !Sets_wordsEquals(focals + (slots[slot] - 1) * nbWords, conj.words, nbWords)){
+				slot = (slot + 1) & mask;
+			}
+			/* If not in, add it ! */
+			if(slots[slot] == 0){
+				slots[slot] = combined.nbFocals + 1;
+				sums[combined.nbFocals] = 0;
+				combined.nbFocals++;
+			}
+			k = slots[slot] - 1;
+			sums[k] += m1.focals[i].beliefValue * m2.focals[j].beliefValue;
+		}
+	}
+
+	/*Unpack the result:*/
+	combined.focals = malloc(sizeof(BF_FocalElement) * combined.nbFocals);
+	DEBUG_CHECK_MALLOC_OR_RETURN(combined.focals, combined);
+	for(k = 0; k < combined.nbFocals; k++){
+		conj.words = focals + k * nbWords;
+		conj.card = Sets_wordsCard(conj.words, nbWords);
+		combined.focals[k].element = Sets_elementFromWide(conj, combined.elementSize);
+		combined.focals[k].beliefValue = sums[k];
+	}
+
+	free(packed1);
+	free(packed2);
+	free(focals);
+	free(sums);
+	free(slots);
+
+	return combined;
+}
+
+
+
+/*
+ * Mass of the void element of a packed function.
+ */
+static BF_Mass getPackedVoidMass(const BF_PackedBeliefFunction m) {
+	int i = 0;
+	for(i = 0; i < m.nbFocals; i++){
+		if(m.focals[i].element == 0){
+			return m.focals[i].beliefValue;
+		}
+	}
+	return 0;
+}
+
+/*
+ * Normalizes a packed function with its void mass as BF_DempsterCombination() does.
+ */
+static void packedDempsterNormalization(BF_PackedBeliefFunction* m) {
+	BF_Mass voidMass = getPackedVoidMass(*m);
+	int i = 0, voidIndex = -1;
+
+	if(voidMass < 1 - BF_PRECISION){
+		for(i = 0; i < m->nbFocals; i++){
+			if(m->focals[i].element != 0){
+				m->focals[i].beliefValue *= 1.0 / (1.0 - voidMass);
+			}
+			else {
+				voidIndex = i;
+			}
+		}
+		/*Set the void mass to 0:*/
+		if(voidIndex != -1){
+			m->focals[voidIndex].beliefValue = 0;
+		}
+	}
+	#ifdef CHECK_VALUES
+	else{
+		printf("debug: in BF_fullDempsterCombination(), major conflict, m(void) = 1!\n");
+	}
+	#endif
+}
+
+/*
+ * Combines a list of functions defined on a small frame (Smets, or Dempster if normalize)
+ * while keeping the intermediate results packed. Each function is packed once and only
+ * the final result is unpacked.
+ */
+static BF_BeliefFunction packedFullCombination(const BF_BeliefFunction* m, const int nbM, const int normalize) {
+	BF_PackedBeliefFunction combined, packed, temp;
+	BF_BeliefFunction result;
+	int i = 0;
+
+	combined = BF_packBeliefFunction(m[0]);
+	for(i = 1; i < nbM; i++){
+		packed = BF_packBeliefFunction(m[i]);
+		temp = BF_packedSmetsCombination(combined, packed);
+		BF_freePackedBeliefFunction(&packed);
+		BF_freePackedBeliefFunction(&combined);
+		combined = temp;
+		if(normalize){
+			packedDempsterNormalization(&combined);
+		}
+	}
+	result = BF_unpackBeliefFunction(combined);
+	BF_freePackedBeliefFunction(&combined);
+
+	return result;
+}
+
+
+/*
+ * Normalizes a dense function with its void mass as BF_DempsterCombination() does.
+ * Returns 0 (and leaves the function unchanged) if the void mass is 1.
+ */
+static int denseDempsterNormalization(BF_DenseBeliefFunction* m) {
+	int nbSubsets = 1 << m->elementSize;
+	BF_Mass voidMass = m->values[0];
+	int i = 0;
+
+	if(voidMass >= 1 - BF_PRECISION){
+		return 0;
+	}
+	for(i = 1; i < nbSubsets; i++){
+		m->values[i] *= 1.0 / (1.0 - voidMass);
+	}
+	m->values[0] = 0;
+	return 1;
+}
+
+/*
+ * Multiplies product by the commonality function of the masses in values
+ * (values[e] being the mass of the subset of id e, overwritten by its commonality).
+ */
+static void multiplyByCommonalities(double* product, double* values, const int elementSize) {
+	int nbSubsets = 1 << elementSize;
+	int i = 0;
+
+	supersetsTransform(values, elementSize, 1);
+	for(i = 0; i < nbSubsets; i++){
+		product[i] *= values[i];
+	}
+}
+
+/*
+ * Divides the commonalities of the non-void subsets by the largest of them, so that
+ * a long product of commonalities does not underflow. The Dempster's rule removes
+ * any common scale factor and ignores the commonality of the void set.
+ */
+static void rescaleCommonalities(double* product, const int elementSize) {
+	int nbSubsets = 1 << elementSize;
+	double maxCommonality = 0;
+	int i = 0;
+
+	for(i = 1; i < nbSubsets; i++){
+		if(product[i] > maxCommonality){
+			maxCommonality = product[i];
+		}
+	}
+	if(maxCommonality > 0){
+		for(i = 1; i < nbSubsets; i++){
+			product[i] /= maxCommonality;
+		}
+	}
+}
+
+/*
+ * Gives back in place the masses of a product of commonality functions, normalized as
+ * the Dempster's rule does if normalize. The masses below the rounding error of the transforms
+ * (relative to the commonalities of the non-void subsets) are set to 0 and the normalization
+ * is computed from the sum of the non-void masses, so that it stays accurate under a strong conflict.
+ * Returns 0 (and does not normalize) if the conflict is total.
+ */
+static int massesFromCommonalities(double* values, const int elementSize, const int normalize) {
+	int nbSubsets = 1 << elementSize;
+	double roundingError = DBL_EPSILON * elementSize * nbSubsets;
+	double maxCommonality = 0, sum = 0;
+	int i = 0;
+
+	for(i = 1; i < nbSubsets; i++){
+		if(values[i] > maxCommonality){
+			maxCommonality = values[i];
+		}
+	}
+	supersetsTransform(values, elementSize, -1);
+	if(values[0] < roundingError){
+		values[0] = 0;
+	}
+	for(i = 1; i < nbSubsets; i++){
+		if(values[i] < roundingError * maxCommonality){
+			values[i] = 0;
+		}
+		sum += values[i];
+	}
+	if(!normalize){
+		return 1;
+	}
+	if(sum <= 0){
+		return 0;
+	}
+	for(i = 1; i < nbSubsets; i++){
+		values[i] /= sum;
+	}
+	values[0] = 0;
+	return 1;
+}
+
+/*
+ * Tells if a list of functions should be combined in the commonality domain, that is if
+ * its nbM + 1 transforms cost less than the pairwise combinations. The number of focals
+ * of the intermediate results is bounded by the product of the numbers of focals
+ * of the functions and by the number of subsets.
+ */
+static int preferCommonalities(const BF_BeliefFunction* m, const int nbM) {
+	int elementSize = m[0].elementSize;
+	double nbSubsets = 0, transforms = 0, pairwise = 0, nbFocals = 0;
+	int i = 0;
+
+	if(elementSize > BF_DENSE_MAX_SIZE){
+		return 0;
+	}
+	nbSubsets = (double)(1 << elementSize);
+	transforms = nbSubsets * elementSize * (nbM + 1) * COMMONALITY_TRANSFORM_COST;
+	nbFocals = m[0].nbFocals;
+	for(i = 1; i < nbM && pairwise <= transforms; i++){
+		pairwise += nbFocals * m[i].nbFocals;
+		nbFocals *= m[i].nbFocals;
+		if(nbFocals > nbSubsets){
+			nbFocals = nbSubsets;
+		}
+	}
+	return pairwise > transforms;
+}
+
+/*
+ * The threads of a parallel region may draw from arenas of their own (see BF_useArena()),
+ * while the temporaries they share are freed by any of them. With several threads, each of
+ * them allocates with malloc() inside the region and gets its arena back at the end of it.
+ */
+static BF_Arena* leaveArena(const int nbThreads) {
+	return (nbThreads > 1) ? BF_useArena(NULL) : NULL;
+}
+
+static void restoreArena(BF_Arena* arena, const int nbThreads) {
+	if(nbThreads > 1){
+		BF_useArena(arena);
+	}
+}
+
+/*
+ * Combines a list of functions defined on at most BF_DENSE_MAX_SIZE atoms (Smets, or Dempster
+ * if normalize) as a product of their commonality functions. With several threads, the
+ * commonality functions of a batch of functions are computed in parallel. They are multiplied
+ * in the order of the list, so the result does not depend on the number of threads.
+ * With the Dempster's rule, the product is rescaled after each function.
+ */
+static BF_BeliefFunction commonalityFullCombination(const BF_BeliefFunction* m, const int nbM, const int normalize, const int nbThreads) {
+	BF_BeliefFunction combined = {NULL, 0, 0};
+	BF_DenseBeliefFunction dense = {NULL, 0};
+	double *product = NULL, *values = NULL;
+	int elementSize = m[0].elementSize;
+	int nbSubsets = 1 << elementSize;
+	int batchSize = 1, first = 0, nb = 0;
+	int i = 0, k = 0;
+
+	combined.elementSize = elementSize;
+	if(nbThreads > 1){
+		batchSize = COMMONALITY_BATCH_BYTES / (sizeof(double) * nbSubsets);
+		batchSize = batchSize < 1 ? 1 : (batchSize > nbM ? nbM : batchSize);
+	}
+	product = malloc(sizeof(double) * nbSubsets);
+	DEBUG_CHECK_MALLOC_OR_RETURN(product, combined);
+	values = malloc(sizeof(double) * nbSubsets * batchSize);
+	DEBUG_CHECK_MALLOC_OR_RETURN(values, combined);
+
+	/*Multiply the commonalities:*/
+	for(i = 0; i < nbSubsets; i++){
+		product[i] = 1;
+	}
+	for(first = 0; first < nbM; first += batchSize){
+		nb = (nbM - first < batchSize) ? nbM - first : batchSize;
+		#ifdef _OPENMP
+		#pragma omp parallel num_threads(nbThreads) if(nb > 1)
+		#endif
+		{
+			BF_Arena* arena = leaveArena(nbThreads);
+			#ifdef _OPENMP
+			#pragma omp for schedule(static)
+			#endif
+			for(k = 0; k < nb; k++){
+				double* q = values + (size_t)k * nbSubsets;
+				int f = 0;
+				for(f = 0; f < nbSubsets; f++){
+					q[f] = 0;
+				}
+				for(f = 0; f < m[first + k].nbFocals; f++){
+					q[Sets_packElement(m[first + k].focals[f].element, elementSize)] += m[first + k].focals[f].beliefValue;
+				}
+				supersetsTransform(q, elementSize, 1);
+			}
+			restoreArena(arena, nbThreads);
+		}
+		for(k = 0; k < nb; k++){
+			#ifdef _OPENMP
+			#pragma omp parallel num_threads(nbThreads) if(nb > 1)
+			#endif
+			{
+				BF_Arena* arena = leaveArena(nbThreads);
+				#ifdef _OPENMP
+				#pragma omp for schedule(static)
+				#endif
+				for(i = 0; i < nbSubsets; i++){
+					product[i] *= values[(size_t)k * nbSubsets + i];
+				}
+				restoreArena(arena, nbThreads);
+			}
+			if(normalize){
+				rescaleCommonalities(product, elementSize);
+			}
+		}
+	}
+	if(!massesFromCommonalities(product, elementSize, normalize)){
+		#ifdef CHECK_VALUES
+		printf("debug: in BF_fullDempsterCombination(), major conflict, m(void) = 1!\n");
+		#endif
+	}
+
+	/*Get the sparse function:*/
+	dense.elementSize = elementSize;
+	dense.values = malloc(sizeof(BF_Mass) * nbSubsets);
+	DEBUG_CHECK_MALLOC_OR_RETURN(dense.values, combined);
+	for(i = 0; i < nbSubsets; i++){
+		dense.values[i] = product[i];
+	}
+	combined = BF_toSparseBeliefFunction(dense);
+
+	BF_freeDenseBeliefFunction(&dense);
+	free(product);
+	free(values);
+
+	return combined;
+}
+
+/*
+ * Combines a list of functions (Smets, or Dempster if normalize) as a balanced tree:
+ * ((m[0] m[1]) (m[2] m[3])) ((m[4] m[5]) ...), the combinations of a level being shared
+ * between the threads. On small frames, the functions are packed once and only the result is unpacked.
+ * The tree only depends on nbM, so the result does not depend on the number of threads.
+ */
+static BF_BeliefFunction treeCombination(const BF_BeliefFunction* m, const int nbM, const int normalize, const int nbThreads) {
+	BF_BeliefFunction combined = {NULL, 0, 0};
+	BF_BeliefFunction *nodes = NULL;
+	BF_PackedBeliefFunction *packed = NULL;
+	int step = 0, i = 0;
+
+	combined.elementSize = m[0].elementSize;
+	if(m[0].elementSize <= SETS_PACKED_MAX_SIZE){
+		packed = malloc(sizeof(BF_PackedBeliefFunction) * nbM);
+		DEBUG_CHECK_MALLOC_OR_RETURN(packed, combined);
+		#ifdef _OPENMP
+		#pragma omp parallel num_threads(nbThreads)
+		#endif
+		{
+			BF_Arena* arena = leaveArena(nbThreads);
+			#ifdef _OPENMP
+			#pragma omp for schedule(static)
+			#endif
+			for(i = 0; i < nbM; i++){
+				packed[i] = BF_packBeliefFunction(m[i]);
+			}
+			restoreArena(arena, nbThreads);
+		}
+		for(step = 1; step < nbM; step *= 2){
+			#ifdef _OPENMP
+			#pragma omp parallel num_threads(nbThreads)
+			#endif
+			{
+				BF_Arena* arena = leaveArena(nbThreads);
+				#ifdef _OPENMP
+				#pragma omp for schedule(dynamic)
+				#endif
+				for(i = 0; i < nbM - step; i += 2 * step){
+					BF_PackedBeliefFunction temp = BF_packedSmetsCombination(packed[i], packed[i + step]);
+					if(normalize){
+						packedDempsterNormalization(&temp);
+					}
+					BF_freePackedBeliefFunction(&(packed[i]));
+					BF_freePackedBeliefFunction(&(packed[i + step]));
+					packed[i] = temp;
+				}
+				restoreArena(arena, nbThreads);
+			}
+		}
+		combined = BF_unpackBeliefFunction(packed[0]);
+		BF_freePackedBeliefFunction(&(packed[0]));
+		free(packed);
+	}
+	else {
+		nodes = malloc(sizeof(BF_BeliefFunction) * nbM);
+		DEBUG_CHECK_MALLOC_OR_RETURN(nodes, combined);
+		/*The first level combines the functions of the list:*/
+		#ifdef _OPENMP
+		#pragma omp parallel num_threads(nbThreads)
+		#endif
+		{
+			BF_Arena* arena = leaveArena(nbThreads);
+			#ifdef _OPENMP
+			#pragma omp for schedule(dynamic)
+			#endif
+			for(i = 0; i < nbM; i += 2){
+				if(i + 1 == nbM){
+					nodes[i] = BF_copyBeliefFunction(m[i]);
+				}
+				else if(normalize){
+					nodes[i] = BF_DempsterCombination(m[i], m[i + 1]);
+				}
+				else {
+					nodes[i] = BF_SmetsCombination(m[i], m[i + 1]);
+				}
+			}
+			restoreArena(arena, nbThreads);
+		}
+		for(step = 2; step < nbM; step *= 2){
+			#ifdef _OPENMP
+			#pragma omp parallel num_threads(nbThreads)
+			#endif
+			{
+				BF_Arena* arena = leaveArena(nbThreads);
+				#ifdef _OPENMP
+				#pragma omp for schedule(dynamic)
+				#endif
+				for(i = 0; i < nbM - step; i += 2 * step){
+					BF_BeliefFunction temp = normalize ? BF_DempsterCombination(nodes[i], nodes[i + step])
+							: BF_SmetsCombination(nodes[i], nodes[i + step]);
+					BF_freeBeliefFunction(&(nodes[i]));
+					BF_freeBeliefFunction(&(nodes[i + step]));
+					nodes[i] = temp;
+				}
+				restoreArena(arena, nbThreads);
+			}
+		}
+		combined = nodes[0];
+		free(nodes);
+	}
+
+	return combined;
+}
+
+/*
+ * Combines a list of dense functions (Smets, or Dempster if normalize) as a product
+ * of their commonality functions.
+ */
+static BF_DenseBeliefFunction denseFullCombination(const BF_DenseBeliefFunction* m, const int nbM, const int normalize) {
+	BF_DenseBeliefFunction combined = {NULL, 0};
+	double *product = NULL, *values = NULL;
+	int nbSubsets = 1 << m[0].elementSize;
+	int i = 0, k = 0;
+
+	#ifdef CHECK_COMPATIBILITY
+	for(k = 0; k < nbM; k++){
+		if(m[k].elementSize != m[0].elementSize){
+			printf("debug: in BF_denseFull%sCombination(), at least one mass function is not compatible with others...\n", normalize ? "Dempster" : "Smets");
+		}
+	}
+	#endif
+
+	combined.elementSize = m[0].elementSize;
+	product = malloc(sizeof(double) * nbSubsets);
+	DEBUG_CHECK_MALLOC_OR_RETURN(product, combined);
+	values = malloc(sizeof(double) * nbSubsets);
+	DEBUG_CHECK_MALLOC_OR_RETURN(values, combined);
+
+	/*Multiply the commonalities and transform back:*/
+	for(i = 0; i < nbSubsets; i++){
+		product[i] = 1;
+	}
+	for(k = 0; k < nbM; k++){
+		for(i = 0; i < nbSubsets; i++){
+			values[i] = m[k].values[i];
+		}
+		multiplyByCommonalities(product, values, combined.elementSize);
+		if(normalize){
+			rescaleCommonalities(product, combined.elementSize);
+		}
+	}
+	if(!massesFromCommonalities(product, combined.elementSize, normalize)){
+		#ifdef CHECK_VALUES
+		printf("debug: in BF_denseFullDempsterCombination(), major conflict, m(void) = 1!\n");
+		#endif
+	}
+
+	combined.values = malloc(sizeof(BF_Mass) * nbSubsets);
+	DEBUG_CHECK_MALLOC_OR_RETURN(combined.values, combined);
+	for(i = 0; i < nbSubsets; i++){
+		combined.values[i] = product[i];
+	}
+
+	free(product);
+	free(values);
+
+	return combined;
+}
+
+/*
+ * Weighted average of a list of functions (a simple average if weights is NULL) in a single pass:
+ * the focal elements are packed once and merged through an open addressing hash table.
+ * The focal elements are given in their order of appearance in the list.
+ */
+static BF_BeliefFunction weightedAverage(const BF_BeliefFunction* m, const int nbM, const float* weights) {
+	BF_BeliefFunction combined = {NULL, 0, 0};
+	Sets_WideElement focal = {NULL, 0};
+	uint64_t *focals = NULL;
+	double *sums = NULL;
+	int *slots = NULL;
+	unsigned int mask = 7, slot = 0;
+	int nbWords = SETS_WIDE_NB_WORDS(m[0].elementSize);
+	int nbMaxFocals = 0, i = 0, k = 0, f = 0;
+
+	combined.elementSize = m[0].elementSize;
+	for(k = 0; k < nbM; k++){
+		nbMaxFocals += m[k].nbFocals;
+	}
+	if(nbMaxFocals == 0){
+		return combined;
+	}
+
+	/*Memory allocation (there cannot be more than the sum of the numbers of focals):*/
+	focals = malloc(sizeof(uint64_t) * nbWords * nbMaxFocals);
+	DEBUG_CHECK_MALLOC_OR_RETURN(focals, combined);
+	sums = malloc(sizeof(double) * nbMaxFocals);
+	DEBUG_CHECK_MALLOC_OR_RETURN(sums, combined);
+	while(mask < 2 * (unsigned int)nbMaxFocals){
+		mask = 2 * mask + 1;
+	}
+	slots = calloc(mask + 1, sizeof(int));
+	DEBUG_CHECK_MALLOC_OR_RETURN(slots, combined);
+
+	/*Sum the masses (the element is packed in the next free slot):*/
+	for(k = 0; k < nbM; k++){
+		for(i = 0; i < m[k].nbFocals; i++){
+			focal.words = focals + (size_t)combined.nbFocals * nbWords;
+			Sets_packWords(focal.words, m[k].focals[i].element, combined.elementSize);
+			slot = (unsigned int)Sets_wordsHash(focal.words, nbWords) & mask;
+			while(slots[slot] != 0 && !Sets_wordsEquals(focals + (size_t)(slots[slot] - 1) * nbWords, focal.words, nbWords)){
+				slot = (slot + 1) & mask;
+			}
+			if(slots[slot] == 0){
+				slots[slot] = combined.nbFocals + 1;
+				sums[combined.nbFocals] = 0;
+				combined.nbFocals++;
+			}
+			f = slots[slot] - 1;
+			sums[f] += (weights != NULL ? weights[k] * m[k].focals[i].beliefValue : m[k].focals[i].beliefValue);
+		}
+	}
+
+	/*Unpack the result:*/
+	combined.focals = malloc(sizeof(BF_FocalElement) * combined.nbFocals);
+	DEBUG_CHECK_MALLOC_OR_RETURN(combined.focals, combined);
+	for(f = 0; f < combined.nbFocals; f++){
+		focal.words = focals + (size_t)f * nbWords;
+		focal.card = Sets_wordsCard(focal.words, nbWords);
+		combined.focals[f].element = Sets_elementFromWide(focal, combined.elementSize);
+		combined.focals[f].beliefValue = (weights != NULL ? sums[f] : sums[f] / nbM);
+	}
+
+	free(focals);
+	free(sums);
+	free(slots);
+
+	return combined;
+}
+
+/*
+ * Tells if the combination of a function with itself n times (Dempster) should be computed
+ * in the commonality domain, that is if its two transforms cost less than the squarings
+ * of dempsterPower().
+ */
+static int preferCommonalityPower(const BF_BeliefFunction m, const int n) {
+	double nbSubsets = 0, transforms = 0, squarings = 0, nbFocals = m.nbFocals;
+	int k = 0;
+
+	if(m.elementSize > BF_DENSE_MAX_SIZE){
+		return 0;
+	}
+	nbSubsets = (double)(1 << m.elementSize);
+	transforms = nbSubsets * m.elementSize * 2 * COMMONALITY_TRANSFORM_COST;
+	/*A squaring and at most one product with the result per bit of n:*/
+	for(k = 1; k < n && squarings <= transforms; k *= 2){
+		squarings += 2 * nbFocals * nbFocals;
+		nbFocals *= nbFocals;
+		if(nbFocals > nbSubsets){
+			nbFocals = nbSubsets;
+		}
+	}
+	return squarings > transforms;
+}
+
+/*
+ * Combines a function with itself n times with the Dempster's rule. On small frames,
+ * the commonality function is raised to the power n when it costs less, otherwise
+ * the function is squared O(log n) times (exponentiation by squaring) instead of
+ * being combined n - 1 times.
+ */
+static BF_BeliefFunction dempsterPower(const BF_BeliefFunction m, const int n) {
+	BF_BeliefFunction power = {NULL, 0, 0}, square = {NULL, 0, 0}, temp;
+	BF_DenseBeliefFunction dense = {NULL, 0};
+	double* values = NULL;
+	int nbSubsets = 0, hasPower = 0;
+	int i = 0, k = n;
+
+	power.elementSize = m.elementSize;
+	if(preferCommonalityPower(m, n)){
+		nbSubsets = 1 << m.elementSize;
+		values = calloc(nbSubsets, sizeof(double));
+		DEBUG_CHECK_MALLOC_OR_RETURN(values, power);
+		for(i = 0; i < m.nbFocals; i++){
+			values[Sets_packElement(m.focals[i].element, m.elementSize)] += m.focals[i].beliefValue;
+		}
+		supersetsTransform(values, m.elementSize, 1);
+		/*Raised relative to the largest one to avoid the underflow:*/
+		rescaleCommonalities(values, m.elementSize);
+		for(i = 1; i < nbSubsets; i++){
+			values[i] = pow(values[i], n);
+		}
+		if(!massesFromCommonalities(values, m.elementSize, 1)){
+			#ifdef CHECK_VALUES
+			printf("debug: in dempsterPower(), major conflict, m(void) = 1!\n");
+			#endif
+		}
+		dense.elementSize = m.elementSize;
+		dense.values = malloc(sizeof(BF_Mass) * nbSubsets);
+		DEBUG_CHECK_MALLOC_OR_RETURN(dense.values, power);
+		for(i = 0; i < nbSubsets; i++){
+			dense.values[i] = values[i];
+		}
+		power = BF_toSparseBeliefFunction(dense);
+		BF_freeDenseBeliefFunction(&dense);
+		free(values);
+		return power;
+	}
+
+	/*Exponentiation by squaring (square = m^(2^j) for the bit j of n):*/
+	square = BF_copyBeliefFunction(m);
+	while(k > 0){
+		if(k & 1){
+			if(hasPower){
+				temp = BF_DempsterCombination(power, square);
+				BF_freeBeliefFunction(&power);
+				power = temp;
+			}
+			else {
+				power = BF_copyBeliefFunction(square);
+				hasPower = 1;
+			}
+		}
+		k >>= 1;
+		if(k > 0){
+			temp = BF_DempsterCombination(square, square);
+			BF_freeBeliefFunction(&square);
+			square = temp;
+		}
+	}
+	BF_freeBeliefFunction(&square);
+
+	return power;
+}
+
+
+/*
+  +-----------+
+  | FUNCTIONS |
+  +-----------+
+*/
 
 /**
  * @name Combination rules
@@ -50,12 +820,22 @@ BF_BeliefFunction BF_fullDempsterCombination(const BF_BeliefFunction* m, const i
     }
     #endif
 
-    /*Initialization: */
-    combined = BF_DempsterCombination(m[0], m[1]);
-    for(i = 2; i < nbM; i++){
-        temp = BF_DempsterCombination(combined, m[i]);
-        BF_freeBeliefFunction(&combined);
-        combined = temp;
+    /*Product of the commonalities when the pairwise combinations would cost more:*/
+    if(preferCommonalities(m, nbM)){
+        combined = commonalityFullCombination(m, nbM, 1, 1);
+    }
+    /*Packed intermediate results for small frames:*/
+    else if(m[0].elementSize <= SETS_PACKED_MAX_SIZE){
+        combined = packedFullCombination(m, nbM, 1);
+    }
+    else {
+        /*Initialization: */
+        combined = BF_DempsterCombination(m[0], m[1]);
+        for(i = 2; i < nbM; i++){
+            temp = BF_DempsterCombination(combined, m[i]);
+            BF_freeBeliefFunction(&combined);
+            combined = temp;
+        }
     }
 
     #ifdef CHECK_SUM
@@ -77,9 +857,8 @@ BF_BeliefFunction BF_fullDempsterCombination(const BF_BeliefFunction* m, const i
 
 BF_BeliefFunction BF_DempsterCombination(const BF_BeliefFunction m1, const BF_BeliefFunction m2){
     BF_BeliefFunction combined;
-    Sets_Element emptySet;
     int i = 0, voidIndex = -1;
-    float voidMass = 0;
+    BF_Mass voidMass = 0;
     #if defined(CHECK_VALUES) || defined(CHECK_SUM)
     char *str;
     #endif
@@ -97,8 +876,7 @@ BF_BeliefFunction BF_DempsterCombination(const BF_BeliefFunction m1, const BF_Be
         printf("debug: in BF_DempsterCombination(), bad sum from SmetsCombination() !\n");
     }
     #endif
-    emptySet = Sets_getEmptyElement(m1.elementSize);
-    voidMass = BF_m(combined, emptySet);
+    voidMass = getVoidMass(combined);
     /*Normalize with the void mass:*/
     if(voidMass < 1 - BF_PRECISION){
         for(i = 0; i<combined.nbFocals; i++){
@@ -125,8 +903,6 @@ BF_BeliefFunction BF_DempsterCombination(const BF_BeliefFunction m1, const BF_Be
     	free(str);
     }
     #endif
-    /*Deallocation:*/
-    Sets_freeElement(&emptySet);
 
     #ifdef CHECK_SUM
     if(BF_checkSum(combined)){
@@ -167,12 +943,22 @@ BF_BeliefFunction BF_fullSmetsCombination(const BF_BeliefFunction* m, const int
     }
     #endif
 
-    /*Initialization:*/
-    combined = BF_SmetsCombination(m[0], m[1]);
-    for(i = 2; i<nbM; i++){
-        temp = BF_SmetsCombination(combined, m[i]);
-        BF_freeBeliefFunction(&combined);
-        combined = temp;
+    /*Product of the commonalities when the pairwise combinations would cost more:*/
+    if(preferCommonalities(m, nbM)){
+        combined = commonalityFullCombination(m, nbM, 0, 1);
+    }
+    /*Packed intermediate results for small frames:*/
+    else if(m[0].elementSize <= SETS_PACKED_MAX_SIZE){
+        combined = packedFullCombination(m, nbM, 0);
+    }
+    else {
+        /*Initialization:*/
+        combined = BF_SmetsCombination(m[0], m[1]);
+        for(i = 2; i<nbM; i++){
+            temp = BF_SmetsCombination(combined, m[i]);
+            BF_freeBeliefFunction(&combined);
+            combined = temp;
+        }
     }
 
     #ifdef CHECK_SUM
@@ -193,8 +979,9 @@ BF_BeliefFunction BF_fullSmetsCombination(const BF_BeliefFunction* m, const int
 
 BF_BeliefFunction BF_SmetsCombination(const BF_BeliefFunction m1, const BF_BeliefFunction m2){
     BF_BeliefFunction combined = {NULL, 0, 0};
-    Sets_Element conj = {NULL, 0};
-    int i = 0, j = 0, k = 0, index = -1;
+    #if defined(CHECK_SUM) || defined(CHECK_VALUES)
+    int i = 0, j = 0;
+    #endif
 
 	#ifdef CHECK_COMPATIBILITY
     if(m1.elementSize != m2.elementSize){
@@ -202,35 +989,12 @@ BF_BeliefFunction BF_SmetsCombination(const BF_BeliefFunction m1, const BF_Belie
     }
     #endif
 
-    /*Memory allocation:*/
-    combined.nbFocals = 0;
-    combined.focals = NULL;
-    combined.elementSize = m1.elementSize;
-    /* For all focal elements of both mass functions : */
-    for(i = 0; i < m1.nbFocals; i++){
-    	for(j = 0; j < m2.nbFocals; j++){
-    		/* Conjunction */
-    		conj = Sets_conjunction(m1.focals[i].element, m2.focals[j].element, combined.elementSize);
-    		index = -1;
-    		/* Check if already in the focals */
-    		for(k = 0; k < combined.nbFocals; k++){
-    			if(Sets_equals(combined.focals[k].element, conj, combined.elementSize)){
-    				index = k;
-    				combined.focals[k].beliefValue += m1.focals[i].beliefValue * m2.focals[j].beliefValue;
-    				break;
-    			}
-    		}
-    		/* If not in, add it ! */
-    		if(index == -1){
-    			combined.nbFocals++;
-    			combined.focals = realloc(combined.focals, sizeof(BF_FocalElement) * combined.nbFocals);
-    			DEBUG_CHECK_MALLOC(combined.focals);
-
-    			combined.focals[combined.nbFocals - 1].element = Sets_copyElement(conj, combined.elementSize);
-    			combined.focals[combined.nbFocals - 1].beliefValue = m1.focals[i].beliefValue * m2.focals[j].beliefValue;
-    		}
-    		Sets_freeElement(&conj);
-    	}
+    /*Packed elements for small frames, multi-word elements for large ones:*/
+    if(m1.elementSize <= SETS_PACKED_MAX_SIZE){
+    	combined = packedSmetsCombination(m1, m2);
+    }
+    else {
+    	combined = wideSmetsCombination(m1, m2);
     }
 
     #ifdef CHECK_SUM
@@ -338,7 +1102,6 @@ BF_BeliefFunction BF_fullYagerCombination(const BF_BeliefFunction* m, const int
 
 BF_BeliefFunction BF_YagerCombination(const BF_BeliefFunction m1, const BF_BeliefFunction m2){
     BF_BeliefFunction combined = {NULL, 0, 0}, smets = {NULL, 0, 0};
-    Sets_Element complete;
     int i = 0, addComplete = 1, completeIndex = -1, voidIndex = -1;
 
 	#ifdef CHECK_COMPATIBILITY
@@ -347,8 +1110,6 @@ BF_BeliefFunction BF_YagerCombination(const BF_BeliefFunction m1, const BF_Belie
     }
     #endif
 
-    /*Get the complete set:*/
-    complete = Sets_getCompleteElement(m1.elementSize);
     /*Get the Smets combination:*/
     smets = BF_SmetsCombination(m1, m2);
     #ifdef CHECK_SUM
@@ -383,7 +1144,7 @@ BF_BeliefFunction BF_YagerCombination(const BF_BeliefFunction m1, const BF_Belie
         combined.focals[i].beliefValue = smets.focals[i].beliefValue;
     }
     if(addComplete){
-        combined.focals[completeIndex].element = Sets_copyElement(complete, combined.elementSize);
+        combined.focals[completeIndex].element = Sets_getCompleteElement(combined.elementSize);
         combined.focals[completeIndex].beliefValue = 0;
     }
     if(voidIndex != -1){
@@ -393,7 +1154,6 @@ BF_BeliefFunction BF_YagerCombination(const BF_BeliefFunction m1, const BF_Belie
 		combined.focals[voidIndex].beliefValue = 0;
 	}
     /*Deallocation:*/
-    Sets_freeElement(&complete);
     BF_freeBeliefFunction(&smets);
 
     #ifdef CHECK_SUM
@@ -452,8 +1212,9 @@ BF_BeliefFunction BF_fullDuboisPradeCombination(const BF_BeliefFunction* m, cons
 
 BF_BeliefFunction BF_DuboisPradeCombination(const BF_BeliefFunction m1, const BF_BeliefFunction m2){
     BF_BeliefFunction combined;
+    BF_FocalIndex* index = NULL;
     Sets_Element newFocal;
-    int i = 0, j = 0, k = 0, index = -1;
+    int i = 0, j = 0;
 
 	#ifdef CHECK_COMPATIBILITY
     if(m1.elementSize != m2.elementSize){
@@ -465,37 +1226,24 @@ BF_BeliefFunction BF_DuboisPradeCombination(const BF_BeliefFunction m1, const BF
     combined.nbFocals = 0;
     combined.focals = NULL;
     combined.elementSize = m1.elementSize;
+    index = BF_indexBeliefFunction(combined);
+    /* Temporary element reused for all the pairs of focals : */
+    newFocal = Sets_getEmptyElement(combined.elementSize);
     /* For all focal elements of both mass functions : */
     for(i = 0; i < m1.nbFocals; i++){
     	for(j = 0; j < m2.nbFocals; j++){
     		/* Conjunction */
-    		newFocal = Sets_conjunction(m1.focals[i].element, m2.focals[j].element, combined.elementSize);
+    		Sets_conjunctionInto(&newFocal, m1.focals[i].element, m2.focals[j].element, combined.elementSize);
     		/* If empty intersection, then disjunction */
     		if(newFocal.card == 0){
-    			Sets_freeElement(&newFocal);
-    			newFocal = Sets_disjunction(m1.focals[i].element, m2.focals[j].element, combined.elementSize);
+    			Sets_disjunctionInto(&newFocal, m1.focals[i].element, m2.focals[j].element, combined.elementSize);
     		}
-    		index = -1;
-    		/* Check if already in the focals */
-    		for(k = 0; k < combined.nbFocals; k++){
-    			if(Sets_equals(combined.focals[k].element, newFocal, combined.elementSize)){
-    				index = k;
-    				combined.focals[k].beliefValue += m1.focals[i].beliefValue * m2.focals[j].beliefValue;
-    				break;
-    			}
-    		}
-    		/* If not in, add it ! */
-    		if(index == -1){
-    			combined.nbFocals++;
-    			combined.focals = realloc(combined.focals, sizeof(BF_FocalElement) * combined.nbFocals);
-    			DEBUG_CHECK_MALLOC(combined.focals);
-
-    			combined.focals[combined.nbFocals - 1].element = Sets_copyElement(newFocal, combined.elementSize);
-    			combined.focals[combined.nbFocals - 1].beliefValue = m1.focals[i].beliefValue * m2.focals[j].beliefValue;
-    		}
-    		Sets_freeElement(&newFocal);
+    		/* Add it to the focals (found through the index if already in) : */
+    		BF_addToFocal(&combined, index, newFocal, m1.focals[i].beliefValue * m2.focals[j].beliefValue);
     	}
     }
+    Sets_freeElement(&newFocal);
+    BF_freeFocalIndex(index);
 
     #ifdef CHECK_SUM
     if(BF_checkSum(combined)){
@@ -515,10 +1263,10 @@ BF_BeliefFunction BF_DuboisPradeCombination(const BF_BeliefFunction m1, const BF
 
 BF_BeliefFunction BF_fullAverageCombination(const BF_BeliefFunction* m, const int nbM){
     BF_BeliefFunction combined;
-    int i = 0, j = 0, k = 0, index = -1;
-    int size = m[0].elementSize;
 
     #ifdef CHECK_COMPATIBILITY
+    int i = 0;
+    int size = m[0].elementSize;
     for(i = 0; i < nbM; i++){
     	if(m[i].elementSize != size){
     		printf("debug: in BF_fullAverageCombination(), at least one mass function is not compatible with others...\n");
@@ -526,36 +1274,8 @@ BF_BeliefFunction BF_fullAverageCombination(const BF_BeliefFunction* m, const in
     }
     #endif
 
-    /*Initialize the belief function:*/
-    combined.nbFocals = 0;
-    combined.focals = NULL;
-    combined.elementSize = size;
-    /* For all mass functions : */
-    for(k = 0; k < nbM; k++){
-		for(i = 0; i < m[k].nbFocals; i++){
-			index = -1;
-			/* Check if already in the focals */
-			for(j = 0; j < combined.nbFocals; j++){
-				if(Sets_equals(combined.focals[j].element, m[k].focals[i].element, combined.elementSize)){
-					index = j;
-					combined.focals[j].beliefValue += m[k].focals[i].beliefValue;
-					break;
-				}
-			}
-			/* If not in, add it ! */
-			if(index == -1){
-				combined.nbFocals++;
-				combined.focals = realloc(combined.focals, sizeof(BF_FocalElement) * combined.nbFocals);
-				DEBUG_CHECK_MALLOC(combined.focals);
-
-				combined.focals[combined.nbFocals - 1].element = Sets_copyElement(m[k].focals[i].element, combined.elementSize);
-				combined.focals[combined.nbFocals - 1].beliefValue = m[k].focals[i].beliefValue;
-			}
-		}
-	}
-	for(i = 0; i<combined.nbFocals; i++){
-        combined.focals[i].beliefValue /= nbM;
-    }
+    /*Sum all the mass functions at once (the focals already in are found through a hash table):*/
+    combined = weightedAverage(m, nbM, NULL);
 
     #ifdef CHECK_SUM
     if(BF_checkSum(combined)){
@@ -575,7 +1295,8 @@ BF_BeliefFunction BF_fullAverageCombination(const BF_BeliefFunction* m, const in
 
 BF_BeliefFunction BF_averageCombination(const BF_BeliefFunction m1, const BF_BeliefFunction m2){
     BF_BeliefFunction combined;
-    int i = 0, j = 0, index = -1;
+    BF_FocalIndex* index = NULL;
+    int i = 0;
 
 	#ifdef CHECK_COMPATIBILITY
     if(m1.elementSize != m2.elementSize){
@@ -587,47 +1308,15 @@ BF_BeliefFunction BF_averageCombination(const BF_BeliefFunction m1, const BF_Bel
     combined.nbFocals = 0;
     combined.focals = NULL;
     combined.elementSize = m1.elementSize;
-    /*Do the average:*/
+    index = BF_indexBeliefFunction(combined);
+    /*Do the average (the index finds the focals already in):*/
     for(i = 0; i < m1.nbFocals; i++){
-    	index = -1;
-    	/* Check if already in the focals */
-    	for(j = 0; j < combined.nbFocals; j++){
-    		if(Sets_equals(combined.focals[j].element, m1.focals[i].element, combined.elementSize)){
-    			index = j;
-    			combined.focals[j].beliefValue += m1.focals[i].beliefValue;
-    			break;
-    		}
-    	}
-    	/* If not in, add it ! */
-    	if(index == -1){
-    		combined.nbFocals++;
-    		combined.focals = realloc(combined.focals, sizeof(BF_FocalElement) * combined.nbFocals);
-    		DEBUG_CHECK_MALLOC(combined.focals);
-
-    		combined.focals[combined.nbFocals - 1].element = Sets_copyElement(m1.focals[i].element, combined.elementSize);
-    		combined.focals[combined.nbFocals - 1].beliefValue = m1.focals[i].beliefValue;
-    	}
+    	BF_addToFocal(&combined, index, m1.focals[i].element, m1.focals[i].beliefValue);
     }
     for(i = 0; i < m2.nbFocals; i++){
-    	index = -1;
-    	/* Check if already in the focals */
-    	for(j = 0; j < combined.nbFocals; j++){
-    		if(Sets_equals(combined.focals[j].element, m2.focals[i].element, combined.elementSize)){
-    			index = j;
-    			combined.focals[j].beliefValue += m2.focals[i].beliefValue;
-    			break;
-    		}
-    	}
-    	/* If not in, add it ! */
-    	if(index == -1){
-    		combined.nbFocals++;
-    		combined.focals = realloc(combined.focals, sizeof(BF_FocalElement) * combined.nbFocals);
-    		DEBUG_CHECK_MALLOC(combined.focals);
-
-    		combined.focals[combined.nbFocals - 1].element = Sets_copyElement(m2.focals[i].element, combined.elementSize);
-    		combined.focals[combined.nbFocals - 1].beliefValue = m2.focals[i].beliefValue;
-    	}
+    	BF_addToFocal(&combined, index, m2.focals[i].element, m2.focals[i].beliefValue);
     }
+    BF_freeFocalIndex(index);
     for(i = 0; i<combined.nbFocals; i++){
         combined.focals[i].beliefValue /= 2;
     }
@@ -650,10 +1339,10 @@ BF_BeliefFunction BF_averageCombination(const BF_BeliefFunction m1, const BF_Bel
 
 
 BF_BeliefFunction BF_fullMurphyCombination(const BF_BeliefFunction* m, const int nbM){
-    BF_BeliefFunction combined, temp, temp2;
-    int i = 0;
+    BF_BeliefFunction combined, average;
 
     #ifdef CHECK_COMPATIBILITY
+    int i = 0;
     int size = m[0].elementSize;
     for(i = 0; i < nbM; i++){
     	if(m[i].elementSize != size){
@@ -663,16 +1352,10 @@ BF_BeliefFunction BF_fullMurphyCombination(const BF_BeliefFunction* m, const int
     #endif
 
     /*Get the average:*/
-    combined = BF_fullAverageCombination(m, nbM);
-    temp = BF_DempsterCombination(combined, combined);
-    /*Do the nbM-1 Dempster combinations:*/
-    for(i = 1; i<nbM-1; i++){
-        temp2 = BF_DempsterCombination(temp, combined);
-        BF_freeBeliefFunction(&temp);
-        temp = temp2;
-    }
-    BF_freeBeliefFunction(&combined);
-    combined = temp;
+    average = weightedAverage(m, nbM, NULL);
+    /*Do the nbM-1 Dempster combinations (at least one) at once:*/
+    combined = dempsterPower(average, nbM > 2 ? nbM : 2);
+    BF_freeBeliefFunction(&average);
 
     #ifdef CHECK_SUM
     if(BF_checkSum(combined)){
@@ -723,14 +1406,13 @@ BF_BeliefFunction BF_MurphyCombination(const BF_BeliefFunction m1, const BF_Beli
 
 
 BF_BeliefFunction BF_fullChenCombination(const BF_BeliefFunction* m, const int nbM){
-    BF_BeliefFunction combined, temp, temp2;
-    Sets_Set focals = {NULL, 0};
-    int i = 0, j = 0, nbMaxFocals = 0;
+    BF_BeliefFunction combined, average;
+    int i = 0;
     float *supports = NULL, *cred = NULL;
     float supportSum = 0;
-    int size = m[0].elementSize;
 
     #ifdef CHECK_COMPATIBILITY
+    int size = m[0].elementSize;
     for(i = 0; i < nbM; i++){
     	if(m[i].elementSize != size){
     		printf("debug: in BF_fullChenCombination(), at least one mass function is not compatible with others...\n");
@@ -738,31 +1420,8 @@ BF_BeliefFunction BF_fullChenCombination(const BF_BeliefFunction* m, const int n
     }
     #endif
 
-    /*Count the max number of focals:*/
-    for(i = 0; i<nbM; i++){
-        nbMaxFocals += m[i].nbFocals;
-    }
-    /*Initialize set:*/
-    focals.elements = malloc(sizeof(Sets_Element) * nbMaxFocals);
-    DEBUG_CHECK_MALLOC(focals.elements);
-
-    /*Get focals:*/
-    for(i = 0; i<nbM; i++){
-        for(j = 0; j<m[i].nbFocals; j++){
-            if(!Sets_isMember(m[i].focals[j].element, focals, size)){
-                focals.elements[focals.card] = Sets_copyElement(m[i].focals[j].element, size);
-                focals.card++;
-            }
-        }
-    }
-    /*Initialize the belief function:*/
-    combined.nbFocals = focals.card;
-    combined.focals = malloc(sizeof(BF_FocalElement) * combined.nbFocals);
-    DEBUG_CHECK_MALLOC(combined.focals);
-
-    combined.elementSize = size;
-    /*Get the credibility for each body of evidence:*/
-    supports = malloc(sizeof(float)*nbM);
+    /*Get the credibility for each body of evidence (all the distances at once):*/
+    supports = BF_supports(m, nbM);
     DEBUG_CHECK_MALLOC(supports);
 
     cred = malloc(sizeof(float)*nbM);
@@ -770,33 +1429,19 @@ BF_BeliefFunction BF_fullChenCombination(const BF_BeliefFunction* m, const int n
 
 
     for(i = 0; i<nbM; i++){
-        supports[i] = BF_support(m[i], m, nbM);
         supportSum += supports[i];
     }
     for(i = 0; i<nbM; i++){
         cred[i] = supports[i] / supportSum;
     }
-    /*Compute the weighted average:*/
-    for(i = 0; i<combined.nbFocals; i++){
-        combined.focals[i].element = Sets_copyElement(focals.elements[i], size);
-        combined.focals[i].beliefValue = 0;
-        for(j = 0; j<nbM; j++){
-            combined.focals[i].beliefValue += cred[j] * BF_m(m[j], focals.elements[i]);
-        }
-    }
-    /*nbM-1 Dempster combinations: */
-    temp = BF_DempsterCombination(combined, combined);
-    for(i = 1; i<nbM-1; i++){
-        temp2 = BF_DempsterCombination(temp, combined);
-        BF_freeBeliefFunction(&temp);
-        temp = temp2;
-    }
-    BF_freeBeliefFunction(&combined);
-    combined = temp;
+    /*Compute the weighted average (all the mass functions at once):*/
+    average = weightedAverage(m, nbM, cred);
+    /*nbM-1 Dempster combinations (at least one) at once: */
+    combined = dempsterPower(average, nbM > 2 ? nbM : 2);
+    BF_freeBeliefFunction(&average);
     /*Deallocation:*/
     free(supports);
     free(cred);
-    Sets_freeSet(&focals);
 
     #ifdef CHECK_SUM
     if(BF_checkSum(combined)){
@@ -833,6 +1478,70 @@ BF_BeliefFunction BF_fullCombination(const BF_BeliefFunction* m, const int nbM,
 
 
 
+BF_BeliefFunction BF_parallelFullCombination(const BF_BeliefFunction* m, const int nbM, const BF_CombinationRule type,
+        __attribute__((unused))const int nbWorkers){
+    BF_BeliefFunction combined = {NULL, 0, 0}, copy = {NULL, 0, 0};
+    BF_Arena* arena = NULL;
+    int nbThreads = 1, normalize = (type == DEMPSTER);
+
+    #ifdef CHECK_COMPATIBILITY
+    int i = 0;
+    for(i = 0; i < nbM; i++){
+    	if(m[i].elementSize != m[0].elementSize){
+    		printf("debug: in BF_parallelFullCombination(), at least one mass function is not compatible with others...\n");
+    	}
+    }
+    #endif
+
+    /*The other rules are not associative, their list is combined in order:*/
+    if(type != DEMPSTER && type != SMETS){
+        return BF_fullCombination(m, nbM, type);
+    }
+
+    #ifdef _OPENMP
+    nbThreads = (nbWorkers > 0) ? nbWorkers : omp_get_max_threads();
+    #endif
+
+    /*An arena is used by one thread only, the intermediate results are allocated with malloc()
+      (by the calling thread here and by the workers in each parallel region):*/
+    if(nbThreads > 1){
+        arena = BF_useArena(NULL);
+    }
+
+    /*Product of the commonalities when the pairwise combinations would cost more:*/
+    if(preferCommonalities(m, nbM)){
+        combined = commonalityFullCombination(m, nbM, normalize, nbThreads);
+    }
+    else {
+        combined = treeCombination(m, nbM, normalize, nbThreads);
+    }
+
+    /*The result is drawn from the arena of the caller:*/
+    if(arena != NULL){
+        BF_useArena(arena);
+        copy = BF_copyBeliefFunction(combined);
+        BF_useArena(NULL);
+        BF_freeBeliefFunction(&combined);
+        BF_useArena(arena);
+        combined = copy;
+    }
+
+    #ifdef CHECK_SUM
+    if(BF_checkSum(combined)){
+        printf("debug: in BF_parallelFullCombination(), the sum is not equal to 1.\ndebug: There may be a problem in the model.\n");
+    }
+    #endif
+    #ifdef CHECK_VALUES
+    if(BF_checkValues(combined)){
+    	printf("debug: in BF_parallelFullCombination(), at least one value is not valid!\n");
+    }
+    #endif
+
+    return combined;
+}
+
+
+
 BF_BeliefFunction BF_combination(const BF_BeliefFunction m1, const BF_BeliefFunction m2, const BF_CombinationRule type){
     BF_BeliefFunction result;
     BF_BeliefFunction* m = NULL;
@@ -861,6 +1570,268 @@ BF_BeliefFunction BF_combination(const BF_BeliefFunction m1, const BF_BeliefFunc
     }
 }
 
+
+
+BF_BeliefFunction BF_boundedCombination(const BF_BeliefFunction m1, const BF_BeliefFunction m2, const BF_CombinationRule type,
+        const int maxFocals, const BF_ApproximationMethod method, BF_Mass* movedMass){
+    BF_BeliefFunction bounded1 = m1, bounded2 = m2, combined = {NULL, 0, 0}, approximated = {NULL, 0, 0};
+    BF_Mass moved = 0;
+    double totalMoved = 0;
+
+    if(m1.nbFocals > maxFocals){
+        bounded1 = BF_approximation(m1, maxFocals, method, &moved);
+        totalMoved += moved;
+    }
+    if(m2.nbFocals > maxFocals){
+        bounded2 = BF_approximation(m2, maxFocals, method, &moved);
+        totalMoved += moved;
+    }
+    combined = BF_combination(bounded1, bounded2, type);
+    if(combined.nbFocals > maxFocals){
+        approximated = BF_approximation(combined, maxFocals, method, &moved);
+        totalMoved += moved;
+        BF_freeBeliefFunction(&combined);
+        combined = approximated;
+    }
+    if(bounded1.focals != m1.focals){
+        BF_freeBeliefFunction(&bounded1);
+    }
+    if(bounded2.focals != m2.focals){
+        BF_freeBeliefFunction(&bounded2);
+    }
+    if(movedMass != NULL){
+        *movedMass = totalMoved;
+    }
+
+    return combined;
+}
+
+
+
+BF_BeliefFunction BF_boundedFullCombination(const BF_BeliefFunction* m, const int nbM, const BF_CombinationRule type,
+        const int maxFocals, const BF_ApproximationMethod method, BF_Mass* movedMass){
+    BF_BeliefFunction combined = {NULL, 0, 0}, temp = {NULL, 0, 0};
+    BF_BeliefFunction* bounded = NULL;
+    BF_Mass moved = 0;
+    double totalMoved = 0;
+    int i = 0;
+
+    #ifdef CHECK_COMPATIBILITY
+    for(i = 0; i < nbM; i++){
+    	if(m[i].elementSize != m[0].elementSize){
+    		printf("debug: in BF_boundedFullCombination(), at least one mass function is not compatible with others...\n");
+    	}
+    }
+    #endif
+
+    /*The associative rules are bounded at each step:*/
+    if(type == SMETS || type == DEMPSTER){
+        combined = BF_approximation(m[0], maxFocals, method, &moved);
+        totalMoved += moved;
+        for(i = 1; i < nbM; i++){
+            temp = BF_boundedCombination(combined, m[i], type, maxFocals, method, &moved);
+            totalMoved += moved;
+            BF_freeBeliefFunction(&combined);
+            combined = temp;
+        }
+    }
+    else {
+        bounded = malloc(sizeof(BF_BeliefFunction) * nbM);
+        DEBUG_CHECK_MALLOC_OR_RETURN(bounded, combined);
+        for(i = 0; i < nbM; i++){
+            bounded[i] = m[i];
+            if(m[i].nbFocals > maxFocals){
+                bounded[i] = BF_approximation(m[i], maxFocals, method, &moved);
+                totalMoved += moved;
+            }
+        }
+        combined = BF_fullCombination(bounded, nbM, type);
+        if(combined.nbFocals > maxFocals){
+            temp = BF_approximation(combined, maxFocals, method, &moved);
+            totalMoved += moved;
+            BF_freeBeliefFunction(&combined);
+            combined = temp;
+        }
+        for(i = 0; i < nbM; i++){
+            if(bounded[i].focals != m[i].focals){
+                BF_freeBeliefFunction(&bounded[i]);
+            }
+        }
+        free(bounded);
+    }
+    if(movedMass != NULL){
+        *movedMass = totalMoved;
+    }
+
+    return combined;
+}
+
+
+
+BF_PackedBeliefFunction BF_packedSmetsCombination(const BF_PackedBeliefFunction m1, const BF_PackedBeliefFunction m2){
+    BF_PackedBeliefFunction combined = {NULL, 0, 0};
+    BF_PackedFocalElement *resized = NULL;
+    Sets_PackedElement conj = 0;
+    double *sums = NULL;
+    int *positions = NULL, *slots = NULL;
+    unsigned int mask = 7, slot = 0;
+    int i = 0, j = 0, k = 0;
+
+	#ifdef CHECK_COMPATIBILITY
+    if(m1.elementSize != m2.elementSize){
+    	printf("debug: in BF_packedSmetsCombination(), the two mass functions aren't defined on the same frame...\n");
+    }
+    #endif
+
+    combined.elementSize = m1.elementSize;
+    if(m1.nbFocals == 0 || m2.nbFocals == 0){
+        return combined;
+    }
+
+    /*Memory allocation (there cannot be more than nb1*nb2 focals):*/
+    combined.focals = malloc(sizeof(BF_PackedFocalElement) * m1.nbFocals * m2.nbFocals);
+    DEBUG_CHECK_MALLOC_OR_RETURN(combined.focals, combined);
+    sums = malloc(sizeof(double) * m1.nbFocals * m2.nbFocals);
+    DEBUG_CHECK_MALLOC_OR_RETURN(sums, combined);
+
+    /*Position of each subset in the focals (+1) when most of them may be focal:*/
+    if(BF_preferDenseForm(combined.elementSize, m1.nbFocals * m2.nbFocals)){
+        positions = calloc(1 << combined.elementSize, sizeof(int));
+        DEBUG_CHECK_MALLOC_OR_RETURN(positions, combined);
+    }
+    /*Open addressing hash table of the positions (+1) otherwise (at most one half of the slots are used):*/
+    else {
+        while(mask < 2 * (unsigned int)(m1.nbFocals * m2.nbFocals)){
+            mask = 2 * mask + 1;
+        }
+        slots = calloc(mask + 1, sizeof(int));
+        DEBUG_CHECK_MALLOC_OR_RETURN(slots, combined);
+    }
+
+    /*Combine:*/
+    for(i = 0; i < m1.nbFocals; i++){
+        for(j = 0; j < m2.nbFocals; j++){
+            conj = Sets_packedConjunction(m1.focals[i].element, m2.focals[j].element);
+            /* Check if already in the focals */
+            if(positions != NULL){
+                k = positions[conj] > 0 ? positions[conj] - 1 : combined.nbFocals;
+                positions[conj] = k + 1;
+            }
+            else {
+                slot = (unsigned int)Sets_wordsHash(&conj, 1) & mask;
+                while(slots[slot] != 0 && combined.focals[slots[slot] - 1].element != conj){
+                    slot = (slot + 1) & mask;
+                }
+                k = slots[slot] > 0 ? slots[slot] - 1 : combined.nbFocals;
+                slots[slot] = k + 1;
+            }
+            /* If not in, add it ! */
+            if(k == combined.nbFocals){
+                combined.focals[k].element = conj;
+                sums[k] = 0;
+                combined.nbFocals++;
+            }
+            sums[k] += m1.focals[i].beliefValue * m2.focals[j].beliefValue;
+        }
+    }
+    for(k = 0; k < combined.nbFocals; k++){
+        combined.focals[k].beliefValue = sums[k];
+    }
+
+    free(sums);
+    free(positions);
+    free(slots);
+
+    /*Give back the unused memory:*/
+    resized = realloc(combined.focals, sizeof(BF_PackedFocalElement) * combined.nbFocals);
+    if(resized != NULL){
+        combined.focals = resized;
+    }
+
+    return combined;
+}
+
+
+
+BF_DenseBeliefFunction BF_denseSmetsCombination(const BF_DenseBeliefFunction m1, const BF_DenseBeliefFunction m2){
+    BF_DenseBeliefFunction combined = {NULL, 0};
+    Sets_PackedElement *focals1 = NULL, *focals2 = NULL;
+    double *sums = NULL;
+    int nbSubsets = 1 << m1.elementSize;
+    int nb1 = 0, nb2 = 0;
+    int i = 0, j = 0;
+
+	#ifdef CHECK_COMPATIBILITY
+    if(m1.elementSize != m2.elementSize){
+    	printf("debug: in BF_denseSmetsCombination(), the two mass functions aren't defined on the same frame...\n");
+    }
+    #endif
+
+    combined.elementSize = m1.elementSize;
+    combined.values = malloc(sizeof(BF_Mass) * nbSubsets);
+    DEBUG_CHECK_MALLOC_OR_RETURN(combined.values, combined);
+    sums = calloc(nbSubsets, sizeof(double));
+    DEBUG_CHECK_MALLOC_OR_RETURN(sums, combined);
+    focals1 = malloc(sizeof(Sets_PackedElement) * nbSubsets);
+    DEBUG_CHECK_MALLOC_OR_RETURN(focals1, combined);
+    focals2 = malloc(sizeof(Sets_PackedElement) * nbSubsets);
+    DEBUG_CHECK_MALLOC_OR_RETURN(focals2, combined);
+
+    /*Get the focal elements:*/
+    for(i = 0; i < nbSubsets; i++){
+        if(m1.values[i] != 0){
+            focals1[nb1++] = i;
+        }
+        if(m2.values[i] != 0){
+            focals2[nb2++] = i;
+        }
+    }
+
+    /*Combine:*/
+    for(i = 0; i < nb1; i++){
+        for(j = 0; j < nb2; j++){
+            sums[Sets_packedConjunction(focals1[i], focals2[j])] += m1.values[focals1[i]] * m2.values[focals2[j]];
+        }
+    }
+    for(i = 0; i < nbSubsets; i++){
+        combined.values[i] = sums[i];
+    }
+
+    free(focals1);
+    free(focals2);
+    free(sums);
+
+    return combined;
+}
+
+
+
+BF_DenseBeliefFunction BF_denseDempsterCombination(const BF_DenseBeliefFunction m1, const BF_DenseBeliefFunction m2){
+    BF_DenseBeliefFunction combined;
+
+    /*Get the Smets combination and normalize it with the void mass:*/
+    combined = BF_denseSmetsCombination(m1, m2);
+    if(!denseDempsterNormalization(&combined)){
+        #ifdef CHECK_VALUES
+        printf("debug: in BF_denseDempsterCombination(), major conflict, m(void) = 1!\n");
+        #endif
+    }
+
+    return combined;
+}
+
+
+
+BF_DenseBeliefFunction BF_denseFullSmetsCombination(const BF_DenseBeliefFunction* m, const int nbM){
+    return denseFullCombination(m, nbM, 0);
+}
+
+
+
+BF_DenseBeliefFunction BF_denseFullDempsterCombination(const BF_DenseBeliefFunction* m, const int nbM){
+    return denseFullCombination(m, nbM, 1);
+}
+
 /** @} */
 
 
@@ -874,28 +1845,36 @@ BF_BeliefFunction BF_combination(const BF_BeliefFunction m1, const BF_BeliefFunc
 float* BF_autoConflict(const BF_BeliefFunction m, const int maxDegree){
     float* voidMasses = NULL;
     int i = 0;
-    Sets_Element emptySet;
     BF_BeliefFunction temp, temp2;
-
-    /*Get void: */
-    emptySet = Sets_getEmptyElement(m.elementSize);
+    BF_PackedBeliefFunction packed, packedTemp, packedTemp2;
 
     /*Allocation: */
     voidMasses = malloc(sizeof(float) * maxDegree);
     DEBUG_CHECK_MALLOC(voidMasses);
 
-    /*Initialization: */
-    temp = BF_SmetsCombination(m, m);
-    for(i = 0; i<maxDegree; i++){
-        voidMasses[i] = BF_m(temp, emptySet);
-        temp2 = temp;
-        temp = BF_SmetsCombination(temp, m);
-        BF_freeBeliefFunction(&temp2);
+    /*Packed powers of m for small frames:*/
+    if(m.elementSize <= SETS_PACKED_MAX_SIZE){
+        packed = BF_packBeliefFunction(m);
+        packedTemp = BF_packedSmetsCombination(packed, packed);
+        for(i = 0; i<maxDegree; i++){
+            voidMasses[i] = getPackedVoidMass(packedTemp);
+            packedTemp2 = packedTemp;
+            packedTemp = BF_packedSmetsCombination(packedTemp, packed);
+            BF_freePackedBeliefFunction(&packedTemp2);
+        }
+        BF_freePackedBeliefFunction(&packedTemp);
+        BF_freePackedBeliefFunction(&packed);
+    }
+    else {
+        temp = BF_SmetsCombination(m, m);
+        for(i = 0; i<maxDegree; i++){
+            voidMasses[i] = getVoidMass(temp);
+            temp2 = temp;
+            temp = BF_SmetsCombination(temp, m);
+            BF_freeBeliefFunction(&temp2);
+        }
+        BF_freeBeliefFunction(&temp);
     }
-
-    /*Deallocation: */
-    BF_freeBeliefFunction(&temp);
-    Sets_freeElement(&emptySet);
 
     return voidMasses;
 }
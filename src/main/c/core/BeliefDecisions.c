@@ -17,6 +17,8 @@
 
 
 #include "BeliefDecisions.h"
+#include <float.h>
+#include "ArenaAllocation.h"
 
 
 /**
@@ -36,8 +38,12 @@
   
 
 
+/*
+ * The elements of the list beyond its size may still hold allocated values
+ * (nbBuffers of them in total) which are reused by the next appends.
+ */
 static unsigned int listAppend(BF_FocalElementList *list, const BF_FocalElement element,
-		const unsigned int realSize, const int elementSize) {
+		const unsigned int realSize, const int elementSize, unsigned int *nbBuffers) {
 	BF_FocalElement *newArray;
 	unsigned int newSize = realSize;
 	if(realSize == list->size) {
@@ -49,7 +55,13 @@ static unsigned int listAppend(BF_FocalElementList *list, const BF_FocalElement
 		list->elements = newArray;
 	}
 	list->elements[list->size].beliefValue = element.beliefValue;
-	list->elements[list->size].element = Sets_copyElement(element.element, elementSize);
+	if(list->size < *nbBuffers) {
+		Sets_copyElementInto(&(list->elements[list->size].element), element.element, elementSize);
+	}
+	else {
+		list->elements[list->size].element = Sets_copyElement(element.element, elementSize);
+		(*nbBuffers)++;
+	}
 	list->size++;
 	return newSize;
 }
@@ -60,11 +72,314 @@ static BF_FocalElementList newList() {
 }
 
 static void emptyList(BF_FocalElementList *list) {
+	/* the values are kept to be reused */
+	list->size = 0;
+}
+
+/*
+ * Restricts a view to the cardinalities accepted by the decision functions.
+ */
+static Sets_PowerSetView decisionView(const Sets_PowerSetView view, const int maxCard) {
+	if(maxCard == 0){
+		return view;
+	}
+	return Sets_restrictToCardinality(view, 0, maxCard);
+}
+
+/*
+ * Builds a list from the packed extrema found in a view, sorted by increasing id.
+ */
+static BF_FocalElementList listFromPacked(BF_PackedBeliefFunction extrema) {
+	BF_FocalElementList list = {NULL, 0};
+	BF_BeliefFunction unpacked;
+
+	BF_sortPackedBeliefFunction(&extrema);
+	unpacked = BF_unpackBeliefFunction(extrema);
+	list.elements = unpacked.focals;
+	list.size = unpacked.nbFocals;
+	BF_freePackedBeliefFunction(&extrema);
+
+	return list;
+}
+
+static void trimList(BF_FocalElementList *list, const unsigned int nbBuffers) {
 	unsigned int i;
-	for (i = 0; i < list->size; ++i) {
+	for (i = list->size; i < nbBuffers; ++i) {
 		Sets_freeElement(&(list->elements[i].element));
 	}
-	list->size = 0;
+}
+
+/*
+ * Number of subsets of nbAtoms atoms whose cardinality is between minCard and maxCard.
+ */
+static double nbSubsets(const int nbAtoms, const int minCard, const int maxCard) {
+	double binomial = 1, nb = 0;
+	int card = 0;
+	for(card = 0; card <= nbAtoms && card <= maxCard; card++){
+		if(card >= minCard){
+			nb += binomial;
+		}
+		binomial = binomial * (nbAtoms - card) / (card + 1);
+	}
+	return nb;
+}
+
+/*
+ * Values of a criterion for all the subsets of the frame (indexed by id) computed at once
+ * with the transforms of dense belief functions. Only available for BF_m(), BF_bel(), BF_pl(),
+ * BF_q() and BF_betP() and only used when it is cheaper than calling the criterion on each
+ * candidate (values is NULL otherwise).
+ * The values given by the transforms may differ from the ones of the criterion by rounding
+ * errors. To give exactly the same results, the candidates whose value may be the extremum
+ * or the value looked for (the ones between low and high) are checked with the packed version
+ * of the criterion, which does the same operations in the same order as the criterion.
+ */
+struct CriterionValues {
+	BF_Mass* values;
+	BF_PackedBeliefFunction packed;
+	BF_criterionFunction criterion;
+	BF_Mass low;
+	BF_Mass high;
+};
+typedef struct CriterionValues CriterionValues;
+
+static CriterionValues getCriterionValues(BF_criterionFunction criterion, const BF_BeliefFunction m,
+		const double nbQueries) {
+	CriterionValues criterionValues = {NULL, {NULL, 0, 0}, NULL, -FLT_MAX, FLT_MAX};
+	BF_DenseBeliefFunction dense, transformed = {NULL, 0};
+	int i = 0;
+
+	criterionValues.criterion = criterion;
+	if(m.elementSize < 1 || m.elementSize > BF_DENSE_MAX_SIZE ||
+			nbQueries * m.nbFocals < (double)m.elementSize * (1 << m.elementSize)){
+		return criterionValues;
+	}
+	if(criterion == BF_m){
+		/*The first occurrence of an element gives its mass (as in BF_m()):*/
+		transformed.values = calloc(1 << m.elementSize, sizeof(BF_Mass));
+		DEBUG_CHECK_MALLOC_OR_RETURN(transformed.values, criterionValues);
+		for(i = m.nbFocals - 1; i >= 0; i--){
+			transformed.values[Sets_packElement(m.focals[i].element, m.elementSize)] = m.focals[i].beliefValue;
+		}
+	}
+	else if(criterion == BF_bel || criterion == BF_pl || criterion == BF_q || criterion == BF_betP){
+		dense = BF_toDenseBeliefFunction(m);
+		if(criterion == BF_bel){
+			transformed = BF_denseCredibilities(dense);
+		}
+		else if(criterion == BF_pl){
+			transformed = BF_densePlausibilities(dense);
+		}
+		else if(criterion == BF_q){
+			transformed = BF_denseCommonalities(dense);
+		}
+		else {
+			transformed = BF_densePignisticProbabilities(dense);
+		}
+		BF_freeDenseBeliefFunction(&dense);
+	}
+	if(transformed.values != NULL){
+		criterionValues.values = transformed.values;
+		criterionValues.packed = BF_packBeliefFunction(m);
+	}
+
+	return criterionValues;
+}
+
+/*
+ * Bounds the values to check (see CriterionValues) for the search of the extremum of the
+ * subsets of the view (extremum = 1 for the maximum, -1 for the minimum not null) or of
+ * the given value (extremum = 0). The rounding errors are bounded by relative * |v| + absolute
+ * (sums of non-negative masses in single precision, cancellations in double precision).
+ */
+static void focusCriterionValues(CriterionValues *criterionValues, const BF_BeliefFunction m,
+		const Sets_PowerSetView view, const int extremum, const BF_Mass value) {
+	const BF_Mass *values = criterionValues->values;
+	double relative = 4.0 * (m.nbFocals + m.elementSize + 1) * FLT_EPSILON;
+	double absolute = 0, reference = extremum > 0 ? -FLT_MAX : FLT_MAX;
+	int nbSubsets = 1 << m.elementSize;
+	int i = 0, card = 0;
+
+	if(values == NULL){
+		return;
+	}
+	for(i = 0; i < m.nbFocals; i++){
+		absolute += fabs(m.focals[i].beliefValue);
+		if(m.focals[i].beliefValue < 0){
+			relative = -1;
+		}
+	}
+	if(relative < 0){
+		/*Negative masses: only an absolute bound.*/
+		absolute *= 4.0 * (m.nbFocals + m.elementSize + 1) * FLT_EPSILON;
+		relative = 0;
+	}
+	else {
+		absolute *= 4.0 * (m.nbFocals + m.elementSize + 1) * DBL_EPSILON;
+	}
+
+	if(extremum == 0){
+		criterionValues->low = value - 2 * (relative * fabs(value) + absolute);
+		criterionValues->high = value + 2 * (relative * fabs(value) + absolute);
+		return;
+	}
+	for(i = 1; i < nbSubsets; i++){
+		card = Sets_packedCard((Sets_PackedElement)i);
+		if((i & ~view.subsetOf) == 0 && (i & view.supersetOf) == view.supersetOf &&
+				card >= view.minCard && card <= view.maxCard){
+			if(extremum > 0 && values[i] > reference){
+				reference = values[i];
+			}
+			else if(extremum < 0 && values[i] < -2 * absolute){
+				/*Negative values: everything is checked.*/
+				return;
+			}
+			else if(extremum < 0 && values[i] > 2 * absolute && values[i] < reference){
+				reference = values[i];
+			}
+		}
+	}
+	if(extremum > 0){
+		criterionValues->low = reference - 2 * (relative * fabs(reference) + absolute);
+	}
+	else if(reference < FLT_MAX){
+		criterionValues->high = reference + 3 * (relative * reference + absolute);
+	}
+}
+
+static BF_Mass getCriterionValue(const CriterionValues *criterionValues, const Sets_PackedElement id) {
+	const BF_Mass value = criterionValues->values[id];
+	BF_criterionFunction criterion = criterionValues->criterion;
+	if(value < criterionValues->low || value > criterionValues->high){
+		return value;
+	}
+	if(criterion == BF_m){
+		return BF_packedM(criterionValues->packed, id);
+	}
+	if(criterion == BF_bel){
+		return BF_packedBel(criterionValues->packed, id);
+	}
+	if(criterion == BF_pl){
+		return BF_packedPl(criterionValues->packed, id);
+	}
+	if(criterion == BF_q){
+		return BF_packedQ(criterionValues->packed, id);
+	}
+	return BF_packedBetP(criterionValues->packed, id);
+}
+
+static void freeCriterionValues(CriterionValues *criterionValues) {
+	free(criterionValues->values);
+	criterionValues->values = NULL;
+	BF_freePackedBeliefFunction(&(criterionValues->packed));
+}
+
+/*
+ * Values of the criterion on the subsets of a view (see CriterionValues).
+ */
+static CriterionValues getViewValues(BF_criterionFunction criterion, const BF_BeliefFunction m,
+		const Sets_PowerSetView view, const int extremum) {
+	int nbFixed = Sets_packedCard(view.supersetOf);
+	CriterionValues criterionValues = getCriterionValues(criterion, m,
+			nbSubsets(Sets_packedCard(view.subsetOf & ~view.supersetOf), view.minCard - nbFixed, view.maxCard - nbFixed));
+	focusCriterionValues(&criterionValues, m, view, extremum, 0);
+	return criterionValues;
+}
+
+/*
+ * Enumeration of the indices of the elements of a powerset which can be chosen
+ * by the decision functions (not void and of cardinality <= maxCard, maxCard = 0
+ * meaning no limit) and of the values of the criterion on them. When the powerset
+ * is a complete one generated by Sets_generatePowerSet(), the index of an element
+ * is its id and only the subsets of the accepted cardinalities are visited, in the
+ * same order, by a lazy view. The values of the criterion may then be computed for
+ * all the subsets at once (see CriterionValues). Otherwise, the whole powerset is
+ * scanned and the criterion is called on each candidate.
+ */
+struct Candidates {
+	Sets_Set powerset;
+	Sets_PowerSetIterator iterator;
+	BF_BeliefFunction m;
+	CriterionValues criterionValues;
+	int lazy;
+	int maxCard;
+	int index;
+};
+typedef struct Candidates Candidates;
+
+static int isStandardPowerSet(const Sets_Set powerset, const int elementSize) {
+	int j = 0;
+	if(elementSize < 1 || elementSize > 30 || powerset.card != 1 << elementSize){
+		return 0;
+	}
+	for(j = 0; j < elementSize; j++){
+		if(powerset.elements[1 << j].card != 1 || !powerset.elements[1 << j].values[j]){
+			return 0;
+		}
+	}
+	return 1;
+}
+
+/*
+ * extremum and value give what the candidates are used for (see focusCriterionValues()).
+ * function is the name of the decision function, for the debug messages.
+ */
+static void startCandidates(Candidates *candidates, const Sets_Set powerset, const BF_BeliefFunction m,
+		BF_criterionFunction criterion, const int maxCard, const int extremum, const BF_Mass value,
+		__attribute__((unused))const char *function) {
+	int standard = isStandardPowerSet(powerset, m.elementSize);
+	Sets_PowerSetView view;
+	#ifdef CHECK_VALUES
+	if(powerset.card == 0 && m.elementSize > 0){
+		printf("debug: in %s(), the powerset is empty: the powerset of large frames is only given as a view, use the InView functions.\n", function);
+	}
+	#endif
+	candidates->powerset = powerset;
+	candidates->m = m;
+	candidates->maxCard = maxCard;
+	candidates->index = -1;
+	candidates->lazy = maxCard > 0 && maxCard < m.elementSize && standard;
+	if(candidates->lazy){
+		candidates->iterator = Sets_iteratePowerSet(
+				Sets_restrictToCardinality(Sets_getPowerSetView(m.elementSize), 1, maxCard));
+	}
+	if(standard){
+		view = Sets_restrictToCardinality(Sets_getPowerSetView(m.elementSize), 1, maxCard > 0 ? maxCard : m.elementSize);
+		candidates->criterionValues = getCriterionValues(criterion, m,
+				nbSubsets(m.elementSize, view.minCard, view.maxCard));
+		focusCriterionValues(&(candidates->criterionValues), m, view, extremum, value);
+	}
+	else {
+		candidates->criterionValues = getCriterionValues(criterion, m, 0);
+	}
+}
+
+static int nextCandidate(Candidates *candidates) {
+	const Sets_Set powerset = candidates->powerset;
+	if(candidates->lazy){
+		return Sets_nextSubset(&(candidates->iterator)) ? (int) candidates->iterator.id : -1;
+	}
+	for(candidates->index++; candidates->index < powerset.card; candidates->index++){
+		if((powerset.elements[candidates->index].card <= candidates->maxCard || candidates->maxCard == 0) &&
+				powerset.elements[candidates->index].card > 0){
+			return candidates->index;
+		}
+	}
+	return -1;
+}
+
+static BF_Mass candidateValue(const Candidates *candidates, const int i) {
+	if(candidates->criterionValues.values != NULL){
+		return getCriterionValue(&(candidates->criterionValues), (Sets_PackedElement)i);
+	}
+	return candidates->criterionValues.criterion(candidates->m, candidates->powerset.elements[i]);
+}
+
+static void endCandidates(Candidates *candidates) {
+	if(candidates->lazy){
+		Sets_freePowerSetIterator(&(candidates->iterator));
+	}
+	freeCriterionValues(&(candidates->criterionValues));
 }
 
 
@@ -86,22 +401,21 @@ static void emptyList(BF_FocalElementList *list) {
 
 BF_FocalElement BF_getMax(BF_criterionFunction criterion, const BF_BeliefFunction beliefFunction,
 		const int maxCard, const Sets_Set powerset) {
+    Candidates candidates;
     BF_FocalElement  max = {{NULL,0}, 0};
     int i = 0, maxIndex = -1;
-    float value = 0;
+    BF_Mass value = 0;
 
 
-    for(i = 0; i < powerset.card; i++){
-        if((powerset.elements[i].card <= maxCard ||
-        		maxCard == 0)                         &&
-           powerset.elements[i].card > 0 ){
-            value = criterion(beliefFunction, powerset.elements[i]);
-            if(value > max.beliefValue){
-                maxIndex = i;
-                max.beliefValue = value;
-            }
+    startCandidates(&candidates, powerset, beliefFunction, criterion, maxCard, 1, 0, "BF_getMax");
+    while((i = nextCandidate(&candidates)) != -1){
+        value = candidateValue(&candidates, i);
+        if(value > max.beliefValue){
+            maxIndex = i;
+            max.beliefValue = value;
         }
     }
+    endCandidates(&candidates);
     if(maxIndex != -1){
         max.element = Sets_copyElement(powerset.elements[maxIndex], beliefFunction.elementSize);
     }
@@ -111,22 +425,21 @@ BF_FocalElement BF_getMax(BF_criterionFunction criterion, const BF_BeliefFunctio
 
 BF_FocalElement BF_getMin(BF_criterionFunction criterion, const BF_BeliefFunction beliefFunction,
 		const int maxCard, const Sets_Set powerset) {
+    Candidates candidates;
     BF_FocalElement  min = {{NULL,0}, 1};
     int i = 0, minIndex = -1;
-    float value = 0;
-
-    for(i = 0; i < powerset.card; i++){
-        if((powerset.elements[i].card <= maxCard ||
-        		maxCard == 0)                         &&
-           powerset.elements[i].card > 0){
-            value = criterion(beliefFunction, powerset.elements[i]);
-            if(value <= min.beliefValue &&
-               value != 0){
-                minIndex = i;
-                min.beliefValue = value;
-            }
+    BF_Mass value = 0;
+
+    startCandidates(&candidates, powerset, beliefFunction, criterion, maxCard, -1, 0, "BF_getMin");
+    while((i = nextCandidate(&candidates)) != -1){
+        value = candidateValue(&candidates, i);
+        if(value <= min.beliefValue &&
+           value != 0){
+            minIndex = i;
+            min.beliefValue = value;
         }
     }
+    endCandidates(&candidates);
     if(minIndex != -1){
         min.element = Sets_copyElement(powerset.elements[minIndex], beliefFunction.elementSize);
     }
@@ -138,66 +451,198 @@ BF_FocalElement BF_getMin(BF_criterionFunction criterion, const BF_BeliefFunctio
 
 BF_FocalElementList BF_getMaxList(BF_criterionFunction criterion, const BF_BeliefFunction beliefFunction,
 		const int maxCard, const Sets_Set powerset) {
+	Candidates candidates;
 	BF_FocalElementList  list = newList();
-	unsigned int listSize = 0;
+	unsigned int listSize = 0, nbBuffers = 0;
 
     BF_FocalElement  max = {{NULL,0}, 0};
 	int i = 0;
-	float value = 0;
+	BF_Mass value = 0;
 
 
-	for(i = 0; i < powerset.card; i++){
-		if((powerset.elements[i].card <= maxCard ||
-				maxCard == 0)                         &&
-		   powerset.elements[i].card > 0 ){
-			value = criterion(beliefFunction, powerset.elements[i]);
+	startCandidates(&candidates, powerset, beliefFunction, criterion, maxCard, 1, 0, "BF_getMaxList");
+	while((i = nextCandidate(&candidates)) != -1){
+		value = candidateValue(&candidates, i);
 
-			if(value > max.beliefValue){
-				emptyList(&list);
-				max.element = powerset.elements[i];
-				max.beliefValue = value;
-				listSize = listAppend(&list, max, listSize, beliefFunction.elementSize);
-			}
-			else if(value == max.beliefValue && value > 0) {
-				max.element = powerset.elements[i];
-				listSize = listAppend(&list, max, listSize, beliefFunction.elementSize);
-			}
+		if(value > max.beliefValue){
+			emptyList(&list);
+			max.element = powerset.elements[i];
+			max.beliefValue = value;
+			listSize = listAppend(&list, max, listSize, beliefFunction.elementSize, &nbBuffers);
+		}
+		else if(value == max.beliefValue && value > 0) {
+			max.element = powerset.elements[i];
+			listSize = listAppend(&list, max, listSize, beliefFunction.elementSize, &nbBuffers);
 		}
 	}
+	endCandidates(&candidates);
+	trimList(&list, nbBuffers);
 
 	return list;
 }
 
 BF_FocalElementList BF_getMinList(BF_criterionFunction criterion, const BF_BeliefFunction beliefFunction,
 		const int maxCard, const Sets_Set powerset) {
+	Candidates candidates;
 	BF_FocalElementList  list = newList();
-	unsigned int listSize = 0;
+	unsigned int listSize = 0, nbBuffers = 0;
 
     BF_FocalElement  min = {{NULL,0}, 2};
 	int i = 0;
-	float value = 0;
+	BF_Mass value = 0;
+
+
+	startCandidates(&candidates, powerset, beliefFunction, criterion, maxCard, -1, 0, "BF_getMinList");
+	while((i = nextCandidate(&candidates)) != -1){
+		value = candidateValue(&candidates, i);
+
+		if(value < min.beliefValue && value > 0){
+			emptyList(&list);
+			min.element = powerset.elements[i];
+			min.beliefValue = value;
+			listSize = listAppend(&list, min, listSize, beliefFunction.elementSize, &nbBuffers);
+		}
+		else if(value == min.beliefValue) {
+			min.element = powerset.elements[i];
+			listSize = listAppend(&list, min, listSize, beliefFunction.elementSize, &nbBuffers);
+		}
+	}
+	endCandidates(&candidates);
+	trimList(&list, nbBuffers);
+
+	return list;
+}
+
+BF_FocalElement BF_getMaxInView(BF_criterionFunction criterion, const BF_BeliefFunction beliefFunction,
+		const int maxCard, const Sets_PowerSetView view) {
+    BF_FocalElement  max = {{NULL,0}, 0};
+    Sets_PowerSetIterator it = Sets_iteratePowerSet(decisionView(view, maxCard));
+    CriterionValues criterionValues = getViewValues(criterion, beliefFunction, decisionView(view, maxCard), 1);
+    Sets_PackedElement maxId = 0;
+    int found = 0;
+    BF_Mass value = 0;
+
+    while(Sets_nextSubset(&it)){
+        if(it.element.card > 0){
+            value = criterionValues.values != NULL ? getCriterionValue(&criterionValues, it.id) :
+                    criterion(beliefFunction, it.element);
+            if(value > max.beliefValue || (found && value == max.beliefValue && it.id < maxId)){
+                maxId = it.id;
+                max.beliefValue = value;
+                found = 1;
+            }
+        }
+    }
+    Sets_freePowerSetIterator(&it);
+    freeCriterionValues(&criterionValues);
+    if(found){
+        max.element = Sets_unpackElement(maxId, beliefFunction.elementSize);
+    }
 
+    return max;
+}
 
-	for(i = 0; i < powerset.card; i++){
-		if((powerset.elements[i].card <= maxCard ||
-				maxCard == 0)                         &&
-		   powerset.elements[i].card > 0 ){
-			value = criterion(beliefFunction, powerset.elements[i]);
+BF_FocalElement BF_getMinInView(BF_criterionFunction criterion, const BF_BeliefFunction beliefFunction,
+		const int maxCard, const Sets_PowerSetView view) {
+    BF_FocalElement  min = {{NULL,0}, 1};
+    Sets_PowerSetIterator it = Sets_iteratePowerSet(decisionView(view, maxCard));
+    CriterionValues criterionValues = getViewValues(criterion, beliefFunction, decisionView(view, maxCard), -1);
+    Sets_PackedElement minId = 0;
+    int found = 0;
+    BF_Mass value = 0;
+
+    while(Sets_nextSubset(&it)){
+        if(it.element.card > 0){
+            value = criterionValues.values != NULL ? getCriterionValue(&criterionValues, it.id) :
+                    criterion(beliefFunction, it.element);
+            if(value != 0 && (value < min.beliefValue || (value == min.beliefValue && (!found || it.id > minId)))){
+                minId = it.id;
+                min.beliefValue = value;
+                found = 1;
+            }
+        }
+    }
+    Sets_freePowerSetIterator(&it);
+    freeCriterionValues(&criterionValues);
+    if(found){
+        min.element = Sets_unpackElement(minId, beliefFunction.elementSize);
+    }
+
+    return min;
+}
 
-			if(value < min.beliefValue && value > 0){
-				emptyList(&list);
-				min.element = powerset.elements[i];
-				min.beliefValue = value;
-				listSize = listAppend(&list, min, listSize, beliefFunction.elementSize);
+BF_FocalElementList BF_getMaxListInView(BF_criterionFunction criterion, const BF_BeliefFunction beliefFunction,
+		const int maxCard, const Sets_PowerSetView view) {
+	BF_PackedBeliefFunction extrema = {NULL, 0, 0};
+	BF_PackedFocalElement *newArray = NULL;
+	Sets_PowerSetIterator it = Sets_iteratePowerSet(decisionView(view, maxCard));
+	CriterionValues criterionValues = getViewValues(criterion, beliefFunction, decisionView(view, maxCard), 1);
+	int realSize = 0;
+	BF_Mass max = 0, value = 0;
+
+	extrema.elementSize = beliefFunction.elementSize;
+	while(Sets_nextSubset(&it)){
+		if(it.element.card > 0){
+			value = criterionValues.values != NULL ? getCriterionValue(&criterionValues, it.id) :
+					criterion(beliefFunction, it.element);
+			if(value > max){
+				extrema.nbFocals = 0;
+				max = value;
 			}
-			else if(value == min.beliefValue) {
-				min.element = powerset.elements[i];
-				listSize = listAppend(&list, min, listSize, beliefFunction.elementSize);
+			if(value == max && value > 0){
+				if(extrema.nbFocals == realSize){
+					realSize = (realSize + 1) * 1.25;
+					newArray = realloc(extrema.focals, sizeof(BF_PackedFocalElement) * realSize);
+					DEBUG_CHECK_MALLOC_OR_RETURN(newArray, listFromPacked(extrema));
+					extrema.focals = newArray;
+				}
+				extrema.focals[extrema.nbFocals].element = it.id;
+				extrema.focals[extrema.nbFocals].beliefValue = value;
+				extrema.nbFocals++;
 			}
 		}
 	}
+	Sets_freePowerSetIterator(&it);
+	freeCriterionValues(&criterionValues);
 
-	return list;
+	return listFromPacked(extrema);
+}
+
+BF_FocalElementList BF_getMinListInView(BF_criterionFunction criterion, const BF_BeliefFunction beliefFunction,
+		const int maxCard, const Sets_PowerSetView view) {
+	BF_PackedBeliefFunction extrema = {NULL, 0, 0};
+	BF_PackedFocalElement *newArray = NULL;
+	Sets_PowerSetIterator it = Sets_iteratePowerSet(decisionView(view, maxCard));
+	CriterionValues criterionValues = getViewValues(criterion, beliefFunction, decisionView(view, maxCard), -1);
+	int realSize = 0;
+	BF_Mass min = 2, value = 0;
+
+	extrema.elementSize = beliefFunction.elementSize;
+	while(Sets_nextSubset(&it)){
+		if(it.element.card > 0){
+			value = criterionValues.values != NULL ? getCriterionValue(&criterionValues, it.id) :
+					criterion(beliefFunction, it.element);
+			if(value < min && value > 0){
+				extrema.nbFocals = 0;
+				min = value;
+			}
+			if(value == min){
+				if(extrema.nbFocals == realSize){
+					realSize = (realSize + 1) * 1.25;
+					newArray = realloc(extrema.focals, sizeof(BF_PackedFocalElement) * realSize);
+					DEBUG_CHECK_MALLOC_OR_RETURN(newArray, listFromPacked(extrema));
+					extrema.focals = newArray;
+				}
+				extrema.focals[extrema.nbFocals].element = it.id;
+				extrema.focals[extrema.nbFocals].beliefValue = value;
+				extrema.nbFocals++;
+			}
+		}
+	}
+	Sets_freePowerSetIterator(&it);
+	freeCriterionValues(&criterionValues);
+
+	return listFromPacked(extrema);
 }
 
 /** @} */
@@ -278,22 +723,21 @@ BF_FocalElement  BF_getMinMass(const BF_BeliefFunction m, const int card){
 
 
 BF_FocalElement  BF_getMaxBel(const BF_BeliefFunction m, const int card, const Sets_Set powerset){
+    Candidates candidates;
     BF_FocalElement  max = {{NULL,0}, 0};
     int i = 0, maxIndex = -1;
-    float value = 0;
+    BF_Mass value = 0;
 
 
-    for(i = 0; i < powerset.card; i++){
-        if((powerset.elements[i].card <= card ||
-           card == 0)                         &&
-           powerset.elements[i].card > 0 ){
-            value = BF_bel(m, powerset.elements[i]);
-            if(value > max.beliefValue){
-                maxIndex = i;
-                max.beliefValue = value;
-            }
+    startCandidates(&candidates, powerset, m, BF_bel, card, 1, 0, "BF_getMaxBel");
+    while((i = nextCandidate(&candidates)) != -1){
+        value = candidateValue(&candidates, i);
+        if(value > max.beliefValue){
+            maxIndex = i;
+            max.beliefValue = value;
         }
     }
+    endCandidates(&candidates);
     if(maxIndex != -1){
         max.element = Sets_copyElement(powerset.elements[maxIndex], m.elementSize);
     }
@@ -304,22 +748,21 @@ BF_FocalElement  BF_getMaxBel(const BF_BeliefFunction m, const int card, const S
 
 
 BF_FocalElement  BF_getMinBel(const BF_BeliefFunction m, const int card, const Sets_Set powerset){
+    Candidates candidates;
     BF_FocalElement  min = {{NULL,0}, 1};
     int i = 0, minIndex = -1;
-    float value = 0;
-
-    for(i = 0; i < powerset.card; i++){
-        if((powerset.elements[i].card <= card ||
-           card == 0)                         &&
-           powerset.elements[i].card > 0){
-            value = BF_bel(m, powerset.elements[i]);
-            if(value <= min.beliefValue &&
-               value != 0){
-                minIndex = i;
-                min.beliefValue = value;
-            }
+    BF_Mass value = 0;
+
+    startCandidates(&candidates, powerset, m, BF_bel, card, -1, 0, "BF_getMinBel");
+    while((i = nextCandidate(&candidates)) != -1){
+        value = candidateValue(&candidates, i);
+        if(value <= min.beliefValue &&
+           value != 0){
+            minIndex = i;
+            min.beliefValue = value;
         }
     }
+    endCandidates(&candidates);
     if(minIndex != -1){
         min.element = Sets_copyElement(powerset.elements[minIndex], m.elementSize);
     }
@@ -330,21 +773,20 @@ BF_FocalElement  BF_getMinBel(const BF_BeliefFunction m, const int card, const S
 
 
 BF_FocalElement  BF_getMaxPl(const BF_BeliefFunction m, const int card, const Sets_Set powerset){
+    Candidates candidates;
     BF_FocalElement  max = {{NULL,0}, 0};
     int i = 0, maxIndex = -1;
-    float value = 0;
-
-    for(i = 0; i < powerset.card; i++){
-        if((powerset.elements[i].card <= card ||
-           card == 0)                         &&
-           powerset.elements[i].card > 0){
-            value = BF_pl(m, powerset.elements[i]);
-            if(value > max.beliefValue){
-                maxIndex = i;
-                max.beliefValue = value;
-            }
+    BF_Mass value = 0;
+
+    startCandidates(&candidates, powerset, m, BF_pl, card, 1, 0, "BF_getMaxPl");
+    while((i = nextCandidate(&candidates)) != -1){
+        value = candidateValue(&candidates, i);
+        if(value > max.beliefValue){
+            maxIndex = i;
+            max.beliefValue = value;
         }
     }
+    endCandidates(&candidates);
     if(maxIndex != -1){
         max.element = Sets_copyElement(powerset.elements[maxIndex], m.elementSize);
     }
@@ -355,22 +797,21 @@ BF_FocalElement  BF_getMaxPl(const BF_BeliefFunction m, const int card, const Se
 
 
 BF_FocalElement  BF_getMinPl(const BF_BeliefFunction m, const int card, const Sets_Set powerset){
+    Candidates candidates;
     BF_FocalElement  min = {{NULL,0}, 1};
     int i = 0, minIndex = -1;
-    float value = 0;
-
-    for(i = 0; i < powerset.card; i++){
-        if((powerset.elements[i].card <= card ||
-           card == 0)                         &&
-           powerset.elements[i].card > 0){
-            value = BF_pl(m, powerset.elements[i]);
-            if(value <= min.beliefValue &&
-               value != 0){
-                minIndex = i;
-                min.beliefValue = value;
-            }
+    BF_Mass value = 0;
+
+    startCandidates(&candidates, powerset, m, BF_pl, card, -1, 0, "BF_getMinPl");
+    while((i = nextCandidate(&candidates)) != -1){
+        value = candidateValue(&candidates, i);
+        if(value <= min.beliefValue &&
+           value != 0){
+            minIndex = i;
+            min.beliefValue = value;
         }
     }
+    endCandidates(&candidates);
     if(minIndex != -1){
         min.element = Sets_copyElement(powerset.elements[minIndex], m.elementSize);
     }
@@ -381,21 +822,20 @@ BF_FocalElement  BF_getMinPl(const BF_BeliefFunction m, const int card, const Se
 
 
 BF_FocalElement  BF_getMaxBetP(const BF_BeliefFunction m, const int card, const Sets_Set powerset){
+    Candidates candidates;
     BF_FocalElement  max = {{NULL,0}, 0};
     int i = 0, maxIndex = -1;
-    float value = 0;
-
-    for(i = 0; i < powerset.card; i++){
-        if((powerset.elements[i].card <= card ||
-           card == 0)                         &&
-           powerset.elements[i].card > 0){
-            value = BF_betP(m, powerset.elements[i]);
-            if(value > max.beliefValue){
-                maxIndex = i;
-                max.beliefValue = value;
-            }
+    BF_Mass value = 0;
+
+    startCandidates(&candidates, powerset, m, BF_betP, card, 1, 0, "BF_getMaxBetP");
+    while((i = nextCandidate(&candidates)) != -1){
+        value = candidateValue(&candidates, i);
+        if(value > max.beliefValue){
+            maxIndex = i;
+            max.beliefValue = value;
         }
     }
+    endCandidates(&candidates);
     if(maxIndex != -1){
         max.element = Sets_copyElement(powerset.elements[maxIndex], m.elementSize);
     }
@@ -406,22 +846,21 @@ BF_FocalElement  BF_getMaxBetP(const BF_BeliefFunction m, const int card, const
 
 
 BF_FocalElement  BF_getMinBetP(const BF_BeliefFunction m, const int card, const Sets_Set powerset){
+    Candidates candidates;
     BF_FocalElement  min = {{NULL,0}, 1};
     int i = 0, minIndex = -1;
-    float value = 0;
-
-    for(i = 0; i < powerset.card; i++){
-        if((powerset.elements[i].card <= card ||
-           card == 0)                         &&
-           powerset.elements[i].card > 0){
-            value = BF_betP(m, powerset.elements[i]);
-            if(value <= min.beliefValue &&
-               value != 0){
-                minIndex = i;
-                min.beliefValue = value;
-            }
+    BF_Mass value = 0;
+
+    startCandidates(&candidates, powerset, m, BF_betP, card, -1, 0, "BF_getMinBetP");
+    while((i = nextCandidate(&candidates)) != -1){
+        value = candidateValue(&candidates, i);
+        if(value <= min.beliefValue &&
+           value != 0){
+            minIndex = i;
+            min.beliefValue = value;
         }
     }
+    endCandidates(&candidates);
     if(minIndex != -1){
         min.element = Sets_copyElement(powerset.elements[minIndex], m.elementSize);
     }
@@ -542,7 +981,7 @@ int BF_getNbMinBetP(const BF_BeliefFunction m, const int card, const Sets_Set po
 
 
 
-int BF_getQuickNbMaxMass(const BF_BeliefFunction m, const int card, float maxValue){
+int BF_getQuickNbMaxMass(const BF_BeliefFunction m, const int card, BF_Mass maxValue){
     int nbMax = 0;
     int i = 0;
 
@@ -560,7 +999,7 @@ int BF_getQuickNbMaxMass(const BF_BeliefFunction m, const int card, float maxVal
 
 
 
-int BF_getQuickNbMinMass(const BF_BeliefFunction m, const int card, float minValue){
+int BF_getQuickNbMinMass(const BF_BeliefFunction m, const int card, BF_Mass minValue){
     int nbMin = 0;
     int i = 0;
 
@@ -578,114 +1017,108 @@ int BF_getQuickNbMinMass(const BF_BeliefFunction m, const int card, float minVal
 
 
 
-int BF_getQuickNbMaxBel(const BF_BeliefFunction m, const int card, const Sets_Set powerset, float maxValue){
+int BF_getQuickNbMaxBel(const BF_BeliefFunction m, const int card, const Sets_Set powerset, BF_Mass maxValue){
+    Candidates candidates;
     int nbMax = 0;
     int i = 0;
 
-    for(i = 0; i < powerset.card; i++){
-        if((powerset.elements[i].card <= card ||
-           card == 0)                         &&
-           powerset.elements[i].card > 0){
-            if(BF_bel(m, powerset.elements[i]) == maxValue){
-                nbMax++;
-            }
+    startCandidates(&candidates, powerset, m, BF_bel, card, 0, maxValue, "BF_getQuickNbMaxBel");
+    while((i = nextCandidate(&candidates)) != -1){
+        if(candidateValue(&candidates, i) == maxValue){
+            nbMax++;
         }
     }
+    endCandidates(&candidates);
 
     return nbMax;
 }
 
 
 
-int BF_getQuickNbMinBel(const BF_BeliefFunction m, const int card, const Sets_Set powerset, float minValue){
+int BF_getQuickNbMinBel(const BF_BeliefFunction m, const int card, const Sets_Set powerset, BF_Mass minValue){
+    Candidates candidates;
     int nbMin = 0;
     int i = 0;
 
-    for(i = 0; i < powerset.card; i++){
-        if((powerset.elements[i].card <= card ||
-           card == 0)                         &&
-           powerset.elements[i].card > 0){
-            if(BF_bel(m, powerset.elements[i]) == minValue){
-                nbMin++;
-            }
+    startCandidates(&candidates, powerset, m, BF_bel, card, 0, minValue, "BF_getQuickNbMinBel");
+    while((i = nextCandidate(&candidates)) != -1){
+        if(candidateValue(&candidates, i) == minValue){
+            nbMin++;
         }
     }
+    endCandidates(&candidates);
 
     return nbMin;
 }
 
 
 
-int BF_getQuickNbMaxPl(const BF_BeliefFunction m, const int card, const Sets_Set powerset, float maxValue){
+int BF_getQuickNbMaxPl(const BF_BeliefFunction m, const int card, const Sets_Set powerset, BF_Mass maxValue){
+    Candidates candidates;
     int nbMax = 0;
     int i = 0;
 
-    for(i = 0; i < powerset.card; i++){
-        if((powerset.elements[i].card <= card ||
-           card == 0)                         &&
-           powerset.elements[i].card > 0){
-            if(BF_pl(m, powerset.elements[i]) == maxValue){
-                nbMax++;
-            }
+    startCandidates(&candidates, powerset, m, BF_pl, card, 0, maxValue, "BF_getQuickNbMaxPl");
+    while((i = nextCandidate(&candidates)) != -1){
+        if(candidateValue(&candidates, i) == maxValue){
+            nbMax++;
         }
     }
+    endCandidates(&candidates);
 
     return nbMax;
 }
 
 
 
-int BF_getQuickNbMinPl(const BF_BeliefFunction m, const int card, const Sets_Set powerset, float minValue){
+int BF_getQuickNbMinPl(const BF_BeliefFunction m, const int card, const Sets_Set powerset, BF_Mass minValue){
+    Candidates candidates;
     int nbMin = 0;
     int i = 0;
 
-    for(i = 0; i < powerset.card; i++){
-        if((powerset.elements[i].card <= card ||
-           card == 0)                         &&
-           powerset.elements[i].card > 0){
-            if(BF_pl(m, powerset.elements[i]) == minValue){
-                nbMin++;
-            }
+    startCandidates(&candidates, powerset, m, BF_pl, card, 0, minValue, "BF_getQuickNbMinPl");
+    while((i = nextCandidate(&candidates)) != -1){
+        if(candidateValue(&candidates, i) == minValue){
+            nbMin++;
         }
     }
+    endCandidates(&candidates);
 
     return nbMin;
 }
 
 
 
-int BF_getQuickNbMaxBetP(const BF_BeliefFunction m, const int card, const Sets_Set powerset, float maxValue){
+int BF_getQuickNbMaxBetP(const BF_BeliefFunction m, const int card, const Sets_Set powerset, BF_Mass maxValue){
+    Candidates candidates;
     int nbMax = 0;
     int i = 0;
 
-    for(i = 0; i < powerset.card; i++){
-        if((powerset.elements[i].card <= card ||
-           card == 0)                         &&
-           powerset.elements[i].card > 0){
-            if(BF_betP(m, powerset.elements[i]) == maxValue){
-                nbMax++;
-            }
+    startCandidates(&candidates, powerset, m, BF_betP, card, 0, maxValue, "BF_getQuickNbMaxBetP");
+    while((i = nextCandidate(&candidates)) != -1){
+        if(candidateValue(&candidates, i) == maxValue){
+            nbMax++;
         }
     }
+    endCandidates(&candidates);
 
     return nbMax;
 }
 
 
 
-int BF_getQuickNbMinBetP(const BF_BeliefFunction m, const int card, const Sets_Set powerset, float minValue){
+int BF_getQuickNbMinBetP(const BF_BeliefFunction m, const int card, const Sets_Set powerset, BF_Mass minValue){
+    Candidates candidates;
     int nbMin = 0;
     int i = 0;
 
-    for(i = 0; i < powerset.card; i++){
-        if((powerset.elements[i].card <= card ||
-           card == 0)                         &&
-           powerset.elements[i].card > 0){
-            if(BF_betP(m, powerset.elements[i]) == minValue){
-                nbMin++;
-            }
+    startCandidates(&candidates, powerset, m, BF_betP, card, 0, minValue, "BF_getQuickNbMinBetP");
+    while((i = nextCandidate(&candidates)) != -1){
+        if(candidateValue(&candidates, i) == minValue){
+            nbMin++;
         }
     }
+    endCandidates(&candidates);
 
     return nbMin;
 }
@@ -812,7 +1245,7 @@ BF_FocalElement * BF_getListMinBetP(const BF_BeliefFunction m, const int card, c
 
 
 
-BF_FocalElement * BF_getQuickListMaxMass(const BF_BeliefFunction m, const int card, const float maxValue){
+BF_FocalElement * BF_getQuickListMaxMass(const BF_BeliefFunction m, const int card, const BF_Mass maxValue){
     int nbMax = 0;
     BF_FocalElement * list = NULL;
 
@@ -825,7 +1258,7 @@ BF_FocalElement * BF_getQuickListMaxMass(const BF_BeliefFunction m, const int ca
 
 
 
-BF_FocalElement * BF_getQuickListMinMass(const BF_BeliefFunction m, const int card, const float minValue){
+BF_FocalElement * BF_getQuickListMinMass(const BF_BeliefFunction m, const int card, const BF_Mass minValue){
     int nbMin = 0;
     BF_FocalElement * list = NULL;
 
@@ -838,7 +1271,7 @@ BF_FocalElement * BF_getQuickListMinMass(const BF_BeliefFunction m, const int ca
 
 
 
-BF_FocalElement * BF_getQuickListMaxBel(const BF_BeliefFunction m, const int card, const Sets_Set powerset, const float maxValue){
+BF_FocalElement * BF_getQuickListMaxBel(const BF_BeliefFunction m, const int card, const Sets_Set powerset, const BF_Mass maxValue){
     int nbMax = 0;
     BF_FocalElement * list = NULL;
 
@@ -851,7 +1284,7 @@ BF_FocalElement * BF_getQuickListMaxBel(const BF_BeliefFunction m, const int car
 
 
 
-BF_FocalElement * BF_getQuickListMinBel(const BF_BeliefFunction m, const int card, const Sets_Set powerset, const float minValue){
+BF_FocalElement * BF_getQuickListMinBel(const BF_BeliefFunction m, const int card, const Sets_Set powerset, const BF_Mass minValue){
     int nbMin = 0;
     BF_FocalElement * list = NULL;
 
@@ -864,7 +1297,7 @@ BF_FocalElement * BF_getQuickListMinBel(const BF_BeliefFunction m, const int car
 
 
 
-BF_FocalElement * BF_getQuickListMaxPl(const BF_BeliefFunction m, const int card, const Sets_Set powerset, const float maxValue){
+BF_FocalElement * BF_getQuickListMaxPl(const BF_BeliefFunction m, const int card, const Sets_Set powerset, const BF_Mass maxValue){
     int nbMax = 0;
     BF_FocalElement * list = NULL;
 
@@ -877,7 +1310,7 @@ BF_FocalElement * BF_getQuickListMaxPl(const BF_BeliefFunction m, const int card
 
 
 
-BF_FocalElement * BF_getQuickListMinPl(const BF_BeliefFunction m, const int card, const Sets_Set powerset, const float minValue){
+BF_FocalElement * BF_getQuickListMinPl(const BF_BeliefFunction m, const int card, const Sets_Set powerset, const BF_Mass minValue){
     int nbMin = 0;
     BF_FocalElement * list = NULL;
 
@@ -890,7 +1323,7 @@ BF_FocalElement * BF_getQuickListMinPl(const BF_BeliefFunction m, const int card
 
 
 
-BF_FocalElement * BF_getQuickListMaxBetP(const BF_BeliefFunction m, const int card, const Sets_Set powerset, const float maxValue){
+BF_FocalElement * BF_getQuickListMaxBetP(const BF_BeliefFunction m, const int card, const Sets_Set powerset, const BF_Mass maxValue){
     int nbMax = 0;
     BF_FocalElement * list = NULL;
 
@@ -903,7 +1336,7 @@ BF_FocalElement * BF_getQuickListMaxBetP(const BF_BeliefFunction m, const int ca
 
 
 
-BF_FocalElement * BF_getQuickListMinBetP(const BF_BeliefFunction m, const int card, const Sets_Set powerset, const float minValue){
+BF_FocalElement * BF_getQuickListMinBetP(const BF_BeliefFunction m, const int card, const Sets_Set powerset, const BF_Mass minValue){
     int nbMin = 0;
     BF_FocalElement * list = NULL;
 
@@ -916,7 +1349,7 @@ BF_FocalElement * BF_getQuickListMinBetP(const BF_BeliefFunction m, const int ca
 
 
 
-BF_FocalElement * BF_getQuickerListMaxMass(const BF_BeliefFunction m, const int card, const float maxValue, const int nbMax){
+BF_FocalElement * BF_getQuickerListMaxMass(const BF_BeliefFunction m, const int card, const BF_Mass maxValue, const int nbMax){
     BF_FocalElement  *list = NULL;
     int i = 0;
     int index = 0;
@@ -940,7 +1373,7 @@ BF_FocalElement * BF_getQuickerListMaxMass(const BF_BeliefFunction m, const int
 
 
 
-BF_FocalElement * BF_getQuickerListMinMass(const BF_BeliefFunction m, const int card, const float minValue, const int nbMin){
+BF_FocalElement * BF_getQuickerListMinMass(const BF_BeliefFunction m, const int card, const BF_Mass minValue, const int nbMin){
     BF_FocalElement  *list = NULL;
     int i = 0;
     int index = 0;
@@ -964,7 +1397,8 @@ BF_FocalElement * BF_getQuickerListMinMass(const BF_BeliefFunction m, const int
 
 
 
-BF_FocalElement * BF_getQuickerListMaxBel(const BF_BeliefFunction m, const int card, const Sets_Set powerset, const float maxValue, const int nbMax){
+BF_FocalElement * BF_getQuickerListMaxBel(const BF_BeliefFunction m, const int card, const Sets_Set powerset, const BF_Mass maxValue, const int nbMax){
+    Candidates candidates;
     BF_FocalElement  *list = NULL;
     int i = 0;
     int index = 0;
@@ -972,24 +1406,23 @@ BF_FocalElement * BF_getQuickerListMaxBel(const BF_BeliefFunction m, const int c
     list = malloc(sizeof(BF_FocalElement ) * nbMax);
     DEBUG_CHECK_MALLOC(list);
 
-    for(i = 0; i < powerset.card; i++){
-        if((powerset.elements[i].card <= card ||
-           card == 0)                         &&
-            powerset.elements[i].card > 0){
-            if(BF_bel(m, powerset.elements[i]) == maxValue){
-                list[index].element = Sets_copyElement(powerset.elements[i], m.elementSize);
-                list[index].beliefValue = maxValue;
-                index++;
-            }
+    startCandidates(&candidates, powerset, m, BF_bel, card, 0, maxValue, "BF_getQuickerListMaxBel");
+    while((i = nextCandidate(&candidates)) != -1){
+        if(candidateValue(&candidates, i) == maxValue){
+            list[index].element = Sets_copyElement(powerset.elements[i], m.elementSize);
+            list[index].beliefValue = maxValue;
+            index++;
         }
     }
+    endCandidates(&candidates);
 
     return list;
 }
 
 
 
-BF_FocalElement * BF_getQuickerListMinBel(const BF_BeliefFunction m, const int card, const Sets_Set powerset, const float minValue, const int nbMin){
+BF_FocalElement * BF_getQuickerListMinBel(const BF_BeliefFunction m, const int card, const Sets_Set powerset, const BF_Mass minValue, const int nbMin){
+    Candidates candidates;
     BF_FocalElement  *list = NULL;
     int i = 0;
     int index = 0;
@@ -997,24 +1430,23 @@ BF_FocalElement * BF_getQuickerListMinBel(const BF_BeliefFunction m, const int c
     list = malloc(sizeof(BF_FocalElement ) * nbMin);
     DEBUG_CHECK_MALLOC(list);
 
-    for(i = 0; i < powerset.card; i++){
-        if((powerset.elements[i].card <= card ||
-           card == 0)                         &&
-            powerset.elements[i].card > 0){
-            if(BF_bel(m, powerset.elements[i]) == minValue){
-                list[index].element = Sets_copyElement(powerset.elements[i], m.elementSize);
-                list[index].beliefValue = minValue;
-                index++;
-            }
+    startCandidates(&candidates, powerset, m, BF_bel, card, 0, minValue, "BF_getQuickerListMinBel");
+    while((i = nextCandidate(&candidates)) != -1){
+        if(candidateValue(&candidates, i) == minValue){
+            list[index].element = Sets_copyElement(powerset.elements[i], m.elementSize);
+            list[index].beliefValue = minValue;
+            index++;
         }
     }
+    endCandidates(&candidates);
 
     return list;
 }
 
 
 
-BF_FocalElement * BF_getQuickerListMaxPl(const BF_BeliefFunction m, const int card, const Sets_Set powerset, const float maxValue, const int nbMax){
+BF_FocalElement * BF_getQuickerListMaxPl(const BF_BeliefFunction m, const int card, const Sets_Set powerset, const BF_Mass maxValue, const int nbMax){
+    Candidates candidates;
     BF_FocalElement  *list = NULL;
     int i = 0;
     int index = 0;
@@ -1022,24 +1454,23 @@ BF_FocalElement * BF_getQuickerListMaxPl(const BF_BeliefFunction m, const int ca
     list = malloc(sizeof(BF_FocalElement ) * nbMax);
     DEBUG_CHECK_MALLOC(list);
 
-    for(i = 0; i < powerset.card; i++){
-        if((powerset.elements[i].card <= card ||
-           card == 0)                         &&
-            powerset.elements[i].card > 0){
-            if(BF_pl(m, powerset.elements[i]) == maxValue){
-                list[index].element = Sets_copyElement(powerset.elements[i], m.elementSize);
-                list[index].beliefValue = maxValue;
-                index++;
-            }
+    startCandidates(&candidates, powerset, m, BF_pl, card, 0, maxValue, "BF_getQuickerListMaxPl");
+    while((i = nextCandidate(&candidates)) != -1){
+        if(candidateValue(&candidates, i) == maxValue){
+            list[index].element = Sets_copyElement(powerset.elements[i], m.elementSize);
+            list[index].beliefValue = maxValue;
+            index++;
         }
     }
+    endCandidates(&candidates);
 
     return list;
 }
 
 
 
-BF_FocalElement * BF_getQuickerListMinPl(const BF_BeliefFunction m, const int card, const Sets_Set powerset, const float minValue, const int nbMin){
+BF_FocalElement * BF_getQuickerListMinPl(const BF_BeliefFunction m, const int card, const Sets_Set powerset, const BF_Mass minValue, const int nbMin){
+    Candidates candidates;
     BF_FocalElement  *list = NULL;
     int i = 0;
     int index = 0;
@@ -1047,24 +1478,23 @@ BF_FocalElement * BF_getQuickerListMinPl(const BF_BeliefFunction m, const int ca
     list = malloc(sizeof(BF_FocalElement ) * nbMin);
     DEBUG_CHECK_MALLOC(list);
 
-    for(i = 0; i < powerset.card; i++){
-        if((powerset.elements[i].card <= card ||
-           card == 0)                         &&
-            powerset.elements[i].card > 0){
-            if(BF_pl(m, powerset.elements[i]) == minValue){
-                list[index].element = Sets_copyElement(powerset.elements[i], m.elementSize);
-                list[index].beliefValue = minValue;
-                index++;
-            }
+    startCandidates(&candidates, powerset, m, BF_pl, card, 0, minValue, "BF_getQuickerListMinPl");
+    while((i = nextCandidate(&candidates)) != -1){
+        if(candidateValue(&candidates, i) == minValue){
+            list[index].element = Sets_copyElement(powerset.elements[i], m.elementSize);
+            list[index].beliefValue = minValue;
+            index++;
         }
     }
+    endCandidates(&candidates);
 
     return list;
 }
 
 
 
-BF_FocalElement * BF_getQuickerListMaxBetP(const BF_BeliefFunction m, const int card, const Sets_Set powerset, const float maxValue, const int nbMax){
+BF_FocalElement * BF_getQuickerListMaxBetP(const BF_BeliefFunction m, const int card, const Sets_Set powerset, const BF_Mass maxValue, const int nbMax){
+    Candidates candidates;
     BF_FocalElement  *list = NULL;
     int i = 0;
     int index = 0;
@@ -1072,24 +1502,23 @@ BF_FocalElement * BF_getQuickerListMaxBetP(const BF_BeliefFunction m, const int
     list = malloc(sizeof(BF_FocalElement) * nbMax);
     DEBUG_CHECK_MALLOC(list);
 
-    for(i = 0; i < powerset.card; i++){
-        if((powerset.elements[i].card <= card ||
-           card == 0)                         &&
-            powerset.elements[i].card > 0){
-            if(BF_betP(m, powerset.elements[i]) == maxValue){
-                list[index].element = Sets_copyElement(powerset.elements[i], m.elementSize);
-                list[index].beliefValue = maxValue;
-                index++;
-            }
+    startCandidates(&candidates, powerset, m, BF_betP, card, 0, maxValue, "BF_getQuickerListMaxBetP");
+    while((i = nextCandidate(&candidates)) != -1){
+        if(candidateValue(&candidates, i) == maxValue){
+            list[index].element = Sets_copyElement(powerset.elements[i], m.elementSize);
+            list[index].beliefValue = maxValue;
+            index++;
         }
     }
+    endCandidates(&candidates);
 
     return list;
 }
 
 
 
-BF_FocalElement * BF_getQuickerListMinBetP(const BF_BeliefFunction m, const int card, const Sets_Set powerset, const float minValue, const int nbMin){
+BF_FocalElement * BF_getQuickerListMinBetP(const BF_BeliefFunction m, const int card, const Sets_Set powerset, const BF_Mass minValue, const int nbMin){
+    Candidates candidates;
     BF_FocalElement  *list = NULL;
     int i = 0;
     int index = 0;
@@ -1097,17 +1526,15 @@ BF_FocalElement * BF_getQuickerListMinBetP(const BF_BeliefFunction m, const int
     list = malloc(sizeof(BF_FocalElement) * nbMin);
     DEBUG_CHECK_MALLOC(list);
 
-    for(i = 0; i < powerset.card; i++){
-        if((powerset.elements[i].card <= card ||
-           card == 0)                         &&
-            powerset.elements[i].card > 0){
-            if(BF_betP(m, powerset.elements[i]) == minValue){
-                list[index].element = Sets_copyElement(powerset.elements[i], m.elementSize);
-                list[index].beliefValue = minValue;
-                index++;
-            }
+    startCandidates(&candidates, powerset, m, BF_betP, card, 0, minValue, "BF_getQuickerListMinBetP");
+    while((i = nextCandidate(&candidates)) != -1){
+        if(candidateValue(&candidates, i) == minValue){
+            list[index].element = Sets_copyElement(powerset.elements[i], m.elementSize);
+            list[index].beliefValue = minValue;
+            index++;
         }
     }
+    endCandidates(&candidates);
 
     return list;
 }
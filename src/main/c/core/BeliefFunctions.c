@@ -17,6 +17,14 @@
 
 #include "BeliefFunctions.h"
 
+#if defined(__GNUC__) && defined(__x86_64__)
+#define BF_X86_KERNELS
+#include <immintrin.h>
+#endif
+
+#include "LatticeTransforms.h"
+#include "ArenaAllocation.h"
+
 /**
  * This module does not enable the building of belief functions but only to manipulate them!
  * Thus, this module offers many functions to characterize, combine and discount belief functions.
@@ -29,435 +37,2264 @@
  */
 
 
-/**
- * @name Utility functions
- * @{
- */
+/*
+  +-------------------+
+  | PRIVATE FUNCTIONS |
+  +-------------------+
+*/
 
-BF_BeliefFunction BF_copyBeliefFunction(const BF_BeliefFunction m){
-    BF_BeliefFunction copy;
-    int i = 0;
+/*
+ * Open addressing hash table of the positions of the focal elements of a belief function.
+ * The focals are hashed in their multi-word form.
+ */
+struct BF_FocalIndex {
+    int* slots; /* position + 1 of the focals, 0 for an empty slot */
+    unsigned int mask;
+    uint64_t* words; /* the words of the indexed focals (nbWords words per focal) */
+    int nbWords;
+    int nbIndexed; /* the index is not used if it differs from the number of focals */
+    int capacity; /* the number of focals that fit in words */
+};
 
-    /*Memory alocation:*/
-    copy.nbFocals = m.nbFocals;
-    copy.focals = malloc(sizeof(BF_FocalElement ) * copy.nbFocals);
-    DEBUG_CHECK_MALLOC(copy.focals);
+/*
+ * Gives the slot of the first indexed focal equal to the given words,
+ * or the empty slot where such a focal would be inserted.
+ */
+static unsigned int findFocalSlot(const BF_FocalIndex* index, const uint64_t* words){
+    unsigned int slot = (unsigned int)Sets_wordsHash(words, index->nbWords) & index->mask;
 
-    copy.elementSize = m.elementSize;
-    /*Copy: */
-    for(i = 0; i < copy.nbFocals; i++){
-        copy.focals[i].element = Sets_copyElement(m.focals[i].element, m.elementSize);
-        copy.focals[i].beliefValue = m.focals[i].beliefValue;
+    while(index->slots[slot] != 0 &&
+          !Sets_wordsEquals(index->words + (size_t)(index->slots[slot] - 1) * index->nbWords, words, index->nbWords)){
+        slot = (slot + 1) & index->mask;
     }
 
-    return copy;
+    return slot;
 }
 
+/*
+ * Rebuilds the table of slots with the given number of slots (a power of 2).
+ * Returns 0 if the allocation failed.
+ */
+static int resizeFocalIndex(BF_FocalIndex* index, const unsigned int nbSlots){
+    unsigned int slot = 0;
+    int i = 0;
 
+    free(index->slots);
+    index->mask = nbSlots - 1;
+    index->slots = calloc(nbSlots, sizeof(int));
+    DEBUG_CHECK_MALLOC_OR_RETURN(index->slots, 0);
 
-BF_BeliefFunction BF_getVacuousBeliefFunction(const int elementSize){
-	BF_BeliefFunction vacuous = {NULL, 0, 0};
-	
-	vacuous.nbFocals = 1;
-	vacuous.focals = malloc(sizeof(BF_FocalElement ));
-	DEBUG_CHECK_MALLOC(vacuous.focals);
+    /*The first occurrence of a focal is kept: */
+    for(i = 0; i < index->nbIndexed; i++){
+        slot = findFocalSlot(index, index->words + (size_t)i * index->nbWords);
+        if(index->slots[slot] == 0){
+            index->slots[slot] = i + 1;
+        }
+    }
 
-    vacuous.elementSize = elementSize;
-	
-	vacuous.focals[0].element = Sets_getCompleteElement(elementSize);
-	vacuous.focals[0].beliefValue = 1;
-	
-	return vacuous;
+    return 1;
 }
 
+/*
+ * Indexes the element e as the focal following the ones already indexed.
+ * Returns 0 if an allocation failed.
+ */
+static int indexFocal(BF_FocalIndex* index, const Sets_Element e, const int elementSize){
+    uint64_t* words = NULL;
+    unsigned int slot = 0;
+
+    if(index->nbIndexed == index->capacity){
+        index->capacity = index->capacity > 0 ? 2 * index->capacity : 8;
+        words = realloc(index->words, sizeof(uint64_t) * index->nbWords * index->capacity);
+        DEBUG_CHECK_MALLOC_OR_RETURN(words, 0);
+        index->words = words;
+    }
+    /*At most one half of the slots are used: */
+    if(2 * (unsigned int)(index->nbIndexed + 1) > index->mask + 1 && !resizeFocalIndex(index, 2 * (index->mask + 1))){
+        return 0;
+    }
 
+    words = index->words + (size_t)index->nbIndexed * index->nbWords;
+    Sets_packWords(words, e, elementSize);
+    slot = findFocalSlot(index, words);
+    index->nbIndexed++;
+    if(index->slots[slot] == 0){
+        index->slots[slot] = index->nbIndexed;
+    }
 
-void BF_cleanBeliefFunction(BF_BeliefFunction* bf){
-	int i = 0, index = 0;
-	int nbZeros = 0;
-	BF_FocalElement* focals;
-	
-	/*Count the number of zeros:*/
-	for(i = 0; i < bf->nbFocals; i++){
-		if(bf->focals[i].beliefValue < BF_PRECISION){
-			nbZeros++;
+    return 1;
+}
+
+/*
+ * Copies the focal elements of m (adding the void element if required)
+ * with null masses to prepare the conditioning of m.
+ */
+static BF_BeliefFunction conditionedFocals(const BF_BeliefFunction m) {
+	BF_BeliefFunction conditioned = {NULL, 0, 0};
+	int i = 0, containVoid = 0;
+
+	/*Check if the belief function contain the void element:*/
+	for(i = 0; i<m.nbFocals; i++){
+		if(m.focals[i].element.card == 0){
+			containVoid = 1;
 		}
 	}
-	
-	/*Create a new list of point:*/
-	focals = malloc(sizeof(BF_FocalElement) * (bf->nbFocals - nbZeros));
-	DEBUG_CHECK_MALLOC(focals);
-	/*Recopy:*/
-	for(i = 0; i < bf->nbFocals; i++){
-		if(bf->focals[i].beliefValue >= BF_PRECISION){
-			focals[index] = bf->focals[i];
-			index++;
-		}
-		else{
-			BF_freeBeliefPoint(&(bf->focals[i]));
-		}
+
+	/*Memory allocation:*/
+	conditioned.elementSize = m.elementSize;
+	conditioned.nbFocals = containVoid ? m.nbFocals : m.nbFocals + 1;
+	conditioned.focals = malloc(sizeof(BF_FocalElement) * conditioned.nbFocals);
+	DEBUG_CHECK_MALLOC_OR_RETURN(conditioned.focals, conditioned);
+
+	/*Add the void element first if missing:*/
+	if(!containVoid){
+		conditioned.focals[0].element = Sets_getEmptyElement(m.elementSize);
+		conditioned.focals[0].beliefValue = 0;
 	}
-	/*Free:*/
-	free(bf->focals);
-	/*Replace:*/
-	bf->focals = focals;
-	bf->nbFocals -= nbZeros;
-	
-	BF_normalize(bf);
+	for(i = 0; i<m.nbFocals; i++){
+		conditioned.focals[i + !containVoid].element = Sets_copyElement(m.focals[i].element, m.elementSize);
+		conditioned.focals[i + !containVoid].beliefValue = 0;
+	}
+
+	return conditioned;
 }
 
+static int comparePackedFocals(const void* f1, const void* f2) {
+	Sets_PackedElement e1 = ((const BF_PackedFocalElement*)f1)->element;
+	Sets_PackedElement e2 = ((const BF_PackedFocalElement*)f2)->element;
+	return (e1 > e2) - (e1 < e2);
+}
 
+/*
+ * Transforms on the lattice of subsets (see LatticeTransforms.h). The values are accumulated
+ * in double precision and given back as a dense belief function.
+ */
+static double* toDoubles(const BF_DenseBeliefFunction m) {
+	int nbSubsets = 1 << m.elementSize;
+	double* values = malloc(sizeof(double) * nbSubsets);
+	int i = 0;
+	DEBUG_CHECK_MALLOC_OR_RETURN(values, NULL);
+	for(i = 0; i < nbSubsets; i++){
+		values[i] = m.values[i];
+	}
+	return values;
+}
 
-void BF_normalize(BF_BeliefFunction* bf){
-	float sum = 0;
+static BF_DenseBeliefFunction fromDoubles(double* values, const int elementSize) {
+	BF_DenseBeliefFunction m = {NULL, 0};
+	int nbSubsets = 1 << elementSize;
 	int i = 0;
-	
-	for(i = 0; i<bf->nbFocals; i++){
-        sum += bf->focals[i].beliefValue;
-    }
+	m.elementSize = elementSize;
+	if(values == NULL){
+		return m;
+	}
+	m.values = malloc(sizeof(BF_Mass) * nbSubsets);
+	DEBUG_CHECK_MALLOC_OR_RETURN(m.values, m);
+	for(i = 0; i < nbSubsets; i++){
+		m.values[i] = values[i];
+	}
+	free(values);
+	return m;
+}
 
-    if(sum != 1){
-        for(i = 0; i < bf->nbFocals; i++){
-        	bf->focals[i].beliefValue /= sum;
-        }
-    }
+
+
+/*
+ * Size of the single block of a compact belief function (the words, then the masses).
+ */
+static size_t compactBlockSize(const int nbFocals, const int elementSize){
+    return (sizeof(uint64_t) * SETS_WIDE_NB_WORDS(elementSize) + sizeof(BF_Mass)) * nbFocals;
 }
 
+/*
+ * Packs e into words: stackWords if it is large enough, a new array otherwise
+ * (to free if different from stackWords, NULL if the allocation failed).
+ */
+static uint64_t* wordsOf(const Sets_Element e, const int elementSize, uint64_t* stackWords){
+    uint64_t* words = stackWords;
 
+    if(SETS_WIDE_NB_WORDS(elementSize) > SETS_WIDE_STACK_WORDS){
+        words = malloc(sizeof(uint64_t) * SETS_WIDE_NB_WORDS(elementSize));
+        DEBUG_CHECK_MALLOC_OR_RETURN(words, NULL);
+    }
+    Sets_packWords(words, e, elementSize);
 
-/** @} */
+    return words;
+}
 
 
 
+/* !!! Approximations !!! */
 
+/*
+ * A belief function being approximated: its focal elements as words and their cardinalities,
+ * their masses and the part of those masses that is still on the element it had in the
+ * original function. The merged or removed focals are not alive anymore.
+ */
+typedef struct {
+    uint64_t* words;
+    int* cards;
+    double* masses;
+    double* unmoved;
+    char* alive;
+    int nbFocals;
+    int nbWords;
+} Approximation;
 
+/*
+ * A focal element ranked by its mass (ties are broken by its position).
+ */
+typedef struct {
+    double mass;
+    int position;
+} RankedFocal;
+
+static int compareRankedFocals(const void* f1, const void* f2) {
+    const RankedFocal* r1 = f1;
+    const RankedFocal* r2 = f2;
+    if(r1->mass != r2->mass){
+        return (r1->mass < r2->mass) - (r1->mass > r2->mass);
+    }
+    return (r1->position > r2->position) - (r1->position < r2->position);
+}
 
+static void freeApproximation(Approximation* a){
+    free(a->words);
+    free(a->cards);
+    free(a->masses);
+    free(a->unmoved);
+    free(a->alive);
+}
 
-/**
- * @name Operations on belief functions
- * @{
+/*
+ * Gets the focal elements of m with a positive mass. Returns 0 if an allocation failed.
  */
+static int toApproximation(const BF_BeliefFunction m, Approximation* a){
+    int i = 0, size = (m.nbFocals > 0 ? m.nbFocals : 1);
+
+    a->nbWords = SETS_WIDE_NB_WORDS(m.elementSize);
+    a->nbFocals = 0;
+    a->words = malloc(sizeof(uint64_t) * a->nbWords * size);
+    a->cards = malloc(sizeof(int) * size);
+    a->masses = malloc(sizeof(double) * size);
+    a->unmoved = malloc(sizeof(double) * size);
+    a->alive = malloc(sizeof(char) * size);
+    if(a->words == NULL || a->cards == NULL || a->masses == NULL || a->unmoved == NULL || a->alive == NULL){
+        #ifdef DEBUG
+        printf("debug: malloc failed in toApproximation()!\n");
+        #endif
+        freeApproximation(a);
+        return 0;
+    }
 
-BF_BeliefFunction BF_conditioning(const BF_BeliefFunction m, const Sets_Element e, const Sets_Set powerset){
-    BF_BeliefFunction conditioned = {NULL, 0, 0};
-    Sets_Element disj = {NULL, 0};
-    Sets_Element opposite = {NULL, 0};
-    Sets_Element emptySet;
-    int i = 0, j = 0, containVoid = 0;
+    for(i = 0; i < m.nbFocals; i++){
+        if(m.focals[i].beliefValue > 0){
+            Sets_packWords(a->words + (size_t)a->nbFocals * a->nbWords, m.focals[i].element, m.elementSize);
+            a->cards[a->nbFocals] = m.focals[i].element.card;
+            a->masses[a->nbFocals] = m.focals[i].beliefValue;
+            a->unmoved[a->nbFocals] = m.focals[i].beliefValue;
+            a->alive[a->nbFocals] = 1;
+            a->nbFocals++;
+        }
+    }
+    return 1;
+}
 
-    /*Get the opposite:*/
-    opposite = Sets_getOpposite(e, m.elementSize);
+/*
+ * Builds the belief function made of the focals still alive (in their order).
+ */
+static BF_BeliefFunction fromApproximation(const Approximation* a, const int elementSize){
+    BF_BeliefFunction approximated = {NULL, 0, 0};
+    Sets_WideElement focal = {NULL, 0};
+    int i = 0;
 
-    /*Check if the belief function contain the void element:*/
-    emptySet = Sets_getEmptyElement(m.elementSize);
-    for(i = 0; i<m.nbFocals; i++){
-        if(m.focals[i].element.card == 0){
-            containVoid = 1;
+    approximated.elementSize = elementSize;
+    approximated.focals = malloc(sizeof(BF_FocalElement) * (a->nbFocals > 0 ? a->nbFocals : 1));
+    DEBUG_CHECK_MALLOC_OR_RETURN(approximated.focals, approximated);
+
+    for(i = 0; i < a->nbFocals; i++){
+        if(a->alive[i]){
+            focal.words = a->words + (size_t)i * a->nbWords;
+            focal.card = a->cards[i];
+            approximated.focals[approximated.nbFocals].element = Sets_elementFromWide(focal, elementSize);
+            approximated.focals[approximated.nbFocals].beliefValue = a->masses[i];
+            approximated.nbFocals++;
         }
     }
+    return approximated;
+}
 
-    /*Memory allocation:*/
-    if(containVoid){
-        conditioned.nbFocals = m.nbFocals;
-        conditioned.focals = malloc(sizeof(BF_FocalElement )*m.nbFocals);
-        DEBUG_CHECK_MALLOC(conditioned.focals);
+/*
+ * Ranks the focals by decreasing mass. Returns NULL if the allocation failed.
+ */
+static RankedFocal* rankFocals(const Approximation* a){
+    RankedFocal* ranked = malloc(sizeof(RankedFocal) * (a->nbFocals > 0 ? a->nbFocals : 1));
+    int i = 0;
+    DEBUG_CHECK_MALLOC_OR_RETURN(ranked, NULL);
 
-		conditioned.elementSize = m.elementSize;
+    for(i = 0; i < a->nbFocals; i++){
+        ranked[i].mass = a->masses[i];
+        ranked[i].position = i;
     }
-    else {
-        conditioned.nbFocals = m.nbFocals + 1;
-        conditioned.focals = malloc(sizeof(BF_FocalElement )*(m.nbFocals+1));
-        DEBUG_CHECK_MALLOC(conditioned.focals);
+    qsort(ranked, a->nbFocals, sizeof(RankedFocal), compareRankedFocals);
+    return ranked;
+}
 
-		conditioned.elementSize = m.elementSize;
+/*
+ * Keeps the nbKept largest masses and gives the other ones to the union of their elements
+ * (merged with a kept focal if equal to it).
+ */
+static void summarize(Approximation* a, const int nbKept){
+    RankedFocal* ranked = rankFocals(a);
+    uint64_t* merged = calloc(a->nbWords, sizeof(uint64_t));
+    double mass = 0, unmoved = 0;
+    int i = 0, k = 0, card = 0, target = 0;
+
+    if(ranked == NULL || merged == NULL){
+        #ifdef DEBUG
+        printf("debug: malloc failed in summarize()!\n");
+        #endif
+        free(ranked);
+        free(merged);
+        return;
     }
-    /*Check for the new focal elements:*/
-    for(i = 0; i<conditioned.nbFocals; i++){
-        /*Initialize the value:*/
-        if(containVoid){
-            conditioned.focals[i].beliefValue = 0;
-            conditioned.focals[i].element = Sets_copyElement(m.focals[i].element, m.elementSize);
-        }
-        else {
-            if(i==0){ /*Add the void element:*/
-                conditioned.focals[0].beliefValue = 0;
-                conditioned.focals[0].element = Sets_copyElement(emptySet, m.elementSize);
-            }
-            else { /*Consider the element normaly...*/
-                conditioned.focals[i].beliefValue = 0;
-                conditioned.focals[i].element = Sets_copyElement(m.focals[i-1].element, m.elementSize);
-            }
-        }
-        /*New belief computation:*/
-        if(Sets_isSubset(conditioned.focals[i].element, e, m.elementSize)){
-            for(j = 0; j<powerset.card; j++){
-                if(Sets_isSubset(powerset.elements[j], opposite, m.elementSize)){
-                    disj = Sets_disjunction(conditioned.focals[i].element, powerset.elements[j], m.elementSize);
-                    conditioned.focals[i].beliefValue += BF_m(m, disj);
-                    Sets_freeElement(&disj);
-                }
-            }
-        }
+    for(k = nbKept; k < a->nbFocals; k++){
+        Sets_wordsDisjunction(merged, merged, a->words + (size_t)ranked[k].position * a->nbWords, a->nbWords);
     }
-    /*Set to 0 everything that is not in e:*/
-    for(i = 0; i<conditioned.nbFocals; i++){
-        if(!Sets_isSubset(conditioned.focals[i].element, e, m.elementSize)){
-            conditioned.focals[i].beliefValue = 0;
+    card = Sets_wordsCard(merged, a->nbWords);
+    for(k = nbKept; k < a->nbFocals; k++){
+        i = ranked[k].position;
+        /*The mass of a removed focal equal to the union does not move:*/
+        if(a->cards[i] == card && Sets_wordsEquals(a->words + (size_t)i * a->nbWords, merged, a->nbWords)){
+            unmoved += a->unmoved[i];
         }
+        mass += a->masses[i];
+        a->alive[i] = 0;
     }
 
-    /*Deallocate:*/
-    Sets_freeElement(&opposite);
-    Sets_freeElement(&emptySet);
-	
-	#ifdef CHECK_SUM
-    if(BF_checkSum(conditioned)){
-        printf("debug: in BF_conditioning(), the sum is not equal to 1.\ndebug: There may be a problem in the model.\n");
+    /*The union is added to a kept focal equal to it or replaces the first removed focal:*/
+    target = ranked[nbKept].position;
+    for(k = 0; k < nbKept; k++){
+        i = ranked[k].position;
+        if(a->cards[i] == card && Sets_wordsEquals(a->words + (size_t)i * a->nbWords, merged, a->nbWords)){
+            target = i;
+            break;
+        }
     }
-    #endif
-    #ifdef CHECK_VALUES 
-    if(BF_checkValues(conditioned)){
-    	printf("debug: in BF_conditioning(), at least one value is not valid!\n");
+    if(!a->alive[target]){
+        memcpy(a->words + (size_t)target * a->nbWords, merged, sizeof(uint64_t) * a->nbWords);
+        a->cards[target] = card;
+        a->masses[target] = 0;
+        a->unmoved[target] = 0;
+        a->alive[target] = 1;
     }
-    #endif
-
-    return conditioned;
+    a->masses[target] += mass;
+    a->unmoved[target] += unmoved;
+    free(ranked);
+    free(merged);
 }
 
+/*
+ * Keeps at least k and at most l of the largest masses, the removed mass not exceeding x
+ * (beyond the focals in excess of l). The kept masses are normalized to the total mass.
+ */
+static void keepLargest(Approximation* a, const int k, const int l, const double x){
+    RankedFocal* ranked = rankFocals(a);
+    double total = 0, removed = 0;
+    int i = 0, nbKept = a->nbFocals;
 
+    if(ranked == NULL){
+        return;
+    }
+    for(i = 0; i < a->nbFocals; i++){
+        total += a->masses[i];
+    }
+    if(nbKept > l){
+        nbKept = l;
+    }
+    while(nbKept > k && removed + ranked[nbKept - 1].mass <= x){
+        removed += ranked[nbKept - 1].mass;
+        nbKept--;
+    }
+    removed = 0;
+    for(i = nbKept; i < a->nbFocals; i++){
+        removed += ranked[i].mass;
+        a->alive[ranked[i].position] = 0;
+        a->unmoved[ranked[i].position] = 0;
+    }
+    if(removed > 0 && total > removed){
+        for(i = 0; i < nbKept; i++){
+            a->masses[ranked[i].position] *= total / (total - removed);
+        }
+    }
+    free(ranked);
+}
 
-BF_BeliefFunction BF_weakening(const BF_BeliefFunction m, const float alpha){
-    BF_BeliefFunction weakened = {NULL, 0, 0};
-    int containVoid = 0, voidIndex = 0;
-    int i = 0;
-    float sum = 0, realAlpha = 0;
-    Sets_Element emptySet;
-    
-    if(alpha >= 1){
-    	realAlpha = 1;
+/*
+ * The cost of merging two focals into their intersection (inner) or union (outer):
+ * the change of the cardinalities weighted by the masses (Denoeux 2001).
+ */
+static double mergingCost(const Approximation* a, const int i, const int j, const int inner){
+    double mi = a->masses[i], mj = a->masses[j];
+    int common = 0;
+
+    /*Small frames fit in one word:*/
+    if(a->nbWords == 1){
+        common = Sets_packedCard(a->words[i] & a->words[j]);
     }
     else {
-    	realAlpha = alpha;
+        common = Sets_wordsConjunctionCard(a->words + (size_t)i * a->nbWords, a->words + (size_t)j * a->nbWords, a->nbWords);
     }
 
-    /*Get void:*/
-    emptySet = Sets_getEmptyElement(m.elementSize);
-    /*Check if the function contain the void element:*/
-    for(i = 0; i<m.nbFocals; i++){
-        if(m.focals[i].element.card == 0){
-            containVoid = 1;
-            voidIndex = i;
+    if(inner){
+        return mi * a->cards[i] + mj * a->cards[j] - (mi + mj) * common;
+    }
+    return (mi + mj) * (a->cards[i] + a->cards[j] - common) - mi * a->cards[i] - mj * a->cards[j];
+}
+
+static void findNearestFocal(const Approximation* a, const int i, const int inner, int* nearest, double* costs){
+    double cost = 0;
+    int j = 0;
+
+    nearest[i] = -1;
+    for(j = 0; j < a->nbFocals; j++){
+        if(j != i && a->alive[j]){
+            cost = mergingCost(a, i, j, inner);
+            if(nearest[i] < 0 || cost < costs[i]){
+                nearest[i] = j;
+                costs[i] = cost;
+            }
         }
     }
-    /*Weaken:*/
-    if(containVoid){
-        /*Weaken the believes on elements:*/
-        weakened.nbFocals = m.nbFocals;
-        weakened.focals = malloc(sizeof(BF_FocalElement) * m.nbFocals);
-        DEBUG_CHECK_MALLOC(weakened.focals);
+}
 
-		weakened.elementSize = m.elementSize;
-        for(i = 0; i<m.nbFocals; i++){
-            weakened.focals[i].element = Sets_copyElement(m.focals[i].element, m.elementSize);
-            if(i != voidIndex){
-                weakened.focals[i].beliefValue = m.focals[i].beliefValue * (1 - realAlpha);
-                sum += weakened.focals[i].beliefValue;
+/*
+ * Merges the closest focals until there are at most maxFocals of them. The nearest focal of each one is kept.
+ * When the nearest focal of k is merged, the former cost of k is a lower bound of its new one: k only looks
+ * again for its nearest focal (stale) if its lower bound is the smallest cost.
+ */
+static void mergeFocals(Approximation* a, const int maxFocals, const int inner){
+    int *nearest = malloc(sizeof(int) * a->nbFocals);
+    double *costs = malloc(sizeof(double) * a->nbFocals);
+    char *stale = calloc(a->nbFocals, sizeof(char));
+    uint64_t *wi = NULL, *wj = NULL;
+    double cost = 0;
+    int nbAlive = a->nbFocals, i = 0, j = 0, k = 0, common = 0, card = 0;
+
+    if(nearest == NULL || costs == NULL || stale == NULL){
+        #ifdef DEBUG
+        printf("debug: malloc failed in mergeFocals()!\n");
+        #endif
+        free(nearest);
+        free(costs);
+        free(stale);
+        return;
+    }
+    for(k = 0; k < a->nbFocals; k++){
+        findNearestFocal(a, k, inner, nearest, costs);
+    }
+
+    while(nbAlive > maxFocals){
+        /*The closest pair:*/
+        do {
+            i = -1;
+            for(k = 0; k < a->nbFocals; k++){
+                if(a->alive[k] && (i < 0 || costs[k] < costs[i])){
+                    i = k;
+                }
+            }
+            if(stale[i]){
+                findNearestFocal(a, i, inner, nearest, costs);
+                stale[i] = 0;
+                i = -1;
+            }
+        } while(i < 0);
+        j = nearest[i];
+        /*j is merged into i:*/
+        wi = a->words + (size_t)i * a->nbWords;
+        wj = a->words + (size_t)j * a->nbWords;
+        common = Sets_wordsConjunctionCard(wi, wj, a->nbWords);
+        card = inner ? common : a->cards[i] + a->cards[j] - common;
+        a->unmoved[i] = (card == a->cards[i] ? a->unmoved[i] : 0) + (card == a->cards[j] ? a->unmoved[j] : 0);
+        if(inner){
+            Sets_wordsConjunction(wi, wi, wj, a->nbWords);
+        }
+        else {
+            Sets_wordsDisjunction(wi, wi, wj, a->nbWords);
+        }
+        a->cards[i] = card;
+        a->masses[i] += a->masses[j];
+        a->alive[j] = 0;
+        nbAlive--;
+
+        /*Update the nearest focals:*/
+        findNearestFocal(a, i, inner, nearest, costs);
+        for(k = 0; k < a->nbFocals; k++){
+            if(k != i && a->alive[k]){
+                cost = mergingCost(a, k, i, inner);
+                if(cost < costs[k] || (!stale[k] && nearest[k] == i && cost == costs[k])){
+                    nearest[k] = i;
+                    costs[k] = cost;
+                    stale[k] = 0;
+                }
+                else if(nearest[k] == i || nearest[k] == j){
+                    stale[k] = 1;
+                }
             }
         }
-        /*Transfer the lost belief on void:*/
-        weakened.focals[voidIndex].beliefValue = 1 - sum;
     }
-    else {
-        weakened.nbFocals = m.nbFocals + 1; /* + void */
-        weakened.focals = malloc(sizeof(BF_FocalElement) * (m.nbFocals + 1));
-        DEBUG_CHECK_MALLOC(weakened.focals);
+    free(nearest);
+    free(costs);
+    free(stale);
+}
 
-		weakened.elementSize = m.elementSize;
-        /*Put the elements: */
-        for(i = 0; i<m.nbFocals; i++){
-            weakened.focals[i].element = Sets_copyElement(m.focals[i].element, m.elementSize);
-            weakened.focals[i].beliefValue = m.focals[i].beliefValue * (1 - realAlpha);
+/*
+ * Gives the mass that is not on its original element anymore.
+ */
+static double getMovedMass(const Approximation* a, const double total){
+    double unmoved = 0;
+    int i = 0;
+
+    for(i = 0; i < a->nbFocals; i++){
+        if(a->alive[i]){
+            unmoved += a->unmoved[i];
         }
-        /*Transfer the lost belief on void: */
-        weakened.focals[m.nbFocals].element = Sets_copyElement(emptySet, m.elementSize);
-        weakened.focals[m.nbFocals].beliefValue = realAlpha;
     }
+    return total - unmoved > 0 ? total - unmoved : 0;
+}
 
-    /*Deallocate: */
-    Sets_freeElement(&emptySet);
 
-    #ifdef CHECK_SUM
-    if(BF_checkSum(weakened)){
-        printf("debug: in BF_weakening(), the sum is not equal to 1.\ndebug: There may be a problem in the model.\n");
+
+/* !!! Distances between several belief functions !!! */
+
+/*
+ * Dot product with 4 partial sums, one per lane of the AVX2 version
+ * which thus gives exactly the same result.
+ */
+static double scalarDotProduct(const double* a, const double* b, const int n){
+    double sums[4] = {0, 0, 0, 0};
+    double dot = 0;
+    int i = 0;
+
+    for(i = 0; i + 4 <= n; i += 4){
+        sums[0] += a[i] * b[i];
+        sums[1] += a[i + 1] * b[i + 1];
+        sums[2] += a[i + 2] * b[i + 2];
+        sums[3] += a[i + 3] * b[i + 3];
     }
-    #endif
-    #ifdef CHECK_VALUES 
-    if(BF_checkValues(weakened)){
-    	printf("debug: in BF_weakening(), at least one value is not valid!\n");
+    dot = (sums[0] + sums[1]) + (sums[2] + sums[3]);
+    for(; i < n; i++){
+        dot += a[i] * b[i];
     }
-    #endif
 
-    return weakened;
+    return dot;
 }
 
-
-
-BF_BeliefFunction BF_discounting(const BF_BeliefFunction m, const float alpha){
-    BF_BeliefFunction discounted;
-    int containComplete = 0, completeIndex = 0;
+#ifdef BF_X86_KERNELS
+__attribute__((target("avx2")))
+static double avx2DotProduct(const double* a, const double* b, const int n){
+    double sums[4];
+    double dot = 0;
+    __m256d acc = _mm256_setzero_pd();
     int i = 0;
-    float sum = 0, realAlpha = 0;
-    Sets_Element complete;
-    
-    if(alpha >= 1){
-    	realAlpha = 1;
+
+    for(i = 0; i + 4 <= n; i += 4){
+        acc = _mm256_add_pd(acc, _mm256_mul_pd(_mm256_loadu_pd(a + i), _mm256_loadu_pd(b + i)));
     }
-    else if(alpha <= 0){
-    	realAlpha = 0;
+    _mm256_storeu_pd(sums, acc);
+    dot = (sums[0] + sums[1]) + (sums[2] + sums[3]);
+    for(; i < n; i++){
+        dot += a[i] * b[i];
     }
-    else {
-    	realAlpha = alpha;
+
+    return dot;
+}
+#endif
+
+/*
+ * Uses the AVX2 version when the word kernels selected by SetsWide allow it.
+ */
+static double dotProduct(const double* a, const double* b, const int n){
+    #ifdef BF_X86_KERNELS
+    if(Sets_getWordKernels() >= KERNELS_AVX2){
+        return avx2DotProduct(a, b, n);
     }
+    #endif
+    return scalarDotProduct(a, b, n);
+}
 
-    /*Get the complete set: */
-    complete = Sets_getCompleteElement(m.elementSize);
-    /*Check if the function contain the complete set element: */
-    for(i = 0; i<m.nbFocals; i++){
-        if(m.focals[i].element.card == m.elementSize){
-            containComplete = 1;
-            completeIndex = i;
+/*
+ * Projects belief functions on the union of their focal elements (the basis).
+ * vectors receives the masses of the functions on the basis (one row per function) and
+ * products the products of the Jaccard matrix of the basis by these vectors (same layout).
+ * The Jaccard matrix is computed once, one row at a time, and never stored. Its coefficients
+ * come from ctx if it is given (and the frame small enough), from the word kernels otherwise.
+ * Returns the size of the basis, -1 if the memory cannot be allocated or if a function gives
+ * a focal element twice (BF_difference() then counts it twice, use BF_distance() in these cases).
+ */
+static int projectOnFocals(const BF_BeliefFunction* m, const int nbM, const Sets_Context* ctx,
+        double** vectors, double** products){
+    BF_BeliefFunction basis = {NULL, 0, 0};
+    BF_CompactBeliefFunction compact;
+    BF_FocalIndex* basisIndex = NULL;
+    Sets_PackedElement* ids = NULL;
+    double* row = NULL;
+    int* owners = NULL;
+    int i = 0, j = 0, a = 0, b = 0, position = 0, repeated = 0, nbBasis = 0, conjCard = 0;
+    int size = m[0].elementSize, nbWords = SETS_WIDE_NB_WORDS(size);
+    int inContext = (ctx != NULL && ctx->elementSize == size && size <= SETS_PACKED_MAX_SIZE);
+
+    /*The basis, indexed to find the focals in a constant time: */
+    basis.elementSize = size;
+    basisIndex = BF_indexBeliefFunction(basis);
+    for(i = 0; i < nbM; i++){
+        for(j = 0; j < m[i].nbFocals; j++){
+            BF_addToFocal(&basis, basisIndex, m[i].focals[j].element, 0);
         }
     }
-    /*Discount: */
-    if(containComplete){
-        /*Discount the believes on elements: */
-        discounted.nbFocals = m.nbFocals;
-        discounted.focals = malloc(sizeof(BF_FocalElement )*m.nbFocals);
-        DEBUG_CHECK_MALLOC(discounted.focals);
-
-		discounted.elementSize = m.elementSize;
-        for(i = 0; i<m.nbFocals; i++){
-            discounted.focals[i].element = Sets_copyElement(m.focals[i].element, m.elementSize);
-            if(i != completeIndex){
-                discounted.focals[i].beliefValue = m.focals[i].beliefValue * (1 - realAlpha);
-                sum += discounted.focals[i].beliefValue;
+    nbBasis = basis.nbFocals;
+
+    *vectors = calloc((size_t)nbM * nbBasis + 1, sizeof(double));
+    *products = malloc(sizeof(double) * ((size_t)nbM * nbBasis + 1));
+    row = malloc(sizeof(double) * (nbBasis + 1));
+    owners = malloc(sizeof(int) * (nbBasis + 1));
+    DEBUG_CHECK_MALLOC(*vectors);
+    DEBUG_CHECK_MALLOC(*products);
+    DEBUG_CHECK_MALLOC(row);
+    DEBUG_CHECK_MALLOC(owners);
+    if(*vectors == NULL || *products == NULL || row == NULL || owners == NULL){
+        repeated = 1;
+    }
+    else {
+        for(a = 0; a < nbBasis; a++){
+            owners[a] = -1;
+        }
+        for(i = 0; i < nbM && !repeated; i++){
+            for(j = 0; j < m[i].nbFocals; j++){
+                position = BF_getFocalPosition(basis, basisIndex, m[i].focals[j].element);
+                repeated |= (owners[position] == i);
+                owners[position] = i;
+                (*vectors)[(size_t)i * nbBasis + position] = m[i].focals[j].beliefValue;
             }
         }
-        /*Transfer the lost belief on complete: */
-        discounted.focals[completeIndex].beliefValue = 1 - sum;
     }
-    else {
-        discounted.nbFocals = m.nbFocals + 1; /* + complete */
-        discounted.focals = malloc(sizeof(BF_FocalElement )*(m.nbFocals + 1));
-        DEBUG_CHECK_MALLOC(discounted.focals);
+    free(owners);
+    BF_freeFocalIndex(basisIndex);
+    if(repeated){
+        free(*vectors);
+        free(*products);
+        free(row);
+        BF_freeBeliefFunction(&basis);
+        return -1;
+    }
 
-		discounted.elementSize = m.elementSize;
-        /*Put the elements: */
-        for(i = 0; i<m.nbFocals; i++){
-            discounted.focals[i].element = Sets_copyElement(m.focals[i].element, m.elementSize);
-            discounted.focals[i].beliefValue = m.focals[i].beliefValue * (1 - realAlpha);
+    if(inContext){
+        ids = malloc(sizeof(Sets_PackedElement) * (nbBasis + 1));
+        DEBUG_CHECK_MALLOC(ids);
+        for(a = 0; a < nbBasis; a++){
+            ids[a] = Sets_packElement(basis.focals[a].element, size);
+        }
+    }
+    compact = BF_toCompactBeliefFunction(basis);
+
+    for(a = 0; a < nbBasis; a++){
+        /*Row a of the Jaccard matrix: */
+        for(b = 0; b < nbBasis; b++){
+            if(inContext){
+                row[b] = Sets_jaccardInContext(ctx, ids[a], ids[b]);
+            }
+            else if(basis.focals[a].element.card > 0 || basis.focals[b].element.card > 0){
+                /*|A u B| = |A| + |B| - |A n B|: */
+                conjCard = Sets_wordsConjunctionCard(compact.elementBits + (size_t)a * nbWords, compact.elementBits + (size_t)b * nbWords, nbWords);
+                row[b] = (double)conjCard / (double)(basis.focals[a].element.card + basis.focals[b].element.card - conjCard);
+            }
+            else {
+                row[b] = 1;
+            }
+        }
+        for(i = 0; i < nbM; i++){
+            (*products)[(size_t)i * nbBasis + a] = dotProduct(row, *vectors + (size_t)i * nbBasis, nbBasis);
+        }
+    }
+
+    /*Deallocate: */
+    free(row);
+    free(ids);
+    BF_freeCompactBeliefFunction(&compact);
+    BF_freeBeliefFunction(&basis);
+
+    return nbBasis;
+}
+
+/*
+ * Distance between the functions i and k projected by projectOnFocals():
+ * sqrt(0.5 * (vi - vk).J.(vi - vk)) where self[i] = vi.J.vi.
+ */
+static float distanceOnFocals(const double* vectors, const double* products, const double* self,
+        const int nbBasis, const int i, const int k){
+    double q = self[i] + self[k] - 2 * dotProduct(vectors + (size_t)i * nbBasis, products + (size_t)k * nbBasis, nbBasis);
+
+    /*Rounding errors may give a slightly negative value for identical functions: */
+    return (q > 0 ? sqrt(0.5 * q) : 0);
+}
+
+/*
+ * Similarity of two belief functions given their distance (see BF_similarity()).
+ */
+static float similarityOf(const float distance){
+    return (0.5 * (cos(3.14159 * distance + 1)));
+}
+
+/*
+ * Number of queries evaluated together by the batch measures (see BF_measures()).
+ * Their results stay in the cache while all the focal elements are scanned.
+ */
+#define MEASURES_TILE_SIZE 64
+
+/*
+ * Number of (query, focal) pairs from which the tiles are split over threads (OpenMP).
+ */
+#define MEASURES_PARALLEL_THRESHOLD 65536
+
+/*
+ * Evaluates the requested measures (NULL if not) of a tile of queries given as element ids,
+ * the focal elements being given as ids, masses and cardinalities. The innermost loops run over the queries
+ * and carry no dependency so that they can be vectorized. The masses are summed in the order of the focals
+ * as in BF_bel(), BF_pl(), BF_q() and BF_betP(), so the results are the same.
+ */
+static void measureTileOfIds(const Sets_PackedElement* focals, const BF_Mass* masses, const int* cards,
+        const int nbFocals, const Sets_PackedElement* queries, const int nbQueries,
+        BF_Mass* bel, BF_Mass* pl, BF_Mass* q, BF_Mass* betP){
+    Sets_PackedElement focal = 0;
+    BF_Mass mass = 0;
+    int i = 0, j = 0;
+
+    for(j = 0; j < nbQueries; j++){
+        if(bel != NULL){ bel[j] = 0; }
+        if(pl != NULL){ pl[j] = 0; }
+        if(q != NULL){ q[j] = 0; }
+        if(betP != NULL){ betP[j] = 0; }
+    }
+    for(i = 0; i < nbFocals; i++){
+        focal = focals[i];
+        mass = masses[i];
+        if(bel != NULL && focal != 0){
+            for(j = 0; j < nbQueries; j++){
+                bel[j] += Sets_packedIsSubset(focal, queries[j]) ? mass : 0;
+            }
+        }
+        if(pl != NULL){
+            for(j = 0; j < nbQueries; j++){
+                pl[j] += Sets_packedConjunction(focal, queries[j]) != 0 ? mass : 0;
+            }
+        }
+        if(q != NULL){
+            for(j = 0; j < nbQueries; j++){
+                q[j] += Sets_packedIsSubset(queries[j], focal) ? mass : 0;
+            }
+        }
+        if(betP != NULL && cards[i] > 0){
+            for(j = 0; j < nbQueries; j++){
+                betP[j] += mass * Sets_packedCard(Sets_packedConjunction(focal, queries[j])) / cards[i];
+            }
+        }
+    }
+}
+
+/*
+ * Batch measures of a belief function on a frame of at most SETS_PACKED_MAX_SIZE atoms.
+ * The queries are given either as elements or as ids (the other one being NULL).
+ * Returns 0 if an allocation failed.
+ */
+static int measuresOfIds(const BF_BeliefFunction m, const Sets_Element* elements, const Sets_PackedElement* ids,
+        const int nbQueries, BF_Mass* bel, BF_Mass* pl, BF_Mass* q, BF_Mass* betP){
+    Sets_PackedElement* focals = NULL;
+    BF_Mass* masses = NULL;
+    int* cards = NULL;
+    int i = 0, t = 0, nbTiles = (nbQueries + MEASURES_TILE_SIZE - 1) / MEASURES_TILE_SIZE;
+
+    /*The focals are converted once for all the queries: */
+    focals = malloc((sizeof(Sets_PackedElement) + sizeof(BF_Mass) + sizeof(int)) * (m.nbFocals + 1));
+    DEBUG_CHECK_MALLOC_OR_RETURN(focals, 0);
+    masses = (BF_Mass*)(focals + m.nbFocals + 1);
+    cards = (int*)(masses + m.nbFocals + 1);
+    for(i = 0; i < m.nbFocals; i++){
+        focals[i] = Sets_packElement(m.focals[i].element, m.elementSize);
+        masses[i] = m.focals[i].beliefValue;
+        cards[i] = m.focals[i].element.card;
+    }
+
+    #ifdef _OPENMP
+    #pragma omp parallel for schedule(static) if(nbTiles > 1 && (long)nbQueries * m.nbFocals >= MEASURES_PARALLEL_THRESHOLD)
+    #endif
+    for(t = 0; t < nbTiles; t++){
+        Sets_PackedElement tileIds[MEASURES_TILE_SIZE];
+        const Sets_PackedElement* queries = tileIds;
+        int start = t * MEASURES_TILE_SIZE, j = 0;
+        int nbInTile = (nbQueries - start < MEASURES_TILE_SIZE ? nbQueries - start : MEASURES_TILE_SIZE);
+
+        if(ids != NULL){
+            queries = ids + start;
+        }
+        else {
+            for(j = 0; j < nbInTile; j++){
+                tileIds[j] = Sets_packElement(elements[start + j], m.elementSize);
+            }
+        }
+        measureTileOfIds(focals, masses, cards, m.nbFocals, queries, nbInTile,
+                bel != NULL ? bel + start : NULL, pl != NULL ? pl + start : NULL,
+                q != NULL ? q + start : NULL, betP != NULL ? betP + start : NULL);
+    }
+    free(focals);
+
+    return 1;
+}
+
+/*
+ * Batch measures of a belief function on a larger frame (multi-word elements).
+ * Returns 0 if an allocation failed.
+ */
+static int measuresOfWords(const BF_BeliefFunction m, const Sets_Element* elements, const int nbQueries,
+        BF_Mass* bel, BF_Mass* pl, BF_Mass* q, BF_Mass* betP){
+    uint64_t* words = NULL;
+    int i = 0, t = 0, nbWords = SETS_WIDE_NB_WORDS(m.elementSize);
+    int nbTiles = (nbQueries + MEASURES_TILE_SIZE - 1) / MEASURES_TILE_SIZE;
+
+    /*The words of the focals, followed by the ones of the queries: */
+    words = malloc(sizeof(uint64_t) * nbWords * ((size_t)m.nbFocals + nbQueries));
+    DEBUG_CHECK_MALLOC_OR_RETURN(words, 0);
+    for(i = 0; i < m.nbFocals; i++){
+        Sets_packWords(words + (size_t)i * nbWords, m.focals[i].element, m.elementSize);
+    }
+    for(i = 0; i < nbQueries; i++){
+        Sets_packWords(words + ((size_t)m.nbFocals + i) * nbWords, elements[i], m.elementSize);
+    }
+
+    #ifdef _OPENMP
+    #pragma omp parallel for schedule(static) if(nbTiles > 1 && (long)nbQueries * m.nbFocals >= MEASURES_PARALLEL_THRESHOLD)
+    #endif
+    for(t = 0; t < nbTiles; t++){
+        int start = t * MEASURES_TILE_SIZE, end = start + MEASURES_TILE_SIZE, f = 0, j = 0;
+        const uint64_t *focal = NULL, *query = NULL;
+        BF_Mass mass = 0;
+        int card = 0;
+
+        if(end > nbQueries){
+            end = nbQueries;
+        }
+        for(j = start; j < end; j++){
+            if(bel != NULL){ bel[j] = 0; }
+            if(pl != NULL){ pl[j] = 0; }
+            if(q != NULL){ q[j] = 0; }
+            if(betP != NULL){ betP[j] = 0; }
+        }
+        for(f = 0; f < m.nbFocals; f++){
+            focal = words + (size_t)f * nbWords;
+            mass = m.focals[f].beliefValue;
+            card = m.focals[f].element.card;
+            for(j = start; j < end; j++){
+                query = words + ((size_t)m.nbFocals + j) * nbWords;
+                if(bel != NULL && card > 0 && Sets_wordsIsSubset(focal, query, nbWords)){
+                    bel[j] += mass;
+                }
+                if(pl != NULL && Sets_wordsConjunctionCard(focal, query, nbWords) > 0){
+                    pl[j] += mass;
+                }
+                if(q != NULL && Sets_wordsIsSubset(query, focal, nbWords)){
+                    q[j] += mass;
+                }
+                if(betP != NULL && card > 0){
+                    betP[j] += mass * Sets_wordsConjunctionCard(query, focal, nbWords) / card;
+                }
+            }
+        }
+    }
+    free(words);
+
+    return 1;
+}
+
+/*
+  +-----------+
+  | FUNCTIONS |
+  +-----------+
+*/
+
+/**
+ * @name Utility functions
+ * @{
+ */
+
+BF_BeliefFunction BF_copyBeliefFunction(const BF_BeliefFunction m){
+    BF_BeliefFunction copy = {NULL, 0, 0};
+    int i = 0;
+
+    /*Memory alocation:*/
+    copy.nbFocals = m.nbFocals;
+    copy.focals = malloc(sizeof(BF_FocalElement ) * copy.nbFocals);
+    DEBUG_CHECK_MALLOC(copy.focals);
+
+    copy.elementSize = m.elementSize;
+    /*Copy: */
+    for(i = 0; i < copy.nbFocals; i++){
+        copy.focals[i].element = Sets_copyElement(m.focals[i].element, m.elementSize);
+        copy.focals[i].beliefValue = m.focals[i].beliefValue;
+    }
+
+    return copy;
+}
+
+
+
+BF_BeliefFunction BF_getVacuousBeliefFunction(const int elementSize){
+	BF_BeliefFunction vacuous = {NULL, 0, 0};
+	
+	vacuous.nbFocals = 1;
+	vacuous.focals = malloc(sizeof(BF_FocalElement ));
+	DEBUG_CHECK_MALLOC(vacuous.focals);
+
+    vacuous.elementSize = elementSize;
+	
+	vacuous.focals[0].element = Sets_getCompleteElement(elementSize);
+	vacuous.focals[0].beliefValue = 1;
+	
+	return vacuous;
+}
+
+
+
+void BF_cleanBeliefFunction(BF_BeliefFunction* bf){
+	int i = 0, index = 0;
+	int nbZeros = 0;
+	
+	/*Compact the list of points in place:*/
+	for(i = 0; i < bf->nbFocals; i++){
+		if(bf->focals[i].beliefValue >= BF_PRECISION){
+			bf->focals[index] = bf->focals[i];
+			index++;
+		}
+		else{
+			BF_freeBeliefPoint(&(bf->focals[i]));
+			nbZeros++;
+		}
+	}
+	bf->nbFocals -= nbZeros;
+	
+	BF_normalize(bf);
+}
+
+
+
+void BF_normalize(BF_BeliefFunction* bf){
+	double sum = 0;
+	int i = 0;
+	
+	for(i = 0; i<bf->nbFocals; i++){
+        sum += bf->focals[i].beliefValue;
+    }
+
+    if(sum != 1){
+        for(i = 0; i < bf->nbFocals; i++){
+        	bf->focals[i].beliefValue /= sum;
+        }
+    }
+}
+
+
+
+BF_FocalIndex* BF_indexBeliefFunction(const BF_BeliefFunction m){
+    BF_FocalIndex* index = NULL;
+    unsigned int nbSlots = 8;
+    int i = 0;
+
+    /*If an allocation fails, the belief function stays usable without index: */
+    index = malloc(sizeof(BF_FocalIndex));
+    DEBUG_CHECK_MALLOC_OR_RETURN(index, NULL);
+    index->slots = NULL;
+    index->words = NULL;
+    index->nbWords = SETS_WIDE_NB_WORDS(m.elementSize);
+    index->nbIndexed = 0;
+    index->capacity = 0;
+    /*At most one half of the slots are used: */
+    while(nbSlots < 2 * (unsigned int)m.nbFocals){
+        nbSlots *= 2;
+    }
+    if(!resizeFocalIndex(index, nbSlots)){
+        BF_freeFocalIndex(index);
+        return NULL;
+    }
+
+    for(i = 0; i < m.nbFocals; i++){
+        if(!indexFocal(index, m.focals[i].element, m.elementSize)){
+            BF_freeFocalIndex(index);
+            return NULL;
+        }
+    }
+
+    return index;
+}
+
+
+
+int BF_getFocalPosition(const BF_BeliefFunction m, const BF_FocalIndex* index, const Sets_Element e){
+    uint64_t stackWords[SETS_WIDE_STACK_WORDS];
+    uint64_t* words = stackWords;
+    unsigned int slot = 0;
+    int i = 0;
+
+    if(index != NULL && index->nbIndexed == m.nbFocals && index->nbWords > SETS_WIDE_STACK_WORDS){
+        words = malloc(sizeof(uint64_t) * index->nbWords);
+        DEBUG_CHECK_MALLOC(words);
+    }
+
+    /*Linear search if not indexed (or if focals were added without updating the index): */
+    if(index == NULL || index->nbIndexed != m.nbFocals || words == NULL){
+        for(i = 0; i<m.nbFocals; i++){
+            if(Sets_equals(e, m.focals[i].element, m.elementSize)){
+                return i;
+            }
+        }
+        return -1;
+    }
+
+    Sets_packWords(words, e, m.elementSize);
+    slot = findFocalSlot(index, words);
+    if(words != stackWords){
+        free(words);
+    }
+
+    return index->slots[slot] - 1;
+}
+
+
+
+int BF_addToFocal(BF_BeliefFunction* bf, BF_FocalIndex* index, const Sets_Element e, const BF_Mass beliefValue){
+    int position = BF_getFocalPosition(*bf, index, e);
+
+    if(position >= 0){
+        bf->focals[position].beliefValue += beliefValue;
+        return position;
+    }
+
+    /*If not in, add it ! */
+    position = bf->nbFocals;
+    bf->focals = realloc(bf->focals, sizeof(BF_FocalElement) * (position + 1));
+    DEBUG_CHECK_MALLOC_OR_RETURN(bf->focals, -1);
+
+    bf->focals[position].element = Sets_copyElement(e, bf->elementSize);
+    bf->focals[position].beliefValue = beliefValue;
+    bf->nbFocals++;
+    /*Keep the index up to date (if it cannot grow, the next lookups fall back to a linear search): */
+    if(index != NULL && index->nbIndexed == position){
+        indexFocal(index, e, bf->elementSize);
+    }
+
+    return position;
+}
+
+
+
+void BF_freeFocalIndex(BF_FocalIndex* index){
+    if(index != NULL){
+        free(index->slots);
+        free(index->words);
+        free(index);
+    }
+}
+
+
+
+/** @} */
+
+
+
+
+
+
+
+/**
+ * @name Operations on belief functions
+ * @{
+ */
+
+BF_BeliefFunction BF_conditioning(const BF_BeliefFunction m, const Sets_Element e,
+        __attribute__((unused))const Sets_Set powerset){
+    /*The transfer does not depend on the powerset: */
+    return BF_conditioningOn(m, e);
+}
+
+
+
+BF_BeliefFunction BF_conditioningInView(const BF_BeliefFunction m, const Sets_Element e,
+        __attribute__((unused))const Sets_PowerSetView view){
+    /*The transfer does not depend on the powerset: */
+    return BF_conditioningOn(m, e);
+}
+
+
+
+BF_BeliefFunction BF_conditioningOn(const BF_BeliefFunction m, const Sets_Element e){
+    BF_BeliefFunction conditioned = {NULL, 0, 0};
+    BF_FocalIndex* index = NULL;
+    Sets_Element conj = {NULL, 0};
+    int i = 0;
+
+    /*Temporary element reused for all the conjunctions: */
+    conj = Sets_getEmptyElement(m.elementSize);
+
+    /*Focal elements of the conditioned function (with the void element), indexed to merge the transfers:*/
+    conditioned = conditionedFocals(m);
+    index = BF_indexBeliefFunction(conditioned);
+
+    /*Transfer of m(A) to A n e (new focal elements are added at the end):*/
+    for(i = 0; i<m.nbFocals; i++){
+        Sets_conjunctionInto(&conj, m.focals[i].element, e, m.elementSize);
+        BF_addToFocal(&conditioned, index, conj, m.focals[i].beliefValue);
+    }
+
+    /*Deallocate:*/
+    Sets_freeElement(&conj);
+    BF_freeFocalIndex(index);
+	
+	#ifdef CHECK_SUM
+    if(BF_checkSum(conditioned)){
+        printf("debug: in BF_conditioningOn(), the sum is not equal to 1.\ndebug: There may be a problem in the model.\n");
+    }
+    #endif
+    #ifdef CHECK_VALUES 
+    if(BF_checkValues(conditioned)){
+    	printf("debug: in BF_conditioningOn(), at least one value is not valid!\n");
+    }
+    #endif
+
+    return conditioned;
+}
+
+
+
+BF_BeliefFunction BF_weakening(const BF_BeliefFunction m, const float alpha){
+    BF_BeliefFunction weakened = BF_copyBeliefFunction(m);
+
+    BF_weaken(&weakened, alpha);
+
+    return weakened;
+}
+
+
+
+BF_BeliefFunction BF_discounting(const BF_BeliefFunction m, const float alpha){
+    BF_BeliefFunction discounted = BF_copyBeliefFunction(m);
+
+    BF_discount(&discounted, alpha);
+
+    return discounted;
+}
+
+
+
+void BF_weaken(BF_BeliefFunction* bf, const float alpha){
+    BF_FocalElement* focals = NULL;
+    int containVoid = 0, voidIndex = 0;
+    int i = 0;
+    double sum = 0;
+    BF_Mass realAlpha = 0;
+    
+    if(alpha >= 1){
+    	realAlpha = 1;
+    }
+    else {
+    	realAlpha = alpha;
+    }
+
+    /*Check if the function contain the void element:*/
+    for(i = 0; i<bf->nbFocals; i++){
+        if(bf->focals[i].element.card == 0){
+            containVoid = 1;
+            voidIndex = i;
+        }
+    }
+    /*Weaken:*/
+    if(containVoid){
+        /*Weaken the believes on elements:*/
+        for(i = 0; i<bf->nbFocals; i++){
+            if(i != voidIndex){
+                bf->focals[i].beliefValue *= (1 - realAlpha);
+                sum += bf->focals[i].beliefValue;
+            }
+        }
+        /*Transfer the lost belief on void:*/
+        bf->focals[voidIndex].beliefValue = 1 - sum;
+    }
+    else {
+        /*Make room for void: */
+        focals = realloc(bf->focals, sizeof(BF_FocalElement) * (bf->nbFocals + 1));
+        DEBUG_CHECK_MALLOC(focals);
+        if(focals == NULL){
+            return;
+        }
+        bf->focals = focals;
+
+        for(i = 0; i<bf->nbFocals; i++){
+            bf->focals[i].beliefValue *= (1 - realAlpha);
+        }
+        /*Transfer the lost belief on void: */
+        bf->focals[bf->nbFocals].element = Sets_getEmptyElement(bf->elementSize);
+        bf->focals[bf->nbFocals].beliefValue = realAlpha;
+        bf->nbFocals++;
+    }
+
+    #ifdef CHECK_SUM
+    if(BF_checkSum(*bf)){
+        printf("debug: in BF_weaken(), the sum is not equal to 1.\ndebug: There may be a problem in the model.\n");
+    }
+    #endif
+    #ifdef CHECK_VALUES 
+    if(BF_checkValues(*bf)){
+    	printf("debug: in BF_weaken(), at least one value is not valid!\n");
+    }
+    #endif
+}
+
+
+
+void BF_discount(BF_BeliefFunction* bf, const float alpha){
+    BF_FocalElement* focals = NULL;
+    int containComplete = 0, completeIndex = 0;
+    int i = 0;
+    double sum = 0;
+    BF_Mass realAlpha = 0;
+    
+    if(alpha >= 1){
+    	realAlpha = 1;
+    }
+    else if(alpha <= 0){
+    	realAlpha = 0;
+    }
+    else {
+    	realAlpha = alpha;
+    }
+
+    /*Check if the function contain the complete set element: */
+    for(i = 0; i<bf->nbFocals; i++){
+        if(bf->focals[i].element.card == bf->elementSize){
+            containComplete = 1;
+            completeIndex = i;
+        }
+    }
+    /*Discount: */
+    if(containComplete){
+        /*Discount the believes on elements: */
+        for(i = 0; i<bf->nbFocals; i++){
+            if(i != completeIndex){
+                bf->focals[i].beliefValue *= (1 - realAlpha);
+                sum += bf->focals[i].beliefValue;
+            }
+        }
+        /*Transfer the lost belief on complete: */
+        bf->focals[completeIndex].beliefValue = 1 - sum;
+    }
+    else {
+        /*Make room for complete: */
+        focals = realloc(bf->focals, sizeof(BF_FocalElement) * (bf->nbFocals + 1));
+        DEBUG_CHECK_MALLOC(focals);
+        if(focals == NULL){
+            return;
+        }
+        bf->focals = focals;
+
+        for(i = 0; i<bf->nbFocals; i++){
+            bf->focals[i].beliefValue *= (1 - realAlpha);
+        }
+        /*Transfer the lost belief on complete: */
+        bf->focals[bf->nbFocals].element = Sets_getCompleteElement(bf->elementSize);
+        bf->focals[bf->nbFocals].beliefValue = realAlpha;
+        bf->nbFocals++;
+    }
+
+    #ifdef CHECK_SUM
+    if(BF_checkSum(*bf)){
+        printf("debug: in BF_discount(), the sum is not equal to 1.\ndebug: There may be a problem in the model.\n");
+        printf("debug: alpha = %f\n", alpha);
+    }
+    #endif
+    #ifdef CHECK_VALUES 
+    if(BF_checkValues(*bf)){
+    	printf("debug: in BF_discount(), at least one value is not valid!\n");
+    	printf("debug: alpha = %f\n", alpha);
+    }
+    #endif
+}
+
+
+
+BF_BeliefFunction BF_difference(const BF_BeliefFunction m1, const BF_BeliefFunction m2){
+    BF_BeliefFunction diff = {NULL, 0, 0};
+    int i = 0;
+    Sets_Set values = {NULL, 0};
+
+	#ifdef CHECK_COMPATIBILITY
+    if(m1.elementSize != m2.elementSize){
+    	printf("debug: in BF_difference(), the two mass functions aren't defined on the same frame...\n");
+    }
+    #endif
+
+    /*Get the set of values to considerate: */
+    values.elements = malloc(sizeof(Sets_Element) * (m1.nbFocals + m2.nbFocals));
+    DEBUG_CHECK_MALLOC(values.elements);
+
+    for(i = 0; i<m1.nbFocals; i++){
+        values.elements[i] = Sets_copyElement(m1.focals[i].element, m1.elementSize);
+        values.card++;
+    }
+    for(i = 0; i<m2.nbFocals; i++){
+        if(!Sets_isMember(m2.focals[i].element, values, m1.elementSize)){
+            values.elements[values.card] = Sets_copyElement(m2.focals[i].element, m1.elementSize);
+            values.card++;
+        }
+    }
+    /*Allocation: */
+    diff.nbFocals = values.card;
+    diff.focals = malloc(sizeof(BF_FocalElement) * values.card);
+    DEBUG_CHECK_MALLOC(diff.focals);
+
+	diff.elementSize = m1.elementSize;
+    /*Get the differences: */
+    for(i = 0; i<values.card; i++){
+        diff.focals[i].element = Sets_copyElement(values.elements[i], m1.elementSize);
+        diff.focals[i].beliefValue = BF_m(m1, values.elements[i]) - BF_m(m2, values.elements[i]);
+    }
+    /*Deallocation: */
+    Sets_freeSet(&values);
+
+    return diff;
+}
+
+
+
+/** @} */
+
+
+
+/**
+ * @name Approximations
+ * @{
+ */
+
+BF_BeliefFunction BF_approximation(const BF_BeliefFunction m, const int maxFocals, const BF_ApproximationMethod method,
+        BF_Mass* movedMass){
+    BF_BeliefFunction approximated = {NULL, 0, 0};
+    Approximation a;
+    double total = 0;
+    int i = 0, bound = (maxFocals > 0 ? maxFocals : 1);
+
+    if(!toApproximation(m, &a)){
+        return approximated;
+    }
+    for(i = 0; i < a.nbFocals; i++){
+        total += a.masses[i];
+    }
+    if(a.nbFocals > bound){
+        switch(method){
+            case APPROX_SUMMARIZATION : summarize(&a, bound - 1);            break;
+            case APPROX_KLX :           keepLargest(&a, bound, bound, 0);    break;
+            case APPROX_INNER :         mergeFocals(&a, bound, 1);           break;
+            case APPROX_OUTER :         mergeFocals(&a, bound, 0);           break;
+            default :
+                printf("debug: The approximation method required in BF_approximation() is unknown.\n");
+                break;
+        }
+    }
+    if(movedMass != NULL){
+        *movedMass = getMovedMass(&a, total);
+    }
+    approximated = fromApproximation(&a, m.elementSize);
+    freeApproximation(&a);
+
+    #ifdef CHECK_VALUES
+    if(BF_checkValues(approximated)){
+    	printf("debug: in BF_approximation(), at least one value is not valid!\n");
+    }
+    #endif
+
+    return approximated;
+}
+
+
+
+BF_BeliefFunction BF_klxApproximation(const BF_BeliefFunction m, const int k, const int l, const float x,
+        BF_Mass* movedMass){
+    BF_BeliefFunction approximated = {NULL, 0, 0};
+    Approximation a;
+    double total = 0;
+    int i = 0;
+
+    if(!toApproximation(m, &a)){
+        return approximated;
+    }
+    for(i = 0; i < a.nbFocals; i++){
+        total += a.masses[i];
+    }
+    keepLargest(&a, (k > 0 ? k : 1), (l > k ? l : k), x);
+    if(movedMass != NULL){
+        *movedMass = getMovedMass(&a, total);
+    }
+    approximated = fromApproximation(&a, m.elementSize);
+    freeApproximation(&a);
+
+    #ifdef CHECK_VALUES
+    if(BF_checkValues(approximated)){
+    	printf("debug: in BF_klxApproximation(), at least one value is not valid!\n");
+    }
+    #endif
+
+    return approximated;
+}
+
+/** @} */
+
+
+
+/**
+ * @name Function-and-element-dependant operations
+ * @{
+ */
+
+BF_Mass BF_m(const BF_BeliefFunction m, const Sets_Element e){
+    int i = BF_getFocalPosition(m, NULL, e);
+
+    return i >= 0 ? m.focals[i].beliefValue : 0;
+}
+
+
+
+BF_Mass BF_bel(const BF_BeliefFunction m, const Sets_Element e){
+    BF_Mass cred = 0;
+    int i = 0, nbWords = SETS_WIDE_NB_WORDS(m.elementSize);
+    Sets_PackedElement packedE = 0, focal = 0;
+    uint64_t stackWords[2 * SETS_WIDE_STACK_WORDS];
+    uint64_t* words = stackWords;
+
+    /*Packed elements for small frames: */
+    if(m.elementSize <= SETS_PACKED_MAX_SIZE){
+        packedE = Sets_packElement(e, m.elementSize);
+        for(i = 0; i<m.nbFocals; i++){
+            focal = Sets_packElement(m.focals[i].element, m.elementSize);
+            if(focal != 0 && Sets_packedIsSubset(focal, packedE)){
+                cred += m.focals[i].beliefValue;
+            }
+        }
+        return cred;
+    }
+    
+    /*Multi-word elements for large frames (e first, then the current focal): */
+    if(nbWords > SETS_WIDE_STACK_WORDS){
+        words = malloc(sizeof(uint64_t) * 2 * nbWords);
+        DEBUG_CHECK_MALLOC_OR_RETURN(words, 0);
+    }
+    Sets_packWords(words, e, m.elementSize);
+    for(i = 0; i<m.nbFocals; i++){
+        if(m.focals[i].element.card > 0){
+            Sets_packWords(words + nbWords, m.focals[i].element, m.elementSize);
+            if(Sets_wordsIsSubset(words + nbWords, words, nbWords)){
+                cred += m.focals[i].beliefValue;
+            }
+        }
+    }
+    if(words != stackWords){
+        free(words);
+    }
+
+    return cred;
+}
+
+
+
+BF_Mass BF_pl(const BF_BeliefFunction m, const Sets_Element e){
+    BF_Mass plaus = 0;
+    int i = 0, nbWords = SETS_WIDE_NB_WORDS(m.elementSize);
+    Sets_PackedElement packedE = 0;
+    uint64_t stackWords[2 * SETS_WIDE_STACK_WORDS];
+    uint64_t* words = stackWords;
+
+    /*Packed elements for small frames: */
+    if(m.elementSize <= SETS_PACKED_MAX_SIZE){
+        packedE = Sets_packElement(e, m.elementSize);
+        for(i = 0; i<m.nbFocals; i++){
+            if(Sets_packedConjunction(Sets_packElement(m.focals[i].element, m.elementSize), packedE) != 0){
+                plaus += m.focals[i].beliefValue;
+            }
+        }
+        return plaus;
+    }
+
+    /*Multi-word elements for large frames (e first, then the current focal): */
+    if(nbWords > SETS_WIDE_STACK_WORDS){
+        words = malloc(sizeof(uint64_t) * 2 * nbWords);
+        DEBUG_CHECK_MALLOC_OR_RETURN(words, 0);
+    }
+    Sets_packWords(words, e, m.elementSize);
+    for(i = 0; i<m.nbFocals; i++){
+        Sets_packWords(words + nbWords, m.focals[i].element, m.elementSize);
+        if(Sets_wordsConjunctionCard(words + nbWords, words, nbWords) > 0){
+            plaus += m.focals[i].beliefValue;
+        }
+    }
+    if(words != stackWords){
+        free(words);
+    }
+
+    return plaus;
+}
+
+
+
+BF_Mass BF_q(const BF_BeliefFunction m, const Sets_Element e){
+    BF_Mass common = 0;
+    int i = 0, nbWords = SETS_WIDE_NB_WORDS(m.elementSize);
+    Sets_PackedElement packedE = 0;
+    uint64_t stackWords[2 * SETS_WIDE_STACK_WORDS];
+    uint64_t* words = stackWords;
+
+    /*Packed elements for small frames: */
+    if(m.elementSize <= SETS_PACKED_MAX_SIZE){
+        packedE = Sets_packElement(e, m.elementSize);
+        for(i = 0; i<m.nbFocals; i++){
+            if(Sets_packedIsSubset(packedE, Sets_packElement(m.focals[i].element, m.elementSize))){
+                common += m.focals[i].beliefValue;
+            }
+        }
+        return common;
+    }
+
+    /*Multi-word elements for large frames (e first, then the current focal): */
+    if(nbWords > SETS_WIDE_STACK_WORDS){
+        words = malloc(sizeof(uint64_t) * 2 * nbWords);
+        DEBUG_CHECK_MALLOC_OR_RETURN(words, 0);
+    }
+    Sets_packWords(words, e, m.elementSize);
+    for(i = 0; i<m.nbFocals; i++){
+        Sets_packWords(words + nbWords, m.focals[i].element, m.elementSize);
+        if(Sets_wordsIsSubset(words, words + nbWords, nbWords)){
+            common += m.focals[i].beliefValue;
+        }
+    }
+    if(words != stackWords){
+        free(words);
+    }
+
+    return common;
+}
+
+
+
+BF_Mass BF_betP(const BF_BeliefFunction m, const Sets_Element e){
+    BF_Mass proba = 0;
+    int i = 0, nbWords = SETS_WIDE_NB_WORDS(m.elementSize);
+    Sets_PackedElement packedE = 0;
+    uint64_t stackWords[2 * SETS_WIDE_STACK_WORDS];
+    uint64_t* words = stackWords;
+
+    /*Packed elements for small frames: */
+    if(m.elementSize <= SETS_PACKED_MAX_SIZE){
+        packedE = Sets_packElement(e, m.elementSize);
+        for(i = 0; i<m.nbFocals; i++){
+            if(m.focals[i].element.card > 0){
+                proba += m.focals[i].beliefValue * Sets_packedCard(Sets_packedConjunction(
+                        Sets_packElement(m.focals[i].element, m.elementSize), packedE)) / m.focals[i].element.card;
+            }
+        }
+        return proba;
+    }
+    
+    /*Multi-word elements for large frames (e first, then the current focal): */
+    if(nbWords > SETS_WIDE_STACK_WORDS){
+        words = malloc(sizeof(uint64_t) * 2 * nbWords);
+        DEBUG_CHECK_MALLOC_OR_RETURN(words, 0);
+    }
+    Sets_packWords(words, e, m.elementSize);
+    for(i = 0; i<m.nbFocals; i++){
+        if(m.focals[i].element.card > 0){
+            Sets_packWords(words + nbWords, m.focals[i].element, m.elementSize);
+            proba += m.focals[i].beliefValue * Sets_wordsConjunctionCard(words, words + nbWords, nbWords) / m.focals[i].element.card;
+        }
+    }
+    if(words != stackWords){
+        free(words);
+    }
+
+    return proba;
+}
+
+
+
+int BF_measures(const BF_BeliefFunction m, const Sets_Element* elements, const int nbElements,
+        BF_Mass* bel, BF_Mass* pl, BF_Mass* q, BF_Mass* betP){
+    if(nbElements <= 0){
+        return 1;
+    }
+    if(m.elementSize <= SETS_PACKED_MAX_SIZE){
+        return measuresOfIds(m, elements, NULL, nbElements, bel, pl, q, betP);
+    }
+
+    return measuresOfWords(m, elements, nbElements, bel, pl, q, betP);
+}
+
+
+
+int BF_measuresOfIds(const BF_BeliefFunction m, const Sets_PackedElement* ids, const int nbIds,
+        BF_Mass* bel, BF_Mass* pl, BF_Mass* q, BF_Mass* betP){
+    if(nbIds <= 0){
+        return 1;
+    }
+
+    return measuresOfIds(m, NULL, ids, nbIds, bel, pl, q, betP);
+}
+
+
+/** @} */
+
+
+
+/**
+ * @name Function-dependant operations
+ * @{
+ */
+
+
+
+
+float BF_specificity(const BF_BeliefFunction m){
+    float spec = 0;
+    int i = 0;
+    
+    /*Computation: */
+    for(i = 0; i<m.nbFocals; i++){
+        if(m.focals[i].element.card > 0){
+            spec += m.focals[i].beliefValue / m.focals[i].element.card;
+        }
+    }
+
+    return spec;
+}
+
+
+
+float BF_nonSpecificity(const BF_BeliefFunction m){
+    float nonSpe = 0;
+    int i = 0;
+   	
+    /*Computation: */
+    for(i = 0; i<m.nbFocals; i++){
+        if(m.focals[i].element.card > 0){
+            nonSpe += m.focals[i].beliefValue * log(m.focals[i].element.card) / log(2);
+        }
+    }
+    
+    return nonSpe;
+}
+
+
+
+float BF_discrepancy(const BF_BeliefFunction m){
+    float disc = 0;
+    int i = 0;
+    /*The focals are packed once for all the pignistic probabilities: */
+    BF_CompactBeliefFunction compact = BF_toCompactBeliefFunction(m);
+
+    for(i = 0; i<m.nbFocals; i++){
+        disc -= m.focals[i].beliefValue * log(BF_compactBetP(compact, m.focals[i].element)) / log(2);
+    }
+    BF_freeCompactBeliefFunction(&compact);
+
+    return disc;
+}
+
+
+
+float BF_distance(const BF_BeliefFunction m1, const BF_BeliefFunction m2){
+    float dist = 0, temp = 0, jaccard = 0;
+    int i = 0, j = 0, conjCard = 0, nbWords = SETS_WIDE_NB_WORDS(m1.elementSize);
+    BF_BeliefFunction diff;
+    BF_CompactBeliefFunction compact;
+    /*Sets_Element emptySet, conj, disj;*/
+	
+	#ifdef CHECK_COMPATIBILITY
+    if(m1.elementSize != m2.elementSize){
+    	printf("debug: in BF_distance(), the two mass functions aren't defined on the same frame...\n");
+    }
+    #endif
+	
+    /*Get void: */
+    /*emptySet = Sets_getEmptyElement(m1.elementSize); */
+
+    /*Get differences between the two functions: */
+    diff = BF_difference(m1, m2);
+
+    /*Compact form to intersect the focals on words: */
+    compact = BF_toCompactBeliefFunction(diff);
+
+    /*Compute the distance, one row of the Jaccard matrix at a time (never stored): */
+    for(i = 0; i<diff.nbFocals; i++){
+        temp = 0;
+        for(j = 0; j<diff.nbFocals; j++){
+            /*if(!Sets_equals(diff.focals[i].element, emptySet, m1.elementSize) || !Sets_equals(diff.focals[j].element, emptySet, m1.elementSize)){ */
+            if(diff.focals[i].element.card > 0 || diff.focals[j].element.card > 0){
+                /*|A u B| = |A| + |B| - |A n B|: */
+                conjCard = Sets_wordsConjunctionCard(compact.elementBits + (size_t)i * nbWords, compact.elementBits + (size_t)j * nbWords, nbWords);
+                jaccard = (float)conjCard / (float)(diff.focals[i].element.card + diff.focals[j].element.card - conjCard);
+            }
+            else {
+                jaccard = 1;
+            }
+            temp += diff.focals[j].beliefValue * jaccard;
+        }
+        dist += temp * diff.focals[i].beliefValue;
+    }
+    dist = sqrt(0.5 * dist);
+
+    /*Deallocate: */
+    BF_freeCompactBeliefFunction(&compact);
+    /*Sets_freeElement(&emptySet); */
+    BF_freeBeliefFunction(&diff);
+
+    return dist;
+}
+
+
+
+float BF_distanceInContext(const BF_BeliefFunction m1, const BF_BeliefFunction m2, const Sets_Context* ctx){
+    float dist = 0, temp = 0;
+    int i = 0, j = 0;
+    BF_BeliefFunction diff;
+    Sets_PackedElement* ids = NULL;
+
+    /*The coefficients are computed on packed elements: */
+    if(ctx->elementSize > SETS_PACKED_MAX_SIZE){
+        return BF_distance(m1, m2);
+    }
+
+    #ifdef CHECK_COMPATIBILITY
+    if(m1.elementSize != ctx->elementSize || m2.elementSize != ctx->elementSize){
+    	printf("debug: in BF_distanceInContext(), the two mass functions aren't defined on the frame of the context...\n");
+    }
+    #endif
+
+    /*Get differences between the two functions: */
+    diff = BF_difference(m1, m2);
+    ids = malloc(sizeof(Sets_PackedElement) * diff.nbFocals);
+    DEBUG_CHECK_MALLOC_OR_RETURN(ids, 0);
+
+    for(i = 0; i<diff.nbFocals; i++){
+        ids[i] = Sets_packElement(diff.focals[i].element, ctx->elementSize);
+    }
+
+    /*Compute the distance (same order of operations as BF_distance()): */
+    for(i = 0; i<diff.nbFocals; i++){
+        temp = 0;
+        for(j = 0; j<diff.nbFocals; j++){
+            temp += diff.focals[j].beliefValue * Sets_jaccardInContext(ctx, ids[i], ids[j]);
+        }
+        dist += temp * diff.focals[i].beliefValue;
+    }
+    dist = sqrt(0.5 * dist);
+
+    /*Deallocate: */
+    free(ids);
+    BF_freeBeliefFunction(&diff);
+
+    return dist;
+}
+
+
+
+float* BF_distanceMatrix(const BF_BeliefFunction* m, const int nbM, const Sets_Context* ctx){
+    float* distances = NULL;
+    double *vectors = NULL, *products = NULL, *self = NULL;
+    int i = 0, k = 0, nbBasis = 0;
+
+    #ifdef CHECK_COMPATIBILITY
+    for(i = 1; i < nbM; i++){
+    	if(m[i].elementSize != m[0].elementSize){
+    		printf("debug: in BF_distanceMatrix(), at least one mass function is not compatible with others...\n");
+    	}
+    }
+    #endif
+
+    distances = calloc((size_t)nbM * nbM + 1, sizeof(float));
+    DEBUG_CHECK_MALLOC_OR_RETURN(distances, NULL);
+    if(nbM <= 0){
+        return distances;
+    }
+
+    /*Project all the functions on the same basis: */
+    nbBasis = projectOnFocals(m, nbM, ctx, &vectors, &products);
+    if(nbBasis < 0){
+        for(i = 0; i < nbM; i++){
+            for(k = 0; k < nbM; k++){
+                distances[(size_t)i * nbM + k] = BF_distance(m[i], m[k]);
+            }
+        }
+        return distances;
+    }
+    self = malloc(sizeof(double) * nbM);
+    DEBUG_CHECK_MALLOC(self);
+
+    for(i = 0; i < nbM; i++){
+        self[i] = dotProduct(vectors + (size_t)i * nbBasis, products + (size_t)i * nbBasis, nbBasis);
+    }
+    /*The matrix is symmetric with a null diagonal: */
+    for(i = 0; i < nbM; i++){
+        for(k = i + 1; k < nbM; k++){
+            distances[(size_t)i * nbM + k] = distanceOnFocals(vectors, products, self, nbBasis, i, k);
+            distances[(size_t)k * nbM + i] = distances[(size_t)i * nbM + k];
         }
-        /*Transfer the lost belief on complete: */
-        discounted.focals[m.nbFocals].element = Sets_copyElement(complete, m.elementSize);
-        discounted.focals[m.nbFocals].beliefValue = realAlpha;
     }
 
     /*Deallocate: */
-    Sets_freeElement(&complete);
+    free(self);
+    free(vectors);
+    free(products);
+
+    return distances;
+}
+
+
+
+float BF_globalDistance(const BF_BeliefFunction m, const BF_BeliefFunction* s, const int nbBF){
+    float conflict = 0;
+    int i = 0; 
+    
+    #ifdef CHECK_COMPATIBILITY
+    int size = m.elementSize;
+    for(i = 0; i < nbBF; i++){
+    	if(s[i].elementSize != size){
+    		printf("debug: in BF_globalDistance(), at least one mass function is not compatible with others...\n");
+    	}
+    }
+    #endif
+	
+    for(i = 0; i<nbBF; i++){
+        conflict += BF_distance(m, s[i]);
+    }
+    conflict /= (nbBF - 1);
+
+    return conflict;
+}
 
-    #ifdef CHECK_SUM
-    if(BF_checkSum(discounted)){
-        printf("debug: in BF_discounting(), the sum is not equal to 1.\ndebug: There may be a problem in the model.\n");
-        printf("debug: alpha = %f\n", alpha);
+
+
+float BF_similarity(const BF_BeliefFunction m1, const BF_BeliefFunction m2){
+    #ifdef CHECK_COMPATIBILITY
+    if(m1.elementSize != m2.elementSize){
+    	printf("debug: in BF_distance(), the two mass functions aren't defined on the same frame...\n");
     }
     #endif
-    #ifdef CHECK_VALUES 
-    if(BF_checkValues(discounted)){
-    	printf("debug: in BF_discounting(), at least one value is not valid!\n");
-    	printf("debug: alpha = %f\n", alpha);
+    
+    return similarityOf(BF_distance(m1,m2));
+}
+
+
+
+float BF_support(const BF_BeliefFunction ref, const BF_BeliefFunction* m, const int nbM){
+    float sup = 0;
+    int i = 0; 
+    
+    #ifdef CHECK_COMPATIBILITY
+    int size = ref.elementSize;
+    for(i = 0; i < nbM; i++){
+    	if(m[i].elementSize != size){
+    		printf("debug: in BF_support(), at least one mass function is not compatible with others...\n");
+    	}
     }
     #endif
 
-    return discounted;
+    for(i = 0; i<nbM; i++){
+        sup += BF_similarity(ref, m[i]);
+    }
+
+    return (sup-1);
 }
 
 
 
-BF_BeliefFunction BF_difference(const BF_BeliefFunction m1, const BF_BeliefFunction m2){
-    BF_BeliefFunction diff = {NULL, 0, 0};
+float* BF_supports(const BF_BeliefFunction* m, const int nbM){
+    float* supports = NULL;
+    float* distances = NULL;
+    int i = 0, k = 0;
+
+    supports = malloc(sizeof(float) * (nbM + 1));
+    DEBUG_CHECK_MALLOC_OR_RETURN(supports, NULL);
+    distances = BF_distanceMatrix(m, nbM, NULL);
+    if(distances == NULL){
+        free(supports);
+        return NULL;
+    }
+
+    for(i = 0; i<nbM; i++){
+        supports[i] = 0;
+        for(k = 0; k<nbM; k++){
+            supports[i] += similarityOf(distances[(size_t)i * nbM + k]);
+        }
+        supports[i] -= 1;
+    }
+    free(distances);
+
+    return supports;
+}
+
+
+
+int BF_checkSum(const BF_BeliefFunction m){
+    double sum = 0;
     int i = 0;
-    Sets_Set values = {NULL, 0};
 
-	#ifdef CHECK_COMPATIBILITY
-    if(m1.elementSize != m2.elementSize){
-    	printf("debug: in BF_difference(), the two mass functions aren't defined on the same frame...\n");
+    for(i = 0; i<m.nbFocals; i++){
+        sum += m.focals[i].beliefValue;
+    }
+
+    if(!(1 - BF_PRECISION < sum && sum < 1 + BF_PRECISION)){
+        printf("debug: Sum problem: %f\n", sum);
+    }
+
+    /*Take into account the precision of the computations... */
+    return !(1 - BF_PRECISION < sum && sum < 1 + BF_PRECISION); /*(sum != 1);*/
+}
+
+
+
+int BF_checkValues(const BF_BeliefFunction m){
+	int okay = 0;
+	int i = 0;
+	int problemIndex = 0;
+	
+	for(i = 0; i < m.nbFocals; i++){
+		okay = okay || (m.focals[i].beliefValue < 0 || m.focals[i].beliefValue > 1 + BF_PRECISION);
+		if(m.focals[i].beliefValue < 0 || m.focals[i].beliefValue > 1 + BF_PRECISION){
+			problemIndex = i;
+		}
+	}
+	
+	if(okay){
+		printf("debug: Value problem!\n");
+		printf("m(%s) = %f\n", m.focals[problemIndex].element.values, m.focals[problemIndex].beliefValue);
+	}
+	
+	return okay;
+}
+
+
+
+/** @} */
+
+
+
+
+/**
+ * @name Belief functions with element ids
+ * @{
+ */
+
+BF_PackedBeliefFunction BF_packBeliefFunction(const BF_BeliefFunction m){
+    BF_PackedBeliefFunction packed = {NULL, 0, 0};
+    int i = 0;
+
+    #ifdef CHECK_VALUES
+    if(m.elementSize > SETS_PACKED_MAX_SIZE){
+        printf("debug: in BF_packBeliefFunction(), the frame has %d atoms, ids are only available up to %d atoms.\n", m.elementSize, SETS_PACKED_MAX_SIZE);
     }
     #endif
 
-    /*Get the set of values to considerate: */
-    values.elements = malloc(sizeof(Sets_Element) * (m1.nbFocals + m2.nbFocals));
-    DEBUG_CHECK_MALLOC(values.elements);
+    packed.elementSize = m.elementSize;
+    packed.nbFocals = m.nbFocals;
+    packed.focals = malloc(sizeof(BF_PackedFocalElement) * m.nbFocals);
+    DEBUG_CHECK_MALLOC_OR_RETURN(packed.focals, packed);
 
-    for(i = 0; i<m1.nbFocals; i++){
-        values.elements[i] = Sets_copyElement(m1.focals[i].element, m1.elementSize);
-        values.card++;
+    for(i = 0; i < m.nbFocals; i++){
+        packed.focals[i].element = Sets_packElement(m.focals[i].element, m.elementSize);
+        packed.focals[i].beliefValue = m.focals[i].beliefValue;
     }
-    for(i = 0; i<m2.nbFocals; i++){
-        if(!Sets_isMember(m2.focals[i].element, values, m1.elementSize)){
-            values.elements[values.card] = Sets_copyElement(m2.focals[i].element, m1.elementSize);
-            values.card++;
+
+    return packed;
+}
+
+
+
+BF_BeliefFunction BF_unpackBeliefFunction(const BF_PackedBeliefFunction m){
+    BF_BeliefFunction unpacked = {NULL, 0, 0};
+    int i = 0;
+
+    unpacked.elementSize = m.elementSize;
+    unpacked.nbFocals = m.nbFocals;
+    unpacked.focals = malloc(sizeof(BF_FocalElement) * m.nbFocals);
+    DEBUG_CHECK_MALLOC_OR_RETURN(unpacked.focals, unpacked);
+
+    for(i = 0; i < m.nbFocals; i++){
+        unpacked.focals[i].element = Sets_unpackElement(m.focals[i].element, m.elementSize);
+        unpacked.focals[i].beliefValue = m.focals[i].beliefValue;
+    }
+
+    return unpacked;
+}
+
+
+
+void BF_sortPackedBeliefFunction(BF_PackedBeliefFunction* m){
+    qsort(m->focals, m->nbFocals, sizeof(BF_PackedFocalElement), comparePackedFocals);
+}
+
+
+
+BF_Mass BF_packedM(const BF_PackedBeliefFunction m, const Sets_PackedElement e){
+    int i = 0;
+
+    for(i = 0; i < m.nbFocals; i++){
+        if(m.focals[i].element == e){
+            return m.focals[i].beliefValue;
         }
     }
-    /*Allocation: */
-    diff.nbFocals = values.card;
-    diff.focals = malloc(sizeof(BF_FocalElement) * values.card);
-    DEBUG_CHECK_MALLOC(diff.focals);
 
-	diff.elementSize = m1.elementSize;
-    /*Get the differences: */
-    for(i = 0; i<values.card; i++){
-        diff.focals[i].element = Sets_copyElement(values.elements[i], m1.elementSize);
-        diff.focals[i].beliefValue = BF_m(m1, values.elements[i]) - BF_m(m2, values.elements[i]);
+    return 0;
+}
+
+
+
+BF_Mass BF_packedBel(const BF_PackedBeliefFunction m, const Sets_PackedElement e){
+    BF_Mass cred = 0;
+    int i = 0;
+
+    for(i = 0; i < m.nbFocals; i++){
+        if(m.focals[i].element != 0 && Sets_packedIsSubset(m.focals[i].element, e)){
+            cred += m.focals[i].beliefValue;
+        }
     }
-    /*Deallocation: */
-    Sets_freeSet(&values);
 
-    return diff;
+    return cred;
+}
+
+
+
+BF_Mass BF_packedPl(const BF_PackedBeliefFunction m, const Sets_PackedElement e){
+    BF_Mass plaus = 0;
+    int i = 0;
+
+    for(i = 0; i < m.nbFocals; i++){
+        if(Sets_packedConjunction(m.focals[i].element, e) != 0){
+            plaus += m.focals[i].beliefValue;
+        }
+    }
+
+    return plaus;
+}
+
+
+
+BF_Mass BF_packedQ(const BF_PackedBeliefFunction m, const Sets_PackedElement e){
+    BF_Mass common = 0;
+    int i = 0;
+
+    for(i = 0; i < m.nbFocals; i++){
+        if(Sets_packedIsSubset(e, m.focals[i].element)){
+            common += m.focals[i].beliefValue;
+        }
+    }
+
+    return common;
+}
+
+
+
+BF_Mass BF_packedBetP(const BF_PackedBeliefFunction m, const Sets_PackedElement e){
+    BF_Mass proba = 0;
+    int i = 0;
+
+    for(i = 0; i < m.nbFocals; i++){
+        if(m.focals[i].element != 0){
+            proba += m.focals[i].beliefValue * Sets_packedCard(Sets_packedConjunction(m.focals[i].element, e))
+                    / Sets_packedCard(m.focals[i].element);
+        }
+    }
+
+    return proba;
+}
+
+/** @} */
+
+
+
+
+/**
+ * @name Dense belief functions
+ * @{
+ */
+
+int BF_preferDenseForm(const int elementSize, const int nbFocals){
+    return elementSize <= BF_DENSE_MAX_SIZE && (1 << elementSize) / BF_DENSE_MIN_DENSITY <= nbFocals;
 }
 
 
 
-/** @} */
+BF_DenseBeliefFunction BF_toDenseBeliefFunction(const BF_BeliefFunction m){
+    BF_DenseBeliefFunction dense = {NULL, 0};
+    int i = 0;
+
+    dense.elementSize = m.elementSize;
+    if(m.elementSize > BF_DENSE_MAX_SIZE){
+        #ifdef CHECK_VALUES
+        printf("debug: in BF_toDenseBeliefFunction(), the frame has %d atoms, dense belief functions are only available up to %d atoms.\n", m.elementSize, BF_DENSE_MAX_SIZE);
+        #endif
+        return dense;
+    }
+
+    dense.values = calloc(1 << m.elementSize, sizeof(BF_Mass));
+    DEBUG_CHECK_MALLOC_OR_RETURN(dense.values, dense);
+
+    for(i = 0; i < m.nbFocals; i++){
+        dense.values[Sets_packElement(m.focals[i].element, m.elementSize)] += m.focals[i].beliefValue;
+    }
+
+    return dense;
+}
+
+
+
+BF_BeliefFunction BF_toSparseBeliefFunction(const BF_DenseBeliefFunction m){
+    BF_BeliefFunction sparse = {NULL, 0, 0};
+    int nbSubsets = 1 << m.elementSize;
+    int i = 0;
+
+    sparse.elementSize = m.elementSize;
+    for(i = 0; i < nbSubsets; i++){
+        if(m.values[i] != 0){
+            sparse.nbFocals++;
+        }
+    }
+    sparse.focals = malloc(sizeof(BF_FocalElement) * sparse.nbFocals);
+    DEBUG_CHECK_MALLOC_OR_RETURN(sparse.focals, sparse);
+
+    sparse.nbFocals = 0;
+    for(i = 0; i < nbSubsets; i++){
+        if(m.values[i] != 0){
+            sparse.focals[sparse.nbFocals].element = Sets_unpackElement((Sets_PackedElement)i, m.elementSize);
+            sparse.focals[sparse.nbFocals].beliefValue = m.values[i];
+            sparse.nbFocals++;
+        }
+    }
+
+    return sparse;
+}
+
+
+
+BF_DenseBeliefFunction BF_copyDenseBeliefFunction(const BF_DenseBeliefFunction m){
+    BF_DenseBeliefFunction copy = {NULL, 0};
+
+    copy.elementSize = m.elementSize;
+    copy.values = malloc(sizeof(BF_Mass) * (1 << m.elementSize));
+    DEBUG_CHECK_MALLOC_OR_RETURN(copy.values, copy);
+    memcpy(copy.values, m.values, sizeof(BF_Mass) * (1 << m.elementSize));
+
+    return copy;
+}
+
+
+
+void BF_denseNormalize(BF_DenseBeliefFunction* m){
+    int nbSubsets = 1 << m->elementSize;
+    double sum = 0;
+    int i = 0;
+
+    for(i = 0; i < nbSubsets; i++){
+        sum += m->values[i];
+    }
+
+    if(sum != 1){
+        for(i = 0; i < nbSubsets; i++){
+            m->values[i] /= sum;
+        }
+    }
+}
+
+
+
+BF_DenseBeliefFunction BF_denseWeakening(const BF_DenseBeliefFunction m, const float alpha){
+    BF_DenseBeliefFunction weakened = {NULL, 0};
+    int nbSubsets = 1 << m.elementSize;
+    double sum = 0;
+    BF_Mass realAlpha = 0;
+    int i = 0;
+
+    if(alpha >= 1){
+        realAlpha = 1;
+    }
+    else {
+        realAlpha = alpha;
+    }
+
+    weakened.elementSize = m.elementSize;
+    weakened.values = malloc(sizeof(BF_Mass) * nbSubsets);
+    DEBUG_CHECK_MALLOC_OR_RETURN(weakened.values, weakened);
+
+    /*Weaken the believes on elements:*/
+    for(i = 1; i < nbSubsets; i++){
+        weakened.values[i] = m.values[i] * (1 - realAlpha);
+        sum += weakened.values[i];
+    }
+    /*Transfer the lost belief on void:*/
+    weakened.values[0] = m.values[0] != 0 ? 1 - sum : realAlpha;
+
+    return weakened;
+}
+
+
+
+BF_DenseBeliefFunction BF_denseDiscounting(const BF_DenseBeliefFunction m, const float alpha){
+    BF_DenseBeliefFunction discounted = {NULL, 0};
+    int nbSubsets = 1 << m.elementSize;
+    double sum = 0;
+    BF_Mass realAlpha = 0;
+    int i = 0;
+
+    if(alpha >= 1){
+        realAlpha = 1;
+    }
+    else if(alpha <= 0){
+        realAlpha = 0;
+    }
+    else {
+        realAlpha = alpha;
+    }
+
+    discounted.elementSize = m.elementSize;
+    discounted.values = malloc(sizeof(BF_Mass) * nbSubsets);
+    DEBUG_CHECK_MALLOC_OR_RETURN(discounted.values, discounted);
 
+    /*Discount the believes on elements:*/
+    for(i = 0; i < nbSubsets - 1; i++){
+        discounted.values[i] = m.values[i] * (1 - realAlpha);
+        sum += discounted.values[i];
+    }
+    /*Transfer the lost belief on complete:*/
+    discounted.values[nbSubsets - 1] = m.values[nbSubsets - 1] != 0 ? 1 - sum : realAlpha;
 
+    return discounted;
+}
 
-/**
- * @name Function-and-element-dependant operations
- * @{
- */
 
-float BF_m(const BF_BeliefFunction m, const Sets_Element e){
-    int i = 0;
 
-    for(i = 0; i<m.nbFocals; i++){
-        if(Sets_equals(e, m.focals[i].element, m.elementSize)){
-            return m.focals[i].beliefValue;
-        }
-    }
-    return 0;
+BF_Mass BF_denseM(const BF_DenseBeliefFunction m, const Sets_PackedElement e){
+    return m.values[e];
 }
 
 
 
-float BF_bel(const BF_BeliefFunction m, const Sets_Element e){
-    float cred = 0;
-    int i = 0;
-    
-    /*Compute: */
-    for(i = 0; i<m.nbFocals; i++){
-        if(Sets_isSubset(m.focals[i].element, e, m.elementSize) && m.focals[i].element.card > 0){
-            cred += m.focals[i].beliefValue;
-        }
+BF_Mass BF_denseBel(const BF_DenseBeliefFunction m, const Sets_PackedElement e){
+    Sets_PackedElement sub = e;
+    BF_Mass cred = 0;
+
+    /*All the non-empty subsets of e:*/
+    while(sub != 0){
+        cred += m.values[sub];
+        sub = (sub - 1) & e;
     }
 
     return cred;
@@ -465,32 +2302,31 @@ float BF_bel(const BF_BeliefFunction m, const Sets_Element e){
 
 
 
-float BF_pl(const BF_BeliefFunction m, const Sets_Element e){
-    float plaus = 0;
+BF_Mass BF_densePl(const BF_DenseBeliefFunction m, const Sets_PackedElement e){
+    int nbSubsets = 1 << m.elementSize;
+    BF_Mass plaus = 0;
     int i = 0;
-    Sets_Element conj;
 
-    /*Compute: */
-    for(i = 0; i<m.nbFocals; i++){
-        conj = Sets_conjunction(m.focals[i].element, e, m.elementSize);
-        if(conj.card > 0){
-            plaus += m.focals[i].beliefValue;
+    for(i = 1; i < nbSubsets; i++){
+        if(Sets_packedConjunction((Sets_PackedElement)i, e) != 0){
+            plaus += m.values[i];
         }
-        Sets_freeElement(&conj);
     }
+
     return plaus;
 }
 
 
 
-float BF_q(const BF_BeliefFunction m, const Sets_Element e){
-    float common = 0;
-    int i = 0;
+BF_Mass BF_denseQ(const BF_DenseBeliefFunction m, const Sets_PackedElement e){
+    Sets_PackedElement others = Sets_packedOpposite(e, m.elementSize);
+    Sets_PackedElement sub = others;
+    BF_Mass common = m.values[e];
 
-    for(i = 0; i<m.nbFocals; i++){
-        if(Sets_isSubset(e, m.focals[i].element, m.elementSize)){
-            common += m.focals[i].beliefValue;
-        }
+    /*All the supersets of e (e plus a non-empty subset of the other atoms):*/
+    while(sub != 0){
+        common += m.values[e | sub];
+        sub = (sub - 1) & others;
     }
 
     return common;
@@ -498,255 +2334,358 @@ float BF_q(const BF_BeliefFunction m, const Sets_Element e){
 
 
 
-float BF_betP(const BF_BeliefFunction m, const Sets_Element e){
-    float proba = 0;
+BF_Mass BF_denseBetP(const BF_DenseBeliefFunction m, const Sets_PackedElement e){
+    int nbSubsets = 1 << m.elementSize;
+    BF_Mass proba = 0;
     int i = 0;
-    Sets_Element conj;
-    
-    /*Compute: */
-    for(i = 0; i<m.nbFocals; i++){
-        if(m.focals[i].element.card > 0){
-            conj = Sets_conjunction(e, m.focals[i].element, m.elementSize);
-            proba += m.focals[i].beliefValue * conj.card / m.focals[i].element.card;
-            Sets_freeElement(&conj);
+
+    for(i = 1; i < nbSubsets; i++){
+        if(m.values[i] != 0){
+            proba += m.values[i] * Sets_packedCard(Sets_packedConjunction((Sets_PackedElement)i, e))
+                    / Sets_packedCard((Sets_PackedElement)i);
         }
     }
 
     return proba;
 }
 
-
 /** @} */
 
 
 
+
 /**
- * @name Function-dependant operations
+ * @name Transforms of dense belief functions
  * @{
  */
 
+BF_DenseBeliefFunction BF_denseImplicabilities(const BF_DenseBeliefFunction m){
+    double* values = toDoubles(m);
+    DEBUG_CHECK_MALLOC_OR_RETURN(values, fromDoubles(NULL, m.elementSize));
+
+    subsetsTransform(values, m.elementSize, 1);
 
+    return fromDoubles(values, m.elementSize);
+}
 
 
-float BF_specificity(const BF_BeliefFunction m){
-    float spec = 0;
+
+BF_DenseBeliefFunction BF_denseCredibilities(const BF_DenseBeliefFunction m){
+    double* values = toDoubles(m);
+    DEBUG_CHECK_MALLOC_OR_RETURN(values, fromDoubles(NULL, m.elementSize));
+
+    /*The void element is not taken into account:*/
+    values[0] = 0;
+    subsetsTransform(values, m.elementSize, 1);
+
+    return fromDoubles(values, m.elementSize);
+}
+
+
+
+BF_DenseBeliefFunction BF_densePlausibilities(const BF_DenseBeliefFunction m){
+    int nbSubsets = 1 << m.elementSize;
+    double* values = toDoubles(m);
+    double* plaus = NULL;
     int i = 0;
-    
-    /*Computation: */
-    for(i = 0; i<m.nbFocals; i++){
-        if(m.focals[i].element.card > 0){
-            spec += m.focals[i].beliefValue / m.focals[i].element.card;
-        }
+    DEBUG_CHECK_MALLOC_OR_RETURN(values, fromDoubles(NULL, m.elementSize));
+    plaus = malloc(sizeof(double) * nbSubsets);
+    DEBUG_CHECK_MALLOC_OR_RETURN(plaus, fromDoubles(NULL, m.elementSize));
+
+    /*pl(A) = b(complete) - b(not A):*/
+    subsetsTransform(values, m.elementSize, 1);
+    for(i = 0; i < nbSubsets; i++){
+        plaus[i] = values[nbSubsets - 1] - values[(nbSubsets - 1) ^ i];
     }
+    free(values);
 
-    return spec;
+    return fromDoubles(plaus, m.elementSize);
 }
 
 
 
-float BF_nonSpecificity(const BF_BeliefFunction m){
-    float nonSpe = 0;
-    int i = 0;
-   	
-    /*Computation: */
-    for(i = 0; i<m.nbFocals; i++){
-        if(m.focals[i].element.card > 0){
-            nonSpe += m.focals[i].beliefValue * log(m.focals[i].element.card) / log(2);
+BF_DenseBeliefFunction BF_denseCommonalities(const BF_DenseBeliefFunction m){
+    double* values = toDoubles(m);
+    DEBUG_CHECK_MALLOC_OR_RETURN(values, fromDoubles(NULL, m.elementSize));
+
+    supersetsTransform(values, m.elementSize, 1);
+
+    return fromDoubles(values, m.elementSize);
+}
+
+
+
+BF_DenseBeliefFunction BF_densePignisticProbabilities(const BF_DenseBeliefFunction m){
+    int nbSubsets = 1 << m.elementSize;
+    double* atoms = NULL;
+    double* proba = NULL;
+    int i = 0, j = 0;
+
+    atoms = calloc(m.elementSize + 1, sizeof(double));
+    DEBUG_CHECK_MALLOC_OR_RETURN(atoms, fromDoubles(NULL, m.elementSize));
+    proba = malloc(sizeof(double) * nbSubsets);
+    DEBUG_CHECK_MALLOC_OR_RETURN(proba, fromDoubles(NULL, m.elementSize));
+
+    /*Share the mass of each focal element between its atoms:*/
+    for(i = 1; i < nbSubsets; i++){
+        if(m.values[i] != 0){
+            for(j = 0; j < m.elementSize; j++){
+                if(i & (1 << j)){
+                    atoms[j] += (double)m.values[i] / Sets_packedCard((Sets_PackedElement)i);
+                }
+            }
         }
     }
-    
-    return nonSpe;
+    /*betP(A) = betP(A without its first atom) + betP(first atom):*/
+    proba[0] = 0;
+    for(i = 1; i < nbSubsets; i++){
+        for(j = 0; !(i & (1 << j)); j++);
+        proba[i] = proba[i & (i - 1)] + atoms[j];
+    }
+    free(atoms);
+
+    return fromDoubles(proba, m.elementSize);
 }
 
 
 
-float BF_discrepancy(const BF_BeliefFunction m){
-    float disc = 0;
+BF_DenseBeliefFunction BF_denseMassesFromImplicabilities(const BF_DenseBeliefFunction b){
+    double* values = toDoubles(b);
+    DEBUG_CHECK_MALLOC_OR_RETURN(values, fromDoubles(NULL, b.elementSize));
+
+    subsetsTransform(values, b.elementSize, -1);
+
+    return fromDoubles(values, b.elementSize);
+}
+
+
+
+BF_DenseBeliefFunction BF_denseMassesFromCredibilities(const BF_DenseBeliefFunction bel){
+    int nbSubsets = 1 << bel.elementSize;
+    double* values = toDoubles(bel);
+    double voidMass = 0;
     int i = 0;
+    DEBUG_CHECK_MALLOC_OR_RETURN(values, fromDoubles(NULL, bel.elementSize));
 
-    for(i = 0; i<m.nbFocals; i++){
-        disc -= m.focals[i].beliefValue * log(BF_betP(m, m.focals[i].element)) / log(2);
+    /*b(A) = bel(A) + m(void):*/
+    voidMass = 1 - values[nbSubsets - 1];
+    for(i = 0; i < nbSubsets; i++){
+        values[i] += voidMass;
     }
+    values[0] = voidMass;
+    subsetsTransform(values, bel.elementSize, -1);
 
-    return disc;
+    return fromDoubles(values, bel.elementSize);
 }
 
 
 
-float BF_distance(const BF_BeliefFunction m1, const BF_BeliefFunction m2){
-    float dist = 0;
-    float *temp = NULL;
-    float **matrix = NULL;
-    int i = 0, j = 0;
-    BF_BeliefFunction diff;
-    /*Sets_Element emptySet, conj, disj;*/
-    Sets_Element conj, disj;
-	
-	#ifdef CHECK_COMPATIBILITY
-    if(m1.elementSize != m2.elementSize){
-    	printf("debug: in BF_distance(), the two mass functions aren't defined on the same frame...\n");
+BF_DenseBeliefFunction BF_denseMassesFromPlausibilities(const BF_DenseBeliefFunction pl){
+    int nbSubsets = 1 << pl.elementSize;
+    double* values = NULL;
+    int i = 0;
+
+    values = malloc(sizeof(double) * nbSubsets);
+    DEBUG_CHECK_MALLOC_OR_RETURN(values, fromDoubles(NULL, pl.elementSize));
+
+    /*b(A) = 1 - pl(not A):*/
+    for(i = 0; i < nbSubsets; i++){
+        values[i] = 1 - (double)pl.values[(nbSubsets - 1) ^ i];
     }
-    #endif
-	
-    /*Get void: */
-    /*emptySet = Sets_getEmptyElement(m1.elementSize); */
+    subsetsTransform(values, pl.elementSize, -1);
 
-    /*Get differences between the two functions: */
-    diff = BF_difference(m1, m2);
+    return fromDoubles(values, pl.elementSize);
+}
 
-    /*Compute the matrix: */
-    matrix = malloc(sizeof(float*) * diff.nbFocals);
-    DEBUG_CHECK_MALLOC(matrix);
 
-    for(i = 0; i<diff.nbFocals; i++){
-        matrix[i] = malloc(sizeof(float) * diff.nbFocals);
-        DEBUG_CHECK_MALLOC(matrix);
 
-        for(j = 0; j<diff.nbFocals; j++){
-            /*if(!Sets_equals(diff.focals[i].element, emptySet, m1.elementSize) || !Sets_equals(diff.focals[j].element, emptySet, m1.elementSize)){ */
-            if(diff.focals[i].element.card > 0 || diff.focals[j].element.card > 0){
-                disj = Sets_disjunction(diff.focals[i].element, diff.focals[j].element, m1.elementSize);
-                conj = Sets_conjunction(diff.focals[i].element, diff.focals[j].element, m1.elementSize);
-                matrix[i][j] = (float)conj.card / (float)disj.card;
-                Sets_freeElement(&disj);
-                Sets_freeElement(&conj);
-            }
-            else {
-                matrix[i][j] = 1;
-            }
-        }
-    }
+BF_DenseBeliefFunction BF_denseMassesFromCommonalities(const BF_DenseBeliefFunction q){
+    double* values = toDoubles(q);
+    DEBUG_CHECK_MALLOC_OR_RETURN(values, fromDoubles(NULL, q.elementSize));
 
-    /*Compute the distance: */
-    temp = malloc(sizeof(float) * diff.nbFocals);
-    DEBUG_CHECK_MALLOC(temp);
+    supersetsTransform(values, q.elementSize, -1);
 
-    for(i = 0; i<diff.nbFocals; i++){
-        temp[i] = 0;
-        for(j = 0; j<diff.nbFocals; j++){
-            temp[i] += diff.focals[j].beliefValue * matrix[i][j];
-        }
+    return fromDoubles(values, q.elementSize);
+}
+
+/** @} */
+
+
+
+
+/**
+ * @name Compact belief functions
+ * @{
+ */
+
+BF_CompactBeliefFunction BF_toCompactBeliefFunction(const BF_BeliefFunction m){
+    BF_CompactBeliefFunction compact = {NULL, NULL, 0, 0};
+    int i = 0, nbWords = SETS_WIDE_NB_WORDS(m.elementSize);
+
+    compact.elementSize = m.elementSize;
+    if(m.nbFocals == 0){
+        return compact;
     }
-    for(i = 0; i<diff.nbFocals; i++){
-        dist += temp[i] * diff.focals[i].beliefValue;
+    compact.elementBits = malloc(compactBlockSize(m.nbFocals, m.elementSize));
+    DEBUG_CHECK_MALLOC_OR_RETURN(compact.elementBits, compact);
+    compact.masses = (BF_Mass*)(compact.elementBits + (size_t)nbWords * m.nbFocals);
+    compact.nbFocals = m.nbFocals;
+
+    for(i = 0; i < m.nbFocals; i++){
+        Sets_packWords(compact.elementBits + (size_t)i * nbWords, m.focals[i].element, m.elementSize);
+        compact.masses[i] = m.focals[i].beliefValue;
     }
-    dist = sqrt(0.5 * dist);
 
-    /*Deallocate: */
-    free(temp);
-    for(i = 0; i<diff.nbFocals; i++){
-        free(matrix[i]);
+    return compact;
+}
+
+
+
+BF_BeliefFunction BF_fromCompactBeliefFunction(const BF_CompactBeliefFunction m){
+    BF_BeliefFunction sparse = {NULL, 0, 0};
+    Sets_WideElement focal = {NULL, 0};
+    int i = 0, nbWords = SETS_WIDE_NB_WORDS(m.elementSize);
+
+    sparse.elementSize = m.elementSize;
+    sparse.focals = malloc(sizeof(BF_FocalElement) * m.nbFocals);
+    DEBUG_CHECK_MALLOC_OR_RETURN(sparse.focals, sparse);
+    sparse.nbFocals = m.nbFocals;
+
+    for(i = 0; i < m.nbFocals; i++){
+        focal.words = m.elementBits + (size_t)i * nbWords;
+        focal.card = Sets_wordsCard(focal.words, nbWords);
+        sparse.focals[i].element = Sets_elementFromWide(focal, m.elementSize);
+        sparse.focals[i].beliefValue = m.masses[i];
     }
-    free(matrix);
-    /*Sets_freeElement(&emptySet); */
-    BF_freeBeliefFunction(&diff);
 
-    return dist;
+    return sparse;
 }
 
 
 
-float BF_globalDistance(const BF_BeliefFunction m, const BF_BeliefFunction* s, const int nbBF){
-    float conflict = 0;
-    int i = 0; 
-    
-    #ifdef CHECK_COMPATIBILITY
-    int size = m.elementSize;
-    for(i = 0; i < nbBF; i++){
-    	if(s[i].elementSize != size){
-    		printf("debug: in BF_globalDistance(), at least one mass function is not compatible with others...\n");
-    	}
-    }
-    #endif
-	
-    for(i = 0; i<nbBF; i++){
-        conflict += BF_distance(m, s[i]);
+BF_CompactBeliefFunction BF_copyCompactBeliefFunction(const BF_CompactBeliefFunction m){
+    BF_CompactBeliefFunction copy = {NULL, NULL, 0, 0};
+
+    copy.elementSize = m.elementSize;
+    if(m.nbFocals == 0){
+        return copy;
     }
-    conflict /= (nbBF - 1);
+    copy.elementBits = malloc(compactBlockSize(m.nbFocals, m.elementSize));
+    DEBUG_CHECK_MALLOC_OR_RETURN(copy.elementBits, copy);
+    memcpy(copy.elementBits, m.elementBits, compactBlockSize(m.nbFocals, m.elementSize));
+    copy.masses = (BF_Mass*)(copy.elementBits + (size_t)SETS_WIDE_NB_WORDS(m.elementSize) * m.nbFocals);
+    copy.nbFocals = m.nbFocals;
 
-    return conflict;
+    return copy;
 }
 
 
 
-float BF_similarity(const BF_BeliefFunction m1, const BF_BeliefFunction m2){
-    #ifdef CHECK_COMPATIBILITY
-    if(m1.elementSize != m2.elementSize){
-    	printf("debug: in BF_distance(), the two mass functions aren't defined on the same frame...\n");
+BF_Mass BF_compactM(const BF_CompactBeliefFunction m, const Sets_Element e){
+    BF_Mass mass = 0;
+    int i = 0, nbWords = SETS_WIDE_NB_WORDS(m.elementSize);
+    uint64_t stackWords[SETS_WIDE_STACK_WORDS];
+    uint64_t* words = wordsOf(e, m.elementSize, stackWords);
+
+    for(i = 0; i < m.nbFocals && words != NULL; i++){
+        if(Sets_wordsEquals(m.elementBits + (size_t)i * nbWords, words, nbWords)){
+            mass = m.masses[i];
+            break;
+        }
     }
-    #endif
-    
-    return (0.5 * (cos(3.14159 * BF_distance(m1,m2) + 1)));
+    if(words != stackWords){
+        free(words);
+    }
+
+    return mass;
 }
 
 
 
-float BF_support(const BF_BeliefFunction ref, const BF_BeliefFunction* m, const int nbM){
-    float sup = 0;
-    int i = 0; 
-    
-    #ifdef CHECK_COMPATIBILITY
-    int size = ref.elementSize;
-    for(i = 0; i < nbM; i++){
-    	if(m[i].elementSize != size){
-    		printf("debug: in BF_support(), at least one mass function is not compatible with others...\n");
-    	}
-    }
-    #endif
+BF_Mass BF_compactBel(const BF_CompactBeliefFunction m, const Sets_Element e){
+    BF_Mass cred = 0;
+    int i = 0, nbWords = SETS_WIDE_NB_WORDS(m.elementSize);
+    uint64_t stackWords[SETS_WIDE_STACK_WORDS];
+    uint64_t* words = wordsOf(e, m.elementSize, stackWords);
+    const uint64_t* focal = NULL;
 
-    for(i = 0; i<nbM; i++){
-        sup += BF_similarity(ref, m[i]);
+    for(i = 0; i < m.nbFocals && words != NULL; i++){
+        focal = m.elementBits + (size_t)i * nbWords;
+        if(Sets_wordsIsSubset(focal, words, nbWords) && Sets_wordsCard(focal, nbWords) > 0){
+            cred += m.masses[i];
+        }
+    }
+    if(words != stackWords){
+        free(words);
     }
 
-    return (sup-1);
+    return cred;
 }
 
 
 
-int BF_checkSum(const BF_BeliefFunction m){
-    float sum = 0;
-    int i = 0;
+BF_Mass BF_compactPl(const BF_CompactBeliefFunction m, const Sets_Element e){
+    BF_Mass plaus = 0;
+    int i = 0, nbWords = SETS_WIDE_NB_WORDS(m.elementSize);
+    uint64_t stackWords[SETS_WIDE_STACK_WORDS];
+    uint64_t* words = wordsOf(e, m.elementSize, stackWords);
 
-    for(i = 0; i<m.nbFocals; i++){
-        sum += m.focals[i].beliefValue;
+    for(i = 0; i < m.nbFocals && words != NULL; i++){
+        if(Sets_wordsConjunctionCard(m.elementBits + (size_t)i * nbWords, words, nbWords) > 0){
+            plaus += m.masses[i];
+        }
     }
-
-    if(!(1 - BF_PRECISION < sum && sum < 1 + BF_PRECISION)){
-        printf("debug: Sum problem: %f\n", sum);
+    if(words != stackWords){
+        free(words);
     }
 
-    /*Take into account the precision of the computations... */
-    return !(1 - BF_PRECISION < sum && sum < 1 + BF_PRECISION); /*(sum != 1);*/
+    return plaus;
 }
 
 
 
-int BF_checkValues(const BF_BeliefFunction m){
-	int okay = 0;
-	int i = 0;
-	int problemIndex = 0;
-	
-	for(i = 0; i < m.nbFocals; i++){
-		okay = okay || (m.focals[i].beliefValue < 0 || m.focals[i].beliefValue > 1 + BF_PRECISION);
-		if(m.focals[i].beliefValue < 0 || m.focals[i].beliefValue > 1 + BF_PRECISION){
-			problemIndex = i;
-		}
-	}
-	
-	if(okay){
-		printf("debug: Value problem!\n");
-		printf("m(%s) = %f\n", m.focals[problemIndex].element.values, m.focals[problemIndex].beliefValue);
-	}
-	
-	return okay;
+BF_Mass BF_compactQ(const BF_CompactBeliefFunction m, const Sets_Element e){
+    BF_Mass common = 0;
+    int i = 0, nbWords = SETS_WIDE_NB_WORDS(m.elementSize);
+    uint64_t stackWords[SETS_WIDE_STACK_WORDS];
+    uint64_t* words = wordsOf(e, m.elementSize, stackWords);
+
+    for(i = 0; i < m.nbFocals && words != NULL; i++){
+        if(Sets_wordsIsSubset(words, m.elementBits + (size_t)i * nbWords, nbWords)){
+            common += m.masses[i];
+        }
+    }
+    if(words != stackWords){
+        free(words);
+    }
+
+    return common;
 }
 
 
 
-/** @} */
+BF_Mass BF_compactBetP(const BF_CompactBeliefFunction m, const Sets_Element e){
+    BF_Mass proba = 0;
+    int i = 0, card = 0, nbWords = SETS_WIDE_NB_WORDS(m.elementSize);
+    uint64_t stackWords[SETS_WIDE_STACK_WORDS];
+    uint64_t* words = wordsOf(e, m.elementSize, stackWords);
+    const uint64_t* focal = NULL;
 
+    for(i = 0; i < m.nbFocals && words != NULL; i++){
+        focal = m.elementBits + (size_t)i * nbWords;
+        card = Sets_wordsCard(focal, nbWords);
+        if(card > 0){
+            proba += m.masses[i] * Sets_wordsConjunctionCard(focal, words, nbWords) / card;
+        }
+    }
+    if(words != stackWords){
+        free(words);
+    }
 
+    return proba;
+}
 
+/** @} */
 
 
 
@@ -778,6 +2717,30 @@ void BF_freeBeliefPoint(BF_FocalElement  *bp){
 }
 
 
+
+void BF_freePackedBeliefFunction(BF_PackedBeliefFunction* m){
+    free(m->focals);
+    m->focals = NULL;
+    m->nbFocals = 0;
+}
+
+
+
+void BF_freeDenseBeliefFunction(BF_DenseBeliefFunction* m){
+    free(m->values);
+    m->values = NULL;
+}
+
+
+
+void BF_freeCompactBeliefFunction(BF_CompactBeliefFunction* m){
+    free(m->elementBits);
+    m->elementBits = NULL;
+    m->masses = NULL;
+    m->nbFocals = 0;
+}
+
+
 /** @} */
 
 
@@ -793,75 +2756,39 @@ void BF_freeBeliefPoint(BF_FocalElement  *bp){
 
 
 char* BF_beliefFunctionToString(const BF_BeliefFunction bf, const Sets_ReferenceList rl){
-    char *str = NULL, *elem = NULL;
-    char temp[MAX_STR_LEN];
-    int i = 0, totChar = 0;
+    StringBuffer buffer = StringBuffer_create(48 * (bf.nbFocals + 1));
 
-    /*Count the chars for the focals: */
-    for(i = 0; i<bf.nbFocals; i++){
-        elem = Sets_elementToString(bf.focals[i].element, rl);
-        sprintf(temp, "m(%s) = %f\n", elem, bf.focals[i].beliefValue);
-        totChar += strlen(temp);
-        free(elem);
-        elem = NULL;
-    }
-    /*Memory allocation: */
-    str = malloc(sizeof(char)*(totChar+1));
-    DEBUG_CHECK_MALLOC_OR_RETURN(str, NULL);
+    BF_appendBeliefFunction(&buffer, bf, rl);
 
-    /*Fill the string: */
-    elem = Sets_elementToString(bf.focals[0].element, rl);
-    sprintf(str, "m(%s) = %f\n", elem, bf.focals[0].beliefValue);
-    free(elem);
-    elem = NULL;
-    for(i = 1; i<bf.nbFocals; i++){
-        elem = Sets_elementToString(bf.focals[i].element, rl);
-        sprintf(temp, "m(%s) = %f\n", elem, bf.focals[i].beliefValue);
-        strcat(str, temp);
-        free(elem);
-        elem = NULL;
-    }
-    /*Add the end of str char: */
-    strcat(str, "\0");
+    return buffer.str;
+}
+
+char* BF_beliefFunctionToBitString(const BF_BeliefFunction bf){
+    StringBuffer buffer = StringBuffer_create((bf.elementSize + 16) * bf.nbFocals + 1);
 
-    return str;
+    BF_appendBeliefFunctionBits(&buffer, bf);
+
+    return buffer.str;
 }
 
+void BF_appendBeliefFunction(StringBuffer* buffer, const BF_BeliefFunction bf, const Sets_ReferenceList rl){
+    int i = 0;
+
+    for(i = 0; i < bf.nbFocals; i++){
+        StringBuffer_append(buffer, "m(");
+        Sets_appendElement(buffer, bf.focals[i].element, rl);
+        StringBuffer_appendFormat(buffer, ") = %f\n", bf.focals[i].beliefValue);
+    }
+}
 
+void BF_appendBeliefFunctionBits(StringBuffer* buffer, const BF_BeliefFunction bf){
+    int i = 0;
 
-char* BF_beliefFunctionToBitString(const BF_BeliefFunction bf){
-	char *str = NULL, *elem = NULL;
-    char temp[MAX_STR_LEN];
-    int i = 0, totChar = 0;
-
-    /*Count the chars for the focals: */
-    for(i = 0; i<bf.nbFocals; i++){
-        elem = Sets_elementToBitString(bf.focals[i].element, bf.elementSize);
-        sprintf(temp, "m(%s) = %f\n", elem, bf.focals[i].beliefValue);
-        totChar += strlen(temp);
-        free(elem);
-        elem = NULL;
-    }
-    /*Memory allocation: */
-    str = malloc(sizeof(char)*(totChar+1));
-    DEBUG_CHECK_MALLOC_OR_RETURN(str, NULL);
-
-    /*Fill the string: */
-    elem = Sets_elementToBitString(bf.focals[0].element, bf.elementSize);
-    sprintf(str, "m(%s) = %f\n", elem, bf.focals[0].beliefValue);
-    free(elem);
-    elem = NULL;
-    for(i = 1; i < bf.nbFocals; i++){
-        elem = Sets_elementToBitString(bf.focals[i].element, bf.elementSize);
-        sprintf(temp, "m(%s) = %f\n", elem, bf.focals[i].beliefValue);
-        strcat(str, temp);
-        free(elem);
-        elem = NULL;
-    }
-    /*Add the end of str char: */
-    strcat(str, "\0");
-
-    return str;
+    for(i = 0; i < bf.nbFocals; i++){
+        StringBuffer_append(buffer, "m(");
+        Sets_appendElementBits(buffer, bf.focals[i].element, bf.elementSize);
+        StringBuffer_appendFormat(buffer, ") = %f\n", bf.focals[i].beliefValue);
+    }
 }
 
 /** @} */
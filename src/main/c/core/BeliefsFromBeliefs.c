@@ -17,6 +17,7 @@
 
 
 #include "BeliefsFromBeliefs.h"
+#include "ArenaAllocation.h"
 
 
 /**
@@ -99,7 +100,7 @@
  */
 
 BFB_BeliefStructure BFB_loadBeliefStructure(const char* frameName){
-	BFB_BeliefStructure bs = {NULL, {NULL, 0}, NULL, 0};
+	BFB_BeliefStructure bs = {NULL, {NULL, 0, NULL}, NULL, 0};
 	char path[MAX_SIZE_PATH];
     int* charsPerDir = NULL;
     char** directories = NULL;
@@ -180,7 +181,7 @@ BFB_BeliefFromBelief BFB_loadBeliefFromBelief(const char* frameOfOrigin, const c
         /*Load the vectors: */
         bfb.nbVectors = nbFiles - 1;
         #ifdef CHECK_MODELS
-        if(bfb.nbVectors != pow(2, bfb.refList.card) - 1){
+        if(bfb.refList.card > 30 || bfb.nbVectors != (1 << bfb.refList.card) - 1){
         	printf("debug: MODEL CHECKING = FAIL! You didn't write a file for each possible element in %s.\n", path);
         }
         #endif
@@ -326,11 +327,10 @@ BF_BeliefFunction* BFB_believeFromBeliefs(const BFB_BeliefStructure bs, const ch
 
 BF_BeliefFunction BFB_believeFromBelief(const BFB_BeliefFromBelief bfb, const BF_BeliefFunction from, const int elementSize){
 	BF_BeliefFunction bf;
-	int i = 0, j = 0, k = 0, l = 0;
-	int nbFocals = 0;
-	char in = 0;
+	BF_FocalIndex* index = NULL;
+	int i = 0, j = 0, k = 0;
 	Sets_Element emptyset;
-	float emptyMass = 0;
+	BF_Mass emptyMass = 0;
 	
 	/*Init: */
 	bf.nbFocals = 0;
@@ -348,36 +348,23 @@ BF_BeliefFunction BFB_believeFromBelief(const BFB_BeliefFromBelief bfb, const BF
 		bf.focals[0].element = Sets_getEmptyElement(elementSize);
 		bf.focals[0].beliefValue = emptyMass;
 	}
+	/*The index finds the focals already in: */
+	index = BF_indexBeliefFunction(bf);
 	
 	/*Transform: */
 	for(i = 0; i < from.nbFocals; i++){
 		for(j = 0; j < bfb.nbVectors; j++){
 			if(Sets_equals(from.focals[i].element, bfb.vectors[j].from, from.elementSize) &&
 			   !Sets_equals(from.focals[i].element, emptyset, from.elementSize)){
-				nbFocals = bf.nbFocals;
 				for(k = 0; k < bfb.vectors[j].nbTos; k++){
-					in = 0;
-					for(l = 0; l < nbFocals; l++){
-						if(Sets_equals(bf.focals[l].element, bfb.vectors[j].to[k], elementSize)){
-							in = 1;
-							bf.focals[l].beliefValue += from.focals[i].beliefValue * bfb.vectors[j].factors[k];
-							break;
-						}	
-					}
-					if(!in){
-						bf.focals = realloc(bf.focals, sizeof(BF_FocalElement) * (bf.nbFocals + 1));
-						DEBUG_CHECK_MALLOC(bf.focals);
-
-						bf.nbFocals++;
-						bf.focals[bf.nbFocals - 1].element = Sets_copyElement(bfb.vectors[j].to[k], elementSize);
-						bf.focals[bf.nbFocals - 1].beliefValue = from.focals[i].beliefValue * bfb.vectors[j].factors[k];
-					} 
+					BF_addToFocal(&bf, index, bfb.vectors[j].to[k], from.focals[i].beliefValue * bfb.vectors[j].factors[k]);
 				}
 				break;
 			}
 		}
 	}
 	Sets_freeElement(&emptyset);
+	BF_freeFocalIndex(index);
 	
 	#ifdef CHECK_VALUES
     if(BF_checkValues(bf)){
@@ -453,137 +440,94 @@ void BFB_freeBeliefVector(BFB_BeliefVector* bv){
  */
 
 char* BFB_beliefStructureToString(const BFB_BeliefStructure bs){
-	char *str = NULL;
-	char** beliefs = NULL;
-	int i = 0, totChar = 0;
-	int len = 0;
-	
-	beliefs = malloc(sizeof(char*) * bs.nbBeliefs);
-	DEBUG_CHECK_MALLOC(beliefs);
+	StringBuffer buffer = StringBuffer_create(MAX_STR_LEN);
 
-	for(i = 0; i < bs.nbBeliefs; i++){
-		beliefs[i] = BFB_beliefFromBeliefToString(bs.beliefs[i], bs.refList);
-		totChar += strlen(beliefs[i]);
-	}
-	
-	/*Count total char: */
-	totChar += (strlen(bs.frameName) + 5) * 3 + 1;
-	
-	/*Print: */
-	str = malloc(sizeof(char) * (totChar+1));
-	DEBUG_CHECK_MALLOC(str);
-
-	strcpy(str, "*");
-	len = strlen(bs.frameName);
-	for(i = 0; i < len + 3; i++){
-		strcat(str, "*");
+	BFB_appendBeliefStructure(&buffer, bs);
+
+	return buffer.str;
+}
+
+char* BFB_beliefFromBeliefToString(const BFB_BeliefFromBelief bfb, const Sets_ReferenceList to){
+	StringBuffer buffer = StringBuffer_create(MAX_STR_LEN);
+
+	BFB_appendBeliefFromBelief(&buffer, bfb, to);
+
+	return buffer.str;
+}
+
+char* BFB_beliefVectorToString(const BFB_BeliefVector bv, const Sets_ReferenceList to, const Sets_ReferenceList from){
+	StringBuffer buffer = StringBuffer_create(MAX_STR_LEN);
+
+	BFB_appendBeliefVector(&buffer, bv, to, from);
+
+	return buffer.str;
+}
+
+/*
+ * Appends the set of the atoms of a frame, as Sets_setToString() would do
+ * with the set given by Sets_createSetFromRefList().
+ */
+static void appendAtoms(StringBuffer* buffer, const Sets_ReferenceList rl){
+	int i = 0;
+
+	StringBuffer_appendChar(buffer, '{');
+	for(i = 0; i < rl.card; i++){
+		if(i > 0){
+			StringBuffer_append(buffer, ", ");
+		}
+		StringBuffer_appendFormat(buffer, "{%s}", rl.values[i]);
 	}
-	strcat(str, "\n* ");
-	strcat(str, bs.frameName);
-	strcat(str, " *\n");
+	StringBuffer_appendChar(buffer, '}');
+}
+
+void BFB_appendBeliefStructure(StringBuffer* buffer, const BFB_BeliefStructure bs){
+	int i = 0;
+	int len = strlen(bs.frameName);
+
 	for(i = 0; i < len + 4; i++){
-		strcat(str, "*");
+		StringBuffer_appendChar(buffer, '*');
 	}
-	strcat(str, "\n");
-	for(i = 0; i < bs.nbBeliefs; i++){
-		strcat(str, beliefs[i]);
+	StringBuffer_appendFormat(buffer, "\n* %s *\n", bs.frameName);
+	for(i = 0; i < len + 4; i++){
+		StringBuffer_appendChar(buffer, '*');
 	}
-	
+	StringBuffer_appendChar(buffer, '\n');
 	for(i = 0; i < bs.nbBeliefs; i++){
-		free(beliefs[i]);
+		BFB_appendBeliefFromBelief(buffer, bs.beliefs[i], bs.refList);
 	}
-	free(beliefs);
-	
-	return str;
 }
 
-char* BFB_beliefFromBeliefToString(const BFB_BeliefFromBelief bfb, const Sets_ReferenceList to){
-	char *str = NULL, *str2 = NULL, *str3 = NULL;
-	char** vectors = NULL;
-	Sets_Set valuesTo, valuesFrom;
-	int i = 0, totChar = 0;
-	int len = 0;
-	
-	/*Vectors' strings: */
-	vectors = malloc(sizeof(char*) * bfb.nbVectors);
-	DEBUG_CHECK_MALLOC(vectors);
-
-	for(i = 0; i < bfb.nbVectors; i++){
-		vectors[i] = BFB_beliefVectorToString(bfb.vectors[i], to, bfb.refList);
-		totChar += strlen(vectors[i]);
-	}
-	
-	/*Values string: */
-	valuesFrom = Sets_createSetFromRefList(bfb.refList);
-	valuesTo = Sets_createSetFromRefList(to);
-	
-	str2 = Sets_setToString(valuesFrom, bfb.refList);
-	str3 = Sets_setToString(valuesTo, to);
-	
-	/*Count number of chars: */
-	totChar += (strlen(bfb.frameName) + 12) * 2 + strlen(str2) + strlen(str3) + 17;/* + bfb.nbVectors; */
-	
-	/*Print: */
-	str = malloc(sizeof(char) * (totChar+1));
-	DEBUG_CHECK_MALLOC(str);
+void BFB_appendBeliefFromBelief(StringBuffer* buffer, const BFB_BeliefFromBelief bfb, const Sets_ReferenceList to){
+	int i = 0;
+	int len = strlen(bfb.frameName);
 
-	sprintf(str, "Subframe %s :\n", bfb.frameName);
-	len = strlen(bfb.frameName);
+	StringBuffer_appendFormat(buffer, "Subframe %s :\n", bfb.frameName);
 	for(i = 0; i < len + 11; i++){
-		strcat(str, "-");
-	}
-	strcat(str, "\n");
-	strcat(str, "From : ");
-	strcat(str, str2);
-	strcat(str, "\nTo   : ");
-	strcat(str, str3);
-	strcat(str, "\n\n");
-	for(i = 0; i < bfb.nbVectors; i++){
-		strcat(str, vectors[i]);
-		/*strcat(str, "\n"); */
+		StringBuffer_appendChar(buffer, '-');
 	}
-	strcat(str, "\0");
-	
-	/*Free: */
-	free(str2);
-	free(str3);
-	Sets_freeSet(&valuesFrom);
-	Sets_freeSet(&valuesTo);
+	StringBuffer_append(buffer, "\nFrom : ");
+	appendAtoms(buffer, bfb.refList);
+	StringBuffer_append(buffer, "\nTo   : ");
+	appendAtoms(buffer, to);
+	StringBuffer_append(buffer, "\n\n");
 	for(i = 0; i < bfb.nbVectors; i++){
-		free(vectors[i]);
+		BFB_appendBeliefVector(buffer, bfb.vectors[i], to, bfb.refList);
 	}
-	free(vectors);
-	
-	return str;
 }
 
-char* BFB_beliefVectorToString(const BFB_BeliefVector bv, const Sets_ReferenceList to, const Sets_ReferenceList from){
-	char* str = NULL;
-	char temp[MAX_STR_LEN], temp2[MAX_STR_LEN];
-	char* elem = NULL;
+void BFB_appendBeliefVector(StringBuffer* buffer, const BFB_BeliefVector bv, const Sets_ReferenceList to, const Sets_ReferenceList from){
 	int i = 0;
-	
-	elem = Sets_elementToString(bv.from, from);
-	sprintf(temp2, "From %s to :\n", elem);
-	free(elem);
-	
+
+	StringBuffer_append(buffer, "From ");
+	Sets_appendElement(buffer, bv.from, from);
+	StringBuffer_append(buffer, " to :\n");
 	for(i = 0; i < bv.nbTos; i++){
-		elem = Sets_elementToString(bv.to[i], to);
-		sprintf(temp, " --> %s : %f\n", elem, bv.factors[i]);
-		strcat(temp2, temp);
-		free(elem);
+		StringBuffer_append(buffer, " --> ");
+		Sets_appendElement(buffer, bv.to[i], to);
+		StringBuffer_appendFormat(buffer, " : %f\n", bv.factors[i]);
 	}
-	
-	str = malloc(sizeof(char) * (strlen(temp2) + 1));
-	DEBUG_CHECK_MALLOC(str);
-
-	strcpy(str, temp2);
-	strcat(str, "\0");
-	
-	return str;
 }
 
-
 /** @} */
 
 
@@ -18,6 +18,7 @@
 
 
 #include "BeliefsFromRandomness.h"
+#include "ArenaAllocation.h"
 
 /**
  * This module provides with methods to randomly generate mass functions. It is roughly based on common
@@ -29,6 +30,108 @@
  * @brief APPLICATION: Gives structures and main
  *        functions to create random belief functions.
  */
+
+
+/*
+  +-------------------+
+  | PRIVATE FUNCTIONS |
+  +-------------------+
+*/
+
+/*
+ * Random subset code of a frame of at most SETS_PACKED_MAX_SIZE atoms computed with integers only.
+ * For frames of at most 30 atoms, it is rand() % 2^size as in the previous versions.
+ */
+static Sets_PackedElement randomCode(const int size){
+	Sets_PackedElement code = 0;
+	int nbBits = 0;
+
+	if(size <= 30){
+		return rand() % (1 << size);
+	}
+	/*15 bits at a time (the minimum guaranteed by RAND_MAX): */
+	for(nbBits = 0; nbBits < size; nbBits += 15){
+		code = (code << 15) | (rand() & 0x7FFF);
+	}
+
+	return code & Sets_packedCompleteElement(size);
+}
+
+/*
+ * Random element of a frame of any size (one code per group of 64 atoms).
+ */
+static Sets_Element randomElement(const int size){
+	Sets_Element e = Sets_getEmptyElement(size);
+	Sets_PackedElement code = 0;
+	int i = 0, j = 0, nbAtoms = 0;
+
+	for(i = 0; i < size; i += SETS_PACKED_MAX_SIZE){
+		nbAtoms = size - i < SETS_PACKED_MAX_SIZE ? size - i : SETS_PACKED_MAX_SIZE;
+		code = randomCode(nbAtoms);
+		for(j = 0; j < nbAtoms; j++){
+			e.values[i + j] = (code >> j) & 1;
+			e.card += e.values[i + j];
+		}
+	}
+
+	return e;
+}
+
+/*
+ * Gives bf->nbFocals distinct random focal elements with random masses to bf.
+ * The codes are compared for frames of at most SETS_PACKED_MAX_SIZE atoms, the elements for larger ones.
+ */
+static void randomFocals(BF_BeliefFunction* bf){
+	Sets_PackedElement* codes = NULL;
+	int packed = bf->elementSize <= SETS_PACKED_MAX_SIZE;
+	int valid = 0;
+	int i = 0, j = 0;
+
+	bf->focals = malloc(sizeof(BF_FocalElement) * bf->nbFocals);
+	DEBUG_CHECK_MALLOC(bf->focals);
+	if(packed){
+		codes = malloc(sizeof(Sets_PackedElement) * bf->nbFocals);
+		DEBUG_CHECK_MALLOC(codes);
+	}
+	for(i = 0; i < bf->nbFocals; i++){
+		valid = 0;
+		while(!valid){
+			valid = 1;
+			if(packed){
+				codes[i] = randomCode(bf->elementSize);
+				for(j = 0; j < i; j++){
+					if(codes[i] == codes[j]){
+						valid = 0;
+					}
+				}
+			}
+			else {
+				bf->focals[i].element = randomElement(bf->elementSize);
+				for(j = 0; j < i; j++){
+					if(Sets_equals(bf->focals[i].element, bf->focals[j].element, bf->elementSize)){
+						valid = 0;
+					}
+				}
+				if(!valid){
+					Sets_freeElement(&(bf->focals[i].element));
+				}
+			}
+		}
+		if(packed){
+			bf->focals[i].element = Sets_unpackElement(codes[i], bf->elementSize);
+		}
+		bf->focals[i].beliefValue = (float)rand() / RAND_MAX;
+	}
+	free(codes);
+}
+
+
+
+/*
+  +-----------+
+  | FUNCTIONS |
+  +-----------+
+*/
  
 /**
  * @name Utility functions
@@ -54,30 +157,11 @@ void BFR_generateRandomSeed(){
  
 BF_BeliefFunction BFR_getCrappyRandomBelief(const int elementSize){
 	BF_BeliefFunction bf;
-	int valid = 0;
-	int i = 0, j = 0;
-	int *elementNumbers = NULL;
 	
 	bf.elementSize = elementSize;
-	bf.nbFocals = rand() % (int)(pow(2, elementSize));
-	bf.focals = malloc(sizeof(BF_FocalElement) * bf.nbFocals);
-	elementNumbers = malloc(sizeof(int) * bf.nbFocals);
-	for(i = 0; i < bf.nbFocals; i++){
-		valid = 0;
-		while(!valid){
-			elementNumbers[i] = rand() % (int)(pow(2, elementSize));
-			valid = 1;
-			for(j = 0; j < i; j++){
-				if(elementNumbers[i] == elementNumbers[j]){
-					valid = 0;
-				}
-			}
-		}
-		bf.focals[i].element = Sets_elementFromNumber(elementNumbers[i], elementSize);
-		bf.focals[i].beliefValue = (float)rand() / RAND_MAX;
-	}
-	
-	free(elementNumbers);
+	/*At most 2^30 focal elements: */
+	bf.nbFocals = rand() % (1 << (elementSize < 30 ? elementSize : 30));
+	randomFocals(&bf);
 	BF_normalize(&bf);
 	
 	return bf;
@@ -86,30 +170,11 @@ BF_BeliefFunction BFR_getCrappyRandomBelief(const int elementSize){
 
 BF_BeliefFunction BFR_getCrappyRandomBeliefWithFixedNbFocals(const int elementSize, const int nbFocals){
 	BF_BeliefFunction bf = {NULL, 0, 0};
-	int valid = 0;
-	int i = 0, j = 0;
-	int *elementNumbers = NULL;
 	
-	if(nbFocals <= pow(2, elementSize)){
+	if(elementSize > 30 || nbFocals <= 1 << elementSize){
 		bf.elementSize = elementSize;
 		bf.nbFocals = nbFocals;
-		bf.focals = malloc(sizeof(BF_FocalElement) * nbFocals);
-		elementNumbers = malloc(sizeof(int) * nbFocals);
-		for(i = 0; i < bf.nbFocals; i++){
-			valid = 0;
-			while(!valid){
-				elementNumbers[i] = rand() % (int)(pow(2, elementSize));
-				valid = 1;
-				for(j = 0; j < i; j++){
-					if(elementNumbers[i] == elementNumbers[j]){
-						valid = 0;
-					}
-				}
-			}
-			bf.focals[i].element = Sets_elementFromNumber(elementNumbers[i], elementSize);
-			bf.focals[i].beliefValue = (float)rand() / RAND_MAX;
-		}
-		free(elementNumbers);
+		randomFocals(&bf);
 		BF_normalize(&bf);
 	}
 	
@@ -16,6 +16,7 @@
 
 
 #include "BeliefsFromSensors.h"
+#include "ArenaAllocation.h"
 
 
 /**
@@ -40,6 +41,9 @@
  * read Pietropaoli et al. 2012 for explanations. It takes the number of seconds before complete forgetness as parameter.
  * @li Tempo-Fusion : includes temporization in the building of mass functions using a fusion based on Dubois & Prade's combination rule.
  * It takes the number of seconds before complete forgetness as parameter.
+ * @li Max-Focals : bounds the number of focal elements of the built mass functions and of the ones kept by the
+ * temporization (summarization, see BF_approximation()), so that the cost of the fusions does not grow over time.
+ * It takes the maximum number of focal elements as parameter.
  *
  * @section BFS_howto How to use this module
  * So, to build your sets of mass functions, you should do the following :
@@ -120,7 +124,14 @@ BFS_BeliefStructure BFS_createBeliefStructure(const char* name, const char * con
 	BFS_BeliefStructure beliefStructure;
 	beliefStructure.frameName = strdup(name);
 	beliefStructure.refList = Sets_createRefListFromArray(possibleValues, size);
-	beliefStructure.powerset = Sets_generatePowerSet(size);
+	beliefStructure.powersetView = Sets_getPowerSetView(size);
+	if(size <= BFS_POWERSET_MAX_SIZE){
+		beliefStructure.powerset = Sets_generatePowerSet(size);
+	}
+	else {
+		beliefStructure.powerset.elements = NULL;
+		beliefStructure.powerset.card = 0;
+	}
 	beliefStructure.possibleValues = Sets_createSetFromRefList(beliefStructure.refList);
 	beliefStructure.nbSensors = 0;
 	beliefStructure.beliefs = NULL;
@@ -149,6 +160,50 @@ BFS_SensorBeliefs BFS_createSensorBeliefs(const char* sensorType) {
 	return sensorBeliefs;
 }
 
+/*
+ * Copies a belief function kept by an option from one measure to the next one.
+ * The copy never comes from the arena in use (it would not survive a reset).
+ */
+static BF_BeliefFunction keepBeliefFunction(const BF_BeliefFunction bf) {
+	BF_Arena* arena = BF_useArena(NULL);
+	BF_BeliefFunction kept = BF_copyBeliefFunction(bf);
+	BF_useArena(arena);
+	return kept;
+}
+
+/*
+ * Applies the Max-Focals option: the projection and the belief functions kept by the
+ * temporizations are summarized so that the cost of the next fusions does not grow.
+ */
+static void boundFocals(const BFS_SensorBeliefs sb, BF_BeliefFunction* projection) {
+	BF_BeliefFunction temp = {NULL, 0, 0};
+	BF_Arena* arena = NULL;
+	int maxFocals = 0;
+	int i = 0;
+
+	for(i = 0; i < sb.nbOptions; i++){
+		if(sb.options[i].type & OP_MAX_FOCALS){
+			maxFocals = (int)sb.options[i].parameter;
+		}
+	}
+	if(projection->nbFocals > maxFocals){
+		temp = BF_approximation(*projection, maxFocals, APPROX_SUMMARIZATION, NULL);
+		BF_freeBeliefFunction(projection);
+		*projection = temp;
+	}
+	/*The kept functions never come from the arena in use:*/
+	for(i = 0; i < sb.nbOptions; i++){
+		if((sb.options[i].type & (OP_TEMPO_SPECIFICITY | OP_TEMPO_FUSION))
+				&& sb.options[i].util[1].bf.nbFocals > maxFocals){
+			arena = BF_useArena(NULL);
+			temp = BF_approximation(sb.options[i].util[1].bf, maxFocals, APPROX_SUMMARIZATION, NULL);
+			BF_freeBeliefFunction(&(sb.options[i].util[1].bf));
+			sb.options[i].util[1].bf = temp;
+			BF_useArena(arena);
+		}
+	}
+}
+
 static void copyOptions(const BFS_SensorBeliefs toCopy, BFS_SensorBeliefs *newBelief) {
 	int i;
 	for (i = 0; i < toCopy.nbOptions; ++i) {
@@ -185,14 +240,18 @@ static BFS_Option BFS_createOption(BFS_OptionFlags flag, float param) {
 	switch(flag) {
 	case OP_TEMPO_FUSION:
 	case OP_TEMPO_SPECIFICITY:
-		option.util = malloc(sizeof(BFS_Option) * 2);
+		option.util = malloc(sizeof(BFS_UtilData) * 2);
 		clock_gettime(CLOCK_ID, &(option.util[0].time));
 		option.util[1].bf.nbFocals = 0;
 		option.util[1].bf.focals = NULL;
 		option.util[1].bf.elementSize = 0;
 		break;
 	case OP_VARIATION:
-		option.util = calloc(param, sizeof(BFS_Option));
+		option.util = calloc(param, sizeof(BFS_UtilData));
+		option.parameter = (int)param;
+		break;
+	case OP_MAX_FOCALS:
+		option.util = NULL;
 		option.parameter = (int)param;
 		break;
 	case OP_NONE:
@@ -302,7 +361,7 @@ void BFS_addPointTosensorBelief(BFS_SensorBeliefs *sensorBeliefs, const Sets_Ele
  */
 
 BFS_BeliefStructure BFS_loadBeliefStructure(const char* directory, const char* frameName){
-    BFS_BeliefStructure bs = {NULL, {NULL,0}, {NULL,0}, {NULL,0}, NULL, 0};
+    BFS_BeliefStructure bs = {NULL, {NULL, 0, NULL}, {NULL,0}, {NULL,0}, NULL, 0, {0, 0, 0, 0, 0}};
     char path[MAX_SIZE_PATH];
     int* charsPerDir = NULL;
     char** directories = NULL;
@@ -325,8 +384,15 @@ BFS_BeliefStructure BFS_loadBeliefStructure(const char* directory, const char* f
         bs.refList = Sets_loadRefList(path);
         /*Create the set: */
         bs.possibleValues = Sets_createSetFromRefList(bs.refList);
-        /*Create the powerset: */
-        bs.powerset = Sets_createPowerSet(bs.possibleValues);
+        /*Create the powerset (only a view for large frames): */
+        bs.powersetView = Sets_getPowerSetView(bs.possibleValues.card);
+        if(bs.possibleValues.card <= BFS_POWERSET_MAX_SIZE){
+            bs.powerset = Sets_createPowerSet(bs.possibleValues);
+        }
+        else {
+            bs.powerset.elements = NULL;
+            bs.powerset.card = 0;
+        }
         /*Get the number of sensors: */
         strcpy(path, directory);     /* The directory where to find the CAs */
         strcat(path, frameName);      /* The name of the CA */
@@ -477,6 +543,14 @@ BFS_SensorBeliefs BFS_loadSensorBeliefs(const char* sensorType, const char* path
                         sb.options[j].type = OP_TEMPO_FUSION;
                         sb.optionFlags = sb.optionFlags | OP_TEMPO_FUSION;
                     }
+                    /*Max-focals: */
+                    /*Storage: nothing */
+                    else if(!strcmp(temp, "MAX-FOCALS")){
+                        sb.options[j].parameter = (int)(sb.options[j].parameter);
+                        sb.options[j].util = NULL;
+                        sb.options[j].type = OP_MAX_FOCALS;
+                        sb.optionFlags = sb.optionFlags | OP_MAX_FOCALS;
+                    }
                     /*WTF: */
                     else{
                         sb.options[j].util = NULL;
@@ -742,7 +816,7 @@ BF_BeliefFunction BFS_getProjection(const BFS_SensorBeliefs sb, const double sen
             projection = temp;
         /*First measure: */
         }else{
-            sb.options[parameterIndex].util[1].bf = BF_copyBeliefFunction(projection);
+            sb.options[parameterIndex].util[1].bf = keepBeliefFunction(projection);
             clock_gettime(CLOCK_ID, &(sb.options[parameterIndex].util[0].time));
         }
     }
@@ -769,11 +843,18 @@ BF_BeliefFunction BFS_getProjection(const BFS_SensorBeliefs sb, const double sen
             projection = temp;
         /*First measure: */
         }else{
-            sb.options[parameterIndex].util[1].bf = BF_copyBeliefFunction(projection);
+            sb.options[parameterIndex].util[1].bf = keepBeliefFunction(projection);
             clock_gettime(CLOCK_ID, &(sb.options[parameterIndex].util[0].time));
         }
     }
 
+    /*
+     * Bound the number of focal elements if required :
+     */
+    if(sb.optionFlags & OP_MAX_FOCALS){
+        boundFocals(sb, &projection);
+    }
+
     #ifdef CHECK_SUM
     if(BF_checkSum(projection)){
     	printf("debug: Sensor type = %s\n", sb.sensorType);
@@ -873,7 +954,7 @@ BF_BeliefFunction BFS_getProjectionElapsedTime(const BFS_SensorBeliefs sensorBel
 			projection = temp;
 		/*First measure: */
 		}else{
-			sensorBelief.options[parameterIndex].util[1].bf = BF_copyBeliefFunction(projection);
+			sensorBelief.options[parameterIndex].util[1].bf = keepBeliefFunction(projection);
 		}
 	}
 	else if(sensorBelief.optionFlags & OP_TEMPO_FUSION){
@@ -893,10 +974,17 @@ BF_BeliefFunction BFS_getProjectionElapsedTime(const BFS_SensorBeliefs sensorBel
 			projection = temp;
 		/*First measure: */
 		}else{
-			sensorBelief.options[parameterIndex].util[1].bf = BF_copyBeliefFunction(projection);
+			sensorBelief.options[parameterIndex].util[1].bf = keepBeliefFunction(projection);
 		}
 	}
 
+	/*
+	 * Bound the number of focal elements if required :
+	 */
+	if(sensorBelief.optionFlags & OP_MAX_FOCALS){
+		boundFocals(sensorBelief, &projection);
+	}
+
 	#ifdef CHECK_SUM
 	if(BF_checkSum(projection)){
 		printf("debug: Sensor type = %s\n", sensorBelief.sensorType);
@@ -1006,13 +1094,14 @@ BF_BeliefFunction BFS_temporization_specificityElapsedTime(const BF_BeliefFuncti
     /*Compare specificity: */
     if(BF_specificity(newOne) > BF_specificity(temp)){
         BF_freeBeliefFunction(&(op->util[1].bf));
-        op->util[1].bf = BF_copyBeliefFunction(newOne);
+        op->util[1].bf = keepBeliefFunction(newOne);
         result = BF_copyBeliefFunction(newOne);
+        BF_freeBeliefFunction(&temp);
     }
     else {
-        result = BF_copyBeliefFunction(temp);
+        /*The discounted copy is already the result: */
+        result = temp;
     }
-    BF_freeBeliefFunction(&temp);
 
     return result;
 }
@@ -1044,7 +1133,7 @@ BF_BeliefFunction BFS_temporization_fusionElapsedTime(const BF_BeliefFunction ol
     /*BF_cleanBeliefFunction(&result);*/
     /*Save: */
     BF_freeBeliefFunction(&(op->util[1].bf));
-    op->util[1].bf = BF_copyBeliefFunction(result);
+    op->util[1].bf = keepBeliefFunction(result);
     BF_freeBeliefFunction(&temp);
     
     return result;
@@ -1115,175 +1204,109 @@ void BFS_freePartOfBelief(BFS_PartOfBelief* pob){
 
 
 char* BFS_partOfBeliefToString(const BFS_PartOfBelief pob, const Sets_ReferenceList rl){
-    char temp[MAX_STR_LEN];
-    char *elem = NULL, *str = NULL;
-    int i = 0, totChar = 0;
-
-    /*Get the element string: */
-    elem = Sets_elementToString(pob.focalElement, rl);
-    /*Counts number of chars required: */
-    totChar += 16 + strlen(elem);
-    for(i = 0; i<pob.nbPts; i++){
-        sprintf(temp, " - (%f, %f)\n", pob.points[i].sensorValue, pob.points[i].belief);
-        totChar += strlen(temp);
-    }
+    StringBuffer buffer = StringBuffer_create(MAX_STR_LEN);
 
-    /*Fill the string: */
-    str = malloc(sizeof(char)*(totChar+1));
-    DEBUG_CHECK_MALLOC_OR_RETURN(str, NULL);
+    BFS_appendPartOfBelief(&buffer, pob, rl);
 
-    sprintf(str, "Focal: %s\nPoints:\n", elem);
-    for(i = 0; i<pob.nbPts; i++){
-        sprintf(temp, " - (%f, %f)\n", pob.points[i].sensorValue, pob.points[i].belief);
-        strcat(str, temp);
-    }
-    /*Add the end of str char: */
-    strcat(str, "\0");
+    return buffer.str;
+}
+
+char* BFS_optionToString(const BFS_Option o){
+    StringBuffer buffer = StringBuffer_create(64);
 
-    /*Deallocate: */
-    free(elem);
+    BFS_appendOption(&buffer, o);
 
-    return str;
+    return buffer.str;
 }
 
-char* BFS_optionToString(const BFS_Option o){
-    char* str = NULL;
-    char temp[MAX_STR_LEN];
+char* BFS_sensorBeliefsToString(const BFS_SensorBeliefs sb, const Sets_ReferenceList rl){
+    StringBuffer buffer = StringBuffer_create(MAX_STR_LEN);
 
-    if(o.type & OP_VARIATION){
-    	sprintf(temp, "Variation (%f)", o.parameter);
-    }
-    else if(o.type & OP_TEMPO_SPECIFICITY){
-    	sprintf(temp, "Tempo-specificity (%f)", o.parameter);
-    }
-    else if(o.type & OP_TEMPO_FUSION){
-    	sprintf(temp, "Tempo-fusion (%f)", o.parameter);
-    }
-    str = malloc(sizeof(char)*strlen(temp)+1);
-    DEBUG_CHECK_MALLOC_OR_RETURN(str, NULL);
+    BFS_appendSensorBeliefs(&buffer, sb, rl);
 
-    strcpy(str, temp);
-    strcat(str, "\0");
+    return buffer.str;
+}
+
+char* BFS_beliefStructureToString(const BFS_BeliefStructure bs){
+    StringBuffer buffer = StringBuffer_create(MAX_STR_LEN);
 
-    return str;
+    BFS_appendBeliefStructure(&buffer, bs);
+
+    return buffer.str;
 }
 
-char* BFS_sensorBeliefsToString(const BFS_SensorBeliefs sb, const Sets_ReferenceList rl){
-    char* str = NULL;
-    char **pobStr = NULL, **opStr = NULL;
-    int i = 0, totChar = 0;
-    char* separator = "---------------------\n";
+void BFS_appendPartOfBelief(StringBuffer* buffer, const BFS_PartOfBelief pob, const Sets_ReferenceList rl){
+    int i = 0;
 
-    /*Get the strings of parts of belief: */
-    pobStr = malloc(sizeof(char*)*sb.nbFocal);
-    DEBUG_CHECK_MALLOC_OR_RETURN(pobStr, NULL);
+    StringBuffer_append(buffer, "Focal: ");
+    Sets_appendElement(buffer, pob.focalElement, rl);
+    StringBuffer_append(buffer, "\nPoints:\n");
+    for(i = 0; i<pob.nbPts; i++){
+        StringBuffer_appendFormat(buffer, " - (%f, %f)\n", pob.points[i].sensorValue, pob.points[i].belief);
+    }
+}
 
-    for(i = 0; i<sb.nbFocal; i++){
-        pobStr[i] = BFS_partOfBeliefToString(sb.beliefOnElements[i], rl);
-        if(pobStr[i] != NULL){
-            totChar += strlen(pobStr[i]);
-        }
+void BFS_appendOption(StringBuffer* buffer, const BFS_Option o){
+    if(o.type & OP_VARIATION){
+        StringBuffer_appendFormat(buffer, "Variation (%f)", o.parameter);
     }
-    /*Get the strings of options: */
-    if(sb.nbOptions){
-        opStr = malloc(sizeof(char*)*sb.nbOptions);
-        DEBUG_CHECK_MALLOC_OR_RETURN(opStr, NULL);
-
-        for(i = 0; i<sb.nbOptions; i++){
-            opStr[i] = BFS_optionToString(sb.options[i]);
-            if(opStr[i] != NULL){
-                totChar += strlen(opStr[i]);
-            }
-        }
+    else if(o.type & OP_TEMPO_SPECIFICITY){
+        StringBuffer_appendFormat(buffer, "Tempo-specificity (%f)", o.parameter);
     }
-    else{
-    	totChar += 5;
+    else if(o.type & OP_TEMPO_FUSION){
+        StringBuffer_appendFormat(buffer, "Tempo-fusion (%f)", o.parameter);
     }
-    /*Count total char: */
-    totChar += 25 + strlen(sb.sensorType) + sb.nbFocal - 1 + 3*strlen(separator);
+    else if(o.type & OP_MAX_FOCALS){
+        StringBuffer_appendFormat(buffer, "Max-focals (%f)", o.parameter);
+    }
+}
 
-    /*Fill the string: */
-    str = malloc(sizeof(char)*(totChar+1));
-    DEBUG_CHECK_MALLOC_OR_RETURN(str, NULL);
+void BFS_appendSensorBeliefs(StringBuffer* buffer, const BFS_SensorBeliefs sb, const Sets_ReferenceList rl){
+    int i = 0;
+    const char* separator = "---------------------\n";
 
     /*Header: */
-    sprintf(str, "%sSensor type: %s\n%sOptions:\n", separator, sb.sensorType, separator);
+    StringBuffer_append(buffer, separator);
+    StringBuffer_appendFormat(buffer, "Sensor type: %s\n", sb.sensorType);
+    StringBuffer_append(buffer, separator);
+    StringBuffer_append(buffer, "Options:\n");
     /*Options: */
     for(i = 0; i<sb.nbOptions; i++){
-        strcat(str, opStr[i]);
-        strcat(str, "\n");
+        BFS_appendOption(buffer, sb.options[i]);
+        StringBuffer_appendChar(buffer, '\n');
     }
     if(!sb.nbOptions){
-    	strcat(str, "none\n");
+        StringBuffer_append(buffer, "none\n");
     }
-    strcat(str, separator);
+    StringBuffer_append(buffer, separator);
     /*Parts of belief: */
     for(i = 0; i<sb.nbFocal; i++){
-        strcat(str, pobStr[i]);
+        BFS_appendPartOfBelief(buffer, sb.beliefOnElements[i], rl);
         if(i != sb.nbFocal - 1){
-            strcat(str, "\n");
+            StringBuffer_appendChar(buffer, '\n');
         }
     }
-    /*Add the end of str char: */
-    strcat(str, "\0");
-
-    /*Deallocate: */
-    for(i = 0; i<sb.nbFocal; i++){
-        free(pobStr[i]);
-    }
-    free(pobStr);
-    for(i = 0; i<sb.nbOptions; i++){
-        free(opStr[i]);
-    }
-    free(opStr);
-
-    return str;
 }
 
-char* BFS_beliefStructureToString(const BFS_BeliefStructure bs){
-    char* str = NULL, *set = NULL, *powerset = NULL;
-    char** sbStr = NULL;
-    int i = 0, totChar = 0;
-
-    /*Get the strings of sensor beliefs: */
-    sbStr = malloc(sizeof(char*)*bs.nbSensors);
-    DEBUG_CHECK_MALLOC_OR_RETURN(sbStr, NULL);
+void BFS_appendBeliefStructure(StringBuffer* buffer, const BFS_BeliefStructure bs){
+    int i = 0;
 
-    for(i = 0; i<bs.nbSensors; i++){
-        sbStr[i] = BFS_sensorBeliefsToString(bs.beliefs[i], bs.refList);
-        if(sbStr[i] != NULL){
-            totChar += strlen(sbStr[i]);
-        }
+    StringBuffer_appendFormat(buffer, "Context attribute:\n%s\nPossible values:\n", bs.frameName);
+    Sets_appendSet(buffer, bs.possibleValues, bs.refList);
+    StringBuffer_append(buffer, "\nPowerset:\n");
+    if(bs.powerset.card > 0){
+        Sets_appendSet(buffer, bs.powerset, bs.refList);
     }
-    /*Get the other strings: */
-    set = Sets_setToString(bs.possibleValues, bs.refList);
-    powerset = Sets_setToString(bs.powerset, bs.refList);
-    /*Count the nb of chars: */
-    totChar += strlen(set) + strlen(powerset) + strlen(bs.frameName) + bs.nbSensors - 1 + 50;
-
-    /*Fill the string: */
-    str = malloc(sizeof(char)*(totChar+1));
-    DEBUG_CHECK_MALLOC_OR_RETURN(str, NULL);
-
-    sprintf(str, "Context attribute:\n%s\nPossible values:\n%s\nPowerset:\n%s\n\n", bs.frameName, set, powerset);
+    else {
+        StringBuffer_appendFormat(buffer, "(2^%d subsets, not stored)", bs.possibleValues.card);
+    }
+    StringBuffer_append(buffer, "\n\n");
     for(i = 0; i<bs.nbSensors; i++){
-        strcat(str, sbStr[i]);
+        BFS_appendSensorBeliefs(buffer, bs.beliefs[i], bs.refList);
         if(i != bs.nbSensors - 1){
-            strcat(str, "\n");
+            StringBuffer_appendChar(buffer, '\n');
         }
     }
-    /*Add the end of str char: */
-    strcat(str, "\0");
-
-    /*Deallocate: */
-    for(i = 0; i<bs.nbSensors; i++){
-        free(sbStr[i]);
-    }
-    free(sbStr);
-    free(set);
-    free(powerset);
-
-    return str;
 }
 
 /** @} */
@@ -17,6 +17,7 @@
 #include <string.h>
 
 #include "Sets.h"
+#include "ArenaAllocation.h"
 
 
 /**
@@ -27,13 +28,57 @@
  * in the theory of belief functions.
  */
 
+/*
+  +-------------------+
+  | PRIVATE FUNCTIONS |
+  +-------------------+
+*/
+
+/*
+ * Open addressing hash table of the positions of the values of a reference list.
+ */
+struct Sets_RefListIndex {
+    int* slots; /* position + 1 of the values, 0 for an empty slot */
+    unsigned int mask;
+};
+
+/*
+ * FNV-1a hash of a string.
+ */
+static unsigned int hashValue(const char* value){
+    unsigned int hash = 2166136261u;
+
+    while(*value != '\0'){
+        hash ^= (unsigned char)*value;
+        hash *= 16777619u;
+        value++;
+    }
+
+    return hash;
+}
+
+static void freeRefListIndex(Sets_RefListIndex* index){
+    if(index != NULL){
+        free(index->slots);
+        free(index);
+    }
+}
+
+
+
+/*
+  +-----------+
+  | FUNCTIONS |
+  +-----------+
+*/
+
 /**
  * @name Reference lists
  * @{
  */
 
 Sets_ReferenceList Sets_loadRefList(const char* fileName){
-    Sets_ReferenceList loadedList = {NULL, 0};
+    Sets_ReferenceList loadedList = {NULL, 0, NULL};
     int nbLines = 0, i = 0, card = 0, current = 0;
     int* charPerLine = NULL;
     char** lines = NULL;
@@ -77,6 +122,8 @@ Sets_ReferenceList Sets_loadRefList(const char* fileName){
     }
     free(lines);
 
+    Sets_indexRefList(&loadedList);
+
     return loadedList;
 }
 
@@ -84,6 +131,7 @@ Sets_ReferenceList Sets_createRefListFromArray(const char* const * values, int s
 	Sets_ReferenceList refList;
 	int i = 0;
 	refList.card = 0;
+	refList.index = NULL;
 	refList.values = malloc(sizeof(char**) * size);
 	DEBUG_CHECK_MALLOC_OR_RETURN(refList.values, refList);
 
@@ -91,9 +139,74 @@ Sets_ReferenceList Sets_createRefListFromArray(const char* const * values, int s
 	for (i = 0; i < size; ++i) {
 		refList.values[i] = strdup(values[i]);
 	}
+	Sets_indexRefList(&refList);
 	return refList;
 }
 
+void Sets_indexRefList(Sets_ReferenceList* rl){
+    Sets_RefListIndex* index = NULL;
+    unsigned int nbSlots = 2, slot = 0;
+    int i = 0;
+
+    freeRefListIndex(rl->index);
+    rl->index = NULL;
+
+    /*At most one half of the slots are used: */
+    while(nbSlots < 2 * (unsigned int)rl->card){
+        nbSlots *= 2;
+    }
+    /*If the allocation fails, the list stays usable without index: */
+    index = malloc(sizeof(Sets_RefListIndex));
+    DEBUG_CHECK_MALLOC(index);
+    if(index == NULL){
+        return;
+    }
+    index->mask = nbSlots - 1;
+    index->slots = calloc(nbSlots, sizeof(int));
+    DEBUG_CHECK_MALLOC(index->slots);
+    if(index->slots == NULL){
+        free(index);
+        return;
+    }
+
+    /*Linear probing, the first occurrence of a value is kept: */
+    for(i = 0; i < rl->card; i++){
+        slot = hashValue(rl->values[i]) & index->mask;
+        while(index->slots[slot] != 0 && strcmp(rl->values[index->slots[slot] - 1], rl->values[i])){
+            slot = (slot + 1) & index->mask;
+        }
+        if(index->slots[slot] == 0){
+            index->slots[slot] = i + 1;
+        }
+    }
+
+    rl->index = index;
+}
+
+int Sets_getRefListPosition(const Sets_ReferenceList rl, const char* value){
+    unsigned int slot = 0;
+    int i = 0;
+
+    if(rl.index == NULL){
+        for(i = 0; i < rl.card; i++){
+            if(!strcmp(value, rl.values[i])){
+                return i;
+            }
+        }
+        return -1;
+    }
+
+    slot = hashValue(value) & rl.index->mask;
+    while(rl.index->slots[slot] != 0){
+        if(!strcmp(value, rl.values[rl.index->slots[slot] - 1])){
+            return rl.index->slots[slot] - 1;
+        }
+        slot = (slot + 1) & rl.index->mask;
+    }
+
+    return -1;
+}
+
 /** @} */
 
 /*
@@ -136,38 +249,27 @@ Sets_Set Sets_createSet(const int nbAtoms){
 
 Sets_Set Sets_createPowerSet(const Sets_Set set){
     Sets_Set powerset = {NULL, 0};
-    int i = 0, j = 0, sum = 0;
+    int i = 0;
+
+    /*The number of subsets must fit in an int: */
+    if(set.card > 30){
+        #ifdef CHECK_COMPATIBILITY
+        printf("debug: in Sets_createPowerSet(), the powerset of %d atoms cannot be stored, use a Sets_PowerSetView.\n", set.card);
+        #endif
+        return powerset;
+    }
 
     /*Powerset allocation: */
-    powerset.card = pow(2, set.card);
+    powerset.card = 1 << set.card;
     powerset.elements = malloc(sizeof(Sets_Element) * powerset.card);
     DEBUG_CHECK_MALLOC(powerset.elements);
 
-    /* ***********************
-       Building the elements:
-       ***********************
-       Empty set:*/
-    powerset.elements[0].values = malloc(sizeof(char) * set.card);
-    DEBUG_CHECK_MALLOC(powerset.elements[0].values);
-
-    for(j = 0; j<set.card; j++){
-        powerset.elements[0].values[j] = 0;
-    }
-    powerset.elements[0].card = 0;
-    /*Other elements: */
-    for(i = 1; i < powerset.card; i++){
-        /*Reset the sum: */
-        sum = 0;
-        /*Allocate memory: */
+    /*Building the elements (the binary form of i is the element i): */
+    for(i = 0; i < powerset.card; i++){
         powerset.elements[i].values = malloc(sizeof(char) * set.card);
         DEBUG_CHECK_MALLOC(powerset.elements[i].values);
 
-        /*Compute the binary value: */
-        for(j = 0; j < set.card; j++){
-                powerset.elements[i].values[j] = ((int)(i/pow(2,j)))%2;
-                sum += powerset.elements[i].values[j];
-        }
-        powerset.elements[i].card = sum;
+        Sets_unpackElementInto(&(powerset.elements[i]), (Sets_PackedElement)i, set.card);
     }
 
     return powerset;
@@ -203,48 +305,40 @@ Sets_Set Sets_generatePowerSet(const int elementSize){
 
 Sets_Element Sets_createElementFromStrings(const char* const * const values, const int nbValues, const Sets_ReferenceList rl){
     Sets_Element newElem = {NULL, 0};
-    int i = 0, j = 0;
+    int i = 0, position = 0;
     #ifdef CHECK_MODELS
-    int valid = 0;
-    #endif
-	
-	#ifdef CHECK_MODELS
-	for(i = 0; i < nbValues; i++){
-		valid = 0;
-		for(j = 0; j < rl.card; j++){
-			if(!strcmp(values[i], rl.values[j])){
-				valid = 1;
-				break;
-			}
-		}
-		if(!valid){
-		   	printf("debug: CHECK MODELS FAIL!\n");
-		   	printf("debug: In function Sets_createElementFromStrings(), \"%s\" is invalid...\n", values[i]);
-		   	printf("debug: It does not correspond to any value in the given ReferenceList.\n");
-		   	printf("debug: Given reference list:\n");
-		   	for(j = 0; j < rl.card; j++){
-		   		printf("debug: %s\n", rl.values[j]);
-		   	}
-		}
-	}
+    int j = 0;
     #endif
 	
     /*Memory allocation: */
     newElem.values = malloc(sizeof(char) * rl.card);
     DEBUG_CHECK_MALLOC(newElem.values);
 
-    /*Fill the element: */
+    /*Initialize: */
     for(i = 0; i < rl.card; i++){
-        /*Initialize: */
         newElem.values[i] = 0;
-        /*If the value is referenced: */
-        for(j = 0; j < nbValues; j++){
-            if(!strcmp(rl.values[i], values[j])) {
-                newElem.values[i] = 1;
+    }
+
+    /*Fill the element with the referenced values: */
+    for(i = 0; i < nbValues; i++){
+        position = Sets_getRefListPosition(rl, values[i]);
+        if(position != -1){
+            if(!newElem.values[position]){
+                newElem.values[position] = 1;
                 newElem.card++;
-                break;
             }
         }
+        #ifdef CHECK_MODELS
+        else {
+		   	printf("debug: CHECK MODELS FAIL!\n");
+		   	printf("debug: In function Sets_createElementFromStrings(), \"%s\" is invalid...\n", values[i]);
+		   	printf("debug: It does not correspond to any value in the given ReferenceList.\n");
+		   	printf("debug: Given reference list:\n");
+		   	for(j = 0; j < rl.card; j++){
+		   		printf("debug: %s\n", rl.values[j]);
+		   	}
+        }
+        #endif
     }
 
     return newElem;
@@ -267,96 +361,65 @@ Sets_Element Sets_createElementFromBits(const char* values, const int size){
 
 Sets_Element Sets_copyElement(const Sets_Element e, const int size){
     Sets_Element copy = {NULL, 0};
-    int i = 0;
 
     /*Copy the element: */
-    copy.card = e.card;
     copy.values = malloc(sizeof(char) * size);
-    DEBUG_CHECK_MALLOC(copy.values);
+    DEBUG_CHECK_MALLOC_OR_RETURN(copy.values, copy);
 
-    for(i = 0; i < size; i++){
-        copy.values[i] = e.values[i];
-    }
+    Sets_copyElementInto(&copy, e, size);
 
     return copy;
 }
 
 Sets_Element Sets_getEmptyElement(const int size){
     Sets_Element emptySet = {NULL, 0};
-    int i = 0;
 
     /*Allocate memory: */
     emptySet.values = malloc(sizeof(char) * size);
-    DEBUG_CHECK_MALLOC(emptySet.values);
+    DEBUG_CHECK_MALLOC_OR_RETURN(emptySet.values, emptySet);
 
-    /*Put zeros: */
-    for(i = 0; i < size; i++){
-        emptySet.values[i] = 0;
-    }
+    Sets_getEmptyElementInto(&emptySet, size);
 
     return emptySet;
 }
 
 Sets_Element Sets_getCompleteElement(const int size){
 	Sets_Element complete = {NULL, 0};
-    int i = 0;
 
     /*Allocate memory: */
     complete.values = malloc(sizeof(char) * size);
-    DEBUG_CHECK_MALLOC(complete.values);
+    DEBUG_CHECK_MALLOC_OR_RETURN(complete.values, complete);
 
-    /*Put ones: */
-    for(i = 0; i < size; i++){
-        complete.values[i] = 1;
-    }
-    complete.card = size;
+    Sets_getCompleteElementInto(&complete, size);
 
     return complete;
 }
 
 Sets_Element Sets_getOpposite(const Sets_Element e, const int size){
     Sets_Element opposite = {NULL, 0};
-    int i = 0;
 
     /*Create opposite: */
-    opposite.card = size - e.card;
     opposite.values = malloc(sizeof(char) * size);
-    DEBUG_CHECK_MALLOC(opposite.values);
+    DEBUG_CHECK_MALLOC_OR_RETURN(opposite.values, opposite);
 
-    for(i = 0; i < size; i++){
-        opposite.values[i] = !e.values[i];
-    }
+    Sets_getOppositeInto(&opposite, e, size);
 
     return opposite;
 }
 
 Sets_Element Sets_elementFromNumber(const int number, const int nbDigits){
-	Sets_Element e = {NULL, 0};
-	int nb = number;
-	int i = 0;
-	
-	e.values = malloc(sizeof(char) * nbDigits);
-	DEBUG_CHECK_MALLOC(e.values);
-
-	for(i = 0; i < nbDigits; i++){
-		e.values[i] = nb % 2 ;
-		nb /= 2;
-		if(e.values[i]){
-			e.card++;
-		}
-	}
-	
-	return e;
+	/*The number is the packed form of the element: */
+	return Sets_unpackElement((Sets_PackedElement)(unsigned int)number, nbDigits);
 }
 
 int Sets_numberFromElement(const Sets_Element e, const int nbDigits){
-	int nb = 0, i = 0;
-	
-	for(i = 0; i < nbDigits; i++){
-		nb += e.values[i] * pow(2, i);
+	#ifdef CHECK_COMPATIBILITY
+	if(nbDigits > 31){
+		printf("debug: in Sets_numberFromElement(), %d digits do not fit in an int, use Sets_packElement().\n", nbDigits);
 	}
-	
-	return nb;
+	#endif
+	/*The number is the packed form of the element: */
+	return (int)Sets_packElement(e, nbDigits);
 }
 
 
@@ -375,38 +438,24 @@ int Sets_numberFromElement(const Sets_Element e, const int nbDigits){
 
 Sets_Element Sets_conjunction(const Sets_Element e1, const Sets_Element e2, const int size){
     Sets_Element conj = {NULL, 0};
-    int i = 0, sum = 0;
 
     /*Memory allocation: */
     conj.values = malloc(sizeof(char) * size);
-    DEBUG_CHECK_MALLOC(conj.values);
+    DEBUG_CHECK_MALLOC_OR_RETURN(conj.values, conj);
 
-    /*Compare both elements: */
-    for(i = 0; i < size; i++){
-        conj.values[i] = e1.values[i] && e2.values[i];
-        sum += conj.values[i];
-    }
-    /*Set cardinal: */
-    conj.card = sum;
+    Sets_conjunctionInto(&conj, e1, e2, size);
 
     return conj;
 }
 
 Sets_Element Sets_disjunction(const Sets_Element e1, const Sets_Element e2, const int size){
     Sets_Element disj = {NULL, 0};
-    int i = 0, sum = 0;
 
     /*Memory allocation: */
     disj.values = malloc(sizeof(char) * size);
-    DEBUG_CHECK_MALLOC(disj.values);
+    DEBUG_CHECK_MALLOC_OR_RETURN(disj.values, disj);
 
-    /*Compare both elements: */
-    for(i = 0; i < size; i++){
-        disj.values[i] = e1.values[i] || e2.values[i];
-        sum += disj.values[i];
-    }
-    /*Set cardinal: */
-    disj.card = sum;
+    Sets_disjunctionInto(&disj, e1, e2, size);
 
     return disj;
 }
@@ -449,6 +498,480 @@ int Sets_isSubset(const Sets_Element e1, const Sets_Element e2, const int size){
 
 /** @} */
 
+/**
+ * @name Operations on elements without allocation
+ * @{
+ */
+
+/*
+ +-------------------------------+
+ | Operations without allocation |
+ +-------------------------------+
+*/
+
+void Sets_copyElementInto(Sets_Element* dst, const Sets_Element e, const int size){
+    memmove(dst->values, e.values, sizeof(char) * size);
+    dst->card = e.card;
+}
+
+void Sets_getEmptyElementInto(Sets_Element* dst, const int size){
+    /*Put zeros: */
+    memset(dst->values, 0, sizeof(char) * size);
+    dst->card = 0;
+}
+
+void Sets_getCompleteElementInto(Sets_Element* dst, const int size){
+    /*Put ones: */
+    memset(dst->values, 1, sizeof(char) * size);
+    dst->card = size;
+}
+
+void Sets_getOppositeInto(Sets_Element* dst, const Sets_Element e, const int size){
+    int i = 0;
+
+    /*The cardinal first as dst may be e: */
+    dst->card = size - e.card;
+    for(i = 0; i < size; i++){
+        dst->values[i] = !e.values[i];
+    }
+}
+
+void Sets_conjunctionInto(Sets_Element* dst, const Sets_Element e1, const Sets_Element e2, const int size){
+    int i = 0, sum = 0;
+
+    /*Compare both elements: */
+    for(i = 0; i < size; i++){
+        dst->values[i] = e1.values[i] && e2.values[i];
+        sum += dst->values[i];
+    }
+    /*Set cardinal: */
+    dst->card = sum;
+}
+
+void Sets_disjunctionInto(Sets_Element* dst, const Sets_Element e1, const Sets_Element e2, const int size){
+    int i = 0, sum = 0;
+
+    /*Compare both elements: */
+    for(i = 0; i < size; i++){
+        dst->values[i] = e1.values[i] || e2.values[i];
+        sum += dst->values[i];
+    }
+    /*Set cardinal: */
+    dst->card = sum;
+}
+
+/** @} */
+
+/**
+ * @name Packed elements
+ * @{
+ */
+
+/*
+ +-----------------+
+ | Packed elements |
+ +-----------------+
+*/
+
+Sets_PackedElement Sets_packElement(const Sets_Element e, const int size){
+    Sets_PackedElement packed = 0;
+    int i = 0;
+    /*A word only holds the first SETS_PACKED_MAX_SIZE atoms: */
+    const int nbBits = size < SETS_PACKED_MAX_SIZE ? size : SETS_PACKED_MAX_SIZE;
+    #if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+    uint64_t bytes = 0;
+
+    /*Gather the atoms 8 by 8 (each byte is 0 or 1) with a multiplication: */
+    for(i = 0; i + 8 <= nbBits; i += 8){
+        memcpy(&bytes, e.values + i, 8);
+        packed |= ((bytes * UINT64_C(0x0102040810204080)) >> 56) << i;
+    }
+    #endif
+    /*Remaining atoms: */
+    for(; i < nbBits; i++){
+        if(e.values[i]){
+            packed |= (Sets_PackedElement)1 << i;
+        }
+    }
+
+    return packed;
+}
+
+Sets_Element Sets_unpackElement(const Sets_PackedElement p, const int size){
+    Sets_Element e = {NULL, 0};
+
+    e.values = malloc(sizeof(char) * size);
+    DEBUG_CHECK_MALLOC_OR_RETURN(e.values, e);
+
+    Sets_unpackElementInto(&e, p, size);
+
+    return e;
+}
+
+void Sets_unpackElementInto(Sets_Element* dst, const Sets_PackedElement p, const int size){
+    int i = 0;
+    const int nbBits = size < SETS_PACKED_MAX_SIZE ? size : SETS_PACKED_MAX_SIZE;
+
+    for(i = 0; i < nbBits; i++){
+        dst->values[i] = (p >> i) & 1;
+    }
+    /*The atoms beyond the word are not in the element: */
+    if(size > nbBits){
+        memset(dst->values + nbBits, 0, size - nbBits);
+    }
+    dst->card = Sets_packedCard(p);
+}
+
+Sets_PackedElement Sets_packedFromStrings(const char* const * const values, const int nbValues, const Sets_ReferenceList rl){
+    Sets_PackedElement p = 0;
+    int i = 0, position = 0;
+
+    /*Set the bits of the referenced values: */
+    for(i = 0; i < nbValues; i++){
+        position = Sets_getRefListPosition(rl, values[i]);
+        if(position != -1){
+            p |= (Sets_PackedElement)1 << position;
+        }
+        #ifdef CHECK_MODELS
+        else {
+            printf("debug: CHECK MODELS FAIL!\n");
+            printf("debug: In function Sets_packedFromStrings(), \"%s\" is invalid...\n", values[i]);
+            printf("debug: It does not correspond to any value in the given ReferenceList.\n");
+        }
+        #endif
+    }
+
+    return p;
+}
+
+Sets_PackedElement Sets_packedFromBits(const char* values, const int size){
+    Sets_PackedElement p = 0;
+    int i = 0;
+
+    for(i = 0; i < size; i++){
+        if(values[i]){
+            p |= (Sets_PackedElement)1 << i;
+        }
+    }
+
+    return p;
+}
+
+char* Sets_packedToString(const Sets_PackedElement p, const Sets_ReferenceList rl){
+    char* str = NULL;
+    int i = 0, totChar = 0, sum = 0;
+
+    /*Empty set: */
+    if(p == 0){
+        str = malloc(sizeof(char) * 7);
+        DEBUG_CHECK_MALLOC(str);
+
+        strcpy(str, "{void}");
+        return str;
+    }
+
+    /*Size of the values, the braquets and the union symbols: */
+    totChar = 3;
+    for(i = 0; i < rl.card; i++){
+        if((p >> i) & 1){
+            totChar += strlen(rl.values[i]) + 3;
+        }
+    }
+    str = malloc(sizeof(char) * totChar);
+    DEBUG_CHECK_MALLOC(str);
+
+    /*Create the string: */
+    strcpy(str, "{");
+    for(i = 0; i < rl.card; i++){
+        if((p >> i) & 1){
+            if(sum++ > 0){
+                strcat(str, " u ");
+            }
+            strcat(str, rl.values[i]);
+        }
+    }
+    strcat(str, "}");
+
+    return str;
+}
+
+char* Sets_packedToBitString(const Sets_PackedElement p, const int size){
+    char* str = NULL;
+    int i = 0;
+
+    str = malloc(sizeof(char) * (size + 1));
+    DEBUG_CHECK_MALLOC(str);
+
+    for(i = 0; i < size; i++){
+        str[i] = ((p >> i) & 1) ? '1' : '0';
+    }
+    str[i] = '\0';
+
+    return str;
+}
+
+/** @} */
+
+/**
+ * @name Lazy powersets
+ * @{
+ */
+
+/*
+ +-----------------+
+ | Lazy powersets  |
+ +-----------------+
+*/
+
+Sets_PowerSetView Sets_getPowerSetView(const int elementSize){
+    Sets_PowerSetView view;
+
+    #ifdef CHECK_VALUES
+    if(elementSize > SETS_PACKED_MAX_SIZE){
+        printf("debug: in Sets_getPowerSetView(), views are only available for frames of at most %d atoms.\n", SETS_PACKED_MAX_SIZE);
+    }
+    #endif
+
+    view.elementSize = elementSize;
+    view.minCard = 0;
+    view.maxCard = elementSize;
+    view.subsetOf = Sets_packedCompleteElement(elementSize);
+    view.supersetOf = 0;
+
+    return view;
+}
+
+Sets_PowerSetView Sets_restrictToCardinality(const Sets_PowerSetView view, const int minCard, const int maxCard){
+    Sets_PowerSetView restricted = view;
+
+    if(minCard > restricted.minCard){
+        restricted.minCard = minCard;
+    }
+    if(maxCard < restricted.maxCard){
+        restricted.maxCard = maxCard;
+    }
+
+    return restricted;
+}
+
+Sets_PowerSetView Sets_restrictToSubsetsOf(const Sets_PowerSetView view, const Sets_Element e){
+    Sets_PowerSetView restricted = view;
+
+    restricted.subsetOf &= Sets_packElement(e, view.elementSize);
+
+    return restricted;
+}
+
+Sets_PowerSetView Sets_restrictToSupersetsOf(const Sets_PowerSetView view, const Sets_Element e){
+    Sets_PowerSetView restricted = view;
+
+    restricted.supersetOf |= Sets_packElement(e, view.elementSize);
+
+    return restricted;
+}
+
+Sets_PowerSetIterator Sets_iteratePowerSet(const Sets_PowerSetView view){
+    Sets_PowerSetIterator it;
+    int fixedCard = Sets_packedCard(view.supersetOf);
+
+    it.view = view;
+    it.id = 0;
+    it.combination = 0;
+    it.card = -1;
+    /*The atoms of supersetOf are always there, the others may vary: */
+    it.atoms = view.subsetOf & ~view.supersetOf;
+    it.nbAtoms = Sets_packedCard(it.atoms);
+    it.minCard = view.minCard - fixedCard;
+    if(it.minCard < 0){
+        it.minCard = 0;
+    }
+    it.maxCard = view.maxCard - fixedCard;
+    if(it.maxCard > it.nbAtoms){
+        it.maxCard = it.nbAtoms;
+    }
+    /*Empty views: */
+    if(!Sets_packedIsSubset(view.supersetOf, view.subsetOf) || it.minCard > it.maxCard){
+        it.minCard = 0;
+        it.maxCard = -1;
+    }
+    /*Skip combinations only if it saves something: */
+    it.byCard = it.minCard > 0 || it.maxCard < it.nbAtoms;
+
+    it.element = Sets_getEmptyElement(view.elementSize);
+
+    return it;
+}
+
+int Sets_nextSubset(Sets_PowerSetIterator* it){
+    Sets_PackedElement lowest = 0, ripple = 0, next = 0, scattered = 0, atoms = 0, bit = 0;
+    Sets_PackedElement end = it->nbAtoms < SETS_PACKED_MAX_SIZE ? (Sets_PackedElement)1 << it->nbAtoms : 0;
+
+    /*Already at the end: */
+    if(it->card > it->maxCard){
+        return 0;
+    }
+
+    if(it->byCard){
+        if(it->card < 0){
+            if(it->maxCard < 0){
+                return 0;
+            }
+            /*Smallest combination with minCard atoms: */
+            it->combination = Sets_packedCompleteElement(it->minCard);
+        }
+        else if(it->minCard == it->maxCard){
+            /*Next combination with the same number of atoms (Gosper's hack): */
+            lowest = it->combination & -it->combination;
+            ripple = it->combination + lowest;
+            if(lowest == 0 || ripple == 0){
+                it->card = it->maxCard + 1;
+                return 0;
+            }
+            it->combination = ripple + (((ripple ^ it->combination) / lowest) >> 2);
+        }
+        else {
+            /*Next combination with a number of atoms in [minCard, maxCard]: */
+            next = it->combination + 1;
+            while(next != 0 && next != end){
+                if(Sets_packedCard(next) > it->maxCard){
+                    /*All the numbers up to the next carry have too many atoms: */
+                    next += next & -next;
+                }
+                else if(Sets_packedCard(next) < it->minCard){
+                    /*Add the lowest missing atoms: */
+                    next |= next + 1;
+                }
+                else {
+                    break;
+                }
+            }
+            it->combination = next;
+        }
+        if(end != 0 && (it->combination >> it->nbAtoms) != 0){
+            it->card = it->maxCard + 1;
+            return 0;
+        }
+        if(it->card >= 0 && it->combination == 0){
+            it->card = it->maxCard + 1;
+            return 0;
+        }
+
+        /*Scatter the combination over the varying atoms: */
+        atoms = it->atoms;
+        for(bit = 1; atoms != 0; bit <<= 1){
+            if(it->combination & bit){
+                scattered |= atoms & -atoms;
+            }
+            atoms &= atoms - 1;
+        }
+    }
+    else {
+        /*Next subset of the varying atoms: */
+        if(it->card < 0){
+            if(it->maxCard < 0){
+                return 0;
+            }
+            it->combination = 0;
+        }
+        else {
+            it->combination = (it->combination - it->atoms) & it->atoms;
+            if(it->combination == 0){
+                it->card = it->maxCard + 1;
+                return 0;
+            }
+        }
+        scattered = it->combination;
+    }
+
+    it->card = Sets_packedCard(it->combination);
+    it->id = it->view.supersetOf | scattered;
+    Sets_unpackElementInto(&(it->element), it->id, it->view.elementSize);
+
+    return 1;
+}
+
+void Sets_freePowerSetIterator(Sets_PowerSetIterator* it){
+    Sets_freeElement(&(it->element));
+}
+
+/** @} */
+
+/**
+ * @name Set algebra contexts
+ * @{
+ */
+
+/*
+ +----------------------+
+ | Set algebra contexts |
+ +----------------------+
+*/
+
+Sets_Context Sets_createContext(const int elementSize){
+    Sets_Context ctx;
+
+    ctx.elementSize = elementSize;
+    ctx.fullMask = 0;
+    if(elementSize <= SETS_PACKED_MAX_SIZE){
+        ctx.fullMask = Sets_packedCompleteElement(elementSize);
+    }
+    ctx.jaccard = NULL;
+
+    return ctx;
+}
+
+Sets_Context Sets_createContextFromRefList(const Sets_ReferenceList rl){
+    return Sets_createContext(rl.card);
+}
+
+int Sets_enableJaccardCache(Sets_Context* ctx){
+    Sets_PackedElement a = 0, b = 0, nbSubsets = 0;
+    int conj = 0;
+
+    if(ctx->jaccard != NULL){
+        return 1;
+    }
+    if(ctx->elementSize > SETS_JACCARD_CACHE_MAX_SIZE){
+        return 0;
+    }
+
+    nbSubsets = (Sets_PackedElement)1 << ctx->elementSize;
+    ctx->jaccard = malloc(sizeof(float) * nbSubsets * nbSubsets);
+    DEBUG_CHECK_MALLOC_OR_RETURN(ctx->jaccard, 0);
+
+    for(a = 0; a < nbSubsets; a++){
+        for(b = 0; b < nbSubsets; b++){
+            if(a == 0 && b == 0){
+                ctx->jaccard[0] = 1;
+            }
+            else {
+                /*|A u B| = |A| + |B| - |A n B|: */
+                conj = Sets_packedCard(a & b);
+                ctx->jaccard[(a << ctx->elementSize) | b] =
+                        (float)conj / (float)(Sets_packedCard(a) + Sets_packedCard(b) - conj);
+            }
+        }
+    }
+
+    return 1;
+}
+
+float Sets_jaccardInContext(const Sets_Context* ctx, const Sets_PackedElement a, const Sets_PackedElement b){
+    int conj = 0;
+
+    if(ctx->jaccard != NULL){
+        return ctx->jaccard[(a << ctx->elementSize) | b];
+    }
+    if(a == 0 && b == 0){
+        return 1;
+    }
+    conj = Sets_packedCard(a & b);
+
+    return (float)conj / (float)(Sets_packedCard(a) + Sets_packedCard(b) - conj);
+}
+
+/** @} */
+
 /**
  * @name Memory deallocation
  * @{
@@ -467,6 +990,8 @@ void Sets_freeReferenceList(Sets_ReferenceList* rl){
         free(rl->values[i]);
     }
     free(rl->values);
+    freeRefListIndex(rl->index);
+    rl->index = NULL;
 }
 
 void Sets_freeElement(Sets_Element* e){
@@ -484,6 +1009,11 @@ void Sets_freeSet(Sets_Set* s){
     free(s->elements);
 }
 
+void Sets_freeContext(Sets_Context* ctx){
+    free(ctx->jaccard);
+    ctx->jaccard = NULL;
+}
+
 /** @} */
 
 /**
@@ -498,133 +1028,91 @@ void Sets_freeSet(Sets_Set* s){
 */
 
 char* Sets_elementToString(const Sets_Element e, const Sets_ReferenceList rl){
-    char* str = NULL;
-    int i = 0, totChar = 0;
-    int sum = 0, firstElement = -1;
+    StringBuffer buffer = StringBuffer_create(32);
 
-    /*Empty set: */
-    if(e.card == 0){
-        str = malloc(sizeof(char) * 7);
-        DEBUG_CHECK_MALLOC(str);
+    Sets_appendElement(&buffer, e, rl);
 
-        strcpy(str, "{void}\0");
-    }
-    /*Others: */
-    else{
-        /*Size of the values: */
-        for(i = 0; i<rl.card; i++){
-            if(e.values[i]){
-                totChar += strlen(rl.values[i]);
-                if(firstElement == -1) { firstElement = i; }
-                sum++;
-            }
-        }
-        /*Add the braquets and the union symbols: */
-        totChar += 4 + 3*(sum - 1);
-        /*Allocate memory: */
-        str = malloc(sizeof(char)*totChar);
-        DEBUG_CHECK_MALLOC(str);
-        /*Create the string: */
-        sprintf(str, "{%s", rl.values[firstElement]);
-        for(i = firstElement + 1; i<rl.card; i++){
-            if(e.values[i]) {
-                strcat(str, " u ");
-                strcat(str, (rl.values)[i]);
-            }
-        }
-        strcat(str,"}\0");
-    }
-
-    return str;
+    return buffer.str;
 }
 
 char* Sets_elementToBitString(const Sets_Element e, int size){
-	char* str = NULL;
-	int i = 0;
-	
-	str = malloc(sizeof(char) * (size + 1));
-	DEBUG_CHECK_MALLOC(str);
+    StringBuffer buffer = StringBuffer_create(size + 1);
 
-	for(i = 0; i < size; i++){
-		str[i] = e.values[i] ? '1' :'0';
-	}
-	str[i] = '\0';
-	
-	return str;
+    Sets_appendElementBits(&buffer, e, size);
+
+    return buffer.str;
 }
 
 char* Sets_setToString(const Sets_Set s, const Sets_ReferenceList rl){
-    char* str = NULL;
-    char** elements = NULL;
-    int i = 0, totChar = 0;
+    StringBuffer buffer = StringBuffer_create(32 * (s.card + 1));
 
-    /*Allocate memory for elements strings: */
-    elements = malloc(sizeof(char*)*s.card);
-    DEBUG_CHECK_MALLOC_OR_RETURN(elements, NULL);
+    Sets_appendSet(&buffer, s, rl);
 
-    /*Count the number of chars: */
-    for(i = 0; i<s.card; i++) {
-        elements[i] = Sets_elementToString(s.elements[i], rl);
-        totChar += strlen(elements[i]);
-    }
-    totChar += 3 + 2*(s.card - 1);
-
-    /*Allocate memory for the string: */
-    str = malloc(sizeof(char)*(totChar+1));
-    DEBUG_CHECK_MALLOC_OR_RETURN(str, NULL);
+    return buffer.str;
+}
 
-    /*Fill the string: */
-    sprintf(str, "{%s", elements[0]);
-    for(i = 1; i<s.card; i++){
-        strcat(str, ", ");
-        strcat(str, elements[i]);
-    }
-    strcat(str,"}\0");
+char* Sets_setToBitString(const Sets_Set s, int size){
+    StringBuffer buffer = StringBuffer_create(s.card * (size + 2) + 3);
 
-    /*Deallocate useless memory: */
-    for(i = 0; i<s.card; i++){
-        free(elements[i]);
-    }
-    free(elements);
+    Sets_appendSetBits(&buffer, s, size);
 
-    return str;
+    return buffer.str;
 }
 
-char* Sets_setToBitString(const Sets_Set s, int size){
-	char* str = NULL;
-    char** elements = NULL;
-    int i = 0, totChar = 0;
-
-    /*Allocate memory for elements strings: */
-    elements = malloc(sizeof(char*)*s.card);
-    DEBUG_CHECK_MALLOC_OR_RETURN(elements, NULL);
+void Sets_appendElement(StringBuffer* buffer, const Sets_Element e, const Sets_ReferenceList rl){
+    int i = 0, first = 1;
 
-    /*Count the number of chars: */
-    for(i = 0; i<s.card; i++) {
-        elements[i] = Sets_elementToBitString(s.elements[i], size);
-        totChar += strlen(elements[i]);
+    /*Empty set: */
+    if(e.card == 0){
+        StringBuffer_append(buffer, "{void}");
+        return;
+    }
+    /*Others: */
+    StringBuffer_appendChar(buffer, '{');
+    for(i = 0; i < rl.card; i++){
+        if(e.values[i]){
+            if(!first){
+                StringBuffer_append(buffer, " u ");
+            }
+            StringBuffer_append(buffer, rl.values[i]);
+            first = 0;
+        }
     }
-    totChar += 3 + 2*(s.card - 1);
+    StringBuffer_appendChar(buffer, '}');
+}
 
-    /*Allocate memory for the string: */
-    str = malloc(sizeof(char)*(totChar+1));
-    DEBUG_CHECK_MALLOC_OR_RETURN(str, NULL);
+void Sets_appendElementBits(StringBuffer* buffer, const Sets_Element e, const int size){
+    int i = 0;
 
-    /*Fill the string: */
-    sprintf(str, "{%s", elements[0]);
-    for(i = 1; i<s.card; i++){
-        strcat(str, ", ");
-        strcat(str, elements[i]);
+    for(i = 0; i < size; i++){
+        StringBuffer_appendChar(buffer, e.values[i] ? '1' : '0');
     }
-    strcat(str,"}\0");
+}
 
-    /*Deallocate useless memory: */
-    for(i = 0; i<s.card; i++){
-        free(elements[i]);
+void Sets_appendSet(StringBuffer* buffer, const Sets_Set s, const Sets_ReferenceList rl){
+    int i = 0;
+
+    StringBuffer_appendChar(buffer, '{');
+    for(i = 0; i < s.card; i++){
+        if(i > 0){
+            StringBuffer_append(buffer, ", ");
+        }
+        Sets_appendElement(buffer, s.elements[i], rl);
     }
-    free(elements);
+    StringBuffer_appendChar(buffer, '}');
+}
 
-    return str;
+void Sets_appendSetBits(StringBuffer* buffer, const Sets_Set s, const int size){
+    int i = 0;
+
+    StringBuffer_appendChar(buffer, '{');
+    for(i = 0; i < s.card; i++){
+        if(i > 0){
+            StringBuffer_append(buffer, ", ");
+        }
+        Sets_appendElementBits(buffer, s.elements[i], size);
+    }
+    StringBuffer_appendChar(buffer, '}');
 }
 
 /** @} */
@@ -0,0 +1,675 @@
+/*
+ * Copyright 2011-2014, EDF. This software was developed with the collaboration of INRIA (Bastien Pietropaoli)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include "SetsWide.h"
+
+#if defined(__GNUC__) && defined(__x86_64__)
+#define SETS_X86_KERNELS
+#include <immintrin.h>
+#endif
+
+#include "ArenaAllocation.h"
+
+
+/**
+ * @file SetsWide.c
+ * @author Bastien Pietropaoli (bastien.pietropaoli@inria.fr)
+ * @brief CORE: Implements multi-word elements
+ * and vectorized operations on them.
+ */
+
+/*
+  +-------------------+
+  | PRIVATE FUNCTIONS |
+  +-------------------+
+*/
+
+/**
+ * A set of kernels working on words.
+ */
+typedef struct {
+	void (*conjunction)(uint64_t*, const uint64_t*, const uint64_t*, const int);
+	void (*disjunction)(uint64_t*, const uint64_t*, const uint64_t*, const int);
+	void (*difference)(uint64_t*, const uint64_t*, const uint64_t*, const int);
+	int (*card)(const uint64_t*, const int);
+	int (*conjunctionCard)(const uint64_t*, const uint64_t*, const int);
+	int (*isSubset)(const uint64_t*, const uint64_t*, const int);
+	int (*equals)(const uint64_t*, const uint64_t*, const int);
+} Kernels;
+
+
+/* !!! Scalar kernels !!! */
+
+static void scalarConjunction(uint64_t* dst, const uint64_t* a, const uint64_t* b, const int nbWords) {
+	int i = 0;
+	for(i = 0; i < nbWords; i++){
+		dst[i] = a[i] & b[i];
+	}
+}
+
+static void scalarDisjunction(uint64_t* dst, const uint64_t* a, const uint64_t* b, const int nbWords) {
+	int i = 0;
+	for(i = 0; i < nbWords; i++){
+		dst[i] = a[i] | b[i];
+	}
+}
+
+static void scalarDifference(uint64_t* dst, const uint64_t* a, const uint64_t* b, const int nbWords) {
+	int i = 0;
+	for(i = 0; i < nbWords; i++){
+		dst[i] = a[i] & ~b[i];
+	}
+}
+
+static int scalarCard(const uint64_t* a, const int nbWords) {
+	int i = 0, card = 0;
+	for(i = 0; i < nbWords; i++){
+		card += Sets_packedCard(a[i]);
+	}
+	return card;
+}
+
+static int scalarConjunctionCard(const uint64_t* a, const uint64_t* b, const int nbWords) {
+	int i = 0, card = 0;
+	for(i = 0; i < nbWords; i++){
+		card += Sets_packedCard(a[i] & b[i]);
+	}
+	return card;
+}
+
+static int scalarIsSubset(const uint64_t* a, const uint64_t* b, const int nbWords) {
+	int i = 0;
+	for(i = 0; i < nbWords; i++){
+		if(a[i] & ~b[i]){
+			return 0;
+		}
+	}
+	return 1;
+}
+
+static int scalarEquals(const uint64_t* a, const uint64_t* b, const int nbWords) {
+	int i = 0;
+	for(i = 0; i < nbWords; i++){
+		if(a[i] != b[i]){
+			return 0;
+		}
+	}
+	return 1;
+}
+
+static const Kernels scalarKernels = {
+	scalarConjunction, scalarDisjunction, scalarDifference,
+	scalarCard, scalarConjunctionCard, scalarIsSubset, scalarEquals
+};
+
+
+#ifdef SETS_X86_KERNELS
+
+/* !!! SSE4.2 kernels (2 words at a time) !!! */
+
+#define SSE_TARGET __attribute__((target("sse4.2,popcnt")))
+
+SSE_TARGET
+static void sseConjunction(uint64_t* dst, const uint64_t* a, const uint64_t* b, const int nbWords) {
+	int i = 0;
+	for(i = 0; i + 2 <= nbWords; i += 2){
+		_mm_storeu_si128((__m128i*)(dst + i), _mm_and_si128(
+				_mm_loadu_si128((const __m128i*)(a + i)), _mm_loadu_si128((const __m128i*)(b + i))));
+	}
+	for(; i < nbWords; i++){
+		dst[i] = a[i] & b[i];
+	}
+}
+
+SSE_TARGET
+static void sseDisjunction(uint64_t* dst, const uint64_t* a, const uint64_t* b, const int nbWords) {
+	int i = 0;
+	for(i = 0; i + 2 <= nbWords; i += 2){
+		_mm_storeu_si128((__m128i*)(dst + i), _mm_or_si128(
+				_mm_loadu_si128((const __m128i*)(a + i)), _mm_loadu_si128((const __m128i*)(b + i))));
+	}
+	for(; i < nbWords; i++){
+		dst[i] = a[i] | b[i];
+	}
+}
+
+SSE_TARGET
+static void sseDifference(uint64_t* dst, const uint64_t* a, const uint64_t* b, const int nbWords) {
+	int i = 0;
+	for(i = 0; i + 2 <= nbWords; i += 2){
+		/* andnot(x, y) = ~x & y */
+		_mm_storeu_si128((__m128i*)(dst + i), _mm_andnot_si128(
+				_mm_loadu_si128((const __m128i*)(b + i)), _mm_loadu_si128((const __m128i*)(a + i))));
+	}
+	for(; i < nbWords; i++){
+		dst[i] = a[i] & ~b[i];
+	}
+}
+
+SSE_TARGET
+static int sseCard(const uint64_t* a, const int nbWords) {
+	int i = 0, card = 0;
+	for(i = 0; i < nbWords; i++){
+		card += (int)_mm_popcnt_u64(a[i]);
+	}
+	return card;
+}
+
+SSE_TARGET
+static int sseConjunctionCard(const uint64_t* a, const uint64_t* b, const int nbWords) {
+	int i = 0, card = 0;
+	for(i = 0; i < nbWords; i++){
+		card += (int)_mm_popcnt_u64(a[i] & b[i]);
+	}
+	return card;
+}
+
+SSE_TARGET
+static int sseIsSubset(const uint64_t* a, const uint64_t* b, const int nbWords) {
+	__m128i diff;
+	int i = 0;
+	for(i = 0; i + 2 <= nbWords; i += 2){
+		diff = _mm_andnot_si128(_mm_loadu_si128((const __m128i*)(b + i)), _mm_loadu_si128((const __m128i*)(a + i)));
+		if(!_mm_testz_si128(diff, diff)){
+			return 0;
+		}
+	}
+	for(; i < nbWords; i++){
+		if(a[i] & ~b[i]){
+			return 0;
+		}
+	}
+	return 1;
+}
+
+SSE_TARGET
+static int sseEquals(const uint64_t* a, const uint64_t* b, const int nbWords) {
+	__m128i diff;
+	int i = 0;
+	for(i = 0; i + 2 <= nbWords; i += 2){
+		diff = _mm_xor_si128(_mm_loadu_si128((const __m128i*)(a + i)), _mm_loadu_si128((const __m128i*)(b + i)));
+		if(!_mm_testz_si128(diff, diff)){
+			return 0;
+		}
+	}
+	for(; i < nbWords; i++){
+		if(a[i] != b[i]){
+			return 0;
+		}
+	}
+	return 1;
+}
+
+static const Kernels sseKernels = {
+	sseConjunction, sseDisjunction, sseDifference,
+	sseCard, sseConjunctionCard, sseIsSubset, sseEquals
+};
+
+
+/* !!! AVX2 kernels (4 words at a time) !!! */
+
+#define AVX2_TARGET __attribute__((target("avx2,popcnt")))
+
+AVX2_TARGET
+static void avx2Conjunction(uint64_t* dst, const uint64_t* a, const uint64_t* b, const int nbWords) {
+	int i = 0;
+	for(i = 0; i + 4 <= nbWords; i += 4){
+		_mm256_storeu_si256((__m256i*)(dst + i), _mm256_and_si256(
+				_mm256_loadu_si256((const __m256i*)(a + i)), _mm256_loadu_si256((const __m256i*)(b + i))));
+	}
+	for(; i < nbWords; i++){
+		dst[i] = a[i] & b[i];
+	}
+}
+
+AVX2_TARGET
+static void avx2Disjunction(uint64_t* dst, const uint64_t* a, const uint64_t* b, const int nbWords) {
+	int i = 0;
+	for(i = 0; i + 4 <= nbWords; i += 4){
+		_mm256_storeu_si256((__m256i*)(dst + i), _mm256_or_si256(
+				_mm256_loadu_si256((const __m256i*)(a + i)), _mm256_loadu_si256((const __m256i*)(b + i))));
+	}
+	for(; i < nbWords; i++){
+		dst[i] = a[i] | b[i];
+	}
+}
+
+AVX2_TARGET
+static void avx2Difference(uint64_t* dst, const uint64_t* a, const uint64_t* b, const int nbWords) {
+	int i = 0;
+	for(i = 0; i + 4 <= nbWords; i += 4){
+		_mm256_storeu_si256((__m256i*)(dst + i), _mm256_andnot_si256(
+				_mm256_loadu_si256((const __m256i*)(b + i)), _mm256_loadu_si256((const __m256i*)(a + i))));
+	}
+	for(; i < nbWords; i++){
+		dst[i] = a[i] & ~b[i];
+	}
+}
+
+/* Counts the bits of each 64-bit lane with a lookup of 4-bit values (Mula's algorithm): */
+AVX2_TARGET
+static __m256i avx2LaneCard(const __m256i v) {
+	const __m256i lookup = _mm256_setr_epi8(0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4,
+			0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4);
+	const __m256i lowMask = _mm256_set1_epi8(0x0f);
+	__m256i low = _mm256_and_si256(v, lowMask);
+	__m256i high = _mm256_and_si256(_mm256_srli_epi16(v, 4), lowMask);
+	__m256i bytes = _mm256_add_epi8(_mm256_shuffle_epi8(lookup, low), _mm256_shuffle_epi8(lookup, high));
+	return _mm256_sad_epu8(bytes, _mm256_setzero_si256());
+}
+
+AVX2_TARGET
+static int avx2SumLanes(const __m256i v) {
+	__m128i sum = _mm_add_epi64(_mm256_castsi256_si128(v), _mm256_extracti128_si256(v, 1));
+	return (int)(_mm_cvtsi128_si64(sum) + _mm_extract_epi64(sum, 1));
+}
+
+AVX2_TARGET
+static int avx2Card(const uint64_t* a, const int nbWords) {
+	__m256i acc = _mm256_setzero_si256();
+	int i = 0, card = 0;
+	for(i = 0; i + 4 <= nbWords; i += 4){
+		acc = _mm256_add_epi64(acc, avx2LaneCard(_mm256_loadu_si256((const __m256i*)(a + i))));
+	}
+	card = avx2SumLanes(acc);
+	for(; i < nbWords; i++){
+		card += (int)_mm_popcnt_u64(a[i]);
+	}
+	return card;
+}
+
+AVX2_TARGET
+static int avx2ConjunctionCard(const uint64_t* a, const uint64_t* b, const int nbWords) {
+	__m256i acc = _mm256_setzero_si256();
+	int i = 0, card = 0;
+	for(i = 0; i + 4 <= nbWords; i += 4){
+		acc = _mm256_add_epi64(acc, avx2LaneCard(_mm256_and_si256(
+				_mm256_loadu_si256((const __m256i*)(a + i)), _mm256_loadu_si256((const __m256i*)(b + i)))));
+	}
+	card = avx2SumLanes(acc);
+	for(; i < nbWords; i++){
+		card += (int)_mm_popcnt_u64(a[i] & b[i]);
+	}
+	return card;
+}
+
+AVX2_TARGET
+static int avx2IsSubset(const uint64_t* a, const uint64_t* b, const int nbWords) {
+	__m256i diff;
+	int i = 0;
+	for(i = 0; i + 4 <= nbWords; i += 4){
+		diff = _mm256_andnot_si256(_mm256_loadu_si256((const __m256i*)(b + i)), _mm256_loadu_si256((const __m256i*)(a + i)));
+		if(!_mm256_testz_si256(diff, diff)){
+			return 0;
+		}
+	}
+	for(; i < nbWords; i++){
+		if(a[i] & ~b[i]){
+			return 0;
+		}
+	}
+	return 1;
+}
+
+AVX2_TARGET
+static int avx2Equals(const uint64_t* a, const uint64_t* b, const int nbWords) {
+	__m256i diff;
+	int i = 0;
+	for(i = 0; i + 4 <= nbWords; i += 4){
+		diff = _mm256_xor_si256(_mm256_loadu_si256((const __m256i*)(a + i)), _mm256_loadu_si256((const __m256i*)(b + i)));
+		if(!_mm256_testz_si256(diff, diff)){
+			return 0;
+		}
+	}
+	for(; i < nbWords; i++){
+		if(a[i] != b[i]){
+			return 0;
+		}
+	}
+	return 1;
+}
+
+static const Kernels avx2Kernels = {
+	avx2Conjunction, avx2Disjunction, avx2Difference,
+	avx2Card, avx2ConjunctionCard, avx2IsSubset, avx2Equals
+};
+
+
+/* !!! AVX-512 kernels (8 words at a time, masked tails) !!! */
+
+#define AVX512_TARGET __attribute__((target("avx512f,avx512vpopcntdq")))
+
+AVX512_TARGET
+static __mmask8 avx512Mask(const int remaining) {
+	return remaining >= 8 ? 0xff : (__mmask8)((1 << remaining) - 1);
+}
+
+AVX512_TARGET
+static void avx512Conjunction(uint64_t* dst, const uint64_t* a, const uint64_t* b, const int nbWords) {
+	__mmask8 mask;
+	int i = 0;
+	for(i = 0; i < nbWords; i += 8){
+		mask = avx512Mask(nbWords - i);
+		_mm512_mask_storeu_epi64(dst + i, mask, _mm512_and_si512(
+				_mm512_maskz_loadu_epi64(mask, a + i), _mm512_maskz_loadu_epi64(mask, b + i)));
+	}
+}
+
+AVX512_TARGET
+static void avx512Disjunction(uint64_t* dst, const uint64_t* a, const uint64_t* b, const int nbWords) {
+	__mmask8 mask;
+	int i = 0;
+	for(i = 0; i < nbWords; i += 8){
+		mask = avx512Mask(nbWords - i);
+		_mm512_mask_storeu_epi64(dst + i, mask, _mm512_or_si512(
+				_mm512_maskz_loadu_epi64(mask, a + i), _mm512_maskz_loadu_epi64(mask, b + i)));
+	}
+}
+
+AVX512_TARGET
+static void avx512Difference(uint64_t* dst, const uint64_t* a, const uint64_t* b, const int nbWords) {
+	__mmask8 mask;
+	int i = 0;
+	for(i = 0; i < nbWords; i += 8){
+		mask = avx512Mask(nbWords - i);
+		_mm512_mask_storeu_epi64(dst + i, mask, _mm512_andnot_si512(
+				_mm512_maskz_loadu_epi64(mask, b + i), _mm512_maskz_loadu_epi64(mask, a + i)));
+	}
+}
+
+AVX512_TARGET
+static int avx512Card(const uint64_t* a, const int nbWords) {
+	__m512i acc = _mm512_setzero_si512();
+	int i = 0;
+	for(i = 0; i < nbWords; i += 8){
+		acc = _mm512_add_epi64(acc, _mm512_popcnt_epi64(_mm512_maskz_loadu_epi64(avx512Mask(nbWords - i), a + i)));
+	}
+	return (int)_mm512_reduce_add_epi64(acc);
+}
+
+AVX512_TARGET
+static int avx512ConjunctionCard(const uint64_t* a, const uint64_t* b, const int nbWords) {
+	__m512i acc = _mm512_setzero_si512();
+	__mmask8 mask;
+	int i = 0;
+	for(i = 0; i < nbWords; i += 8){
+		mask = avx512Mask(nbWords - i);
+		acc = _mm512_add_epi64(acc, _mm512_popcnt_epi64(_mm512_and_si512(
+				_mm512_maskz_loadu_epi64(mask, a + i), _mm512_maskz_loadu_epi64(mask, b + i))));
+	}
+	return (int)_mm512_reduce_add_epi64(acc);
+}
+
+AVX512_TARGET
+static int avx512IsSubset(const uint64_t* a, const uint64_t* b, const int nbWords) {
+	__m512i diff;
+	__mmask8 mask;
+	int i = 0;
+	for(i = 0; i < nbWords; i += 8){
+		mask = avx512Mask(nbWords - i);
+		diff = _mm512_andnot_si512(_mm512_maskz_loadu_epi64(mask, b + i), _mm512_maskz_loadu_epi64(mask, a + i));
+		if(_mm512_test_epi64_mask(diff, diff)){
+			return 0;
+		}
+	}
+	return 1;
+}
+
+AVX512_TARGET
+static int avx512Equals(const uint64_t* a, const uint64_t* b, const int nbWords) {
+	__mmask8 mask;
+	int i = 0;
+	for(i = 0; i < nbWords; i += 8){
+		mask = avx512Mask(nbWords - i);
+		if(_mm512_mask_cmpneq_epi64_mask(mask, _mm512_maskz_loadu_epi64(mask, a + i), _mm512_maskz_loadu_epi64(mask, b + i))){
+			return 0;
+		}
+	}
+	return 1;
+}
+
+static const Kernels avx512Kernels = {
+	avx512Conjunction, avx512Disjunction, avx512Difference,
+	avx512Card, avx512ConjunctionCard, avx512IsSubset, avx512Equals
+};
+
+#endif /* SETS_X86_KERNELS */
+
+
+/* !!! Dispatch !!! */
+
+static const Kernels* currentKernels = NULL;
+static Sets_WordKernels currentKernelsName = KERNELS_SCALAR;
+
+static int isSupported(const Sets_WordKernels kernels) {
+	switch(kernels){
+		case KERNELS_SCALAR:
+			return 1;
+		#ifdef SETS_X86_KERNELS
+		case KERNELS_SSE:
+			return __builtin_cpu_supports("sse4.2") && __builtin_cpu_supports("popcnt");
+		case KERNELS_AVX2:
+			return __builtin_cpu_supports("avx2") && __builtin_cpu_supports("popcnt");
+		case KERNELS_AVX512:
+			return __builtin_cpu_supports("avx512f") && __builtin_cpu_supports("avx512vpopcntdq");
+		#endif
+		default:
+			return 0;
+	}
+}
+
+static const Kernels* getKernels(void) {
+	/* The first call selects the kernels. Concurrent first calls (from the threads of
+	   a combination for instance) store the same ones, atomically. */
+	const Kernels* kernels = __atomic_load_n(&currentKernels, __ATOMIC_ACQUIRE);
+	if(kernels == NULL){
+		Sets_useWordKernels(KERNELS_AUTO);
+		kernels = __atomic_load_n(&currentKernels, __ATOMIC_ACQUIRE);
+	}
+	return kernels;
+}
+
+
+
+
+/*
+  +-----------+
+  | FUNCTIONS |
+  +-----------+
+*/
+
+/**
+ * @name Kernel selection
+ * @{
+ */
+
+int Sets_useWordKernels(const Sets_WordKernels kernels){
+	const Kernels* selected = NULL;
+
+	if(kernels == KERNELS_AUTO){
+		if(Sets_useWordKernels(KERNELS_AVX512) || Sets_useWordKernels(KERNELS_AVX2) || Sets_useWordKernels(KERNELS_SSE)){
+			return 1;
+		}
+		return Sets_useWordKernels(KERNELS_SCALAR);
+	}
+
+	if(!isSupported(kernels)){
+		return 0;
+	}
+
+	switch(kernels){
+		#ifdef SETS_X86_KERNELS
+		case KERNELS_SSE:
+			selected = &sseKernels;
+			break;
+		case KERNELS_AVX2:
+			selected = &avx2Kernels;
+			break;
+		case KERNELS_AVX512:
+			selected = &avx512Kernels;
+			break;
+		#endif
+		default:
+			selected = &scalarKernels;
+			break;
+	}
+	__atomic_store_n(&currentKernelsName, kernels, __ATOMIC_RELAXED);
+	__atomic_store_n(&currentKernels, selected, __ATOMIC_RELEASE);
+
+	return 1;
+}
+
+Sets_WordKernels Sets_getWordKernels(void){
+	getKernels();
+	return __atomic_load_n(&currentKernelsName, __ATOMIC_RELAXED);
+}
+
+/** @} */
+
+
+/**
+ * @name Operations on words
+ * @{
+ */
+
+void Sets_packWords(uint64_t* words, const Sets_Element e, const int size){
+	Sets_Element chunk = {NULL, 0};
+	int i = 0;
+
+	for(i = 0; i < SETS_WIDE_NB_WORDS(size); i++){
+		chunk.values = e.values + 64 * i;
+		words[i] = Sets_packElement(chunk, size - 64 * i < 64 ? size - 64 * i : 64);
+	}
+}
+
+void Sets_wordsConjunction(uint64_t* dst, const uint64_t* a, const uint64_t* b, const int nbWords){
+	getKernels()->conjunction(dst, a, b, nbWords);
+}
+
+void Sets_wordsDisjunction(uint64_t* dst, const uint64_t* a, const uint64_t* b, const int nbWords){
+	getKernels()->disjunction(dst, a, b, nbWords);
+}
+
+void Sets_wordsDifference(uint64_t* dst, const uint64_t* a, const uint64_t* b, const int nbWords){
+	getKernels()->difference(dst, a, b, nbWords);
+}
+
+int Sets_wordsCard(const uint64_t* a, const int nbWords){
+	return getKernels()->card(a, nbWords);
+}
+
+int Sets_wordsConjunctionCard(const uint64_t* a, const uint64_t* b, const int nbWords){
+	return getKernels()->conjunctionCard(a, b, nbWords);
+}
+
+int Sets_wordsIsSubset(const uint64_t* a, const uint64_t* b, const int nbWords){
+	return getKernels()->isSubset(a, b, nbWords);
+}
+
+int Sets_wordsEquals(const uint64_t* a, const uint64_t* b, const int nbWords){
+	return getKernels()->equals(a, b, nbWords);
+}
+
+uint64_t Sets_wordsHash(const uint64_t* a, const int nbWords){
+	uint64_t hash = UINT64_C(0x9e3779b97f4a7c15);
+	int i = 0;
+
+	/*Each word is mixed with the finalizer of MurmurHash3 so that all the bits count: */
+	for(i = 0; i < nbWords; i++){
+		hash ^= a[i];
+		hash ^= hash >> 33;
+		hash *= UINT64_C(0xff51afd7ed558ccd);
+		hash ^= hash >> 33;
+		hash *= UINT64_C(0xc4ceb9fe1a85ec53);
+		hash ^= hash >> 33;
+	}
+
+	return hash;
+}
+
+/** @} */
+
+
+/**
+ * @name Wide elements
+ * @{
+ */
+
+Sets_WideElement Sets_wideFromElement(const Sets_Element e, const int size){
+	Sets_WideElement w = {NULL, 0};
+
+	w.words = malloc(sizeof(uint64_t) * SETS_WIDE_NB_WORDS(size));
+	DEBUG_CHECK_MALLOC_OR_RETURN(w.words, w);
+
+	Sets_packWords(w.words, e, size);
+	w.card = e.card;
+
+	return w;
+}
+
+Sets_Element Sets_elementFromWide(const Sets_WideElement w, const int size){
+	Sets_Element e = {NULL, 0};
+	int i = 0;
+
+	e.values = malloc(sizeof(char) * size);
+	DEBUG_CHECK_MALLOC_OR_RETURN(e.values, e);
+
+	for(i = 0; i < size; i++){
+		e.values[i] = (w.words[i / 64] >> (i % 64)) & 1;
+	}
+	e.card = w.card;
+
+	return e;
+}
+
+Sets_WideElement Sets_wideConjunction(const Sets_WideElement e1, const Sets_WideElement e2, const int size){
+	Sets_WideElement conj = {NULL, 0};
+
+	conj.words = malloc(sizeof(uint64_t) * SETS_WIDE_NB_WORDS(size));
+	DEBUG_CHECK_MALLOC_OR_RETURN(conj.words, conj);
+
+	Sets_wordsConjunction(conj.words, e1.words, e2.words, SETS_WIDE_NB_WORDS(size));
+	conj.card = Sets_wordsCard(conj.words, SETS_WIDE_NB_WORDS(size));
+
+	return conj;
+}
+
+Sets_WideElement Sets_wideDisjunction(const Sets_WideElement e1, const Sets_WideElement e2, const int size){
+	Sets_WideElement disj = {NULL, 0};
+
+	disj.words = malloc(sizeof(uint64_t) * SETS_WIDE_NB_WORDS(size));
+	DEBUG_CHECK_MALLOC_OR_RETURN(disj.words, disj);
+
+	Sets_wordsDisjunction(disj.words, e1.words, e2.words, SETS_WIDE_NB_WORDS(size));
+	disj.card = Sets_wordsCard(disj.words, SETS_WIDE_NB_WORDS(size));
+
+	return disj;
+}
+
+int Sets_wideEquals(const Sets_WideElement e1, const Sets_WideElement e2, const int size){
+	return e1.card == e2.card && Sets_wordsEquals(e1.words, e2.words, SETS_WIDE_NB_WORDS(size));
+}
+
+int Sets_wideIsSubset(const Sets_WideElement e1, const Sets_WideElement e2, const int size){
+	return Sets_wordsIsSubset(e1.words, e2.words, SETS_WIDE_NB_WORDS(size));
+}
+
+void Sets_freeWideElement(Sets_WideElement* w){
+	free(w->words);
+}
+
+/** @} */
@@ -0,0 +1,191 @@
+/*
+ * Copyright 2011-2014, EDF. This software was developed with the collaboration of INRIA (Bastien Pietropaoli)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <stdarg.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "StringBuffer.h"
+#include "config.h"
+
+/**
+ * @file StringBuffer.c
+ * @author Bastien Pietropaoli (bastien.pietropaoli@inria.fr)
+ * @brief UTILITY: A growable buffer of characters
+ * to build strings in a single pass.
+ */
+
+/*
+  +-------------------+
+  | PRIVATE FUNCTIONS |
+  +-------------------+
+*/
+
+/*
+ * Makes room for nbChars more characters (and the final '\0').
+ * The capacity is doubled so that appends take a constant amortized time.
+ * Returns 0 if the memory cannot be allocated.
+ */
+static int reserve(StringBuffer* sb, const int nbChars){
+    char* newStr = NULL;
+    int newCapacity = sb->capacity;
+
+    if(sb->length + nbChars + 1 <= sb->capacity){
+        return 1;
+    }
+    if(newCapacity < 16){
+        newCapacity = 16;
+    }
+    while(newCapacity < sb->length + nbChars + 1){
+        newCapacity *= 2;
+    }
+    newStr = realloc(sb->str, sizeof(char) * newCapacity);
+    DEBUG_CHECK_MALLOC_OR_RETURN(newStr, 0);
+
+    sb->str = newStr;
+    sb->capacity = newCapacity;
+
+    return 1;
+}
+
+
+
+/*
+  +-----------+
+  | FUNCTIONS |
+  +-----------+
+*/
+
+/**
+ * @name Creation
+ * @{
+ */
+
+StringBuffer StringBuffer_create(const int capacity){
+    StringBuffer sb = {NULL, 0, 0, NULL};
+
+    if(reserve(&sb, capacity > 0 ? capacity - 1 : 0)){
+        sb.str[0] = '\0';
+    }
+
+    return sb;
+}
+
+StringBuffer StringBuffer_fromFile(FILE* file){
+    StringBuffer sb = {NULL, 0, 0, NULL};
+
+    sb.file = file;
+
+    return sb;
+}
+
+/** @} */
+
+
+/**
+ * @name Writing
+ * @{
+ */
+
+void StringBuffer_append(StringBuffer* sb, const char* str){
+    int len = 0;
+
+    if(sb->file != NULL){
+        fputs(str, sb->file);
+        sb->length += strlen(str);
+        return;
+    }
+    len = strlen(str);
+    if(reserve(sb, len)){
+        memcpy(sb->str + sb->length, str, len + 1);
+        sb->length += len;
+    }
+}
+
+void StringBuffer_appendChar(StringBuffer* sb, const char c){
+    if(sb->file != NULL){
+        fputc(c, sb->file);
+        sb->length++;
+        return;
+    }
+    if(reserve(sb, 1)){
+        sb->str[sb->length] = c;
+        sb->length++;
+        sb->str[sb->length] = '\0';
+    }
+}
+
+void StringBuffer_appendFormat(StringBuffer* sb, const char* format, ...){
+    va_list args;
+    int len = 0;
+
+    if(sb->file != NULL){
+        va_start(args, format);
+        len = vfprintf(sb->file, format, args);
+        va_end(args);
+        if(len > 0){
+            sb->length += len;
+        }
+        return;
+    }
+
+    if(!reserve(sb, 0)){
+        return;
+    }
+    /*Try to write in the remaining space first: */
+    va_start(args, format);
+    len = vsnprintf(sb->str + sb->length, sb->capacity - sb->length, format, args);
+    va_end(args);
+    if(len < 0){
+        sb->str[sb->length] = '\0';
+        return;
+    }
+    if(sb->length + len + 1 > sb->capacity){
+        /*Not enough space, grow and write again: */
+        if(!reserve(sb, len)){
+            sb->str[sb->length] = '\0';
+            return;
+        }
+        va_start(args, format);
+        vsnprintf(sb->str + sb->length, sb->capacity - sb->length, format, args);
+        va_end(args);
+    }
+    sb->length += len;
+}
+
+void StringBuffer_clear(StringBuffer* sb){
+    sb->length = 0;
+    if(sb->str != NULL){
+        sb->str[0] = '\0';
+    }
+}
+
+/** @} */
+
+
+/**
+ * @name Deallocation
+ * @{
+ */
+
+void StringBuffer_free(StringBuffer* sb){
+    free(sb->str);
+    sb->str = NULL;
+    sb->length = 0;
+    sb->capacity = 0;
+}
+
+/** @} */
@@ -87,6 +87,9 @@ static BFS_OptionFlags toOptionFlag(xmlChar *optionName, xmlDoc* doc) {
 	}
 	else if(0 == xmlStrcmp((xmlChar*)"variation",optionName)) {
 		return OP_VARIATION;
+	}
+	else if(0 == xmlStrcmp((xmlChar*)"max-focals",optionName)) {
+		return OP_MAX_FOCALS;
 	} else {
 		fprintf(stderr,
 				"[THEGAME-xml]warning - while parsing %s : unknown option '%s'",
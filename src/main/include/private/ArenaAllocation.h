@@ -0,0 +1,39 @@
+/*
+ * Copyright 2011-2014, EDF. This software was developed with the collaboration of INRIA (Bastien Pietropaoli)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#ifndef DEF_ARENAALLOCATION
+#define DEF_ARENAALLOCATION
+
+#include <stdlib.h>
+
+#include "Arena.h"
+
+/**
+ * Makes the allocations of a module go through the arena of the calling thread (see Arena.h).
+ * Must be included by the source files of the modules only, after all the other headers.
+ *
+ * @file ArenaAllocation.h
+ * @author Bastien Pietropaoli (bastien.pietropaoli@inria.fr)
+ * @brief UTILITY: Redirects the allocations of a module to arenas.
+ */
+
+#define malloc(size) BF_arenaMalloc(size)
+#define calloc(nb, size) BF_arenaCalloc(nb, size)
+#define realloc(ptr, size) BF_arenaRealloc(ptr, size)
+#define free(ptr) BF_arenaFree(ptr)
+
+#endif
@@ -0,0 +1,62 @@
+/*
+ * Copyright 2011-2014, EDF. This software was developed with the collaboration of INRIA (Bastien Pietropaoli)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#ifndef DEF_LATTICETRANSFORMS
+#define DEF_LATTICETRANSFORMS
+
+/**
+ * Fast zeta and Moebius transforms on the lattice of subsets of a frame (O(n * 2^n)
+ * for a frame of n atoms), values[e] being the value of the subset of id e.
+ * They are computed in double precision and shared by the dense belief functions
+ * and the combinations in the commonality domain.
+ *
+ * @file LatticeTransforms.h
+ * @author Bastien Pietropaoli (bastien.pietropaoli@inria.fr)
+ * @brief UTILITY: Transforms on the lattice of subsets.
+ */
+
+/*
+ * values[A] = sum of values[B] for B subset of A (sign = 1) or its inverse (sign = -1).
+ */
+static inline void subsetsTransform(double* values, const int elementSize, const int sign) {
+	int nbSubsets = 1 << elementSize;
+	int bit = 0, i = 0;
+	for(bit = 1; bit < nbSubsets; bit <<= 1){
+		for(i = 0; i < nbSubsets; i++){
+			if(i & bit){
+				values[i] += sign * values[i ^ bit];
+			}
+		}
+	}
+}
+
+/*
+ * values[A] = sum of values[B] for B superset of A (sign = 1) or its inverse (sign = -1).
+ */
+static inline void supersetsTransform(double* values, const int elementSize, const int sign) {
+	int nbSubsets = 1 << elementSize;
+	int bit = 0, i = 0;
+	for(bit = 1; bit < nbSubsets; bit <<= 1){
+		for(i = 0; i < nbSubsets; i++){
+			if(!(i & bit)){
+				values[i] += sign * values[i | bit];
+			}
+		}
+	}
+}
+
+#endif
@@ -302,6 +302,85 @@
  * @li The debug code has been cleaned (Thx Aurélien!)
  * @li ... there are certainly things I forgot...
  *
+ * @section v07_subsec V0.7 (in progress)
+ * Performance work:
+ * @li Elements of frames of at most 64 atoms can be packed into a single word (Sets_PackedElement). BF_SmetsCombination(),
+ * BF_bel(), BF_pl(), BF_q() and BF_betP() use them internally for such frames.
+ * @li Larger frames use multi-word elements (SetsWide module) whose operations are vectorized (SSE4.2, AVX2 or AVX-512)
+ * and selected at runtime depending on the CPU.
+ * @li Operations on elements without allocation (Sets_conjunctionInto(), Sets_disjunctionInto()...). BF_conditioning(),
+ * BF_distance(), BF_DuboisPradeCombination() and the decision lists do not allocate temporary elements in their loops anymore.
+ * @li Belief functions with element ids (BF_PackedBeliefFunction) whose focal elements are single words: no allocation per
+ * focal element, integer comparisons and conjunctions. Sets_numberFromElement() does not use pow() anymore.
+ * @li Lazy powersets (Sets_PowerSetView and Sets_PowerSetIterator) with restrictions on cardinality, subsets and supersets.
+ * BF_getMaxInView(), BF_getMinInView(), BF_getMaxListInView(), BF_getMinListInView() and BF_conditioningInView() use them.
+ * Belief structures give a view on their powerset (powersetView) beside the powerset itself, which is only stored for frames
+ * of at most BFS_POWERSET_MAX_SIZE (30) values.
+ * @li Views restricted on cardinality jump directly from one subset to the next one of an accepted cardinality. The decision
+ * functions limited to a maximum cardinality only visit the C(n, 1) + ... + C(n, card) candidates of generated powersets.
+ * @li Reference lists carry a hash index of their values (Sets_indexRefList(), Sets_getRefListPosition()).
+ * Sets_createElementFromStrings() and Sets_packedFromStrings() take a time linear in the number of given values.
+ * @li Conversions into strings in a single pass with the StringBuffer module: the append functions (Sets_appendElement(),
+ * BF_appendBeliefFunction(), BFS_appendBeliefStructure()...) write into a growable buffer or directly into a file without
+ * intermediate allocation. The ToString functions use them.
+ * @li Set algebra contexts (Sets_Context) computed once per frame: full mask and an optional cache of the Jaccard coefficients
+ * of all the pairs of subsets used by BF_distanceInContext(). BF_weakening(), BF_discounting(), BF_DempsterCombination(),
+ * BF_YagerCombination() and BF_autoConflict() find the void and complete elements by their cardinality instead of allocating them.
+ * @li Sets_elementFromNumber(), Sets_numberFromElement() and Sets_createPowerSet() use exact integer arithmetic (no more pow()).
+ * 64-bit codes are available through the packed elements and codes of any width through SetsWide. The random generators of
+ * BeliefsFromRandomness support frames of any size.
+ * @li Dense belief functions (BF_DenseBeliefFunction) for frames of at most BF_DENSE_MAX_SIZE atoms: vector of masses indexed by
+ * element ids with conversions from and to the sparse form, constant-time BF_denseM(), bel, pl, q, betP, normalization, weakening,
+ * discounting and the Smets and Dempster combinations. BF_preferDenseForm() tells when the dense form pays off; the Smets
+ * combination of small frames uses it to index the resulting focal elements instead of searching them.
+ * @li Fast zeta and Moebius transforms of dense belief functions: implicability, credibility, plausibility, commonality and
+ * pignistic probability of all the subsets at once in O(n.2^n) and back to the masses. The decision functions use them for BF_m(),
+ * BF_bel(), BF_pl(), BF_q() and BF_betP() when it is cheaper than evaluating each candidate (same results).
+ * @li Hash index of the focal elements of belief functions, kept beside them (BF_indexBeliefFunction(), BF_getFocalPosition(),
+ * BF_addToFocal(), BF_freeFocalIndex()): a focal is found in a constant time. The Dubois and Prade's rule, the average combinations,
+ * BF_conditioningOn() and BFB_believeFromBelief() accumulate their focals through an index and the Smets combination hashes its
+ * focals (same results). BF_BeliefFunction is unchanged.
+ * @li Compact belief functions (BF_CompactBeliefFunction): the focal elements as words and their masses in a single block,
+ * copied with a single memcpy() and freed with a single free(), with m, bel, pl, q and betP of frames of any size.
+ * BF_distance() and BF_discrepancy() use them instead of repacking or intersecting elements atom by atom (same results).
+ * @li Arenas (Arena module): once a thread uses an arena (BF_useArena()), the Sets, BF_*, BFB_*, BFR_* and BFS_* functions draw
+ * their memory from it and a whole fusion cycle is released in a constant time by BF_arenaReset(). The blocks are kept from one
+ * cycle to the next, so the threads using their own arena do not compete for malloc() anymore.
+ * @li BF_distance() computes the Jaccard coefficients row by row instead of allocating a matrix. BF_distanceMatrix() gives the
+ * distances between all the pairs of a set at once: the functions are projected on the union of their focal elements, whose Jaccard
+ * matrix is computed once (from the context cache if any), and the quadratic forms use vectorized dot products. BF_supports() and
+ * BF_fullChenCombination() use it.
+ * @li BF_conditioningOn() transfers the mass of each focal element A to A n e in a time linear in the number of focal elements,
+ * without any powerset. BF_conditioning() and BF_conditioningInView() use it: the masses of the intersections that were not focal
+ * elements of the conditioned function are not lost anymore.
+ * @li New BF_weaken() and BF_discount() modify a belief function in place, BF_weakening() and BF_discounting()
+ * are built on them. BF_cleanBeliefFunction() compacts the focal elements without allocating a new list and
+ * the temporization by specificity does not copy the discounted function anymore.
+ * @li New BF_measures() and BF_measuresOfIds() evaluate bel, pl, q and betP for many elements in one pass
+ * over the focal elements per tile of elements. Large batches are split over threads if the library is built
+ * with THEGAME_OPENMP.
+ * @li Masses have their own type (BF_Mass), float by default or double if BF_DOUBLE_MASSES is defined
+ * (THEGAME_DOUBLE_MASSES option of CMake, recorded in the generated and installed BeliefFunctionsConfig.h). The sums of masses of the normalization, weakening,
+ * discounting, conjunctive and Chen combinations are accumulated in double precision, which keeps
+ * long chains of combinations within BF_PRECISION.
+ * @li BF_fullDempsterCombination(), BF_fullSmetsCombination() and BF_autoConflict() keep their
+ * intermediate results packed on small frames: each function is packed once and only the result
+ * is unpacked.
+ * @li BF_denseFullSmetsCombination() and BF_denseFullDempsterCombination() combine lists of functions
+ * as a product of their commonality functions (one fast zeta transform per function and one Moebius
+ * transform). BF_fullSmetsCombination() and BF_fullDempsterCombination() use them when the pairwise
+ * combinations would cost more. The Dempster's normalization is then applied once in double precision.
+ * @li BF_parallelFullCombination() combines lists of functions on several threads (THEGAME_OPENMP):
+ * as a balanced tree or a product of commonality functions computed in parallel for SMETS and DEMPSTER,
+ * in an order that does not depend on the number of workers. The other rules fall back to BF_fullCombination().
+ * @li BF_approximation() and BF_klxApproximation() bound the number of focal elements of a belief function
+ * (summarization, k-l-x, inner and outer approximations) and give the mass they moved. BF_boundedCombination()
+ * and BF_boundedFullCombination() keep the results of combinations within the bound, and the Max-Focals option
+ * of the sensors bounds the functions kept by the temporizations.
+ * @li BF_fullAverageCombination(), BF_fullMurphyCombination() and BF_fullChenCombination() average the functions
+ * in a single pass through a hash table, and the Dempster's combinations of the average are computed at once
+ * (power of its commonality function or exponentiation by squaring).
+ *
  * @section Version_contact Contact
  * Bastien Pietropaoli @n
  *
@@ -0,0 +1,162 @@
+/*
+ * Copyright 2011-2014, EDF. This software was developed with the collaboration of INRIA (Bastien Pietropaoli)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#ifndef DEF_ARENA
+#define DEF_ARENA
+
+#include <stddef.h>
+
+/**
+ * This module provides with arenas from which the library can draw its memory.
+ * An arena is a chain of growing blocks in which allocations are simply stacked.
+ * Once a thread uses an arena (BF_useArena()), every allocation of the Sets, SetsWide, BF_*,
+ * BFB_*, BFR_* and BFS_* functions called by this thread is taken from it, and all of them
+ * are released at once in a constant time by BF_arenaReset(). The blocks are kept from one
+ * reset to the next, so a fusion cycle that fits in them does not call malloc() at all and
+ * threads using their own arena do not compete for the allocator.
+ *
+ * While an arena is in use, the memory given by the library belongs to the arena:
+ * it must not be given to free() or realloc(). The BF_free...() and Sets_free...() functions
+ * may still be called on it (they do not release anything but the last allocation) and
+ * BF_arenaFree() can be used instead of free(). Structures that outlive a reset (a loaded belief
+ * structure, a result to keep...) must be created or copied while no arena is in use.
+ * The states kept by the belief structures between two measures (temporization) never
+ * come from an arena.
+ *
+ * An arena must only be used by one thread at a time.
+ *
+ * @file Arena.h
+ * @author Bastien Pietropaoli (bastien.pietropaoli@inria.fr)
+ * @brief UTILITY: Arenas from which the library
+ * draws its temporary memory.
+ */
+
+/*
+  +------------+
+  | STRUCTURES |
+  +------------+
+*/
+
+/**
+ * @def BF_ARENA_DEFAULT_BLOCK_SIZE
+ * The default size (in bytes) of the first block of an arena.
+ */
+#define BF_ARENA_DEFAULT_BLOCK_SIZE 65536
+
+/**
+ * An arena (opaque structure).
+ * @struct BF_Arena
+ */
+typedef struct BF_Arena BF_Arena;
+
+
+/*
+  +-----------+
+  | FUNCTIONS |
+  +-----------+
+*/
+
+/**
+ * @name Arenas
+ * @{
+ */
+
+/**
+ * Creates an empty arena. No block is allocated before the first allocation.
+ * @param blockSize The size (in bytes) of the first block of the arena (0 for BF_ARENA_DEFAULT_BLOCK_SIZE).
+ * Each new block is twice as large as the previous one and larger allocations get a block of their own.
+ * @return A new arena. Must be freed after use with BF_freeArena().
+ */
+BF_Arena* BF_createArena(const size_t blockSize);
+
+/**
+ * Makes the calling thread draw the memory of the library from the given arena.
+ * @param arena The arena to use (NULL to go back to malloc())
+ * @return The arena previously used by the thread (NULL if none), to restore it afterwards.
+ */
+BF_Arena* BF_useArena(BF_Arena* arena);
+
+/**
+ * Gives the arena used by the calling thread.
+ * @return The arena in use or NULL if none.
+ */
+BF_Arena* BF_getArena(void);
+
+/**
+ * Releases all the memory drawn from the arena in a constant time.
+ * The blocks of the arena are kept for the next allocations.
+ * @param arena The arena to reset
+ */
+void BF_arenaReset(BF_Arena* arena);
+
+/**
+ * Gives the number of bytes drawn from the arena since its creation or last reset.
+ * @param arena The arena
+ * @return The number of bytes in use (including the alignment and bookkeeping).
+ */
+size_t BF_arenaUsage(const BF_Arena* arena);
+
+/**
+ * Frees an arena and all its blocks. If the calling thread uses it, it goes back to malloc().
+ * @param arena The arena to free
+ */
+void BF_freeArena(BF_Arena* arena);
+
+/** @} */
+
+
+/**
+ * @name Allocation
+ * These functions behave like malloc(), calloc(), realloc() and free() but use the arena of the
+ * calling thread if any. They are used by every allocation of the library.
+ * @{
+ */
+
+/**
+ * Allocates memory from the arena in use or with malloc().
+ * @param size The number of bytes to allocate
+ * @return The allocated memory or NULL on failure.
+ */
+void* BF_arenaMalloc(const size_t size);
+
+/**
+ * Allocates zeroed memory from the arena in use or with calloc().
+ * @param nb The number of items to allocate
+ * @param size The size of an item
+ * @return The allocated memory or NULL on failure.
+ */
+void* BF_arenaCalloc(const size_t nb, const size_t size);
+
+/**
+ * Resizes memory. Memory drawn from the arena in use grows in place when it is
+ * the last allocation, other memory is given to realloc().
+ * @param ptr The memory to resize (may be NULL)
+ * @param size The new size in bytes
+ * @return The resized memory or NULL on failure.
+ */
+void* BF_arenaRealloc(void* ptr, const size_t size);
+
+/**
+ * Frees memory. Memory drawn from the arena in use is only released by BF_arenaReset()
+ * (except the last allocation), other memory is given to free().
+ * @param ptr The memory to free (may be NULL)
+ */
+void BF_arenaFree(void* ptr);
+
+/** @} */
+
+#endif
@@ -71,6 +71,9 @@ typedef enum BF_CombinationRule BF_CombinationRule;
 /**
  * Combines a list of belief functions into one. The combination rule used
  * is the classical normalized Dempster rule of combination.
+ * When the frame has at most BF_DENSE_MAX_SIZE atoms and the pairwise combinations would
+ * cost more, the functions are combined as a product of their commonality functions
+ * (see BF_denseFullDempsterCombination()) and the focal elements are given by increasing element id.
  * @param m A list of BeliefFunctions
  * @param nbM The number of functions in the list
  * @return The resulting BF_BeliefFunction corresponding to the accumulation of evidences
@@ -91,6 +94,9 @@ BF_BeliefFunction BF_DempsterCombination(const BF_BeliefFunction m1, const BF_Be
  * is defined in P. Smets 1999 (The transferable belief model for
  * belief representation). This is the same rule than the Dempster's one but
  * without any normalization. Thus, the void element may have a non-null mass.
+ * When the frame has at most BF_DENSE_MAX_SIZE atoms and the pairwise combinations would
+ * cost more, the functions are combined as a product of their commonality functions
+ * (see BF_denseFullSmetsCombination()) and the focal elements are given by increasing element id.
  * @param m A list of BeliefFunctions
  * @param nbM The number of functions in the list
  * @return The resulting BF_BeliefFunction corresponding to the accumulation of evidences
@@ -181,7 +187,9 @@ BF_BeliefFunction BF_averageCombination(const BF_BeliefFunction m1, const BF_Bel
  * Combines a list of belief functions into one. The combination rule used
  * is defined in C. K. Murphy 1999 (Combining belief functions when evidence conflicts).
  * This combination is based on the average Murphy's combination. Then, nbM - 1 Dempster's
- * combinations of the average are performed to create a convergence.
+ * combinations of the average are performed to create a convergence. They are computed at once:
+ * the commonality function of the average is raised to the power nbM on frames of at most
+ * BF_DENSE_MAX_SIZE atoms when it costs less, otherwise the average is squared O(log nbM) times.
  * @param m A list of BeliefFunctions
  * @param nbM The number of functions in the list
  * @return The resulting BF_BeliefFunction corresponding to the accumulation of evidences
@@ -205,7 +213,8 @@ BF_BeliefFunction BF_MurphyCombination(const BF_BeliefFunction m1, const BF_Beli
  * This rule corresponds to a weighted average taking into account the credibility of
  * each belief function among a set of belief functions. The Chen combination is not
  * very useful with only two belief functions. This is why there is no binary Chen
- * combination implementation.
+ * combination implementation. The Dempster's combinations of the weighted average
+ * are computed at once as in BF_fullMurphyCombination().
  * @param m A list of BeliefFunctions
  * @param nbM The number of functions in the list
  * @return The resulting BF_BeliefFunction corresponding to the accumulation of evidences
@@ -224,6 +233,23 @@ BF_BeliefFunction BF_fullChenCombination(const BF_BeliefFunction* m, const int n
  */
 BF_BeliefFunction BF_fullCombination(const BF_BeliefFunction* m, const int nbM, const BF_CombinationRule type);
 
+/**
+ * Combines a list of belief functions into one on several threads. The associative rules
+ * (SMETS and DEMPSTER) are applied as a balanced tree ((m[0] m[1]) (m[2] m[3])) ((m[4] m[5]) ...)
+ * whose combinations are shared between the threads, or as a product of the commonality functions
+ * (see BF_fullSmetsCombination()) computed in parallel. The tree only depends on nbM, so the result
+ * does not depend on the number of workers, but it may slightly differ from the one of
+ * BF_fullCombination() which combines the list in order.
+ * The other rules are not associative: they fall back to BF_fullCombination().
+ * The threads are only used if the library is built with OpenMP (THEGAME_OPENMP).
+ * @param m A list of BeliefFunctions
+ * @param nbM The number of functions in the list
+ * @param type The type of combination rule to use
+ * @param nbWorkers The number of threads to use (0 for the default number of threads of OpenMP)
+ * @return The resulting BF_BeliefFunction corresponding to the accumulation of evidences
+ */
+BF_BeliefFunction BF_parallelFullCombination(const BF_BeliefFunction* m, const int nbM, const BF_CombinationRule type, const int nbWorkers);
+
 /**
  * Combines two BeliefFunctions into one. The combination rule used
  * depends on the given type of combination. You can get a list of those types in the
@@ -236,6 +262,88 @@ BF_BeliefFunction BF_fullCombination(const BF_BeliefFunction* m, const int nbM,
  */
 BF_BeliefFunction BF_combination(const BF_BeliefFunction m1, const BF_BeliefFunction m2, const BF_CombinationRule type);
 
+/**
+ * Combines two BeliefFunctions into one having at most maxFocals focal elements (see BF_approximation()).
+ * The functions having more than maxFocals focal elements are approximated before the combination,
+ * which thus considers at most maxFocals * maxFocals pairs of focal elements, and the result is approximated
+ * if needed.
+ * @param m1 The first BF_BeliefFunction to combine
+ * @param m2 The second BF_BeliefFunction to combine
+ * @param type The type of combination rule to use
+ * @param maxFocals The maximum number of focal elements of the result (and of the combined functions)
+ * @param method The approximation method
+ * @param movedMass Where to store the sum of the masses moved by the approximations (may be NULL)
+ * @return The resulting BF_BeliefFunction. Must be freed after use.
+ */
+BF_BeliefFunction BF_boundedCombination(const BF_BeliefFunction m1, const BF_BeliefFunction m2, const BF_CombinationRule type,
+        const int maxFocals, const BF_ApproximationMethod method, BF_Mass* movedMass);
+
+/**
+ * Combines a list of belief functions into one having at most maxFocals focal elements.
+ * The associative rules (SMETS and DEMPSTER) combine the list in order with BF_boundedCombination(),
+ * so that each step has a bounded cost whatever the number of functions. The other rules combine
+ * the approximated functions with BF_fullCombination() and approximate the result.
+ * @param m A list of BeliefFunctions
+ * @param nbM The number of functions in the list
+ * @param type The type of combination rule to use
+ * @param maxFocals The maximum number of focal elements of the result (and of the intermediate results)
+ * @param method The approximation method
+ * @param movedMass Where to store the sum of the masses moved by the approximations (may be NULL)
+ * @return The resulting BF_BeliefFunction. Must be freed after use.
+ */
+BF_BeliefFunction BF_boundedFullCombination(const BF_BeliefFunction* m, const int nbM, const BF_CombinationRule type,
+        const int maxFocals, const BF_ApproximationMethod method, BF_Mass* movedMass);
+
+/**
+ * Combines two belief functions with element ids using the Smets' combination
+ * rule (see BF_SmetsCombination()). The focal elements of the result are given
+ * in the order of their first appearance.
+ * @param m1 The first BF_PackedBeliefFunction to combine
+ * @param m2 The second BF_PackedBeliefFunction to combine
+ * @return The resulting BF_PackedBeliefFunction. Must be freed after use.
+ */
+BF_PackedBeliefFunction BF_packedSmetsCombination(const BF_PackedBeliefFunction m1, const BF_PackedBeliefFunction m2);
+
+/**
+ * Combines two dense belief functions using the Smets' combination rule
+ * (see BF_SmetsCombination()). Only the pairs of focal elements are visited.
+ * @param m1 The first BF_DenseBeliefFunction to combine
+ * @param m2 The second BF_DenseBeliefFunction to combine
+ * @return The resulting BF_DenseBeliefFunction. Must be freed after use.
+ */
+BF_DenseBeliefFunction BF_denseSmetsCombination(const BF_DenseBeliefFunction m1, const BF_DenseBeliefFunction m2);
+
+/**
+ * Combines two dense belief functions using the Dempster's combination rule
+ * (see BF_DempsterCombination()).
+ * @param m1 The first BF_DenseBeliefFunction to combine
+ * @param m2 The second BF_DenseBeliefFunction to combine
+ * @return The resulting BF_DenseBeliefFunction. Must be freed after use.
+ */
+BF_DenseBeliefFunction BF_denseDempsterCombination(const BF_DenseBeliefFunction m1, const BF_DenseBeliefFunction m2);
+
+/**
+ * Combines a list of dense belief functions using the Smets' combination rule
+ * (see BF_fullSmetsCombination()). The rule is applied as a product of the commonality
+ * functions: each function is transformed once and the product is transformed back
+ * (O(nbM * n * 2^n) for a frame of n atoms, whatever the number of focal elements).
+ * Masses below the rounding error of the transforms are set to 0.
+ * @param m A list of BF_DenseBeliefFunction
+ * @param nbM The number of functions in the list
+ * @return The resulting BF_DenseBeliefFunction. Must be freed after use.
+ */
+BF_DenseBeliefFunction BF_denseFullSmetsCombination(const BF_DenseBeliefFunction* m, const int nbM);
+
+/**
+ * Combines a list of dense belief functions using the Dempster's combination rule
+ * (see BF_fullDempsterCombination()). The Smets' combination of the list
+ * (BF_denseFullSmetsCombination()) is normalized once.
+ * @param m A list of BF_DenseBeliefFunction
+ * @param nbM The number of functions in the list
+ * @return The resulting BF_DenseBeliefFunction. Must be freed after use.
+ */
+BF_DenseBeliefFunction BF_denseFullDempsterCombination(const BF_DenseBeliefFunction* m, const int nbM);
+
 /** @} */
 
 
@@ -37,7 +37,7 @@
  * @return The value for the given element according to the criterion.
  * @see BF_pl(), BF_m(), BF_bel(), BF_betP(), Bf_q()
  */
-typedef  float (*BF_criterionFunction)(const BF_BeliefFunction beliefFunction, const Sets_Element element) ;
+typedef  BF_Mass (*BF_criterionFunction)(const BF_BeliefFunction beliefFunction, const Sets_Element element) ;
 
 
 /*
@@ -154,6 +154,60 @@ BF_FocalElementList BF_getMaxList(BF_criterionFunction criterion, const BF_Belie
 BF_FocalElementList BF_getMinList(BF_criterionFunction criterion, const BF_BeliefFunction beliefFunction,
 		const int maxCard, const Sets_Set powerset);
 
+/**
+ * Same as BF_getMax() but the powerset is given as a lazy view. The elements
+ * are generated on demand and only the ones of cardinality at most maxCard are
+ * generated. In case of equality, the element with the smallest id is returned
+ * (i.e. the same element as BF_getMax() on a complete powerset).
+ * @param criterion The criterion used to get the max
+ * @param beliefFunction The belief function function from which we extract the max
+ * @param maxCard The maximum authorized cardinality of the max Element (0 = no card limit)
+ * @param view The view on the powerset to consider
+ * @return The BF_FocalElement (Element + mass) corresponding to the maximum. Must be freed after use.
+ */
+BF_FocalElement BF_getMaxInView(BF_criterionFunction criterion, const BF_BeliefFunction beliefFunction,
+		const int maxCard, const Sets_PowerSetView view);
+
+/**
+ * Same as BF_getMin() but the powerset is given as a lazy view. The elements
+ * are generated on demand and only the ones of cardinality at most maxCard are
+ * generated. In case of equality, the element with the greatest id is returned
+ * (i.e. the same element as BF_getMin() on a complete powerset).
+ * @param criterion The criterion used to get the min
+ * @param beliefFunction The belief function function from which we extract the min
+ * @param maxCard The maximum authorized cardinality of the min Element (0 = no card limit)
+ * @param view The view on the powerset to consider
+ * @return The BF_FocalElement (Element + mass) corresponding to the minimum. Must be freed after use.
+ */
+BF_FocalElement BF_getMinInView(BF_criterionFunction criterion, const BF_BeliefFunction beliefFunction,
+		const int maxCard, const Sets_PowerSetView view);
+
+/**
+ * Same as BF_getMaxList() but the powerset is given as a lazy view.
+ * The elements of the list are sorted by increasing id.
+ * @param criterion The criterion used to find the max
+ * @param beliefFunction The belief function from which we extract the maxima
+ * @param maxCard The maximum authorized cardinality of the max Element (0 = no card limit)
+ * @param view The view on the powerset to consider
+ * @return The BF_FocalElement (Element + mass) list corresponding to the maximum.
+ * Must be freed with BF_freeFocalElementList().
+ */
+BF_FocalElementList BF_getMaxListInView(BF_criterionFunction criterion, const BF_BeliefFunction beliefFunction,
+		const int maxCard, const Sets_PowerSetView view);
+
+/**
+ * Same as BF_getMinList() but the powerset is given as a lazy view.
+ * The elements of the list are sorted by increasing id.
+ * @param criterion The criterion used to find the minimum
+ * @param beliefFunction The belief function from which we extract the minima
+ * @param maxCard The maximum authorized cardinality of the max Element (0 = no card limit)
+ * @param view The view on the powerset to consider
+ * @return The BF_FocalElement (Element + mass) list corresponding to the minimum.
+ * Must be freed with BF_freeFocalElementList().
+ */
+BF_FocalElementList BF_getMinListInView(BF_criterionFunction criterion, const BF_BeliefFunction beliefFunction,
+		const int maxCard, const Sets_PowerSetView view);
+
 
 /** @} */
 
@@ -364,7 +418,7 @@ int BF_getNbMinBetP(const BF_BeliefFunction m, const int card, const Sets_Set po
  * @return The number of focals corresponding to the maximum of mass. Returns 0 if no element
  * fitting the cardinality constraint is found.
  */
-int BF_getQuickNbMaxMass(const BF_BeliefFunction m, const int card, float maxValue);
+int BF_getQuickNbMaxMass(const BF_BeliefFunction m, const int card, BF_Mass maxValue);
 
 /**
  * Returns the number of focals actually corresponding to the non-null minimum of mass of the given BF_BeliefFunction.
@@ -375,7 +429,7 @@ int BF_getQuickNbMaxMass(const BF_BeliefFunction m, const int card, float maxVal
  * @return The number of focals corresponding to the minimum of mass. Returns 0 if no element
  * fitting the cardinality constraint is found.
  */
-int BF_getQuickNbMinMass(const BF_BeliefFunction m, const int card, float minValue);
+int BF_getQuickNbMinMass(const BF_BeliefFunction m, const int card, BF_Mass minValue);
 
 /**
  * Returns the number of focals actually corresponding to the maximum of belief (see bel()) of the given BF_BeliefFunction.
@@ -387,7 +441,7 @@ int BF_getQuickNbMinMass(const BF_BeliefFunction m, const int card, float minVal
  * @return The number of focals corresponding to the maximum of belief. Returns 0 if no element
  * fitting the cardinality constraint is found.
  */
-int BF_getQuickNbMaxBel(const BF_BeliefFunction m, const int card, const Sets_Set powerset, float maxValue);
+int BF_getQuickNbMaxBel(const BF_BeliefFunction m, const int card, const Sets_Set powerset, BF_Mass maxValue);
 
 /**
  * Returns the number of focals actually corresponding to the non-null minimum of belief (see bel()) of the given BF_BeliefFunction.
@@ -399,7 +453,7 @@ int BF_getQuickNbMaxBel(const BF_BeliefFunction m, const int card, const Sets_Se
  * @return The number of focals corresponding to the minimum of belief. Returns 0 if no element
  * fitting the cardinality constraint is found.
  */
-int BF_getQuickNbMinBel(const BF_BeliefFunction m, const int card, const Sets_Set powerset, float minValue);
+int BF_getQuickNbMinBel(const BF_BeliefFunction m, const int card, const Sets_Set powerset, BF_Mass minValue);
 
 /**
  * Returns the number of focals actually corresponding to the maximum of plausibility (see pl()) of the given BF_BeliefFunction.
@@ -411,7 +465,7 @@ int BF_getQuickNbMinBel(const BF_BeliefFunction m, const int card, const Sets_Se
  * @return The number of focals corresponding to the maximum of plausibility. Returns 0 if no element
  * fitting the cardinality constraint is found.
  */
-int BF_getQuickNbMaxPl(const BF_BeliefFunction m, const int card, const Sets_Set powerset, float maxValue);
+int BF_getQuickNbMaxPl(const BF_BeliefFunction m, const int card, const Sets_Set powerset, BF_Mass maxValue);
 
 /**
  * Returns the number of focals actually corresponding to the non-null minimum of plausibility (see pl()) of the given BF_BeliefFunction.
@@ -423,7 +477,7 @@ int BF_getQuickNbMaxPl(const BF_BeliefFunction m, const int card, const Sets_Set
  * @return The number of focals corresponding to the minimum of plausibility. Returns 0 if no element
  * fitting the cardinality constraint is found.
  */
-int BF_getQuickNbMinPl(const BF_BeliefFunction m, const int card, const Sets_Set powerset, float minValue);
+int BF_getQuickNbMinPl(const BF_BeliefFunction m, const int card, const Sets_Set powerset, BF_Mass minValue);
 
 /**
  * Returns the number of focals actually corresponding to the maximum of pignistic transformation (see betP()) of the given BF_BeliefFunction.
@@ -435,7 +489,7 @@ int BF_getQuickNbMinPl(const BF_BeliefFunction m, const int card, const Sets_Set
  * @return The number of focals corresponding to the maximum of pignistic transformation. Returns 0 if no element
  * fitting the cardinality constraint is found.
  */
-int BF_getQuickNbMaxBetP(const BF_BeliefFunction m, const int card, const Sets_Set powerset, float maxValue);
+int BF_getQuickNbMaxBetP(const BF_BeliefFunction m, const int card, const Sets_Set powerset, BF_Mass maxValue);
 
 /**
  * Returns the number of focals actually corresponding to the non-null minimum of pignistic transformation (see betP()) of the given BF_BeliefFunction.
@@ -447,7 +501,7 @@ int BF_getQuickNbMaxBetP(const BF_BeliefFunction m, const int card, const Sets_S
  * @return The number of focals corresponding to the minimum of pignistic transformation. Returns 0 if no element
  * fitting the cardinality constraint is found.
  */
-int BF_getQuickNbMinBetP(const BF_BeliefFunction m, const int card, const Sets_Set powerset, float minValue);
+int BF_getQuickNbMinBetP(const BF_BeliefFunction m, const int card, const Sets_Set powerset, BF_Mass minValue);
 
 /**
  * Get the list of focals corresponding to the maximum of mass of the given BF_BeliefFunction.
@@ -544,7 +598,7 @@ BF_FocalElement* BF_getListMinBetP(const BF_BeliefFunction m, const int card, co
  * @return A list of BF_FocalElement corresponding to the maximum of mass. Must be freed after use.
  * Returns null if no Element fitting the cardinality constraint is found.
  */
-BF_FocalElement* BF_getQuickListMaxMass(const BF_BeliefFunction m, const int card, const float maxValue);
+BF_FocalElement* BF_getQuickListMaxMass(const BF_BeliefFunction m, const int card, const BF_Mass maxValue);
 
 /**
  * Get the list of focals corresponding to the non-null minimum of mass of the given BF_BeliefFunction.
@@ -555,7 +609,7 @@ BF_FocalElement* BF_getQuickListMaxMass(const BF_BeliefFunction m, const int car
  * @return A list of BF_FocalElement corresponding to the minimum of mass. Must be freed after use.
  * Returns null if no Element fitting the cardinality constraint is found.
  */
-BF_FocalElement* BF_getQuickListMinMass(const BF_BeliefFunction m, const int card, const float minValue);
+BF_FocalElement* BF_getQuickListMinMass(const BF_BeliefFunction m, const int card, const BF_Mass minValue);
 
 /**
  * Get the list of focals corresponding to the maximum of belief (see bel())of the given BF_BeliefFunction.
@@ -567,7 +621,7 @@ BF_FocalElement* BF_getQuickListMinMass(const BF_BeliefFunction m, const int car
  * @return A list of BF_FocalElement corresponding to the maximum of belief. Must be freed after use.
  * Returns null if no Element fitting the cardinality constraint is found.
  */
-BF_FocalElement* BF_getQuickListMaxBel(const BF_BeliefFunction m, const int card, const Sets_Set powerset, const float maxValue);
+BF_FocalElement* BF_getQuickListMaxBel(const BF_BeliefFunction m, const int card, const Sets_Set powerset, const BF_Mass maxValue);
 
 /**
  * Get the list of focals corresponding to the non-null minimum of belief (see bel()) of the given BF_BeliefFunction.
@@ -579,7 +633,7 @@ BF_FocalElement* BF_getQuickListMaxBel(const BF_BeliefFunction m, const int card
  * @return A list of BF_FocalElement corresponding to the minimum of belief. Must be freed after use.
  * Returns null if no Element fitting the cardinality constraint is found.
  */
-BF_FocalElement* BF_getQuickListMinBel(const BF_BeliefFunction m, const int card, const Sets_Set powerset, const float minValue);
+BF_FocalElement* BF_getQuickListMinBel(const BF_BeliefFunction m, const int card, const Sets_Set powerset, const BF_Mass minValue);
 
 /**
  * Get the list of focals corresponding to the maximum of plausibility (see pl()) of the given BF_BeliefFunction.
@@ -591,7 +645,7 @@ BF_FocalElement* BF_getQuickListMinBel(const BF_BeliefFunction m, const int card
  * @return A list of BF_FocalElement corresponding to the maximum of plausibility. Must be freed after use.
  * Returns null if no Element fitting the cardinality constraint is found.
  */
-BF_FocalElement* BF_getQuickListMaxPl(const BF_BeliefFunction m, const int card, const Sets_Set powerset, const float maxValue);
+BF_FocalElement* BF_getQuickListMaxPl(const BF_BeliefFunction m, const int card, const Sets_Set powerset, const BF_Mass maxValue);
 
 /**
  * Get the list of focals corresponding to the non-null minimum of plausibility (see pl()) of the given BF_BeliefFunction.
@@ -603,7 +657,7 @@ BF_FocalElement* BF_getQuickListMaxPl(const BF_BeliefFunction m, const int card,
  * @return A list of BF_FocalElement corresponding to the minimum of plausibility. Must be freed after use.
  * Returns null if no Element fitting the cardinality constraint is found.
  */
-BF_FocalElement* BF_getQuickListMinPl(const BF_BeliefFunction m, const int card, const Sets_Set powerset, const float minValue);
+BF_FocalElement* BF_getQuickListMinPl(const BF_BeliefFunction m, const int card, const Sets_Set powerset, const BF_Mass minValue);
 
 /**
  * Get the list of focals corresponding to the maximum of pignistic transformation (see betP()) of the given BF_BeliefFunction.
@@ -615,7 +669,7 @@ BF_FocalElement* BF_getQuickListMinPl(const BF_BeliefFunction m, const int card,
  * @return A list of BF_FocalElement corresponding to the maximum of pignistic transformation. Must be freed after use.
  * Returns null if no Element fitting the cardinality constraint is found.
  */
-BF_FocalElement* BF_getQuickListMaxBetP(const BF_BeliefFunction m, const int card, const Sets_Set powerset, const float maxValue);
+BF_FocalElement* BF_getQuickListMaxBetP(const BF_BeliefFunction m, const int card, const Sets_Set powerset, const BF_Mass maxValue);
 
 /**
  * Get the list of focals corresponding to the non-null minimum of pignistic transformation (see betP()) of the given BF_BeliefFunction.
@@ -627,7 +681,7 @@ BF_FocalElement* BF_getQuickListMaxBetP(const BF_BeliefFunction m, const int car
  * @return A list of BF_FocalElement corresponding to the minimum of pignistic transformation. Must be freed after use.
  * Returns null if no Element fitting the cardinality constraint is found.
  */
-BF_FocalElement* BF_getQuickListMinBetP(const BF_BeliefFunction m, const int card, const Sets_Set powerset, const float minValue);
+BF_FocalElement* BF_getQuickListMinBetP(const BF_BeliefFunction m, const int card, const Sets_Set powerset, const BF_Mass minValue);
 
 /**
  * Get the list of focals corresponding to the maximum of mass of the given BF_BeliefFunction.
@@ -639,7 +693,7 @@ BF_FocalElement* BF_getQuickListMinBetP(const BF_BeliefFunction m, const int car
  * @return A list of BF_FocalElement corresponding to the maximum of mass. Must be freed after use.
  * Returns null if no Element fitting the cardinality constraint is found.
  */
-BF_FocalElement* BF_getQuickerListMaxMass(const BF_BeliefFunction m, const int card, const float maxValue, const int nbMax);
+BF_FocalElement* BF_getQuickerListMaxMass(const BF_BeliefFunction m, const int card, const BF_Mass maxValue, const int nbMax);
 
 /**
  * Get the list of focals corresponding to the non-null minimum of mass of the given BF_BeliefFunction.
@@ -651,7 +705,7 @@ BF_FocalElement* BF_getQuickerListMaxMass(const BF_BeliefFunction m, const int c
  * @return A list of BF_FocalElement corresponding to the minimum of mass. Must be freed after use.
  * Returns null if no Element fitting the cardinality constraint is found.
  */
-BF_FocalElement* BF_getQuickerListMinMass(const BF_BeliefFunction m, const int card, const float minValue, const int nbMin);
+BF_FocalElement* BF_getQuickerListMinMass(const BF_BeliefFunction m, const int card, const BF_Mass minValue, const int nbMin);
 
 /**
  * Get the list of focals corresponding to the maximum of belief (see bel())of the given BF_BeliefFunction.
@@ -664,7 +718,7 @@ BF_FocalElement* BF_getQuickerListMinMass(const BF_BeliefFunction m, const int c
  * @return A list of BF_FocalElement corresponding to the maximum of belief. Must be freed after use.
  * Returns null if no Element fitting the cardinality constraint is found.
  */
-BF_FocalElement* BF_getQuickerListMaxBel(const BF_BeliefFunction m, const int card, const Sets_Set powerset, const float maxValue, const int nbMax);
+BF_FocalElement* BF_getQuickerListMaxBel(const BF_BeliefFunction m, const int card, const Sets_Set powerset, const BF_Mass maxValue, const int nbMax);
 
 /**
  * Get the list of focals corresponding to the non-null minimum of belief (see bel()) of the given BF_BeliefFunction.
@@ -677,7 +731,7 @@ BF_FocalElement* BF_getQuickerListMaxBel(const BF_BeliefFunction m, const int ca
  * @return A list of BF_FocalElement corresponding to the minimum of belief. Must be freed after use.
  * Returns null if no Element fitting the cardinality constraint is found.
  */
-BF_FocalElement* BF_getQuickerListMinBel(const BF_BeliefFunction m, const int card, const Sets_Set powerset, const float minValue, const int nbMin);
+BF_FocalElement* BF_getQuickerListMinBel(const BF_BeliefFunction m, const int card, const Sets_Set powerset, const BF_Mass minValue, const int nbMin);
 
 /**
  * Get the list of focals corresponding to the maximum of plausibility (see pl()) of the given BF_BeliefFunction.
@@ -690,7 +744,7 @@ BF_FocalElement* BF_getQuickerListMinBel(const BF_BeliefFunction m, const int ca
  * @return A list of BF_FocalElement corresponding to the maximum of plausibility. Must be freed after use.
  * Returns null if no Element fitting the cardinality constraint is found.
  */
-BF_FocalElement* BF_getQuickerListMaxPl(const BF_BeliefFunction m, const int card, const Sets_Set powerset, const float maxValue, const int nbMax);
+BF_FocalElement* BF_getQuickerListMaxPl(const BF_BeliefFunction m, const int card, const Sets_Set powerset, const BF_Mass maxValue, const int nbMax);
 
 /**
  * Get the list of focals corresponding to the non-null minimum of plausibility (see pl()) of the given BF_BeliefFunction.
@@ -703,7 +757,7 @@ BF_FocalElement* BF_getQuickerListMaxPl(const BF_BeliefFunction m, const int car
  * @return A list of BF_FocalElement corresponding to the minimum of plausibility. Must be freed after use.
  * Returns null if no Element fitting the cardinality constraint is found.
  */
-BF_FocalElement* BF_getQuickerListMinPl(const BF_BeliefFunction m, const int card, const Sets_Set powerset, const float minValue, const int nbMin);
+BF_FocalElement* BF_getQuickerListMinPl(const BF_BeliefFunction m, const int card, const Sets_Set powerset, const BF_Mass minValue, const int nbMin);
 
 /**
  * Get the list of focals corresponding to the maximum of pignistic transformation (see betP()) of the given BF_BeliefFunction.
@@ -716,7 +770,7 @@ BF_FocalElement* BF_getQuickerListMinPl(const BF_BeliefFunction m, const int car
  * @return A list of BF_FocalElement corresponding to the maximum of pignistic transformation. Must be freed after use.
  * Returns null if no Element fitting the cardinality constraint is found.
  */
-BF_FocalElement* BF_getQuickerListMaxBetP(const BF_BeliefFunction m, const int card, const Sets_Set powerset, const float maxValue, const int nbMax);
+BF_FocalElement* BF_getQuickerListMaxBetP(const BF_BeliefFunction m, const int card, const Sets_Set powerset, const BF_Mass maxValue, const int nbMax);
 
 /**
  * Get the list of focals corresponding to the non-null minimum of pignistic transformation (see betP()) of the given BF_BeliefFunction.
@@ -729,7 +783,7 @@ BF_FocalElement* BF_getQuickerListMaxBetP(const BF_BeliefFunction m, const int c
  * @return A list of BF_FocalElement corresponding to the minimum of pignistic transformation. Must be freed after use.
  * Returns null if no Element fitting the cardinality constraint is found.
  */
-BF_FocalElement* BF_getQuickerListMinBetP(const BF_BeliefFunction m, const int card, const Sets_Set powerset, const float minValue, const int nbMin);
+BF_FocalElement* BF_getQuickerListMinBetP(const BF_BeliefFunction m, const int card, const Sets_Set powerset, const BF_Mass minValue, const int nbMin);
 
 /** @} */
 
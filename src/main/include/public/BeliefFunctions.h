@@ -19,7 +19,9 @@
 #define DEF_BELIEFFUNCTIONS
 
 
+#include "BeliefFunctionsConfig.h"
 #include "Sets.h"
+#include "SetsWide.h"
 
 /**
  * This module does not enable the building of belief functions but only to manipulate them!
@@ -38,6 +40,42 @@
  */
 #define BF_PRECISION 0.000002
 
+/**
+ * The type of the masses (and of the values of credibility, plausibility, commonality
+ * and pignistic probability): float or double if BF_DOUBLE_MASSES is defined in
+ * BeliefFunctionsConfig.h (generated with the THEGAME_DOUBLE_MASSES option of CMake).
+ */
+#ifdef BF_DOUBLE_MASSES
+typedef double BF_Mass;
+#else
+typedef float BF_Mass;
+#endif
+
+
+
+/*
+  +--------------+
+  | ENUMERATIONS |
+  +--------------+
+*/
+
+/**
+ * @enum BF_ApproximationMethod
+ * The ways to reduce the number of focal elements of a belief function (see BF_approximation()).
+ * @li APPROX_SUMMARIZATION keeps the largest masses and gives the others to the union of their elements (Lowrance et al. 1986).
+ * @li APPROX_KLX keeps the largest masses and normalizes them (Tessem 1993, see BF_klxApproximation()).
+ * @li APPROX_INNER merges the closest focal elements into their intersection (Denoeux 2001).
+ * @li APPROX_OUTER merges the closest focal elements into their union (Denoeux 2001).
+ */
+enum BF_ApproximationMethod
+{
+    APPROX_SUMMARIZATION,
+    APPROX_KLX,
+    APPROX_INNER,
+    APPROX_OUTER
+};
+typedef enum BF_ApproximationMethod BF_ApproximationMethod;
+
 
 /*
   +------------+
@@ -57,11 +95,19 @@
  */
 struct BF_FocalElement{
     Sets_Element element;
-    float beliefValue;
+    BF_Mass beliefValue;
 };
 typedef struct BF_FocalElement BF_FocalElement;
 
 
+/**
+ * A hash index of the focal elements of a belief function (element -> position),
+ * built by BF_indexBeliefFunction() and kept beside the belief function.
+ * Its content is private to the BeliefFunctions module.
+ * @struct BF_FocalIndex
+ */
+typedef struct BF_FocalIndex BF_FocalIndex;
+
 /**
  * The real belief function. There are several ways to build
  * belief functions (for instance using the BeliefsFromSensors
@@ -81,6 +127,96 @@ struct BF_BeliefFunction{
 typedef struct BF_BeliefFunction BF_BeliefFunction;
 
 
+/* !!! Belief with element ids !!! */
+
+
+/**
+ * A couple (element, belief) where the element is given by its id,
+ * i.e. its packed form (see Sets_PackedElement). Such focal elements
+ * are trivially copyable, comparable and sortable.
+ * @param element The id of the focal element
+ * @param beliefValue The belief on the element
+ * @struct BF_PackedFocalElement
+ */
+struct BF_PackedFocalElement{
+    Sets_PackedElement element;
+    BF_Mass beliefValue;
+};
+typedef struct BF_PackedFocalElement BF_PackedFocalElement;
+
+
+/**
+ * A belief function whose focal elements are given by their ids.
+ * Only available for frames of at most SETS_PACKED_MAX_SIZE atoms.
+ * The focal elements are stored in a single array (no allocation per focal).
+ * @param focals The focal elements of the mass function
+ * @param nbFocals The number of focals
+ * @param elementSize The number of possible worlds in the frame of discernment.
+ * @struct BF_PackedBeliefFunction
+ */
+struct BF_PackedBeliefFunction{
+    BF_PackedFocalElement *focals;
+    int nbFocals;
+    int elementSize;
+};
+typedef struct BF_PackedBeliefFunction BF_PackedBeliefFunction;
+
+
+/* !!! Dense belief !!! */
+
+
+/**
+ * @def BF_DENSE_MAX_SIZE
+ * The maximum number of atoms of the frames on which dense belief functions are available.
+ */
+#define BF_DENSE_MAX_SIZE 24
+
+/**
+ * @def BF_DENSE_MIN_DENSITY
+ * The dense form is preferred when at least one subset out of BF_DENSE_MIN_DENSITY
+ * may be focal (see BF_preferDenseForm()).
+ */
+#define BF_DENSE_MIN_DENSITY 16
+
+/**
+ * A belief function stored as a vector of masses indexed by the ids of the
+ * elements (see Sets_PackedElement): values[e] = m(e) for every subset e of the frame.
+ * Only available for frames of at most BF_DENSE_MAX_SIZE atoms. The mass of any element
+ * is obtained in constant time.
+ * @param values The masses of the 2^elementSize subsets of the frame
+ * @param elementSize The number of possible worlds in the frame of discernment.
+ * @struct BF_DenseBeliefFunction
+ */
+struct BF_DenseBeliefFunction{
+    BF_Mass *values;
+    int elementSize;
+};
+typedef struct BF_DenseBeliefFunction BF_DenseBeliefFunction;
+
+
+/* !!! Compact belief !!! */
+
+
+/**
+ * A belief function stored in a single block of memory as a structure of arrays:
+ * the focal elements as multi-word elements (see SetsWide) followed by their masses
+ * in the same order. Copying it takes a single allocation and freeing it a single deallocation.
+ * Available for frames of any size.
+ * @param elementBits The focal elements (SETS_WIDE_NB_WORDS(elementSize) words per focal)
+ * @param masses The masses of the focal elements
+ * @param nbFocals The number of focals
+ * @param elementSize The number of possible worlds in the frame of discernment.
+ * @struct BF_CompactBeliefFunction
+ */
+struct BF_CompactBeliefFunction{
+    uint64_t *elementBits;
+    BF_Mass *masses;
+    int nbFocals;
+    int elementSize;
+};
+typedef struct BF_CompactBeliefFunction BF_CompactBeliefFunction;
+
+
 
 
 /*
@@ -111,8 +247,8 @@ BF_BeliefFunction BF_getVacuousBeliefFunction(const int elementSize);
 
 /**
  * Cleans the BF_BeliefFunction given from all the non-focal elements.
- * If there are zeros, the list of BF_FocalElement is freed and replaced
- * by a clean one. Thus, it modifies the given BF_BeliefFunction.
+ * The list of BF_FocalElement is compacted in place (nothing is allocated).
+ * Thus, it modifies the given BF_BeliefFunction.
  * @param bf A pointer to a BF_BeliefFunction
  */
 void BF_cleanBeliefFunction(BF_BeliefFunction* bf);
@@ -123,6 +259,44 @@ void BF_cleanBeliefFunction(BF_BeliefFunction* bf);
  */
 void BF_normalize(BF_BeliefFunction* bf);
 
+/**
+ * Builds the hash index of the focal elements of a belief function. The index is kept
+ * beside the belief function, which is not modified. It stays valid as long as the focal
+ * elements are only added with BF_addToFocal() (given the index); it must be rebuilt if
+ * they are modified otherwise.
+ * @param m The BF_BeliefFunction to index
+ * @return The index of the focal elements of m (NULL if an allocation failed). Must be freed after use with BF_freeFocalIndex().
+ */
+BF_FocalIndex* BF_indexBeliefFunction(const BF_BeliefFunction m);
+
+/**
+ * Gets the position of an element in the focals of a belief function.
+ * Takes a constant time with an index of the focals, a time linear
+ * in the number of focals without.
+ * @param m The BF_BeliefFunction in which to look for the element
+ * @param index The index of the focals of m (see BF_indexBeliefFunction()) or NULL
+ * @param e The element to look for
+ * @return The position of the first focal equal to e, -1 if e is not a focal element.
+ */
+int BF_getFocalPosition(const BF_BeliefFunction m, const BF_FocalIndex* index, const Sets_Element e);
+
+/**
+ * Adds some belief to an element of a belief function. If the element is not a focal element yet,
+ * a copy of it is appended to the focals. The given index, if any, is kept up to date.
+ * @param bf A pointer to the BF_BeliefFunction to modify
+ * @param index The index of the focals of bf (see BF_indexBeliefFunction()) or NULL
+ * @param e The element receiving the belief
+ * @param beliefValue The belief to add
+ * @return The position of the element in the focals.
+ */
+int BF_addToFocal(BF_BeliefFunction* bf, BF_FocalIndex* index, const Sets_Element e, const BF_Mass beliefValue);
+
+/**
+ * Frees an index of the focal elements of a belief function.
+ * @param index The index to free (may be NULL)
+ */
+void BF_freeFocalIndex(BF_FocalIndex* index);
+
 /** @} */
 
 
@@ -139,13 +313,37 @@ void BF_normalize(BF_BeliefFunction* bf);
  * Get the new resulting BF_BeliefFunction knowing that an certain element
  * is true. The rule used is defined in P. Smets 1999 (The transferable
  * belief model for belief representation).
+ * Same as BF_conditioningOn(), the powerset is not used anymore.
  * @param m The BF_BeliefFunction to work on
  * @param e The element which is true
- * @param powerset The set of values the BF_BeliefFunction is applied on
+ * @param powerset The set of values the BF_BeliefFunction is applied on (not used)
  * @return A conditioned BF_BeliefFunction knowing that e is true
  */
 BF_BeliefFunction BF_conditioning(const BF_BeliefFunction m, const Sets_Element e, const Sets_Set powerset);
 
+/**
+ * Same as BF_conditioning() but the powerset is given as a lazy view.
+ * Same as BF_conditioningOn(), the view is not used anymore.
+ * @param m The BF_BeliefFunction to work on
+ * @param e The element which is true
+ * @param view The view on the powerset the BF_BeliefFunction is applied on (not used)
+ * @return A conditioned BF_BeliefFunction knowing that e is true
+ */
+BF_BeliefFunction BF_conditioningInView(const BF_BeliefFunction m, const Sets_Element e, const Sets_PowerSetView view);
+
+/**
+ * Get the new resulting BF_BeliefFunction knowing that an certain element
+ * is true (P. Smets 1999): the mass of each focal element A is transferred to A n e.
+ * Takes a time linear in the number of focal elements (the transfers are merged
+ * through an index of the result, see BF_indexBeliefFunction()).
+ * The result keeps the focal elements of m (with null masses if they are not
+ * included in e) and the void element, followed by the new intersections.
+ * @param m The BF_BeliefFunction to work on
+ * @param e The element which is true
+ * @return A conditioned BF_BeliefFunction knowing that e is true.
+ */
+BF_BeliefFunction BF_conditioningOn(const BF_BeliefFunction m, const Sets_Element e);
+
 /**
  * Weakens a belief function given a coefficient alpha in [0,1]. All
  * believes on focal elements will be multiplied by a factor of (1 - alpha).
@@ -166,6 +364,24 @@ BF_BeliefFunction BF_weakening(const BF_BeliefFunction m, const float alpha);
  */
 BF_BeliefFunction BF_discounting(const BF_BeliefFunction m, const float alpha);
 
+/**
+ * Weakens a belief function in place (see BF_weakening()). The masses are scaled
+ * where they are and nothing is allocated if the void element is already a focal element
+ * (which is the case after a first weakening).
+ * @param bf A pointer to the BF_BeliefFunction to weaken
+ * @param alpha The weakening coefficient
+ */
+void BF_weaken(BF_BeliefFunction* bf, const float alpha);
+
+/**
+ * Discounts a belief function in place (see BF_discounting()). The masses are scaled
+ * where they are and nothing is allocated if the complete element is already a focal element
+ * (which is the case after a first discounting).
+ * @param bf A pointer to the BF_BeliefFunction to discount
+ * @param alpha The discounting coefficient
+ */
+void BF_discount(BF_BeliefFunction* bf, const float alpha);
+
 /**
  * Get a vector (represented as a BF_BeliefFunction but is NOT an actual one)
  * of the difference of two BeliefFunctions.
@@ -179,6 +395,53 @@ BF_BeliefFunction BF_difference(const BF_BeliefFunction m1, const BF_BeliefFunct
 
 /** @} */
 
+
+/* !!! Approximations !!! */
+
+
+/**
+ * @name Approximations
+ * These functions bound the number of focal elements of a belief function, for instance
+ * to keep the cost of repeated combinations constant (see BF_boundedCombination()).
+ * @{
+ */
+
+/**
+ * Approximates a belief function by another one having at most maxFocals focal elements.
+ * The focal elements with a null mass are dropped. If there are no more than maxFocals of them left,
+ * the result is a copy of m. Otherwise, the masses are moved as defined by the method:
+ * APPROX_SUMMARIZATION keeps the maxFocals - 1 largest masses and gives the other ones to the union
+ * of their elements (an outer approximation, the result is less committed than m), APPROX_KLX keeps the
+ * maxFocals largest masses, APPROX_INNER and APPROX_OUTER merge iteratively the two focal elements whose
+ * intersection (resp. union) changes the least the cardinalities weighted by the masses.
+ * The total mass of m is kept. Ties between equal masses are broken by the position of the focals.
+ * For n focal elements, APPROX_SUMMARIZATION and APPROX_KLX take a time in O(n log n),
+ * APPROX_INNER and APPROX_OUTER at least O(n^2).
+ * @param m The BF_BeliefFunction to approximate
+ * @param maxFocals The maximum number of focal elements of the result (at least 1)
+ * @param method The approximation method
+ * @param movedMass Where to store the mass that has been moved to another element (may be NULL)
+ * @return The approximated BF_BeliefFunction. Must be freed after use.
+ */
+BF_BeliefFunction BF_approximation(const BF_BeliefFunction m, const int maxFocals, const BF_ApproximationMethod method,
+        BF_Mass* movedMass);
+
+/**
+ * Approximates a belief function with the k-l-x method (Tessem 1993): keeps at least k and at most l of
+ * the largest masses, removing the smallest ones as long as the removed mass does not exceed x.
+ * The kept masses are normalized to the total mass of m.
+ * @param m The BF_BeliefFunction to approximate
+ * @param k The minimum number of focal elements to keep
+ * @param l The maximum number of focal elements to keep
+ * @param x The maximum mass to remove (beyond the focals in excess of l)
+ * @param movedMass Where to store the mass that has been removed (may be NULL)
+ * @return The approximated BF_BeliefFunction. Must be freed after use.
+ */
+BF_BeliefFunction BF_klxApproximation(const BF_BeliefFunction m, const int k, const int l, const float x,
+        BF_Mass* movedMass);
+
+/** @} */
+
 /**
  * @name Function-and-element-dependant operations
  * @{
@@ -190,7 +453,7 @@ BF_BeliefFunction BF_difference(const BF_BeliefFunction m1, const BF_BeliefFunct
  * @param e The element whose belief we want on
  * @return m(e), the belief on the element e from the belief function m.
  */
-float BF_m(const BF_BeliefFunction m, const Sets_Element e);
+BF_Mass BF_m(const BF_BeliefFunction m, const Sets_Element e);
 
 /**
  * Get the belief (or credibility) of an element given a BF_BeliefFunction. The operation used
@@ -201,7 +464,7 @@ float BF_m(const BF_BeliefFunction m, const Sets_Element e);
  * @param e The element to work on
  * @return The belief (or credibility) value associated to the element given the BF_BeliefFunction
  */
-float BF_bel(const BF_BeliefFunction m, const Sets_Element e);
+BF_Mass BF_bel(const BF_BeliefFunction m, const Sets_Element e);
 
 /**
  * Get the plausibility of an element given a BF_BeliefFunction. The operation used
@@ -212,7 +475,7 @@ float BF_bel(const BF_BeliefFunction m, const Sets_Element e);
  * @param e The Element to work on
  * @return The plausibility value associated to the element given the BF_BeliefFunction
  */
-float BF_pl(const BF_BeliefFunction m, const Sets_Element e);
+BF_Mass BF_pl(const BF_BeliefFunction m, const Sets_Element e);
 
 /**
  * Get the commonality of an element given a BF_BeliefFunction. The operation used
@@ -223,7 +486,7 @@ float BF_pl(const BF_BeliefFunction m, const Sets_Element e);
  * @param e The Element to work on
  * @return The commonality value associated to the element given the BF_BeliefFunction
  */
-float BF_q(const BF_BeliefFunction m, const Sets_Element e);
+BF_Mass BF_q(const BF_BeliefFunction m, const Sets_Element e);
 
 /**
  * Get the pignistic (the bet) probability of an element given a BF_BeliefFunction.
@@ -234,7 +497,39 @@ float BF_q(const BF_BeliefFunction m, const Sets_Element e);
  * @param e The Element to work on
  * @return The pignistic probability of an element given the BF_BeliefFunction
  */
-float BF_betP(const BF_BeliefFunction m, const Sets_Element e);
+BF_Mass BF_betP(const BF_BeliefFunction m, const Sets_Element e);
+
+/**
+ * Evaluates the credibility, plausibility, commonality and pignistic probability of many elements
+ * in one call. The focal elements are converted once and scanned once for each tile of elements,
+ * which is much faster than calling BF_bel(), BF_pl(), BF_q() and BF_betP() for each element.
+ * The results are the same as the ones of these functions.
+ * If the library is built with OpenMP (THEGAME_OPENMP), large batches are split over threads.
+ * @param m The BF_BeliefFunction to work on
+ * @param elements The elements to work on
+ * @param nbElements The number of elements
+ * @param bel The array filled with the nbElements credibilities (NULL if not required)
+ * @param pl The array filled with the nbElements plausibilities (NULL if not required)
+ * @param q The array filled with the nbElements commonalities (NULL if not required)
+ * @param betP The array filled with the nbElements pignistic probabilities (NULL if not required)
+ * @return 1 if the measures have been evaluated, 0 if an allocation failed.
+ */
+int BF_measures(const BF_BeliefFunction m, const Sets_Element* elements, const int nbElements,
+        BF_Mass* bel, BF_Mass* pl, BF_Mass* q, BF_Mass* betP);
+
+/**
+ * Same as BF_measures() but the elements are given by their ids (see Sets_packElement()).
+ * @param m The BF_BeliefFunction to work on (defined on at most SETS_PACKED_MAX_SIZE atoms)
+ * @param ids The ids of the elements to work on
+ * @param nbIds The number of elements
+ * @param bel The array filled with the nbIds credibilities (NULL if not required)
+ * @param pl The array filled with the nbIds plausibilities (NULL if not required)
+ * @param q The array filled with the nbIds commonalities (NULL if not required)
+ * @param betP The array filled with the nbIds pignistic probabilities (NULL if not required)
+ * @return 1 if the measures have been evaluated, 0 if an allocation failed.
+ */
+int BF_measuresOfIds(const BF_BeliefFunction m, const Sets_PackedElement* ids, const int nbIds,
+        BF_Mass* bel, BF_Mass* pl, BF_Mass* q, BF_Mass* betP);
 
 /** @} */
 
@@ -284,11 +579,36 @@ float BF_discrepancy(const BF_BeliefFunction m);
  */
 float BF_distance(const BF_BeliefFunction m1, const BF_BeliefFunction m2);
 
+/**
+ * Same as BF_distance() using the context of the frame. The Jaccard coefficients
+ * of the focal elements are taken from the cache of the context if it has been
+ * enabled (see Sets_enableJaccardCache()).
+ * @param m1 The first BF_BeliefFunction to work on
+ * @param m2 The second BF_BeliefFunction to work on
+ * @param ctx The context of the frame of m1 and m2
+ * @return The distance between the two BeliefFunctions
+ */
+float BF_distanceInContext(const BF_BeliefFunction m1, const BF_BeliefFunction m2, const Sets_Context* ctx);
+
+/**
+ * Gets the distances between all the pairs of a set of BeliefFunctions (see BF_distance()).
+ * The functions are projected on the union of their focal elements whose Jaccard matrix is
+ * computed only once (from the context if given) and the distances are obtained with vectorized
+ * dot products. The results are the same as BF_distance() up to the rounding of floats.
+ * @param m The set of BeliefFunctions (defined on the same frame)
+ * @param nbM The number of BeliefFunctions in the set
+ * @param ctx The context of the frame (may be NULL), useful with a Jaccard cache (see Sets_enableJaccardCache())
+ * @return The matrix of the distances (nbM x nbM floats, row i giving the distances between m[i] and the others).
+ * Must be freed after use.
+ */
+float* BF_distanceMatrix(const BF_BeliefFunction* m, const int nbM, const Sets_Context* ctx);
+
 /**
  * Get the global distance between a BF_BeliefFunction and a set of BeliefFunctions.
  * The rule used is defined in A. Martin 2009 (Modelisation et gestion du conflit
  * dans la theorie des fonctions de croyance (French)). The @link distance() @endlink is what is
  * is used to characterize the conflict between a BF_BeliefFunction and the given set.
+ * To get the distances between all the functions of a set, BF_distanceMatrix() is faster.
  * @param m The BF_BeliefFunction to work on
  * @param s The set of BeliefFunctions to work on (m should be included in)
  * @param nbBF The number of BeliefFunctions contained in the given set
@@ -310,6 +630,7 @@ float BF_similarity(const BF_BeliefFunction m1, const BF_BeliefFunction m2);
  * Get the support degree given to a BF_BeliefFunction by a set of BeliefFunctions.
  * The BF_BeliefFunction used as a reference should be included in the set.
  * This value is the sum of the similarity of ref with the functions of the given set.
+ * To get the support degrees of all the functions of a set, BF_supports() is faster.
  * @param ref The BF_BeliefFunction used as reference
  * @param m The set of BeliefFunctions that may support ref or not
  * @param nbM The number of BeliefFunctions in the set
@@ -317,6 +638,15 @@ float BF_similarity(const BF_BeliefFunction m1, const BF_BeliefFunction m2);
  */
 float BF_support(const BF_BeliefFunction ref, const BF_BeliefFunction* m, const int nbM);
 
+/**
+ * Gets the support degree given to each BF_BeliefFunction of a set by the whole set (see BF_support()).
+ * The distances between all the pairs are computed only once with BF_distanceMatrix().
+ * @param m The set of BeliefFunctions
+ * @param nbM The number of BeliefFunctions in the set
+ * @return The support degrees of the functions of the set (nbM values). Must be freed after use.
+ */
+float* BF_supports(const BF_BeliefFunction* m, const int nbM);
+
 /**
  * Checks the sum of all beliefs on elements.
  * @param m The BF_BeliefFunction to work on
@@ -334,6 +664,329 @@ int BF_checkValues(const BF_BeliefFunction m);
 /** @} */
 
 
+/* !!! Belief with element ids !!! */
+
+/**
+ * @name Belief functions with element ids
+ * @{
+ */
+
+/**
+ * Converts a belief function into a belief function with element ids.
+ * @param m The belief function to convert (defined on at most SETS_PACKED_MAX_SIZE atoms)
+ * @return The corresponding BF_PackedBeliefFunction. Must be freed after use.
+ */
+BF_PackedBeliefFunction BF_packBeliefFunction(const BF_BeliefFunction m);
+
+/**
+ * Converts a belief function with element ids into a belief function.
+ * @param m The belief function to convert
+ * @return The corresponding BF_BeliefFunction. Must be freed after use.
+ */
+BF_BeliefFunction BF_unpackBeliefFunction(const BF_PackedBeliefFunction m);
+
+/**
+ * Sorts the focal elements of a belief function by increasing element id.
+ * @param m The belief function to sort
+ */
+void BF_sortPackedBeliefFunction(BF_PackedBeliefFunction* m);
+
+/**
+ * Gets the mass of the given element.
+ * @param m The mass function
+ * @param e The id of the element
+ * @return m(e)
+ */
+BF_Mass BF_packedM(const BF_PackedBeliefFunction m, const Sets_PackedElement e);
+
+/**
+ * Gets the credibility of the given element.
+ * @param m The mass function
+ * @param e The id of the element
+ * @return bel(e)
+ */
+BF_Mass BF_packedBel(const BF_PackedBeliefFunction m, const Sets_PackedElement e);
+
+/**
+ * Gets the plausibility of the given element.
+ * @param m The mass function
+ * @param e The id of the element
+ * @return pl(e)
+ */
+BF_Mass BF_packedPl(const BF_PackedBeliefFunction m, const Sets_PackedElement e);
+
+/**
+ * Gets the commonality of the given element.
+ * @param m The mass function
+ * @param e The id of the element
+ * @return q(e)
+ */
+BF_Mass BF_packedQ(const BF_PackedBeliefFunction m, const Sets_PackedElement e);
+
+/**
+ * Gets the pignistic probability of the given element.
+ * @param m The mass function
+ * @param e The id of the element
+ * @return betP(e)
+ */
+BF_Mass BF_packedBetP(const BF_PackedBeliefFunction m, const Sets_PackedElement e);
+
+/** @} */
+
+
+/* !!! Dense belief !!! */
+
+/**
+ * @name Dense belief functions
+ * @{
+ */
+
+/**
+ * Tells if the dense form should be preferred to the sparse one for an operation on
+ * a frame of the given size producing at most nbFocals focal elements (for instance
+ * nb1 * nb2 for the combination of two mass functions).
+ * @param elementSize The number of atoms of the frame
+ * @param nbFocals The maximum number of focal elements
+ * @return 1 if the dense form should be used, 0 if not.
+ */
+int BF_preferDenseForm(const int elementSize, const int nbFocals);
+
+/**
+ * Converts a belief function into a dense belief function.
+ * @param m The belief function to convert (defined on at most BF_DENSE_MAX_SIZE atoms)
+ * @return The corresponding BF_DenseBeliefFunction. Must be freed after use.
+ */
+BF_DenseBeliefFunction BF_toDenseBeliefFunction(const BF_BeliefFunction m);
+
+/**
+ * Converts a dense belief function into a belief function. Only the elements with a non-null mass
+ * are kept, by increasing element id.
+ * @param m The dense belief function to convert
+ * @return The corresponding BF_BeliefFunction. Must be freed after use.
+ */
+BF_BeliefFunction BF_toSparseBeliefFunction(const BF_DenseBeliefFunction m);
+
+/**
+ * Copies a dense belief function.
+ * @param m The dense belief function to copy
+ * @return A copy of m. Must be freed after use.
+ */
+BF_DenseBeliefFunction BF_copyDenseBeliefFunction(const BF_DenseBeliefFunction m);
+
+/**
+ * Normalizes a dense belief function so that the sum of its masses is 1.
+ * @param m The dense belief function to normalize
+ */
+void BF_denseNormalize(BF_DenseBeliefFunction* m);
+
+/**
+ * Weakens a dense belief function (see BF_weakening()).
+ * @param m The dense belief function to weaken
+ * @param alpha The weakening factor
+ * @return The weakened dense belief function. Must be freed after use.
+ */
+BF_DenseBeliefFunction BF_denseWeakening(const BF_DenseBeliefFunction m, const float alpha);
+
+/**
+ * Discounts a dense belief function (see BF_discounting()).
+ * @param m The dense belief function to discount
+ * @param alpha The discounting factor
+ * @return The discounted dense belief function. Must be freed after use.
+ */
+BF_DenseBeliefFunction BF_denseDiscounting(const BF_DenseBeliefFunction m, const float alpha);
+
+/**
+ * Gets the mass of the given element in constant time.
+ * @param m The dense mass function
+ * @param e The id of the element
+ * @return m(e)
+ */
+BF_Mass BF_denseM(const BF_DenseBeliefFunction m, const Sets_PackedElement e);
+
+/**
+ * Gets the credibility of the given element (only the subsets of e are visited).
+ * @param m The dense mass function
+ * @param e The id of the element
+ * @return bel(e)
+ */
+BF_Mass BF_denseBel(const BF_DenseBeliefFunction m, const Sets_PackedElement e);
+
+/**
+ * Gets the plausibility of the given element.
+ * @param m The dense mass function
+ * @param e The id of the element
+ * @return pl(e)
+ */
+BF_Mass BF_densePl(const BF_DenseBeliefFunction m, const Sets_PackedElement e);
+
+/**
+ * Gets the commonality of the given element (only the supersets of e are visited).
+ * @param m The dense mass function
+ * @param e The id of the element
+ * @return q(e)
+ */
+BF_Mass BF_denseQ(const BF_DenseBeliefFunction m, const Sets_PackedElement e);
+
+/**
+ * Gets the pignistic probability of the given element.
+ * @param m The dense mass function
+ * @param e The id of the element
+ * @return betP(e)
+ */
+BF_Mass BF_denseBetP(const BF_DenseBeliefFunction m, const Sets_PackedElement e);
+
+/** @} */
+
+
+/**
+ * @name Transforms of dense belief functions
+ * These functions give the values of a function for all the subsets of the frame
+ * at once using the fast zeta and Moebius transforms on the lattice of subsets
+ * (O(n * 2^n) for a frame of n atoms). The results are stored in dense belief functions
+ * (values[e] being the value of the subset of id e).
+ * @{
+ */
+
+/**
+ * Gives the implicability of all the subsets: b(A) = sum of m(B) for B subset of A (void included).
+ * @param m The dense mass function
+ * @return The dense implicability function. Must be freed after use.
+ */
+BF_DenseBeliefFunction BF_denseImplicabilities(const BF_DenseBeliefFunction m);
+
+/**
+ * Gives the credibility of all the subsets (see BF_bel()).
+ * @param m The dense mass function
+ * @return The dense credibility function. Must be freed after use.
+ */
+BF_DenseBeliefFunction BF_denseCredibilities(const BF_DenseBeliefFunction m);
+
+/**
+ * Gives the plausibility of all the subsets (see BF_pl()).
+ * @param m The dense mass function
+ * @return The dense plausibility function. Must be freed after use.
+ */
+BF_DenseBeliefFunction BF_densePlausibilities(const BF_DenseBeliefFunction m);
+
+/**
+ * Gives the commonality of all the subsets (see BF_q()).
+ * @param m The dense mass function
+ * @return The dense commonality function. Must be freed after use.
+ */
+BF_DenseBeliefFunction BF_denseCommonalities(const BF_DenseBeliefFunction m);
+
+/**
+ * Gives the pignistic probability of all the subsets (see BF_betP()).
+ * @param m The dense mass function
+ * @return The dense pignistic probability function. Must be freed after use.
+ */
+BF_DenseBeliefFunction BF_densePignisticProbabilities(const BF_DenseBeliefFunction m);
+
+/**
+ * Gives back the mass function from its implicability function (Moebius transform).
+ * @param b The dense implicability function
+ * @return The dense mass function. Must be freed after use.
+ */
+BF_DenseBeliefFunction BF_denseMassesFromImplicabilities(const BF_DenseBeliefFunction b);
+
+/**
+ * Gives back the mass function from its credibility function. The masses are supposed
+ * to sum to 1 (m(void) = 1 - bel(complete)).
+ * @param bel The dense credibility function
+ * @return The dense mass function. Must be freed after use.
+ */
+BF_DenseBeliefFunction BF_denseMassesFromCredibilities(const BF_DenseBeliefFunction bel);
+
+/**
+ * Gives back the mass function from its plausibility function. The masses are supposed
+ * to sum to 1 (b(A) = 1 - pl(not A)).
+ * @param pl The dense plausibility function
+ * @return The dense mass function. Must be freed after use.
+ */
+BF_DenseBeliefFunction BF_denseMassesFromPlausibilities(const BF_DenseBeliefFunction pl);
+
+/**
+ * Gives back the mass function from its commonality function (Moebius transform).
+ * @param q The dense commonality function
+ * @return The dense mass function. Must be freed after use.
+ */
+BF_DenseBeliefFunction BF_denseMassesFromCommonalities(const BF_DenseBeliefFunction q);
+
+/** @} */
+
+
+/* !!! Compact belief functions !!! */
+
+/**
+ * @name Compact belief functions
+ * The values are the same as the ones of the corresponding functions on BF_BeliefFunction.
+ * @{
+ */
+
+/**
+ * Converts a belief function into its compact form.
+ * @param m The belief function to convert
+ * @return The corresponding BF_CompactBeliefFunction. Must be freed after use.
+ */
+BF_CompactBeliefFunction BF_toCompactBeliefFunction(const BF_BeliefFunction m);
+
+/**
+ * Converts a compact belief function into a belief function.
+ * @param m The compact belief function to convert
+ * @return The corresponding BF_BeliefFunction. Must be freed after use.
+ */
+BF_BeliefFunction BF_fromCompactBeliefFunction(const BF_CompactBeliefFunction m);
+
+/**
+ * Copies a compact belief function.
+ * @param m The compact belief function to copy
+ * @return A new BF_CompactBeliefFunction. Must be freed after use.
+ */
+BF_CompactBeliefFunction BF_copyCompactBeliefFunction(const BF_CompactBeliefFunction m);
+
+/**
+ * Gets the mass of the given element.
+ * @param m The mass function
+ * @param e The element
+ * @return m(e)
+ */
+BF_Mass BF_compactM(const BF_CompactBeliefFunction m, const Sets_Element e);
+
+/**
+ * Gets the credibility of the given element.
+ * @param m The mass function
+ * @param e The element
+ * @return bel(e)
+ */
+BF_Mass BF_compactBel(const BF_CompactBeliefFunction m, const Sets_Element e);
+
+/**
+ * Gets the plausibility of the given element.
+ * @param m The mass function
+ * @param e The element
+ * @return pl(e)
+ */
+BF_Mass BF_compactPl(const BF_CompactBeliefFunction m, const Sets_Element e);
+
+/**
+ * Gets the commonality of the given element.
+ * @param m The mass function
+ * @param e The element
+ * @return q(e)
+ */
+BF_Mass BF_compactQ(const BF_CompactBeliefFunction m, const Sets_Element e);
+
+/**
+ * Gets the pignistic probability of the given element.
+ * @param m The mass function
+ * @param e The element
+ * @return betP(e)
+ */
+BF_Mass BF_compactBetP(const BF_CompactBeliefFunction m, const Sets_Element e);
+
+/** @} */
+
+
 /* !!! Deallocate memory given to believes !!! */
 
 /**
@@ -353,6 +1006,24 @@ void BF_freeBeliefFunction(BF_BeliefFunction* bf);
  */
 void BF_freeBeliefPoint(BF_FocalElement *bp);
 
+/**
+ * Frees the memory used for the BF_PackedBeliefFunction.
+ * @param m A pointer to the BF_PackedBeliefFunction to free
+ */
+void BF_freePackedBeliefFunction(BF_PackedBeliefFunction* m);
+
+/**
+ * Frees the memory used for the BF_DenseBeliefFunction.
+ * @param m A pointer to the BF_DenseBeliefFunction to free
+ */
+void BF_freeDenseBeliefFunction(BF_DenseBeliefFunction* m);
+
+/**
+ * Frees the memory used for the BF_CompactBeliefFunction.
+ * @param m A pointer to the BF_CompactBeliefFunction to free
+ */
+void BF_freeCompactBeliefFunction(BF_CompactBeliefFunction* m);
+
 /** @} */
 
 /* !!! Conversion into strings !!! */
@@ -380,6 +1051,23 @@ char* BF_beliefFunctionToString(const BF_BeliefFunction bf, const Sets_Reference
  */
 char* BF_beliefFunctionToBitString(const BF_BeliefFunction bf);
 
+/**
+ * Appends the representation of a BF_BeliefFunction to a buffer
+ * (same representation as BF_beliefFunctionToString()).
+ * @param buffer The buffer in which to write
+ * @param bf The BF_BeliefFunction to convert
+ * @param rl The ReferenceList containing the real values of the context attribute
+ */
+void BF_appendBeliefFunction(StringBuffer* buffer, const BF_BeliefFunction bf, const Sets_ReferenceList rl);
+
+/**
+ * Appends the representation of a BF_BeliefFunction to a buffer where elements are given
+ * in their binary form (same representation as BF_beliefFunctionToBitString()).
+ * @param buffer The buffer in which to write
+ * @param bf The BF_BeliefFunction to convert
+ */
+void BF_appendBeliefFunctionBits(StringBuffer* buffer, const BF_BeliefFunction bf);
+
 /** @} */
 
 #endif
@@ -325,6 +325,33 @@ char* BFB_beliefFromBeliefToString(const BFB_BeliefFromBelief bfb, const Sets_Re
  */
 char* BFB_beliefVectorToString(const BFB_BeliefVector bv, const Sets_ReferenceList to, const Sets_ReferenceList from);
 
+/**
+ * Appends the representation of a BFB_BeliefStructure to a buffer
+ * (same representation as BFB_beliefStructureToString()).
+ * @param buffer The buffer in which to write
+ * @param bs The BFB_BeliefStructure to convert
+ */
+void BFB_appendBeliefStructure(StringBuffer* buffer, const BFB_BeliefStructure bs);
+
+/**
+ * Appends the representation of a BFB_BeliefFromBelief to a buffer
+ * (same representation as BFB_beliefFromBeliefToString()).
+ * @param buffer The buffer in which to write
+ * @param bfb The BFB_BeliefFromBelief to convert
+ * @param to The Sets_ReferenceList to use to get the real values of resulting elements
+ */
+void BFB_appendBeliefFromBelief(StringBuffer* buffer, const BFB_BeliefFromBelief bfb, const Sets_ReferenceList to);
+
+/**
+ * Appends the representation of a BFB_BeliefVector to a buffer
+ * (same representation as BFB_beliefVectorToString()).
+ * @param buffer The buffer in which to write
+ * @param bv The BFB_BeliefVector to convert
+ * @param to The Sets_ReferenceList to use to get the real values of resulting elements
+ * @param from The Sets_ReferenceList to use to the real values of elements to transform
+ */
+void BFB_appendBeliefVector(StringBuffer* buffer, const BFB_BeliefVector bv, const Sets_ReferenceList to, const Sets_ReferenceList from);
+
 
 /** @} */
 
@@ -64,7 +64,7 @@ BF_BeliefFunction BFR_getCrappyRandomBelief(const int elementSize);
 /**
  * Generates a crappy random belief function with a fixed number of focal elements but those
  * elements and their mass values are random. A constraint nbFocals <= 2^elementSize has to
- * be respected. Returns a null BF_BeliefFunction if not.
+ * be respected. Returns a null BF_BeliefFunction if not. Frames of any size are supported.
  * @param elementSize The number of possible states/worlds.
  * @param nbFocals The number of focal elements wanted.
  * @param A random belief function.
@@ -49,6 +49,9 @@
  * read Pietropaoli et al. 2012 for explanations. It takes the number of seconds before complete forgetness as parameter.
  * @li Tempo-Fusion : includes temporization in the building of mass functions using a fusion based on Dubois & Prade's combination rule.
  * It takes the number of seconds before complete forgetness as parameter.
+ * @li Max-Focals : bounds the number of focal elements of the built mass functions and of the ones kept by the
+ * temporization (summarization, see BF_approximation()), so that the cost of the fusions does not grow over time.
+ * It takes the maximum number of focal elements as parameter.
  *
  * @section BFS_howto How to use this module
  * So, to build your sets of mass functions, you should do the following :
@@ -127,6 +130,16 @@
  */
 #define NO_MEASURE -1048576
 
+/**
+ * @def BFS_POWERSET_MAX_SIZE
+ * The maximum number of possible values of a frame of discernment for its powerset
+ * to be stored in the belief structure (as a Sets_Set of 2^n elements), i.e. the largest
+ * powerset Sets_createPowerSet() can store. The lazy view on the powerset (powersetView)
+ * is given for all frames. Larger frames only have the view: their powerset is empty and
+ * callers must use powersetView (and the InView decision functions) instead.
+ */
+#define BFS_POWERSET_MAX_SIZE 30
+
 /**
  * @def CLOCK_ID
  * Defines the clock ID to use for the function clock_gettime(). By default, it is set to CLOCK_MONOTONIC.
@@ -151,7 +164,8 @@ enum BFS_OptionFlags{
 	OP_NONE               = 0,
 	OP_VARIATION          = 1 << 0,
 	OP_TEMPO_SPECIFICITY  = 1 << 1,
-	OP_TEMPO_FUSION       = 1 << 2
+	OP_TEMPO_FUSION       = 1 << 2,
+	OP_MAX_FOCALS         = 1 << 3
 };
 typedef enum BFS_OptionFlags BFS_OptionFlags;
 
@@ -268,9 +282,10 @@ typedef struct BFS_SensorBeliefs BFS_SensorBeliefs;
  * @param frameName The name of the frame of discernment (or the thing we want to believe on)
  * @param refList The Sets_ReferenceList corresponding to the real values of the frame of discernment
  * @param possibleValues The set of all possible values for the frame of discernment
- * @param powerset The set of all subsets of possible values
+ * @param powerset The set of all subsets of possible values (empty if there are more than BFS_POWERSET_MAX_SIZE possible values, use powersetView then)
  * @param beliefs The model of belief to get the frame of discernment value
  * @param nbSensors The number of sensors in the structure
+ * @param powersetView A lazy view on the set of all subsets of possible values
  * @struct BFS_BeliefStructure
  */
 struct BFS_BeliefStructure{
@@ -280,6 +295,7 @@ struct BFS_BeliefStructure{
     Sets_Set powerset;
     BFS_SensorBeliefs* beliefs;
     int nbSensors;
+    Sets_PowerSetView powersetView;
 };
 typedef struct BFS_BeliefStructure BFS_BeliefStructure;
 
@@ -653,6 +669,40 @@ char* BFS_sensorBeliefsToString(const BFS_SensorBeliefs sb, const Sets_Reference
  */
 char* BFS_beliefStructureToString(const BFS_BeliefStructure bs);
 
+/**
+ * Appends the representation of a BFS_PartOfBelief to a buffer
+ * (same representation as BFS_partOfBeliefToString()).
+ * @param buffer The buffer in which to write
+ * @param pob The BFS_PartOfBelief to convert
+ * @param rl The Sets_ReferenceList containing the real values of the frame of discernment
+ */
+void BFS_appendPartOfBelief(StringBuffer* buffer, const BFS_PartOfBelief pob, const Sets_ReferenceList rl);
+
+/**
+ * Appends the representation of a BFS_Option to a buffer
+ * (same representation as BFS_optionToString()).
+ * @param buffer The buffer in which to write
+ * @param o The BFS_Option to convert
+ */
+void BFS_appendOption(StringBuffer* buffer, const BFS_Option o);
+
+/**
+ * Appends the representation of a BFS_SensorBeliefs to a buffer
+ * (same representation as BFS_sensorBeliefsToString()).
+ * @param buffer The buffer in which to write
+ * @param sb The BFS_SensorBeliefs to convert
+ * @param rl The Sets_ReferenceList containing the real values of the frame of discernment
+ */
+void BFS_appendSensorBeliefs(StringBuffer* buffer, const BFS_SensorBeliefs sb, const Sets_ReferenceList rl);
+
+/**
+ * Appends the representation of a BFS_BeliefStructure to a buffer
+ * (same representation as BFS_beliefStructureToString()).
+ * @param buffer The buffer in which to write
+ * @param bs The BFS_BeliefStructure to convert
+ */
+void BFS_appendBeliefStructure(StringBuffer* buffer, const BFS_BeliefStructure bs);
+
 /** @} */
 
 #endif
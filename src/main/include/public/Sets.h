@@ -19,8 +19,11 @@
 #define DEF_SETS
 
 #include <math.h>
+#include <stdint.h>
 
+#include "Arena.h"
 #include "ReadFile.h"
+#include "StringBuffer.h"
 #include "config.h"
 
 /**
@@ -37,16 +40,25 @@
   +------------+
 */
 
+/**
+ * A hash index of the values of a reference list (value -> position).
+ * Its content is private to the Sets module.
+ * @struct Sets_RefListIndex
+ */
+typedef struct Sets_RefListIndex Sets_RefListIndex;
+
 /**
  * The reference list to get the real values
  * of the atoms in a set or in an element.
  * @param values The real values (strings) of the atoms
  * @param card The cardinal of the list
+ * @param index The hash index of the values (NULL if the list is not indexed)
  * @struct Sets_ReferenceList
  */
 struct Sets_ReferenceList {
     char** values;
     int card;
+    Sets_RefListIndex* index;
 };
 typedef struct Sets_ReferenceList Sets_ReferenceList;
 
@@ -80,6 +92,104 @@ struct Sets_Set {
 typedef struct Sets_Set Sets_Set;
 
 
+/**
+ * @def SETS_PACKED_MAX_SIZE
+ * The maximum number of atoms an element can have to be
+ * represented as a Sets_PackedElement.
+ */
+#define SETS_PACKED_MAX_SIZE 64
+
+/**
+ * A packed representation of elements for frames of at most
+ * SETS_PACKED_MAX_SIZE atoms. The atom i of the element is stored
+ * in the bit i of a machine word. Packed elements do not require
+ * any allocation and operations on them are single instructions.
+ * @typedef Sets_PackedElement
+ */
+typedef uint64_t Sets_PackedElement;
+
+
+/**
+ * A lazy view on the powerset of a frame of at most SETS_PACKED_MAX_SIZE atoms.
+ * Contrary to a powerset stored in a Sets_Set, a view does not contain
+ * any element: they are generated on demand with a Sets_PowerSetIterator.
+ * The view can be restricted to the subsets having a cardinality in
+ * [minCard, maxCard], to the subsets of a given element and to the
+ * supersets of a given element.
+ * @param elementSize The number of atoms of the frame
+ * @param minCard The minimum cardinality of the subsets in the view
+ * @param maxCard The maximum cardinality of the subsets in the view
+ * @param subsetOf The subsets in the view are all subsets of this (packed) element
+ * @param supersetOf The subsets in the view are all supersets of this (packed) element
+ * @struct Sets_PowerSetView
+ */
+struct Sets_PowerSetView {
+    int elementSize;
+    int minCard;
+    int maxCard;
+    Sets_PackedElement subsetOf;
+    Sets_PackedElement supersetOf;
+};
+typedef struct Sets_PowerSetView Sets_PowerSetView;
+
+
+/**
+ * An iterator over the subsets of a Sets_PowerSetView.
+ * The current subset is available in element (and in id in its packed form).
+ * The values of element belong to the iterator and must not be freed or
+ * kept after the next call to Sets_nextSubset().
+ * The other fields give the state of the enumeration and should not be modified.
+ * @param element The current subset
+ * @param id The current subset in its packed form
+ * @param view The view iterated on
+ * @param atoms The atoms that vary from one subset to another
+ * @param nbAtoms The number of atoms that vary
+ * @param combination The current combination of varying atoms
+ * @param card The cardinality of the current combination (-1 before the first subset)
+ * @param minCard The minimum number of varying atoms in a combination
+ * @param maxCard The maximum number of varying atoms in a combination
+ * @param byCard 1 if the combinations are restricted by their cardinality, 0 if not
+ * @struct Sets_PowerSetIterator
+ */
+struct Sets_PowerSetIterator {
+    Sets_Element element;
+    Sets_PackedElement id;
+    Sets_PowerSetView view;
+    Sets_PackedElement atoms;
+    int nbAtoms;
+    Sets_PackedElement combination;
+    int card;
+    int minCard;
+    int maxCard;
+    int byCard;
+};
+typedef struct Sets_PowerSetIterator Sets_PowerSetIterator;
+
+/**
+ * @def SETS_JACCARD_CACHE_MAX_SIZE
+ * The maximum size of the frames for which a context may store the Jaccard
+ * coefficients of all the pairs of subsets (2^(2 * size) floats).
+ */
+#define SETS_JACCARD_CACHE_MAX_SIZE 8
+
+/**
+ * Data about a frame of discernment computed once and shared by the functions
+ * working on this frame (the ...InContext() functions). A context is only read by
+ * these functions and can thus be shared by several threads.
+ * @param elementSize The size of the frame
+ * @param fullMask The complete element in its packed form (frames of at most SETS_PACKED_MAX_SIZE atoms, 0 for larger ones)
+ * @param jaccard The Jaccard coefficients |A n B| / |A u B| indexed by (id(A) << elementSize) | id(B), 1 for void and void
+ * (NULL if not computed, see Sets_enableJaccardCache())
+ * @struct Sets_Context
+ */
+struct Sets_Context {
+    int elementSize;
+    Sets_PackedElement fullMask;
+    float* jaccard;
+};
+typedef struct Sets_Context Sets_Context;
+
+
 /*
   +-----------+
   | FUNCTIONS |
@@ -111,6 +221,23 @@ Sets_ReferenceList Sets_loadRefList(const char* filename);
  */
 Sets_ReferenceList Sets_createRefListFromArray(const char* const * values, int size);
 
+/**
+ * Builds (or rebuilds) the hash index of a reference list. The lists given by Sets_loadRefList()
+ * and Sets_createRefListFromArray() are already indexed. A list built by hand must have its index
+ * set to NULL or be indexed with this function. The index must be rebuilt if the values are modified.
+ * @param rl The ReferenceList to index
+ */
+void Sets_indexRefList(Sets_ReferenceList* rl);
+
+/**
+ * Gets the position of a value in a reference list (i.e. the atom corresponding to this value).
+ * Takes a constant time if the list is indexed, a time linear in the size of the list if not.
+ * @param rl The ReferenceList in which to look for the value
+ * @param value The value to look for
+ * @return The position of the value in the list, -1 if the value is not in the list.
+ */
+int Sets_getRefListPosition(const Sets_ReferenceList rl, const char* value);
+
 /** @} */
 
 
@@ -138,10 +265,11 @@ Sets_Set Sets_createSetFromRefList(const Sets_ReferenceList rl);
 Sets_Set Sets_createSet(const int nbAtoms);
 
 /**
- * Creates a powerset using a Set.
- * @param set The generator set, assuming that it contains only atoms
- * @return A new set representing the powerset. Must be freed
- *         after use.
+ * Creates a powerset using a Set. The element i of the powerset is
+ * the element whose binary form is i.
+ * @param set The generator set, assuming that it contains only atoms (at most 30)
+ * @return A new set representing the powerset (empty if there are more than 30 atoms).
+ *         Must be freed after use.
  */
 Sets_Set Sets_createPowerSet(const Sets_Set set);
 
@@ -154,6 +282,7 @@ Sets_Set Sets_generatePowerSet(const int elementSize);
 
 /**
  * Creates an element from a list of string values.
+ * If the ReferenceList is indexed, it takes a time linear in the number of values.
  * @param values The strings corresponding to the values
  * @param nbValues The number of values to store
  * @param rl The ReferenceList containing the real values of the context attribute
@@ -203,6 +332,8 @@ Sets_Element Sets_getOpposite(const Sets_Element e, const int size);
 
 /**
  * Builds an element from the integer corresponding to its binary form.
+ * An int only holds the elements of frames of at most 31 atoms: Sets_unpackElement()
+ * works with 64-bit codes and Sets_elementFromWide() with codes of any width.
  * @param number The number to convert into an Element in a binary form.
  * @param nbDigits The number of digits to use for the binary form.
  * @result The corresponding Element. Must be freed after use.
@@ -211,6 +342,8 @@ Sets_Element Sets_elementFromNumber(const int number, const int nbDigits);
 
 /**
  * Gives the number corresponding to the binary form of an Element.
+ * An int only holds the elements of frames of at most 31 atoms: Sets_packElement()
+ * gives 64-bit codes and Sets_wideFromElement() codes of any width.
  * @param e The Sets_Element to convert.
  * @param nbDigits The number of digits used for the binary form.
  * @result The number corresponding to the binary form of the given Element.
@@ -280,6 +413,339 @@ int Sets_isSubset(const Sets_Element e1, const Sets_Element e2, const int size);
 /** @} */
 
 
+/* !!! Operations without allocation !!! */
+
+
+/**
+ * @name Operations on elements without allocation
+ * These functions write their result into a caller-provided element
+ * whose values must already be allocated with (at least) size chars.
+ * The destination may be one of the operands. They do not allocate anything
+ * and are meant to be used in loops with a single temporary element.
+ * @{
+ */
+
+/**
+ * Copies an element into another one.
+ * @param dst The element where to store the copy
+ * @param e The element to copy
+ * @param size The size of the elements
+ */
+void Sets_copyElementInto(Sets_Element* dst, const Sets_Element e, const int size);
+
+/**
+ * Sets an element to the empty set.
+ * @param dst The element to set
+ * @param size The size of the element
+ */
+void Sets_getEmptyElementInto(Sets_Element* dst, const int size);
+
+/**
+ * Sets an element to the complete set.
+ * @param dst The element to set
+ * @param size The size of the element
+ */
+void Sets_getCompleteElementInto(Sets_Element* dst, const int size);
+
+/**
+ * Computes the opposite of the element e.
+ * @param dst The element where to store the opposite
+ * @param e The element whose opposite is required
+ * @param size The size of the elements
+ */
+void Sets_getOppositeInto(Sets_Element* dst, const Sets_Element e, const int size);
+
+/**
+ * Computes the conjunction of two elements.
+ * @param dst The element where to store the conjunction
+ * @param e1 The first element of the operation
+ * @param e2 The second element of the operation
+ * @param size The size of the elements
+ */
+void Sets_conjunctionInto(Sets_Element* dst, const Sets_Element e1, const Sets_Element e2, const int size);
+
+/**
+ * Computes the disjunction of two elements.
+ * @param dst The element where to store the disjunction
+ * @param e1 The first element of the operation
+ * @param e2 The second element of the operation
+ * @param size The size of the elements
+ */
+void Sets_disjunctionInto(Sets_Element* dst, const Sets_Element e1, const Sets_Element e2, const int size);
+
+/** @} */
+
+
+/* !!! Packed elements !!! */
+
+
+/**
+ * @name Packed elements
+ * Elements of frames of at most SETS_PACKED_MAX_SIZE atoms can be
+ * packed into a single word to speed up the operations on them.
+ * @{
+ */
+
+/**
+ * Packs an element into a single word.
+ * Only the first SETS_PACKED_MAX_SIZE atoms are packed, the others are ignored.
+ * @param e The element to pack (one byte per atom, equal to 0 or 1)
+ * @param size The size of the element (at most SETS_PACKED_MAX_SIZE)
+ * @return The packed element.
+ */
+Sets_PackedElement Sets_packElement(const Sets_Element e, const int size);
+
+/**
+ * Unpacks a packed element.
+ * The atoms beyond SETS_PACKED_MAX_SIZE are set to 0.
+ * @param p The packed element
+ * @param size The size of the element (at most SETS_PACKED_MAX_SIZE)
+ * @return The corresponding element. Must be freed after use.
+ */
+Sets_Element Sets_unpackElement(const Sets_PackedElement p, const int size);
+
+/**
+ * Unpacks a packed element into an already allocated element.
+ * @param dst The element where to store the unpacked element (size chars)
+ * @param p The packed element
+ * @param size The size of the element (at most SETS_PACKED_MAX_SIZE)
+ */
+void Sets_unpackElementInto(Sets_Element* dst, const Sets_PackedElement p, const int size);
+
+/**
+ * Creates a packed element from an array of strings and a reference list.
+ * @param values The values of the element
+ * @param nbValues The number of values
+ * @param rl The reference list to use (at most SETS_PACKED_MAX_SIZE values)
+ * @return The packed element.
+ */
+Sets_PackedElement Sets_packedFromStrings(const char* const * const values, const int nbValues, const Sets_ReferenceList rl);
+
+/**
+ * Creates a packed element from an array of bits.
+ * @param values The bits (one char per atom, equal to 0 or 1)
+ * @param size The size of the element (at most SETS_PACKED_MAX_SIZE)
+ * @return The packed element.
+ */
+Sets_PackedElement Sets_packedFromBits(const char* values, const int size);
+
+/**
+ * Converts a packed element into a string.
+ * @param p The packed element
+ * @param rl The reference list to use
+ * @return The string representing the element. Must be freed after use.
+ */
+char* Sets_packedToString(const Sets_PackedElement p, const Sets_ReferenceList rl);
+
+/**
+ * Converts a packed element into a string of bits.
+ * @param p The packed element
+ * @param size The size of the element (at most SETS_PACKED_MAX_SIZE)
+ * @return The string of bits representing the element. Must be freed after use.
+ */
+char* Sets_packedToBitString(const Sets_PackedElement p, const int size);
+
+/**
+ * Gives the packed complete set.
+ * @param size The size of the elements (at most SETS_PACKED_MAX_SIZE)
+ * @return The packed complete set.
+ */
+static inline Sets_PackedElement Sets_packedCompleteElement(const int size){
+    return size >= SETS_PACKED_MAX_SIZE ? ~(Sets_PackedElement)0 : ((Sets_PackedElement)1 << size) - 1;
+}
+
+/**
+ * Gives the opposite of a packed element.
+ * @param p The packed element whose opposite is required
+ * @param size The size of the elements
+ * @return The packed opposite of p.
+ */
+static inline Sets_PackedElement Sets_packedOpposite(const Sets_PackedElement p, const int size){
+    return ~p & Sets_packedCompleteElement(size);
+}
+
+/**
+ * Conjunction operation for packed elements.
+ * @param p1 The first packed element
+ * @param p2 The second packed element
+ * @return The packed conjunction of p1 and p2.
+ */
+static inline Sets_PackedElement Sets_packedConjunction(const Sets_PackedElement p1, const Sets_PackedElement p2){
+    return p1 & p2;
+}
+
+/**
+ * Disjunction operation for packed elements.
+ * @param p1 The first packed element
+ * @param p2 The second packed element
+ * @return The packed disjunction of p1 and p2.
+ */
+static inline Sets_PackedElement Sets_packedDisjunction(const Sets_PackedElement p1, const Sets_PackedElement p2){
+    return p1 | p2;
+}
+
+/**
+ * Compares two packed elements.
+ * @param p1 The first packed element
+ * @param p2 The second packed element to compare to
+ * @return 1 if p1=p2, 0 if not.
+ */
+static inline int Sets_packedEquals(const Sets_PackedElement p1, const Sets_PackedElement p2){
+    return p1 == p2;
+}
+
+/**
+ * Tests if a packed element is a subset of another one.
+ * @param p1 The packed element that may be included
+ * @param p2 The packed 'set' in which p1 may be included
+ * @return 1 if p1 is a subset of p2, 0 if not.
+ */
+static inline int Sets_packedIsSubset(const Sets_PackedElement p1, const Sets_PackedElement p2){
+    return (p1 & ~p2) == 0;
+}
+
+/**
+ * Gives the cardinality of a packed element (population count).
+ * @param p The packed element
+ * @return The number of atoms in p.
+ */
+static inline int Sets_packedCard(const Sets_PackedElement p){
+    #if defined(__GNUC__) && defined(__POPCNT__)
+    return __builtin_popcountll(p);
+    #else
+    Sets_PackedElement x = p;
+    x = x - ((x >> 1) & UINT64_C(0x5555555555555555));
+    x = (x & UINT64_C(0x3333333333333333)) + ((x >> 2) & UINT64_C(0x3333333333333333));
+    x = (x + (x >> 4)) & UINT64_C(0x0f0f0f0f0f0f0f0f);
+    return (int)((x * UINT64_C(0x0101010101010101)) >> 56);
+    #endif
+}
+
+/** @} */
+
+
+/* !!! Lazy powersets !!! */
+
+
+/**
+ * @name Lazy powersets
+ * Powersets of large frames cannot be stored in a Sets_Set (2^n elements).
+ * These functions give views on powersets and iterate over them
+ * without materializing them. Typical use:
+ * @code
+ * Sets_PowerSetIterator it = Sets_iteratePowerSet(Sets_getPowerSetView(size));
+ * while(Sets_nextSubset(&it)){
+ *     ... it.element ...
+ * }
+ * Sets_freePowerSetIterator(&it);
+ * @endcode
+ * @{
+ */
+
+/**
+ * Gives a view on the whole powerset of a frame.
+ * @param elementSize The number of atoms of the frame (at most SETS_PACKED_MAX_SIZE)
+ * @return The view on all the subsets of the frame.
+ */
+Sets_PowerSetView Sets_getPowerSetView(const int elementSize);
+
+/**
+ * Restricts a view to the subsets having a cardinality in [minCard, maxCard].
+ * The iteration then jumps directly from one subset of the view to the next
+ * one (Gosper's hack if minCard = maxCard) so that its cost only depends on
+ * the number of subsets in the view (e.g. C(n, k) for the subsets of k atoms)
+ * and not on the size of the whole powerset.
+ * @param view The view to restrict
+ * @param minCard The minimum cardinality
+ * @param maxCard The maximum cardinality
+ * @return The restricted view.
+ */
+Sets_PowerSetView Sets_restrictToCardinality(const Sets_PowerSetView view, const int minCard, const int maxCard);
+
+/**
+ * Restricts a view to the subsets of an element.
+ * @param view The view to restrict
+ * @param e The element whose subsets are kept
+ * @return The restricted view.
+ */
+Sets_PowerSetView Sets_restrictToSubsetsOf(const Sets_PowerSetView view, const Sets_Element e);
+
+/**
+ * Restricts a view to the supersets of an element.
+ * @param view The view to restrict
+ * @param e The element whose supersets are kept
+ * @return The restricted view.
+ */
+Sets_PowerSetView Sets_restrictToSupersetsOf(const Sets_PowerSetView view, const Sets_Element e);
+
+/**
+ * Creates an iterator over the subsets of a view. The subsets are given
+ * by increasing id, i.e. in the same order as in the powersets created by
+ * Sets_generatePowerSet().
+ * @param view The view to iterate on
+ * @return A new iterator positioned before the first subset. Must be freed after use.
+ */
+Sets_PowerSetIterator Sets_iteratePowerSet(const Sets_PowerSetView view);
+
+/**
+ * Moves an iterator to the next subset of its view.
+ * @param it The iterator
+ * @return 1 if the iterator gives a new subset, 0 if all the subsets have been given.
+ */
+int Sets_nextSubset(Sets_PowerSetIterator* it);
+
+/**
+ * Frees the memory used by an iterator.
+ * @param it A pointer to the iterator to deallocate in memory
+ */
+void Sets_freePowerSetIterator(Sets_PowerSetIterator* it);
+
+/** @} */
+
+
+/* !!! Set algebra contexts !!! */
+
+
+/**
+ * @name Set algebra contexts
+ * @{
+ */
+
+/**
+ * Creates the context of a frame of discernment.
+ * @param elementSize The size of the frame
+ * @return A new context without Jaccard cache. Must be freed after use.
+ */
+Sets_Context Sets_createContext(const int elementSize);
+
+/**
+ * Creates the context of the frame of discernment defined by a reference list.
+ * @param rl The ReferenceList of the atoms of the frame
+ * @return A new context without Jaccard cache. Must be freed after use.
+ */
+Sets_Context Sets_createContextFromRefList(const Sets_ReferenceList rl);
+
+/**
+ * Computes the Jaccard coefficients of all the pairs of subsets of the frame of a context
+ * (only for frames of at most SETS_JACCARD_CACHE_MAX_SIZE atoms).
+ * @param ctx The context
+ * @return 1 if the coefficients are available in the context, 0 if the frame is too large.
+ */
+int Sets_enableJaccardCache(Sets_Context* ctx);
+
+/**
+ * Gets the Jaccard coefficient |A n B| / |A u B| of two packed elements (1 if both are void),
+ * from the cache of the context if it has been enabled.
+ * @param ctx The context of the frame of the elements
+ * @param a The first element
+ * @param b The second element
+ * @return The Jaccard coefficient of a and b.
+ */
+float Sets_jaccardInContext(const Sets_Context* ctx, const Sets_PackedElement a, const Sets_PackedElement b);
+
+/** @} */
+
+
 /* !!! Deallocation of the memory !!! */
 
 
@@ -306,6 +772,12 @@ void Sets_freeElement(Sets_Element* e);
  */
 void Sets_freeSet(Sets_Set* s);
 
+/**
+ * Frees the memory used by a context.
+ * @param ctx A pointer to the context to deallocate in memory
+ */
+void Sets_freeContext(Sets_Context* ctx);
+
 /** @} */
 
 
@@ -352,6 +824,42 @@ char* Sets_setToString(const Sets_Set s, const Sets_ReferenceList rl);
  */
 char* Sets_setToBitString(const Sets_Set s, int size);
 
+/**
+ * Appends the natural representation of an element to a buffer
+ * (same representation as Sets_elementToString()).
+ * @param buffer The buffer in which to write
+ * @param e The element to convert
+ * @param rl The ReferenceList containing the real value of atoms
+ */
+void Sets_appendElement(StringBuffer* buffer, const Sets_Element e, const Sets_ReferenceList rl);
+
+/**
+ * Appends the binary representation of an element to a buffer
+ * (same representation as Sets_elementToBitString()).
+ * @param buffer The buffer in which to write
+ * @param e The element to convert
+ * @param size The size of the elements
+ */
+void Sets_appendElementBits(StringBuffer* buffer, const Sets_Element e, const int size);
+
+/**
+ * Appends the natural representation of a set to a buffer
+ * (same representation as Sets_setToString()).
+ * @param buffer The buffer in which to write
+ * @param s The set to convert
+ * @param rl The ReferenceList containing the real value of atoms
+ */
+void Sets_appendSet(StringBuffer* buffer, const Sets_Set s, const Sets_ReferenceList rl);
+
+/**
+ * Appends the binary representation of a set to a buffer
+ * (same representation as Sets_setToBitString()).
+ * @param buffer The buffer in which to write
+ * @param s The set to convert
+ * @param size The size of the elements
+ */
+void Sets_appendSetBits(StringBuffer* buffer, const Sets_Set s, const int size);
+
 /** @} */
 
 #endif
@@ -0,0 +1,282 @@
+/*
+ * Copyright 2011-2014, EDF. This software was developed with the collaboration of INRIA (Bastien Pietropaoli)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#ifndef DEF_SETSWIDE
+#define DEF_SETSWIDE
+
+#include <stdint.h>
+
+#include "Sets.h"
+
+/**
+ * This module extends the Sets module with a multi-word bitset representation
+ * of elements for large frames (more than SETS_PACKED_MAX_SIZE atoms). The atom i
+ * of an element is stored in the bit (i % 64) of the word (i / 64).
+ *
+ * The operations on words (conjunction, disjunction, difference, population count,
+ * subset test...) are implemented with different instruction sets (scalar, SSE4.2,
+ * AVX2 and AVX-512). The best set of kernels supported by the CPU is selected at
+ * runtime the first time a kernel is used, from any thread. It can also be forced with
+ * Sets_useWordKernels().
+ *
+ * @file SetsWide.h
+ * @author Bastien Pietropaoli (bastien.pietropaoli@inria.fr)
+ * @brief CORE: Implements multi-word elements
+ * and vectorized operations on them.
+ */
+
+/*
+  +--------------+
+  | ENUMERATIONS |
+  +--------------+
+*/
+
+/**
+ * @enum Sets_WordKernels
+ * The different sets of kernels used for the operations on words.
+ */
+enum Sets_WordKernels
+{
+    KERNELS_AUTO,
+    KERNELS_SCALAR,
+    KERNELS_SSE,
+    KERNELS_AVX2,
+    KERNELS_AVX512
+};
+typedef enum Sets_WordKernels Sets_WordKernels;
+
+
+/*
+  +------------+
+  | STRUCTURES |
+  +------------+
+*/
+
+/**
+ * @def SETS_WIDE_NB_WORDS
+ * The number of words required to store an element of the given size.
+ */
+#define SETS_WIDE_NB_WORDS(size) (((size) + 63) / 64)
+
+/**
+ * @def SETS_WIDE_STACK_WORDS
+ * The number of words of the temporary elements that the library keeps on the stack.
+ * Larger elements (more than 64 * SETS_WIDE_STACK_WORDS atoms) use temporary allocations.
+ */
+#define SETS_WIDE_STACK_WORDS 8
+
+/**
+ * A multi-word representation of elements.
+ * @param words The words containing the atoms (SETS_WIDE_NB_WORDS(size) words)
+ * @param card The cardinality of the element
+ * @struct Sets_WideElement
+ */
+struct Sets_WideElement {
+    uint64_t* words;
+    int card;
+};
+typedef struct Sets_WideElement Sets_WideElement;
+
+
+/*
+  +-----------+
+  | FUNCTIONS |
+  +-----------+
+*/
+
+/**
+ * @name Kernel selection
+ * @{
+ */
+
+/**
+ * Selects the set of kernels to use for the operations on words.
+ * The selection is global to the process.
+ * @param kernels The set of kernels to use (KERNELS_AUTO selects the best supported one)
+ * @return 1 if the set of kernels is supported by the CPU and has been selected, 0 if not.
+ */
+int Sets_useWordKernels(const Sets_WordKernels kernels);
+
+/**
+ * Gives the set of kernels currently used for the operations on words.
+ * @return The set of kernels in use (never KERNELS_AUTO).
+ */
+Sets_WordKernels Sets_getWordKernels(void);
+
+/** @} */
+
+
+/**
+ * @name Operations on words
+ * All these functions work on arrays of nbWords words.
+ * @{
+ */
+
+/**
+ * Packs an element into words.
+ * @param words The words to fill (SETS_WIDE_NB_WORDS(size) words)
+ * @param e The element to pack (one byte per atom, equal to 0 or 1)
+ * @param size The size of the element
+ */
+void Sets_packWords(uint64_t* words, const Sets_Element e, const int size);
+
+/**
+ * Computes the conjunction of two multi-word elements (dst = a & b).
+ * dst may be equal to a or b.
+ * @param dst The words where to store the result
+ * @param a The first operand
+ * @param b The second operand
+ * @param nbWords The number of words
+ */
+void Sets_wordsConjunction(uint64_t* dst, const uint64_t* a, const uint64_t* b, const int nbWords);
+
+/**
+ * Computes the disjunction of two multi-word elements (dst = a | b).
+ * dst may be equal to a or b.
+ * @param dst The words where to store the result
+ * @param a The first operand
+ * @param b The second operand
+ * @param nbWords The number of words
+ */
+void Sets_wordsDisjunction(uint64_t* dst, const uint64_t* a, const uint64_t* b, const int nbWords);
+
+/**
+ * Computes the difference of two multi-word elements (dst = a & ~b).
+ * dst may be equal to a or b.
+ * @param dst The words where to store the result
+ * @param a The first operand
+ * @param b The second operand
+ * @param nbWords The number of words
+ */
+void Sets_wordsDifference(uint64_t* dst, const uint64_t* a, const uint64_t* b, const int nbWords);
+
+/**
+ * Counts the atoms of a multi-word element (population count).
+ * @param a The element
+ * @param nbWords The number of words
+ * @return The cardinality of a.
+ */
+int Sets_wordsCard(const uint64_t* a, const int nbWords);
+
+/**
+ * Counts the atoms of the conjunction of two multi-word elements
+ * without storing the conjunction.
+ * @param a The first operand
+ * @param b The second operand
+ * @param nbWords The number of words
+ * @return The cardinality of a & b.
+ */
+int Sets_wordsConjunctionCard(const uint64_t* a, const uint64_t* b, const int nbWords);
+
+/**
+ * Tests if a multi-word element is a subset of another one.
+ * @param a The element that may be included
+ * @param b The 'set' in which a may be included
+ * @param nbWords The number of words
+ * @return 1 if a is a subset of b, 0 if not.
+ */
+int Sets_wordsIsSubset(const uint64_t* a, const uint64_t* b, const int nbWords);
+
+/**
+ * Compares two multi-word elements.
+ * @param a The first element
+ * @param b The second element to compare to
+ * @param nbWords The number of words
+ * @return 1 if a=b, 0 if not.
+ */
+int Sets_wordsEquals(const uint64_t* a, const uint64_t* b, const int nbWords);
+
+/**
+ * Hashes a multi-word element (e.g. to index elements in an open addressing hash table).
+ * Equal elements have equal hashes. A packed element can be hashed as a single word.
+ * @param a The element
+ * @param nbWords The number of words
+ * @return The hash of a.
+ */
+uint64_t Sets_wordsHash(const uint64_t* a, const int nbWords);
+
+/** @} */
+
+
+/**
+ * @name Wide elements
+ * @{
+ */
+
+/**
+ * Converts an element into a wide element.
+ * @param e The element to convert
+ * @param size The size of the element
+ * @return The corresponding wide element. Must be freed after use.
+ */
+Sets_WideElement Sets_wideFromElement(const Sets_Element e, const int size);
+
+/**
+ * Converts a wide element into an element.
+ * @param w The wide element to convert
+ * @param size The size of the element
+ * @return The corresponding element. Must be freed after use.
+ */
+Sets_Element Sets_elementFromWide(const Sets_WideElement w, const int size);
+
+/**
+ * Conjunction operation for wide elements.
+ * @param e1 The first element of the operation
+ * @param e2 The second element of the operation
+ * @param size The size of the elements
+ * @return A new wide element equal to the conjunction of e1 and e2.
+ * Must be freed after use.
+ */
+Sets_WideElement Sets_wideConjunction(const Sets_WideElement e1, const Sets_WideElement e2, const int size);
+
+/**
+ * Disjunction operation for wide elements.
+ * @param e1 The first element of the operation
+ * @param e2 The second element of the operation
+ * @param size The size of the elements
+ * @return A new wide element equal to the disjunction of e1 and e2.
+ * Must be freed after use.
+ */
+Sets_WideElement Sets_wideDisjunction(const Sets_WideElement e1, const Sets_WideElement e2, const int size);
+
+/**
+ * Compares two wide elements.
+ * @param e1 The first element
+ * @param e2 The second element to compare to
+ * @param size The size of the elements
+ * @return 1 if e1=e2, 0 if not.
+ */
+int Sets_wideEquals(const Sets_WideElement e1, const Sets_WideElement e2, const int size);
+
+/**
+ * Tests if the wide element is a subset of another one.
+ * @param e1 The element that may be included
+ * @param e2 The 'set' in which e1 may be included
+ * @param size The size of the elements
+ * @return 1 if e1 is a subset of e2, 0 if not.
+ */
+int Sets_wideIsSubset(const Sets_WideElement e1, const Sets_WideElement e2, const int size);
+
+/**
+ * Frees the memory used for the words of a wide element.
+ * @param w A pointer to the wide element to deallocate in memory
+ */
+void Sets_freeWideElement(Sets_WideElement* w);
+
+/** @} */
+
+#endif
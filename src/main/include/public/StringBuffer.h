@@ -0,0 +1,138 @@
+/*
+ * Copyright 2011-2014, EDF. This software was developed with the collaboration of INRIA (Bastien Pietropaoli)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#ifndef DEF_STRINGBUFFER
+#define DEF_STRINGBUFFER
+
+#include <stdio.h>
+
+/**
+ * This module provides with a growable buffer of characters used to convert the structures
+ * of the library into strings in a single pass. A buffer may also write directly
+ * into a file (or a stream such as stdout), in which case nothing is stored in memory.
+ * The append functions of the other modules (Sets_appendElement(), BF_appendBeliefFunction()...)
+ * write into such buffers without any intermediate allocation. A buffer can be cleared and
+ * reused to avoid any allocation at all once it is large enough.
+ *
+ * @file StringBuffer.h
+ * @author Bastien Pietropaoli (bastien.pietropaoli@inria.fr)
+ * @brief UTILITY: A growable buffer of characters
+ * to build strings in a single pass.
+ */
+
+/*
+  +------------+
+  | STRUCTURES |
+  +------------+
+*/
+
+/**
+ * A growable buffer of characters or a stream in which to write.
+ * @param str The characters written so far, always terminated by '\0' (NULL if file != NULL)
+ * @param length The number of characters written so far
+ * @param capacity The number of characters that can be stored in str (including the final '\0')
+ * @param file The stream in which to write (NULL for a buffer in memory)
+ * @struct StringBuffer
+ */
+struct StringBuffer {
+    char* str;
+    int length;
+    int capacity;
+    FILE* file;
+};
+typedef struct StringBuffer StringBuffer;
+
+
+/*
+  +-----------+
+  | FUNCTIONS |
+  +-----------+
+*/
+
+/**
+ * @name Creation
+ * @{
+ */
+
+/**
+ * Creates an empty buffer in memory.
+ * @param capacity The initial capacity of the buffer (it grows when needed)
+ * @return A new empty buffer. Must be freed after use.
+ */
+StringBuffer StringBuffer_create(const int capacity);
+
+/**
+ * Creates a buffer which writes directly into a stream.
+ * @param file The stream in which to write (a file open for writing, stdout...)
+ * @return A buffer writing into the stream. It does not need to be freed
+ *         and the stream is not closed by this module.
+ */
+StringBuffer StringBuffer_fromFile(FILE* file);
+
+/** @} */
+
+
+/**
+ * @name Writing
+ * @{
+ */
+
+/**
+ * Appends a string at the end of a buffer.
+ * @param sb The buffer in which to write
+ * @param str The string to append
+ */
+void StringBuffer_append(StringBuffer* sb, const char* str);
+
+/**
+ * Appends a character at the end of a buffer.
+ * @param sb The buffer in which to write
+ * @param c The character to append
+ */
+void StringBuffer_appendChar(StringBuffer* sb, const char c);
+
+/**
+ * Appends a formatted string at the end of a buffer (same format as printf()).
+ * @param sb The buffer in which to write
+ * @param format The format of the string to append
+ */
+void StringBuffer_appendFormat(StringBuffer* sb, const char* format, ...);
+
+/**
+ * Empties a buffer in memory without releasing its memory, so that it can be reused.
+ * @param sb The buffer to empty
+ */
+void StringBuffer_clear(StringBuffer* sb);
+
+/** @} */
+
+
+/**
+ * @name Deallocation
+ * @{
+ */
+
+/**
+ * Frees the memory used by a buffer. A buffer writing into a stream
+ * does not close the stream.
+ * @param sb A pointer to the buffer to deallocate in memory
+ */
+void StringBuffer_free(StringBuffer* sb);
+
+/** @} */
+
+#endif
@@ -37,6 +37,8 @@ void Tests_typicalProblem(BFS_BeliefStructure bs, char** sensorTypes, double* se
     int i = 0, j = 0;
     char *str = NULL, *str2 = NULL;
     float* conflict = NULL;
+    BF_Mass* measures = NULL;
+    Sets_Element* elements = NULL;
     FILE* f = NULL;
 	
 	if(write){
@@ -83,15 +85,25 @@ void Tests_typicalProblem(BFS_BeliefStructure bs, char** sensorTypes, double* se
 		    free(conflict);
 
 		    fprintf(f, "\nFunction AND element specific:\n");
+		    /*All the measures of all the focals at once: */
+		    elements = malloc(sizeof(Sets_Element) * evidences[j].nbFocals);
+		    measures = malloc(sizeof(BF_Mass) * 4 * evidences[j].nbFocals);
+		    for(i = 0; i<evidences[j].nbFocals; i++){
+		        elements[i] = evidences[j].focals[i].element;
+		    }
+		    BF_measures(evidences[j], elements, evidences[j].nbFocals, measures, measures + evidences[j].nbFocals,
+		            measures + 2 * evidences[j].nbFocals, measures + 3 * evidences[j].nbFocals);
 		    for(i = 0; i<evidences[j].nbFocals; i++){
 		        str = Sets_elementToString(evidences[j].focals[i].element, bs.refList);
-		        fprintf(f, "\nbel(%s) = %f\n", str, BF_bel(evidences[j], evidences[j].focals[i].element));
-		        fprintf(f, "betP(%s) = %f\n", str, BF_betP(evidences[j], evidences[j].focals[i].element));
-		        fprintf(f, "pl(%s) = %f\n", str, BF_pl(evidences[j], evidences[j].focals[i].element));
-		        fprintf(f, "q(%s) = %f\n", str, BF_q(evidences[j], evidences[j].focals[i].element));
+		        fprintf(f, "\nbel(%s) = %f\n", str, measures[i]);
+		        fprintf(f, "betP(%s) = %f\n", str, measures[3 * evidences[j].nbFocals + i]);
+		        fprintf(f, "pl(%s) = %f\n", str, measures[evidences[j].nbFocals + i]);
+		        fprintf(f, "q(%s) = %f\n", str, measures[2 * evidences[j].nbFocals + i]);
 		        free(str);
 		        str = NULL;
 		    }
+		    free(elements);
+		    free(measures);
 		    fprintf(f, "-----------------\n");
 		}
 
@@ -123,12 +135,15 @@ void Tests_typicalProblem(BFS_BeliefStructure bs, char** sensorTypes, double* se
 		    conflict = BF_autoConflict(evidences[j], 5);
 		    free(conflict);
 
+		    elements = malloc(sizeof(Sets_Element) * evidences[j].nbFocals);
+		    measures = malloc(sizeof(BF_Mass) * 4 * evidences[j].nbFocals);
 		    for(i = 0; i<evidences[j].nbFocals; i++){
-		        BF_bel(evidences[j], evidences[j].focals[i].element);
-		        BF_betP(evidences[j], evidences[j].focals[i].element);
-		        BF_pl(evidences[j], evidences[j].focals[i].element);
-		        BF_q(evidences[j], evidences[j].focals[i].element);
+		        elements[i] = evidences[j].focals[i].element;
 		    }
+		    BF_measures(evidences[j], elements, evidences[j].nbFocals, measures, measures + evidences[j].nbFocals,
+		            measures + 2 * evidences[j].nbFocals, measures + 3 * evidences[j].nbFocals);
+		    free(elements);
+		    free(measures);
 		}
 
 		/*Deallocation: */
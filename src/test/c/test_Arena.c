@@ -0,0 +1,251 @@
+/*
+ * Copyright 2011-2014, EDF. This software was developed with the collaboration of INRIA (Bastien Pietropaoli)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * test_Arena.c
+ *
+ * Checks the arenas and that the library gives the same results
+ * when it draws its memory from an arena.
+ */
+
+#include <stdlib.h>
+#include <check.h>
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+#include "Arena.h"
+#include "BeliefCombinations.h"
+#include "BeliefDecisions.h"
+#include "BeliefsFromRandomness.h"
+
+#define NB_FUNCTIONS 4
+#define FRAME_SIZE 5
+
+START_TEST(testAllocation) {
+	BF_Arena* arena = BF_createArena(256);
+	char *a = NULL, *b = NULL, *big = NULL;
+	size_t usage = 0;
+	int i = 0;
+
+	ck_assert(NULL == BF_useArena(arena));
+	ck_assert(arena == BF_getArena());
+
+	a = BF_arenaMalloc(10);
+	for (i = 0; i < 10; ++i) {
+		a[i] = i;
+	}
+	usage = BF_arenaUsage(arena);
+	ck_assert(usage > 0);
+
+	/* the last allocation grows in place and keeps its content: */
+	ck_assert(a == BF_arenaRealloc(a, 100));
+	for (i = 0; i < 10; ++i) {
+		ck_assert_int_eq(i, a[i]);
+	}
+
+	/* an older one is moved: */
+	b = BF_arenaCalloc(4, 8);
+	for (i = 0; i < 32; ++i) {
+		ck_assert_int_eq(0, b[i]);
+	}
+	a = BF_arenaRealloc(a, 120);
+	for (i = 0; i < 10; ++i) {
+		ck_assert_int_eq(i, a[i]);
+	}
+
+	/* the last allocation is given back: */
+	usage = BF_arenaUsage(arena);
+	big = BF_arenaMalloc(1000);
+	ck_assert(big != NULL);
+	ck_assert(BF_arenaUsage(arena) > usage);
+	BF_arenaFree(big);
+	ck_assert(BF_arenaUsage(arena) == usage);
+
+	BF_arenaReset(arena);
+	ck_assert(0 == BF_arenaUsage(arena));
+
+	ck_assert(arena == BF_useArena(NULL));
+	ck_assert(NULL == BF_getArena());
+	BF_freeArena(arena);
+}
+END_TEST
+
+START_TEST(testFusionCycles) {
+	/*
+	 * the same fusion cycle with and without an arena
+	 */
+	BF_BeliefFunction evidences[NB_FUNCTIONS], expected, fused;
+	BF_FocalElement expectedMax, max;
+	Sets_Set powerset = Sets_generatePowerSet(FRAME_SIZE);
+	BF_Arena* arena = BF_createArena(0);
+	size_t usage = 0;
+	int i = 0, cycle = 0;
+
+	srand(42);
+	for (i = 0; i < NB_FUNCTIONS; ++i) {
+		evidences[i] = BFR_getCrappyRandomBeliefWithFixedNbFocals(FRAME_SIZE, 6);
+	}
+	expected = BF_fullDempsterCombination(evidences, NB_FUNCTIONS);
+	expectedMax = BF_getMaxBetP(expected, 0, powerset);
+
+	for (cycle = 0; cycle < 3; ++cycle) {
+		BF_useArena(arena);
+		fused = BF_fullDempsterCombination(evidences, NB_FUNCTIONS);
+		max = BF_getMaxBetP(fused, 0, powerset);
+
+		ck_assert_int_eq(expected.nbFocals, fused.nbFocals);
+		for (i = 0; i < expected.nbFocals; ++i) {
+			ck_assert(Sets_equals(expected.focals[i].element, fused.focals[i].element, FRAME_SIZE));
+			ck_assert(expected.focals[i].beliefValue == fused.focals[i].beliefValue);
+		}
+		ck_assert(Sets_equals(expectedMax.element, max.element, FRAME_SIZE));
+		ck_assert(expectedMax.beliefValue == max.beliefValue);
+
+		/* every cycle draws the same memory from the kept blocks: */
+		if (cycle == 0) {
+			usage = BF_arenaUsage(arena);
+			ck_assert(usage > 0);
+		}
+		ck_assert(usage == BF_arenaUsage(arena));
+		BF_arenaReset(arena);
+		BF_useArena(NULL);
+	}
+
+	BF_freeArena(arena);
+	BF_freeBeliefPoint(&expectedMax);
+	BF_freeBeliefFunction(&expected);
+	for (i = 0; i < NB_FUNCTIONS; ++i) {
+		BF_freeBeliefFunction(&evidences[i]);
+	}
+	Sets_freeSet(&powerset);
+}
+END_TEST
+
+START_TEST(testParallelFusion) {
+	/*
+	 * the workers of a parallel combination do not draw from the arena of the caller
+	 */
+	BF_BeliefFunction evidences[NB_FUNCTIONS], expected, fused;
+	BF_Arena* arena = BF_createArena(0);
+	int i = 0;
+
+	srand(7);
+	for (i = 0; i < NB_FUNCTIONS; ++i) {
+		evidences[i] = BFR_getCrappyRandomBeliefWithFixedNbFocals(FRAME_SIZE, 6);
+	}
+	expected = BF_parallelFullCombination(evidences, NB_FUNCTIONS, DEMPSTER, 4);
+
+	BF_useArena(arena);
+	fused = BF_parallelFullCombination(evidences, NB_FUNCTIONS, DEMPSTER, 4);
+	ck_assert(arena == BF_getArena());
+	ck_assert_int_eq(expected.nbFocals, fused.nbFocals);
+	for (i = 0; i < expected.nbFocals; ++i) {
+		ck_assert(Sets_equals(expected.focals[i].element, fused.focals[i].element, FRAME_SIZE));
+		ck_assert(expected.focals[i].beliefValue == fused.focals[i].beliefValue);
+	}
+	/* the result is drawn from the arena: */
+	ck_assert(BF_arenaUsage(arena) > 0);
+	BF_arenaReset(arena);
+	BF_useArena(NULL);
+
+	BF_freeArena(arena);
+	BF_freeBeliefFunction(&expected);
+	for (i = 0; i < NB_FUNCTIONS; ++i) {
+		BF_freeBeliefFunction(&evidences[i]);
+	}
+}
+END_TEST
+
+START_TEST(testParallelFusionWithWorkerArenas) {
+	/*
+	 * the workers of a parallel combination may use arenas of their own (small and large frames)
+	 */
+	int sizes[2] = {20, 70};
+	BF_BeliefFunction evidences[16], expected, fused;
+	BF_Arena* arenas[4];
+	int c = 0, i = 0;
+
+	for (i = 0; i < 4; ++i) {
+		arenas[i] = BF_createArena(0);
+	}
+	srand(11);
+	for (c = 0; c < 2; ++c) {
+		for (i = 0; i < 16; ++i) {
+			evidences[i] = BFR_getCrappyRandomBeliefWithFixedNbFocals(sizes[c], 3);
+		}
+		expected = BF_fullSmetsCombination(evidences, 16);
+
+		/* each thread of the pool draws from its own arena: */
+		#ifdef _OPENMP
+		#pragma omp parallel num_threads(4)
+		#endif
+		{
+			#ifdef _OPENMP
+			BF_useArena(arenas[omp_get_thread_num()]);
+			#else
+			BF_useArena(arenas[0]);
+			#endif
+		}
+		fused = BF_parallelFullCombination(evidences, 16, SMETS, 4);
+		#ifdef _OPENMP
+		#pragma omp parallel num_threads(4)
+		#endif
+		{
+			BF_useArena(NULL);
+		}
+
+		ck_assert_int_eq(expected.nbFocals, fused.nbFocals);
+		for (i = 0; i < expected.nbFocals; ++i) {
+			ck_assert(Sets_equals(expected.focals[i].element, fused.focals[i].element, sizes[c]));
+		}
+		for (i = 0; i < 4; ++i) {
+			BF_arenaReset(arenas[i]);
+		}
+		BF_freeBeliefFunction(&expected);
+		for (i = 0; i < 16; ++i) {
+			BF_freeBeliefFunction(&evidences[i]);
+		}
+	}
+	for (i = 0; i < 4; ++i) {
+		BF_freeArena(arenas[i]);
+	}
+}
+END_TEST
+
+Suite *createSuite(void) {
+	Suite *suite = suite_create("Arena");
+
+	TCase *testCaseArena = tcase_create("Arena");
+	tcase_add_test(testCaseArena, testAllocation);
+	tcase_add_test(testCaseArena, testFusionCycles);
+	tcase_add_test(testCaseArena, testParallelFusion);
+	tcase_add_test(testCaseArena, testParallelFusionWithWorkerArenas);
+
+	suite_add_tcase(suite, testCaseArena);
+	return suite;
+}
+
+
+int main() {
+	int numberFailed = 0;
+	Suite *suite = createSuite();
+	SRunner *suiteRunner= srunner_create(suite);
+	srunner_run_all(suiteRunner, CK_NORMAL);
+	numberFailed = srunner_ntests_failed (suiteRunner);
+	srunner_free(suiteRunner);
+	return (numberFailed == 0) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -25,6 +25,7 @@
 #include <stdlib.h>
 
 #include "BeliefCombinations.h"
+#include "BeliefsFromRandomness.h"
 #include "BeliefsFromSensors.h"
 
 #include "unit_tests.h"
@@ -78,6 +79,48 @@ START_TEST(SmetsCombinationValuesAreOk) {
 }
 END_TEST
 
+/* ##Smets with element ids */
+START_TEST(packedSmetsCombinationValuesAreOk) {
+	/*
+	 * same expected values as the Smets combination
+	 */
+	BF_PackedBeliefFunction m1 = BF_packBeliefFunction(evidences[0]);
+	BF_PackedBeliefFunction m2 = BF_packBeliefFunction(evidences[1]);
+	BF_PackedBeliefFunction fused = BF_packedSmetsCombination(m1, m2);
+	assert_flt_equals(0.45f, BF_packedM(fused, Sets_packElement(A, ATOM_NB)), BF_PRECISION);
+	assert_flt_equals(0.025f, BF_packedM(fused, Sets_packElement(B, ATOM_NB)), BF_PRECISION);
+	assert_flt_equals(0.0f, BF_packedM(fused, Sets_packElement(C, ATOM_NB)), BF_PRECISION);
+	assert_flt_equals(0.525f, BF_packedM(fused, 0), BF_PRECISION);
+	assert_flt_equals(BF_pl(SmetsFusedBelief, AuB), BF_packedPl(fused, Sets_packElement(AuB, ATOM_NB)), BF_PRECISION);
+	assert_flt_equals(BF_betP(SmetsFusedBelief, AuC), BF_packedBetP(fused, Sets_packElement(AuC, ATOM_NB)), BF_PRECISION);
+	BF_freePackedBeliefFunction(&m1);
+	BF_freePackedBeliefFunction(&m2);
+	BF_freePackedBeliefFunction(&fused);
+}
+END_TEST
+
+/* ##Smets and Dempster with dense functions */
+START_TEST(denseCombinationValuesAreOk) {
+	/*
+	 * same expected values as the Smets and Dempster combinations
+	 */
+	BF_DenseBeliefFunction m1 = BF_toDenseBeliefFunction(evidences[0]);
+	BF_DenseBeliefFunction m2 = BF_toDenseBeliefFunction(evidences[1]);
+	BF_DenseBeliefFunction fused = BF_denseSmetsCombination(m1, m2);
+	BF_DenseBeliefFunction normalized = BF_denseDempsterCombination(m1, m2);
+	assert_flt_equals(0.45f, BF_denseM(fused, Sets_packElement(A, ATOM_NB)), BF_PRECISION);
+	assert_flt_equals(0.025f, BF_denseM(fused, Sets_packElement(B, ATOM_NB)), BF_PRECISION);
+	assert_flt_equals(0.0f, BF_denseM(fused, Sets_packElement(C, ATOM_NB)), BF_PRECISION);
+	assert_flt_equals(0.525f, BF_denseM(fused, 0), BF_PRECISION);
+	assert_flt_equals(0.45 / 0.475, BF_denseM(normalized, Sets_packElement(A, ATOM_NB)), BF_PRECISION);
+	assert_flt_equals(0.0f, BF_denseM(normalized, 0), BF_PRECISION);
+	BF_freeDenseBeliefFunction(&m1);
+	BF_freeDenseBeliefFunction(&m2);
+	BF_freeDenseBeliefFunction(&fused);
+	BF_freeDenseBeliefFunction(&normalized);
+}
+END_TEST
+
 /* ##Dempster */
 START_TEST(DempsterCombinationValuesAreOk) {
 	/*
@@ -94,11 +137,513 @@ START_TEST(DempsterCombinationValuesAreOk) {
 END_TEST
 
 
+/* ##Lists */
+START_TEST(fullCombinationValuesAreOk) {
+	/*
+	 * same expected values as the Smets and Dempster combinations,
+	 * m1 + m1 gives m(void) = 2 * 0.75 * 0.1 = 0.15, and m1 + m1 + m1 gives
+	 * m(void) = 0.15 + m(A) * 0.1 + m(B) * 0.75 = 0.15 + 0.7875 * 0.1 + 0.04 * 0.75 = 0.25875
+	 */
+	BF_BeliefFunction smets = BF_fullSmetsCombination(evidences, 2);
+	BF_BeliefFunction dempster = BF_fullDempsterCombination(evidences, 2);
+	float* conflicts = BF_autoConflict(evidences[0], 2);
+	assert_flt_equals(0.45f, BF_m(smets, A), BF_PRECISION);
+	assert_flt_equals(0.025f, BF_m(smets, B), BF_PRECISION);
+	assert_flt_equals(0.525f, BF_m(smets, VOID), BF_PRECISION);
+	assert_flt_equals(0.45 / 0.475, BF_m(dempster, A), BF_PRECISION);
+	assert_flt_equals(0.025 / 0.475, BF_m(dempster, B), BF_PRECISION);
+	assert_flt_equals(0.0f, BF_m(dempster, VOID), BF_PRECISION);
+	assert_flt_equals(0.15f, conflicts[0], BF_PRECISION);
+	assert_flt_equals(0.25875f, conflicts[1], BF_PRECISION);
+	BF_freeBeliefFunction(&smets);
+	BF_freeBeliefFunction(&dempster);
+	free(conflicts);
+}
+END_TEST
+
+START_TEST(fullCombinationsReturnTheSameAsPairwise) {
+	/*
+	 * the combination of a list gives the same as the chain of pairwise combinations
+	 */
+	BF_BeliefFunction m[4], full, chained, tmp;
+	Sets_Element emptyElement = Sets_getEmptyElement(6);
+	float* conflicts = NULL;
+	int i, rule;
+	srand(5);
+	for(i = 0; i < 4; i++){
+		m[i] = BFR_getCrappyRandomBeliefWithFixedNbFocals(6, 12);
+	}
+	for(rule = 0; rule < 2; rule++){
+		full = (rule == 0) ? BF_fullSmetsCombination(m, 4) : BF_fullDempsterCombination(m, 4);
+		chained = BF_copyBeliefFunction(m[0]);
+		for(i = 1; i < 4; i++){
+			tmp = (rule == 0) ? BF_SmetsCombination(chained, m[i]) : BF_DempsterCombination(chained, m[i]);
+			BF_freeBeliefFunction(&chained);
+			chained = tmp;
+		}
+		ck_assert_int_eq(chained.nbFocals, full.nbFocals);
+		for(i = 0; i < chained.nbFocals; i++){
+			ck_assert(Sets_equals(chained.focals[i].element, full.focals[i].element, 6));
+			ck_assert(chained.focals[i].beliefValue == full.focals[i].beliefValue);
+		}
+		BF_freeBeliefFunction(&full);
+		BF_freeBeliefFunction(&chained);
+	}
+
+	conflicts = BF_autoConflict(m[0], 3);
+	chained = BF_SmetsCombination(m[0], m[0]);
+	for(i = 0; i < 3; i++){
+		assert_flt_equals(BF_m(chained, emptyElement), conflicts[i], BF_PRECISION);
+		tmp = BF_SmetsCombination(chained, m[0]);
+		BF_freeBeliefFunction(&chained);
+		chained = tmp;
+	}
+	BF_freeBeliefFunction(&chained);
+	free(conflicts);
+	Sets_freeElement(&emptyElement);
+	for(i = 0; i < 4; i++){
+		BF_freeBeliefFunction(&m[i]);
+	}
+}
+END_TEST
+
+START_TEST(commonalityCombinationValuesAreOk) {
+	/*
+	 * same expected values as the Smets and Dempster combinations: the totally discounted
+	 * functions are vacuous but keep their focal elements (with null masses), which makes
+	 * the pairwise combinations of the list cost more than its commonality functions
+	 */
+	BF_BeliefFunction m[9], smets, dempster;
+	BF_DenseBeliefFunction dense[2], denseSmets, denseDempster;
+	int i;
+	m[0] = evidences[0];
+	m[1] = evidences[1];
+	for(i = 2; i < 9; i++){
+		m[i] = BF_discounting(evidences[1], 1);
+	}
+	smets = BF_fullSmetsCombination(m, 9);
+	dempster = BF_fullDempsterCombination(m, 9);
+	assert_flt_equals(0.45f, BF_m(smets, A), BF_PRECISION);
+	assert_flt_equals(0.025f, BF_m(smets, B), BF_PRECISION);
+	assert_flt_equals(0.525f, BF_m(smets, VOID), BF_PRECISION);
+	assert_flt_equals(0.45 / 0.475, BF_m(dempster, A), BF_PRECISION);
+	assert_flt_equals(0.025 / 0.475, BF_m(dempster, B), BF_PRECISION);
+	assert_flt_equals(0.0f, BF_m(dempster, VOID), BF_PRECISION);
+
+	dense[0] = BF_toDenseBeliefFunction(evidences[0]);
+	dense[1] = BF_toDenseBeliefFunction(evidences[1]);
+	denseSmets = BF_denseFullSmetsCombination(dense, 2);
+	denseDempster = BF_denseFullDempsterCombination(dense, 2);
+	assert_flt_equals(0.45f, BF_denseM(denseSmets, Sets_packElement(A, ATOM_NB)), BF_PRECISION);
+	assert_flt_equals(0.525f, BF_denseM(denseSmets, 0), BF_PRECISION);
+	assert_flt_equals(0.025 / 0.475, BF_denseM(denseDempster, Sets_packElement(B, ATOM_NB)), BF_PRECISION);
+	assert_flt_equals(0.0f, BF_denseM(denseDempster, 0), BF_PRECISION);
+
+	BF_freeBeliefFunction(&smets);
+	BF_freeBeliefFunction(&dempster);
+	BF_freeDenseBeliefFunction(&dense[0]);
+	BF_freeDenseBeliefFunction(&dense[1]);
+	BF_freeDenseBeliefFunction(&denseSmets);
+	BF_freeDenseBeliefFunction(&denseDempster);
+	for(i = 2; i < 9; i++){
+		BF_freeBeliefFunction(&m[i]);
+	}
+}
+END_TEST
+
+START_TEST(commonalityCombinationsReturnTheSameAsPairwise) {
+	/*
+	 * enough functions to be combined in the commonality domain
+	 */
+	BF_BeliefFunction m[8], full, chained, tmp;
+	BF_DenseBeliefFunction dense[8], denseFull;
+	Sets_Element e;
+	int i, id, rule;
+	srand(9);
+	for(i = 0; i < 8; i++){
+		m[i] = BFR_getCrappyRandomBeliefWithFixedNbFocals(6, 12);
+		BF_discount(&m[i], 0.2);
+		dense[i] = BF_toDenseBeliefFunction(m[i]);
+	}
+	for(rule = 0; rule < 2; rule++){
+		full = (rule == 0) ? BF_fullSmetsCombination(m, 8) : BF_fullDempsterCombination(m, 8);
+		denseFull = (rule == 0) ? BF_denseFullSmetsCombination(dense, 8) : BF_denseFullDempsterCombination(dense, 8);
+		chained = BF_copyBeliefFunction(m[0]);
+		for(i = 1; i < 8; i++){
+			tmp = (rule == 0) ? BF_SmetsCombination(chained, m[i]) : BF_DempsterCombination(chained, m[i]);
+			BF_freeBeliefFunction(&chained);
+			chained = tmp;
+		}
+		for(id = 0; id < 64; id++){
+			e = Sets_unpackElement(id, 6);
+			assert_flt_equals(BF_m(chained, e), BF_m(full, e), BF_PRECISION);
+			assert_flt_equals(BF_m(chained, e), BF_denseM(denseFull, id), BF_PRECISION);
+			Sets_freeElement(&e);
+		}
+		/* the focal elements are given by increasing id: */
+		for(i = 1; i < full.nbFocals; i++){
+			ck_assert(Sets_packElement(full.focals[i - 1].element, 6) < Sets_packElement(full.focals[i].element, 6));
+		}
+		BF_freeBeliefFunction(&full);
+		BF_freeDenseBeliefFunction(&denseFull);
+		BF_freeBeliefFunction(&chained);
+	}
+	for(i = 0; i < 8; i++){
+		BF_freeBeliefFunction(&m[i]);
+		BF_freeDenseBeliefFunction(&dense[i]);
+	}
+}
+END_TEST
+
+START_TEST(commonalityCombinationsOfManySourcesDoNotUnderflow) {
+	/*
+	 * hundreds of identical sources agree: the product of their commonalities is rescaled
+	 */
+	BF_BeliefFunction m[400], full;
+	BF_DenseBeliefFunction dense;
+	int i;
+	dense.elementSize = 12;
+	dense.values = calloc(1 << 12, sizeof(BF_Mass));
+	for(i = 0; i < 12; i++){
+		dense.values[1 << i] = 1.0 / 13;
+	}
+	dense.values[(1 << 12) - 1] = 1.0 / 13;
+	for(i = 0; i < 400; i++){
+		m[i] = BF_toSparseBeliefFunction(dense);
+	}
+	full = BF_fullDempsterCombination(m, 400);
+	ck_assert_int_eq(12, full.nbFocals);
+	for(i = 0; i < full.nbFocals; i++){
+		ck_assert_int_eq(1, full.focals[i].element.card);
+		assert_flt_equals(1.0 / 12, full.focals[i].beliefValue, BF_PRECISION);
+	}
+	BF_freeBeliefFunction(&full);
+	BF_freeDenseBeliefFunction(&dense);
+	for(i = 0; i < 400; i++){
+		BF_freeBeliefFunction(&m[i]);
+	}
+}
+END_TEST
+
+START_TEST(parallelCombinationValuesAreOk) {
+	/*
+	 * same expected values as the Smets and Dempster combinations, with vacuous functions
+	 * combined in a tree (one focal element each) or in the commonality domain (null masses
+	 * on the focal elements of a totally discounted function)
+	 */
+	BF_BeliefFunction m[9], smets, dempster;
+	int c, w, i;
+	int workers[2] = {1, 4};
+	m[0] = evidences[0];
+	m[1] = evidences[1];
+	for(c = 0; c < 2; c++){
+		for(i = 2; i < 9; i++){
+			m[i] = (c == 0) ? BF_getVacuousBeliefFunction(ATOM_NB) : BF_discounting(evidences[1], 1);
+		}
+		for(w = 0; w < 2; w++){
+			smets = BF_parallelFullCombination(m, 9, SMETS, workers[w]);
+			dempster = BF_parallelFullCombination(m, 9, DEMPSTER, workers[w]);
+			assert_flt_equals(0.45f, BF_m(smets, A), BF_PRECISION);
+			assert_flt_equals(0.025f, BF_m(smets, B), BF_PRECISION);
+			assert_flt_equals(0.525f, BF_m(smets, VOID), BF_PRECISION);
+			assert_flt_equals(0.45 / 0.475, BF_m(dempster, A), BF_PRECISION);
+			assert_flt_equals(0.025 / 0.475, BF_m(dempster, B), BF_PRECISION);
+			assert_flt_equals(0.0f, BF_m(dempster, VOID), BF_PRECISION);
+			BF_freeBeliefFunction(&smets);
+			BF_freeBeliefFunction(&dempster);
+		}
+		for(i = 2; i < 9; i++){
+			BF_freeBeliefFunction(&m[i]);
+		}
+	}
+}
+END_TEST
+
+START_TEST(parallelCombinationsDoNotDependOnTheWorkers) {
+	/*
+	 * tree (small and large frames) and commonality paths with 1 and 4 workers
+	 */
+	int sizes[3] = {5, 70, 6}, nbFocals[3] = {3, 1, 12};
+	BF_CombinationRule rules[3] = {SMETS, DEMPSTER, YAGER};
+	BF_BeliefFunction m[9], one, four, full;
+	int c, r, i;
+	srand(13);
+	for(c = 0; c < 3; c++){
+		for(i = 0; i < 9; i++){
+			m[i] = BFR_getCrappyRandomBeliefWithFixedNbFocals(sizes[c], nbFocals[c]);
+			BF_discount(&m[i], 0.3);
+		}
+		for(r = 0; r < 3; r++){
+			one = BF_parallelFullCombination(m, 9, rules[r], 1);
+			four = BF_parallelFullCombination(m, 9, rules[r], 4);
+			full = BF_fullCombination(m, 9, rules[r]);
+			ck_assert_int_eq(one.nbFocals, four.nbFocals);
+			for(i = 0; i < one.nbFocals; i++){
+				ck_assert(Sets_equals(one.focals[i].element, four.focals[i].element, sizes[c]));
+				ck_assert(one.focals[i].beliefValue == four.focals[i].beliefValue);
+				assert_flt_equals(BF_m(full, one.focals[i].element), one.focals[i].beliefValue, BF_PRECISION);
+			}
+			for(i = 0; i < full.nbFocals; i++){
+				assert_flt_equals(full.focals[i].beliefValue, BF_m(one, full.focals[i].element), BF_PRECISION);
+			}
+			BF_freeBeliefFunction(&one);
+			BF_freeBeliefFunction(&four);
+			BF_freeBeliefFunction(&full);
+		}
+		for(i = 0; i < 9; i++){
+			BF_freeBeliefFunction(&m[i]);
+		}
+	}
+}
+END_TEST
+
+START_TEST(boundedCombinationValuesAreOk) {
+	/*
+	 * with 3 focals at most (summarization):
+	 * m2 becomes m(AuC) = 0.4, m(C) = 0.4, m(AuB) = 0.1 + 0.1 (0.2 moved),
+	 * m1 + m2 gives m(A) = 0.51, m(void) = 0.44, m(AuB) = 0.03, m(B) = 0.02,
+	 * which becomes m(A) = 0.51, m(void) = 0.44, m(AuB) = 0.05 (0.02 moved)
+	 */
+	BF_BeliefFunction bounded;
+	BF_Mass moved;
+	bounded = BF_boundedFullCombination(evidences, 2, SMETS, 3, APPROX_SUMMARIZATION, &moved);
+	ck_assert_int_eq(3, bounded.nbFocals);
+	assert_flt_equals(0.51f, BF_m(bounded, A), BF_PRECISION);
+	assert_flt_equals(0.44f, BF_m(bounded, VOID), BF_PRECISION);
+	assert_flt_equals(0.05f, BF_m(bounded, AuB), BF_PRECISION);
+	assert_flt_equals(0.22f, moved, BF_PRECISION);
+	BF_freeBeliefFunction(&bounded);
+	bounded = BF_boundedCombination(evidences[0], evidences[1], SMETS, 3, APPROX_SUMMARIZATION, &moved);
+	assert_flt_equals(0.51f, BF_m(bounded, A), BF_PRECISION);
+	assert_flt_equals(0.22f, moved, BF_PRECISION);
+	BF_freeBeliefFunction(&bounded);
+}
+END_TEST
+
+START_TEST(boundedCombinationsKeepFewFocals) {
+	/*
+	 * long chains of combinations stay within the bound, a large bound changes nothing
+	 */
+	BF_ApproximationMethod methods[4] = {APPROX_SUMMARIZATION, APPROX_KLX, APPROX_INNER, APPROX_OUTER};
+	BF_CombinationRule rules[3] = {SMETS, DEMPSTER, DUBOISPRADE};
+	BF_BeliefFunction m[8], bounded, full;
+	BF_Mass moved;
+	double sum;
+	int a, r, i;
+	srand(17);
+	for(i = 0; i < 8; i++){
+		m[i] = BFR_getCrappyRandomBeliefWithFixedNbFocals(6, 5);
+		BF_discount(&m[i], 0.4);
+	}
+	for(a = 0; a < 4; a++){
+		for(r = 0; r < 3; r++){
+			bounded = BF_boundedFullCombination(m, 8, rules[r], 8, methods[a], &moved);
+			ck_assert(bounded.nbFocals <= 8);
+			ck_assert(moved > 0);
+			sum = 0;
+			for(i = 0; i < bounded.nbFocals; i++){
+				sum += bounded.focals[i].beliefValue;
+			}
+			assert_flt_equals(1, sum, BF_PRECISION);
+			BF_freeBeliefFunction(&bounded);
+		}
+	}
+	bounded = BF_boundedFullCombination(m, 3, SMETS, 64, APPROX_SUMMARIZATION, &moved);
+	full = BF_fullCombination(m, 3, SMETS);
+	assert_flt_equals(0, moved, 0);
+	for(i = 0; i < full.nbFocals; i++){
+		assert_flt_equals(full.focals[i].beliefValue, BF_m(bounded, full.focals[i].element), BF_PRECISION);
+	}
+	BF_freeBeliefFunction(&bounded);
+	BF_freeBeliefFunction(&full);
+	for(i = 0; i < 8; i++){
+		BF_freeBeliefFunction(&m[i]);
+	}
+}
+END_TEST
+
+START_TEST(MurphyCombinationValuesAreOk) {
+	/*
+	 * average: m(A) = 0.425, m(B) = 0.1, m(C) = 0.2, m(AuB) = 0.075, m(AuC) = 0.2,
+	 * combined with itself: m(A) = 0.444375, m(B) = 0.025, m(C) = 0.12, m(AuB) = 0.005625,
+	 * m(AuC) = 0.04, normalized by 0.635
+	 */
+	BF_BeliefFunction average = BF_fullAverageCombination(evidences, 2);
+	BF_BeliefFunction murphy = BF_fullMurphyCombination(evidences, 2);
+	assert_flt_equals(0.425f, BF_m(average, A), BF_PRECISION);
+	assert_flt_equals(0.1f, BF_m(average, B), BF_PRECISION);
+	assert_flt_equals(0.2f, BF_m(average, C), BF_PRECISION);
+	assert_flt_equals(0.075f, BF_m(average, AuB), BF_PRECISION);
+	assert_flt_equals(0.2f, BF_m(average, AuC), BF_PRECISION);
+	assert_flt_equals(0.444375 / 0.635, BF_m(murphy, A), BF_PRECISION);
+	assert_flt_equals(0.025 / 0.635, BF_m(murphy, B), BF_PRECISION);
+	assert_flt_equals(0.12 / 0.635, BF_m(murphy, C), BF_PRECISION);
+	assert_flt_equals(0.005625 / 0.635, BF_m(murphy, AuB), BF_PRECISION);
+	assert_flt_equals(0.04 / 0.635, BF_m(murphy, AuC), BF_PRECISION);
+	assert_flt_equals(0.0f, BF_m(murphy, VOID), BF_PRECISION);
+	BF_freeBeliefFunction(&average);
+	BF_freeBeliefFunction(&murphy);
+}
+END_TEST
+
+START_TEST(MurphyCombinationsReturnTheSameAsSequential) {
+	/*
+	 * powers in the commonality domain (small frame) and by squaring (large frame)
+	 */
+	int sizes[2] = {6, 70}, nbFocals[2] = {12, 2}, nbM[2] = {2, 5};
+	BF_BeliefFunction m[5], average, chained, murphy, chen, tmp;
+	int c, n, i;
+	srand(21);
+	for(c = 0; c < 2; c++){
+		for(i = 0; i < 5; i++){
+			m[i] = BFR_getCrappyRandomBeliefWithFixedNbFocals(sizes[c], nbFocals[c]);
+			BF_discount(&m[i], 0.3);
+		}
+		for(n = 0; n < 2; n++){
+			average = BF_fullAverageCombination(m, nbM[n]);
+			chained = BF_DempsterCombination(average, average);
+			for(i = 2; i < nbM[n]; i++){
+				tmp = BF_DempsterCombination(chained, average);
+				BF_freeBeliefFunction(&chained);
+				chained = tmp;
+			}
+			murphy = BF_fullMurphyCombination(m, nbM[n]);
+			for(i = 0; i < chained.nbFocals; i++){
+				assert_flt_equals(chained.focals[i].beliefValue, BF_m(murphy, chained.focals[i].element), BF_PRECISION);
+			}
+			for(i = 0; i < murphy.nbFocals; i++){
+				assert_flt_equals(BF_m(chained, murphy.focals[i].element), murphy.focals[i].beliefValue, BF_PRECISION);
+			}
+			BF_freeBeliefFunction(&average);
+			BF_freeBeliefFunction(&chained);
+			BF_freeBeliefFunction(&murphy);
+		}
+		/* the credibilities of identical functions are equal: Chen is Murphy */
+		for(i = 1; i < 5; i++){
+			BF_freeBeliefFunction(&m[i]);
+			m[i] = BF_copyBeliefFunction(m[0]);
+		}
+		murphy = BF_fullMurphyCombination(m, 5);
+		chen = BF_fullChenCombination(m, 5);
+		ck_assert_int_eq(murphy.nbFocals, chen.nbFocals);
+		for(i = 0; i < murphy.nbFocals; i++){
+			assert_flt_equals(murphy.focals[i].beliefValue, BF_m(chen, murphy.focals[i].element), BF_PRECISION);
+		}
+		BF_freeBeliefFunction(&murphy);
+		BF_freeBeliefFunction(&chen);
+		for(i = 0; i < 5; i++){
+			BF_freeBeliefFunction(&m[i]);
+		}
+	}
+}
+END_TEST
+
+START_TEST(MurphyCombinationsOfManySourcesDoNotUnderflow) {
+	/*
+	 * the power of the commonalities of 500 identical sources is rescaled
+	 */
+	BF_BeliefFunction m[500], murphy;
+	BF_DenseBeliefFunction dense;
+	int i;
+	dense.elementSize = 12;
+	dense.values = calloc(1 << 12, sizeof(BF_Mass));
+	dense.values[1] = 0.2;
+	for(i = 1; i < 12; i++){
+		dense.values[1 << i] = 0.8 / 11;
+	}
+	for(i = 0; i < 500; i++){
+		m[i] = BF_toSparseBeliefFunction(dense);
+	}
+	murphy = BF_fullMurphyCombination(m, 500);
+	ck_assert_int_eq(1, murphy.nbFocals);
+	ck_assert_int_eq(1, Sets_packElement(murphy.focals[0].element, 12));
+	assert_flt_equals(1, murphy.focals[0].beliefValue, BF_PRECISION);
+	BF_freeBeliefFunction(&murphy);
+	BF_freeDenseBeliefFunction(&dense);
+	for(i = 0; i < 500; i++){
+		BF_freeBeliefFunction(&m[i]);
+	}
+}
+END_TEST
+
+/* ##Precision */
+START_TEST(longCombinationChainsKeepTheirSum) {
+	/*
+	 * the masses of a long chain of combinations of random functions still sum to 1
+	 */
+	BF_BeliefFunction fused, evidence, tmp;
+	double sum = 0;
+	int i;
+	srand(3);
+	fused = BFR_getCrappyRandomBeliefWithFixedNbFocals(8, 40);
+	for(i = 0; i < 300; i++){
+		evidence = BFR_getCrappyRandomBeliefWithFixedNbFocals(8, 40);
+		BF_discount(&evidence, 0.05);
+		tmp = BF_SmetsCombination(fused, evidence);
+		BF_freeBeliefFunction(&fused);
+		BF_freeBeliefFunction(&evidence);
+		fused = tmp;
+	}
+	for(i = 0; i < fused.nbFocals; i++){
+		sum += fused.focals[i].beliefValue;
+	}
+	assert_flt_equals(1, sum, BF_PRECISION);
+	BF_freeBeliefFunction(&fused);
+}
+END_TEST
+
+START_TEST(longCombinationChainsValuesAreOk) {
+	/*
+	 * n simple support functions m(A) = 0.01, m(AuBuC) = 0.99 give m(AuBuC) = 0.99^n and m(A) = 1 - 0.99^n
+	 */
+	BF_BeliefFunction support = {NULL, 2, ATOM_NB}, fused, tmp;
+	int i;
+	#ifdef BF_DOUBLE_MASSES
+	ck_assert_int_eq(sizeof(double), sizeof(BF_Mass));
+	#else
+	ck_assert_int_eq(sizeof(float), sizeof(BF_Mass));
+	#endif
+	support.focals = malloc(sizeof(BF_FocalElement) * 2);
+	support.focals[0].element = Sets_copyElement(A, ATOM_NB);
+	support.focals[0].beliefValue = 0.01;
+	support.focals[1].element = Sets_copyElement(AuBuC, ATOM_NB);
+	support.focals[1].beliefValue = 0.99;
+	fused = BF_copyBeliefFunction(support);
+	for(i = 1; i < 1000; i++){
+		tmp = BF_SmetsCombination(fused, support);
+		BF_freeBeliefFunction(&fused);
+		fused = tmp;
+	}
+	ck_assert_int_eq(2, fused.nbFocals);
+	assert_flt_equals(pow(0.99, 1000), BF_m(fused, AuBuC), BF_PRECISION);
+	assert_flt_equals(1 - pow(0.99, 1000), BF_m(fused, A), BF_PRECISION);
+	BF_freeBeliefFunction(&fused);
+	BF_freeBeliefFunction(&support);
+}
+END_TEST
+
+
 TCase* createFusionTestCase() {
 TCase* testCaseFusion = tcase_create("Fusion");
 tcase_add_checked_fixture(testCaseFusion, setup, teardown);
 tcase_add_test(testCaseFusion, SmetsCombinationValuesAreOk);
+tcase_add_test(testCaseFusion, packedSmetsCombinationValuesAreOk);
+tcase_add_test(testCaseFusion, denseCombinationValuesAreOk);
 tcase_add_test(testCaseFusion, DempsterCombinationValuesAreOk);
+tcase_add_test(testCaseFusion, fullCombinationValuesAreOk);
+tcase_add_test(testCaseFusion, fullCombinationsReturnTheSameAsPairwise);
+tcase_add_test(testCaseFusion, commonalityCombinationValuesAreOk);
+tcase_add_test(testCaseFusion, commonalityCombinationsReturnTheSameAsPairwise);
+tcase_add_test(testCaseFusion, commonalityCombinationsOfManySourcesDoNotUnderflow);
+tcase_add_test(testCaseFusion, parallelCombinationValuesAreOk);
+tcase_add_test(testCaseFusion, parallelCombinationsDoNotDependOnTheWorkers);
+tcase_add_test(testCaseFusion, boundedCombinationValuesAreOk);
+tcase_add_test(testCaseFusion, boundedCombinationsKeepFewFocals);
+tcase_add_test(testCaseFusion, MurphyCombinationValuesAreOk);
+tcase_add_test(testCaseFusion, MurphyCombinationsReturnTheSameAsSequential);
+tcase_add_test(testCaseFusion, MurphyCombinationsOfManySourcesDoNotUnderflow);
+tcase_add_test(testCaseFusion, longCombinationChainsKeepTheirSum);
+tcase_add_test(testCaseFusion, longCombinationChainsValuesAreOk);
 return testCaseFusion;
 }
 
@@ -304,6 +304,32 @@ START_TEST(testTempoFusion) {
 }
 END_TEST
 
+START_TEST(testMaxFocals) {
+	BFS_SensorBeliefs *beliefS4 = getSensorBelief(beliefStructure,"S4");
+	BF_BeliefFunction function;
+	int i;
+	/* the two smallest masses go to the union of all the focal elements: */
+	BFS_addOption(belief, OP_MAX_FOCALS, 2);
+	function = BFS_getProjection(*belief, 150.0, ATOM_NB);
+	ck_assert_int_eq(2, function.nbFocals);
+	assert_flt_equals(0.625, valueFor(function, B), BF_PRECISION);
+	assert_flt_equals(0.375, valueFor(function, AuBuC), BF_PRECISION);
+	BF_freeBeliefFunction(&function);
+	/* the function kept by the temporization is bounded as well: */
+	BFS_addOption(beliefS4, OP_MAX_FOCALS, 2);
+	for(i = 0; i < 3; i++){
+		function = BFS_getProjectionElapsedTime(*beliefS4, 100 + 100 * i, ATOM_NB, 0.5);
+		ck_assert(function.nbFocals <= 2);
+		BF_freeBeliefFunction(&function);
+	}
+	for(i = 0; i < beliefS4->nbOptions; i++){
+		if(beliefS4->options[i].type & OP_TEMPO_FUSION){
+			ck_assert(beliefS4->options[i].util[1].bf.nbFocals <= 2);
+		}
+	}
+}
+END_TEST
+
 static TCase* createParsingTestcase() {
 	TCase* testCaseParsing = tcase_create("Parsing");
 	tcase_add_checked_fixture(testCaseParsing, setup, teardown);
@@ -327,6 +353,7 @@ static TCase* createBeliefProjectionsTestCase() {
 	tcase_add_test(testCaseProjections, ProjectionFocalValues);
 	tcase_add_test(testCaseProjections, testTempoSpecificity);
 	tcase_add_test(testCaseProjections, testTempoFusion);
+	tcase_add_test(testCaseProjections, testMaxFocals);
 
 	return testCaseProjections;
 
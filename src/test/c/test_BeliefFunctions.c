@@ -175,6 +175,449 @@ START_TEST(getListMinMassReturnsTheRightFocals) {
 }
 END_TEST
 
+/*
+ * ## Lazy powerset
+ */
+
+START_TEST(getMaxInViewReturnsTheSameAsGetMax) {
+	BF_FocalElement expected = BF_getMax(BF_betP, evidences[0], 1, beliefStructure.powerset);
+	BF_FocalElement focalPoint = BF_getMaxInView(BF_betP, evidences[0], 1, beliefStructure.powersetView);
+	ck_assert(Sets_equals(expected.element, focalPoint.element, ATOM_NB));
+	assert_flt_equals(expected.beliefValue, focalPoint.beliefValue, BF_PRECISION);
+	BF_freeBeliefPoint(&expected);
+	BF_freeBeliefPoint(&focalPoint);
+}
+END_TEST
+
+START_TEST(getMinListInViewReturnsTheSameAsGetMinList) {
+	BF_FocalElementList expected = BF_getMinList(BF_m, evidences[1], 0, beliefStructure.powerset);
+	BF_FocalElementList list = BF_getMinListInView(BF_m, evidences[1], 0, beliefStructure.powersetView);
+	int i;
+	ck_assert_int_eq(expected.size, list.size);
+	for(i = 0; i < list.size; ++i) {
+		ck_assert(Sets_equals(expected.elements[i].element, list.elements[i].element, ATOM_NB));
+	}
+	BF_freeFocalElementList(&expected);
+	BF_freeFocalElementList(&list);
+}
+END_TEST
+
+START_TEST(conditioningValuesAreOk) {
+	/*
+	 * On {A u B}: m(A u C) and m(A) go to {A}, m(A u B u C) to {A u B},
+	 * m(B) to {B} and m(C) to the void set (the former focals are kept with 0)
+	 */
+	BF_BeliefFunction conditioned[3];
+	int i;
+	conditioned[0] = BF_conditioning(evidences[1], AuB, beliefStructure.powerset);
+	conditioned[1] = BF_conditioningInView(evidences[1], AuB, beliefStructure.powersetView);
+	conditioned[2] = BF_conditioningOn(evidences[1], AuB);
+	for(i = 0; i < 3; ++i) {
+		ck_assert_int_eq(evidences[1].nbFocals + 2, conditioned[i].nbFocals);
+		assert_flt_equals(0.5, BF_m(conditioned[i], A), BF_PRECISION);
+		assert_flt_equals(0.1, BF_m(conditioned[i], B), BF_PRECISION);
+		assert_flt_equals(0, BF_m(conditioned[i], AuB), BF_PRECISION);
+		assert_flt_equals(0.4, BF_m(conditioned[i], VOID), BF_PRECISION);
+		assert_flt_equals(0, BF_m(conditioned[i], C), BF_PRECISION);
+		assert_flt_equals(0, BF_m(conditioned[i], AuC), BF_PRECISION);
+		BF_freeBeliefFunction(&conditioned[i]);
+	}
+}
+END_TEST
+
+START_TEST(conditioningOnTransfersTheMasses) {
+	BF_BeliefFunction conditioned = BF_conditioningOn(evidences[0], AuB);
+	Sets_Element conj;
+	float expected, sum = 0;
+	int i, j;
+	for(i = 0; i < beliefStructure.powerset.card; ++i) {
+		expected = 0;
+		for(j = 0; j < evidences[0].nbFocals; ++j) {
+			conj = Sets_conjunction(evidences[0].focals[j].element, AuB, ATOM_NB);
+			if(Sets_equals(conj, beliefStructure.powerset.elements[i], ATOM_NB)) {
+				expected += evidences[0].focals[j].beliefValue;
+			}
+			Sets_freeElement(&conj);
+		}
+		assert_flt_equals(expected, BF_m(conditioned, beliefStructure.powerset.elements[i]), BF_PRECISION);
+	}
+	for(i = 0; i < conditioned.nbFocals; ++i) {
+		sum += conditioned.focals[i].beliefValue;
+	}
+	assert_flt_equals(1, sum, BF_PRECISION);
+	BF_freeBeliefFunction(&conditioned);
+}
+END_TEST
+
+START_TEST(inPlaceOperationsValuesAreOk) {
+	/*
+	 * m'(X) = (1 - alpha).m(X) and alpha is added to the void set (weakening)
+	 * or to the complete set (discounting), in place or on a copy
+	 */
+	BF_BeliefFunction copies[2], inPlace[2];
+	BF_BeliefFunction *weakened = NULL, *discounted = NULL;
+	BF_FocalElement* focals = NULL;
+	int i;
+	copies[0] = BF_weakening(evidences[0], 0.3);
+	copies[1] = BF_discounting(evidences[1], 0.4);
+	inPlace[0] = BF_copyBeliefFunction(evidences[0]);
+	BF_weaken(&inPlace[0], 0.3);
+	inPlace[1] = BF_copyBeliefFunction(evidences[1]);
+	BF_discount(&inPlace[1], 0.4);
+	for(i = 0; i < 2; ++i) {
+		weakened = i == 0 ? &copies[0] : &inPlace[0];
+		discounted = i == 0 ? &copies[1] : &inPlace[1];
+		ck_assert_int_eq(evidences[0].nbFocals + 1, weakened->nbFocals);
+		assert_flt_equals(0.525, BF_m(*weakened, A), BF_PRECISION);
+		assert_flt_equals(0.07, BF_m(*weakened, B), BF_PRECISION);
+		assert_flt_equals(0.105, BF_m(*weakened, AuB), BF_PRECISION);
+		assert_flt_equals(0.3, BF_m(*weakened, VOID), BF_PRECISION);
+		/* the complete set already is a focal element: */
+		ck_assert_int_eq(evidences[1].nbFocals, discounted->nbFocals);
+		assert_flt_equals(0.06, BF_m(*discounted, A), BF_PRECISION);
+		assert_flt_equals(0.24, BF_m(*discounted, C), BF_PRECISION);
+		assert_flt_equals(0.24, BF_m(*discounted, AuC), BF_PRECISION);
+		assert_flt_equals(0.4, BF_m(*discounted, AuBuC), BF_PRECISION);
+	}
+
+	/* once the void element is in, nothing is added nor moved: */
+	focals = inPlace[0].focals;
+	BF_weaken(&inPlace[0], 0.5);
+	ck_assert(focals == inPlace[0].focals);
+	ck_assert_int_eq(copies[0].nbFocals, inPlace[0].nbFocals);
+
+	/* the cleaning compacts the same list: */
+	focals = inPlace[1].focals;
+	BF_discount(&inPlace[1], 0);
+	inPlace[1].focals[0].beliefValue = 0;
+	BF_cleanBeliefFunction(&inPlace[1]);
+	ck_assert(focals == inPlace[1].focals);
+	ck_assert_int_eq(copies[1].nbFocals - 1, inPlace[1].nbFocals);
+	for(i = 0; i < 2; ++i) {
+		BF_freeBeliefFunction(&copies[i]);
+		BF_freeBeliefFunction(&inPlace[i]);
+	}
+}
+END_TEST
+
+START_TEST(distanceValuesAreOk) {
+	/*
+	 * m1 - m2 = (A: 0.65, C: -0.4, AuB: 0.15, AuC: -0.4), with the Jaccard coefficients
+	 * (A, AuB) = (A, AuC) = (C, AuC) = 1/2 and (AuB, AuC) = 1/3:
+	 * d = sqrt(0.5 * (0.765 - 2 * 0.02125)) = sqrt(0.36125)
+	 */
+	Sets_Context ctx = Sets_createContextFromRefList(beliefStructure.refList);
+	float expected = sqrt(0.36125);
+	float* distances = NULL;
+	assert_flt_equals(expected, BF_distance(evidences[0], evidences[1]), BF_PRECISION);
+	assert_flt_equals(expected, BF_distanceInContext(evidences[0], evidences[1], &ctx), BF_PRECISION);
+	ck_assert(Sets_enableJaccardCache(&ctx));
+	assert_flt_equals(expected, BF_distanceInContext(evidences[0], evidences[1], &ctx), BF_PRECISION);
+	distances = BF_distanceMatrix(evidences, 2, &ctx);
+	assert_flt_equals(0, distances[0], BF_PRECISION);
+	assert_flt_equals(expected, distances[1], BF_PRECISION);
+	assert_flt_equals(expected, distances[2], BF_PRECISION);
+	assert_flt_equals(0, distances[3], BF_PRECISION);
+	free(distances);
+	Sets_freeContext(&ctx);
+}
+END_TEST
+
+START_TEST(distanceInContextReturnsTheSameAsDistance) {
+	Sets_Context ctx = Sets_createContextFromRefList(beliefStructure.refList);
+	float expected = BF_distance(evidences[0], evidences[1]);
+	assert_flt_equals(expected, BF_distanceInContext(evidences[0], evidences[1], &ctx), BF_PRECISION);
+	ck_assert(Sets_enableJaccardCache(&ctx));
+	assert_flt_equals(expected, BF_distanceInContext(evidences[0], evidences[1], &ctx), BF_PRECISION);
+	assert_flt_equals(0, BF_distanceInContext(evidences[0], evidences[0], &ctx), BF_PRECISION);
+	Sets_freeContext(&ctx);
+}
+END_TEST
+
+START_TEST(distanceMatrixReturnsTheSameAsDistance) {
+	Sets_Context ctx = Sets_createContextFromRefList(beliefStructure.refList);
+	BF_BeliefFunction set[4];
+	float *distances = NULL, *supports = NULL;
+	float similarities = 0;
+	int i, j;
+	set[0] = evidences[0];
+	set[1] = evidences[1];
+	set[2] = BF_discounting(evidences[0], 0.3);
+	set[3] = BF_weakening(evidences[1], 0.6);
+
+	distances = BF_distanceMatrix(set, 4, NULL);
+	for(i = 0; i < 4; ++i) {
+		for(j = 0; j < 4; ++j) {
+			assert_flt_equals(BF_distance(set[i], set[j]), distances[i * 4 + j], BF_PRECISION);
+		}
+	}
+	free(distances);
+	ck_assert(Sets_enableJaccardCache(&ctx));
+	distances = BF_distanceMatrix(set, 4, &ctx);
+	for(i = 0; i < 4; ++i) {
+		for(j = 0; j < 4; ++j) {
+			assert_flt_equals(BF_distance(set[i], set[j]), distances[i * 4 + j], BF_PRECISION);
+		}
+	}
+	free(distances);
+
+	supports = BF_supports(set, 4);
+	for(i = 0; i < 4; ++i) {
+		similarities = 0;
+		for(j = 0; j < 4; ++j) {
+			similarities += BF_similarity(set[i], set[j]);
+		}
+		assert_flt_equals(similarities - 1, supports[i], BF_PRECISION);
+		assert_flt_equals(similarities - 1, BF_support(set[i], set, 4), BF_PRECISION);
+	}
+	free(supports);
+
+	BF_freeBeliefFunction(&set[2]);
+	BF_freeBeliefFunction(&set[3]);
+	Sets_freeContext(&ctx);
+}
+END_TEST
+
+START_TEST(denseFunctionsReturnTheSameAsSparse) {
+	BF_DenseBeliefFunction dense = BF_toDenseBeliefFunction(evidences[0]);
+	BF_DenseBeliefFunction denseDiscounted = BF_denseDiscounting(dense, 0.3);
+	BF_BeliefFunction discounted = BF_discounting(evidences[0], 0.3);
+	BF_BeliefFunction back = BF_toSparseBeliefFunction(dense);
+	Sets_PackedElement e;
+	int i;
+	for(i = 0; i < beliefStructure.powerset.card; ++i) {
+		e = Sets_packElement(beliefStructure.powerset.elements[i], ATOM_NB);
+		assert_flt_equals(BF_m(evidences[0], beliefStructure.powerset.elements[i]), BF_denseM(dense, e), BF_PRECISION);
+		assert_flt_equals(BF_bel(evidences[0], beliefStructure.powerset.elements[i]), BF_denseBel(dense, e), BF_PRECISION);
+		assert_flt_equals(BF_pl(evidences[0], beliefStructure.powerset.elements[i]), BF_densePl(dense, e), BF_PRECISION);
+		assert_flt_equals(BF_q(evidences[0], beliefStructure.powerset.elements[i]), BF_denseQ(dense, e), BF_PRECISION);
+		assert_flt_equals(BF_betP(evidences[0], beliefStructure.powerset.elements[i]), BF_denseBetP(dense, e), BF_PRECISION);
+		assert_flt_equals(BF_m(discounted, beliefStructure.powerset.elements[i]), BF_denseM(denseDiscounted, e), BF_PRECISION);
+		assert_flt_equals(BF_m(evidences[0], beliefStructure.powerset.elements[i]), BF_m(back, beliefStructure.powerset.elements[i]), BF_PRECISION);
+	}
+	BF_freeDenseBeliefFunction(&dense);
+	BF_freeDenseBeliefFunction(&denseDiscounted);
+	BF_freeBeliefFunction(&discounted);
+	BF_freeBeliefFunction(&back);
+}
+END_TEST
+
+START_TEST(denseTransformsReturnTheSameAsSparse) {
+	BF_DenseBeliefFunction dense = BF_toDenseBeliefFunction(evidences[0]);
+	BF_DenseBeliefFunction bel = BF_denseCredibilities(dense);
+	BF_DenseBeliefFunction pl = BF_densePlausibilities(dense);
+	BF_DenseBeliefFunction q = BF_denseCommonalities(dense);
+	BF_DenseBeliefFunction betP = BF_densePignisticProbabilities(dense);
+	BF_DenseBeliefFunction fromBel = BF_denseMassesFromCredibilities(bel);
+	BF_DenseBeliefFunction fromPl = BF_denseMassesFromPlausibilities(pl);
+	BF_DenseBeliefFunction fromQ = BF_denseMassesFromCommonalities(q);
+	Sets_PackedElement e;
+	int i;
+	for(i = 0; i < beliefStructure.powerset.card; ++i) {
+		e = Sets_packElement(beliefStructure.powerset.elements[i], ATOM_NB);
+		assert_flt_equals(BF_bel(evidences[0], beliefStructure.powerset.elements[i]), bel.values[e], BF_PRECISION);
+		assert_flt_equals(BF_pl(evidences[0], beliefStructure.powerset.elements[i]), pl.values[e], BF_PRECISION);
+		assert_flt_equals(BF_q(evidences[0], beliefStructure.powerset.elements[i]), q.values[e], BF_PRECISION);
+		assert_flt_equals(BF_betP(evidences[0], beliefStructure.powerset.elements[i]), betP.values[e], BF_PRECISION);
+		assert_flt_equals(dense.values[e], fromBel.values[e], BF_PRECISION);
+		assert_flt_equals(dense.values[e], fromPl.values[e], BF_PRECISION);
+		assert_flt_equals(dense.values[e], fromQ.values[e], BF_PRECISION);
+	}
+	BF_freeDenseBeliefFunction(&dense);
+	BF_freeDenseBeliefFunction(&bel);
+	BF_freeDenseBeliefFunction(&pl);
+	BF_freeDenseBeliefFunction(&q);
+	BF_freeDenseBeliefFunction(&betP);
+	BF_freeDenseBeliefFunction(&fromBel);
+	BF_freeDenseBeliefFunction(&fromPl);
+	BF_freeDenseBeliefFunction(&fromQ);
+}
+END_TEST
+
+START_TEST(indexedFunctionsReturnTheSameAsNotIndexed) {
+	BF_BeliefFunction copy = BF_copyBeliefFunction(evidences[0]);
+	BF_BeliefFunction average = BF_averageCombination(evidences[0], evidences[1]);
+	BF_FocalIndex* index = BF_indexBeliefFunction(copy);
+	Sets_Element e;
+	int i, nbFocals = copy.nbFocals;
+	ck_assert(index != NULL);
+	for(i = 0; i < beliefStructure.powerset.card; ++i) {
+		e = beliefStructure.powerset.elements[i];
+		ck_assert_int_eq(BF_getFocalPosition(evidences[0], NULL, e), BF_getFocalPosition(copy, index, e));
+		assert_flt_equals((BF_m(evidences[0], e) + BF_m(evidences[1], e)) / 2, BF_m(average, e), BF_PRECISION);
+	}
+	/* accumulation on a new element, then on the same one (found through the index): */
+	e = beliefStructure.powerset.elements[0];
+	ck_assert_int_eq(-1, BF_getFocalPosition(copy, index, e));
+	i = BF_addToFocal(&copy, index, e, 0.5);
+	ck_assert_int_eq(nbFocals, i);
+	ck_assert_int_eq(nbFocals + 1, copy.nbFocals);
+	ck_assert_int_eq(i, BF_getFocalPosition(copy, index, e));
+	ck_assert_int_eq(i, BF_addToFocal(&copy, index, e, 0.25));
+	ck_assert_int_eq(nbFocals + 1, copy.nbFocals);
+	assert_flt_equals(0.75, BF_m(copy, e), BF_PRECISION);
+	BF_freeFocalIndex(index);
+	BF_freeBeliefFunction(&copy);
+	BF_freeBeliefFunction(&average);
+}
+END_TEST
+
+START_TEST(compactFunctionsReturnTheSameAsSparse) {
+	BF_CompactBeliefFunction compact = BF_toCompactBeliefFunction(evidences[0]);
+	BF_CompactBeliefFunction copy = BF_copyCompactBeliefFunction(compact);
+	BF_BeliefFunction back = BF_fromCompactBeliefFunction(copy);
+	Sets_Element e;
+	int i;
+	ck_assert_int_eq(evidences[0].nbFocals, back.nbFocals);
+	for(i = 0; i < back.nbFocals; ++i) {
+		ck_assert(Sets_equals(evidences[0].focals[i].element, back.focals[i].element, ATOM_NB));
+		assert_flt_equals(evidences[0].focals[i].beliefValue, back.focals[i].beliefValue, 0);
+	}
+	for(i = 0; i < beliefStructure.powerset.card; ++i) {
+		e = beliefStructure.powerset.elements[i];
+		assert_flt_equals(BF_m(evidences[0], e), BF_compactM(copy, e), 0);
+		assert_flt_equals(BF_bel(evidences[0], e), BF_compactBel(copy, e), 0);
+		assert_flt_equals(BF_pl(evidences[0], e), BF_compactPl(copy, e), 0);
+		assert_flt_equals(BF_q(evidences[0], e), BF_compactQ(copy, e), 0);
+		assert_flt_equals(BF_betP(evidences[0], e), BF_compactBetP(copy, e), 0);
+	}
+	BF_freeCompactBeliefFunction(&compact);
+	BF_freeCompactBeliefFunction(&copy);
+	BF_freeBeliefFunction(&back);
+}
+END_TEST
+
+START_TEST(measuresValuesAreOk) {
+	/*
+	 * m(A) = 0.75, m(B) = 0.1, m(AuB) = 0.15, m(C) = 0:
+	 * A:   bel = 0.75, pl = 0.9, q = 0.9,  betP = 0.825
+	 * AuB: bel = 1,    pl = 1,   q = 0.15, betP = 1
+	 * C:   bel = 0,    pl = 0,   q = 0,    betP = 0
+	 * AuC: bel = 0.75, pl = 0.9, q = 0,    betP = 0.825
+	 */
+	Sets_Element elements[4];
+	float expectedBel[4] = {0.75, 1, 0, 0.75}, expectedPl[4] = {0.9, 1, 0, 0.9};
+	float expectedQ[4] = {0.9, 0.15, 0, 0}, expectedBetP[4] = {0.825, 1, 0, 0.825};
+	BF_Mass bel[4], pl[4], q[4], betP[4];
+	Sets_PackedElement ids[4];
+	int i;
+	elements[0] = A;
+	elements[1] = AuB;
+	elements[2] = C;
+	elements[3] = AuC;
+	ck_assert(BF_measures(evidences[0], elements, 4, bel, pl, q, betP));
+	for(i = 0; i < 4; ++i) {
+		assert_flt_equals(expectedBel[i], bel[i], BF_PRECISION);
+		assert_flt_equals(expectedPl[i], pl[i], BF_PRECISION);
+		assert_flt_equals(expectedQ[i], q[i], BF_PRECISION);
+		assert_flt_equals(expectedBetP[i], betP[i], BF_PRECISION);
+		ids[i] = Sets_packElement(elements[i], ATOM_NB);
+	}
+	ck_assert(BF_measuresOfIds(evidences[0], ids, 4, NULL, pl, q, NULL));
+	for(i = 0; i < 4; ++i) {
+		assert_flt_equals(expectedPl[i], pl[i], BF_PRECISION);
+		assert_flt_equals(expectedQ[i], q[i], BF_PRECISION);
+	}
+}
+END_TEST
+
+START_TEST(measuresReturnTheSameAsSingleCalls) {
+	int nb = beliefStructure.powerset.card;
+	BF_Mass *bel = malloc(sizeof(BF_Mass) * nb), *pl = malloc(sizeof(BF_Mass) * nb);
+	BF_Mass *q = malloc(sizeof(BF_Mass) * nb), *betP = malloc(sizeof(BF_Mass) * nb);
+	Sets_PackedElement *ids = malloc(sizeof(Sets_PackedElement) * nb);
+	Sets_Element e;
+	int i;
+	ck_assert(BF_measures(evidences[0], beliefStructure.powerset.elements, nb, bel, pl, q, betP));
+	for(i = 0; i < nb; ++i) {
+		e = beliefStructure.powerset.elements[i];
+		assert_flt_equals(BF_bel(evidences[0], e), bel[i], 0);
+		assert_flt_equals(BF_pl(evidences[0], e), pl[i], 0);
+		assert_flt_equals(BF_q(evidences[0], e), q[i], 0);
+		assert_flt_equals(BF_betP(evidences[0], e), betP[i], 0);
+		ids[i] = Sets_packElement(e, ATOM_NB);
+	}
+	/* with ids and only some of the measures: */
+	ck_assert(BF_measuresOfIds(evidences[1], ids, nb, NULL, pl, NULL, betP));
+	for(i = 0; i < nb; ++i) {
+		e = beliefStructure.powerset.elements[i];
+		assert_flt_equals(BF_pl(evidences[1], e), pl[i], 0);
+		assert_flt_equals(BF_betP(evidences[1], e), betP[i], 0);
+	}
+	free(bel);
+	free(pl);
+	free(q);
+	free(betP);
+	free(ids);
+}
+END_TEST
+
+/*
+ * ## Approximations
+ */
+
+static BF_BeliefFunction createFourFocals() {
+	/*
+	 * m(A) = 0.4, m(B) = 0.25, m(C) = 0.2, m(AuB) = 0.15
+	 */
+	BF_BeliefFunction m = {NULL, 4, ATOM_NB};
+	m.focals = malloc(sizeof(BF_FocalElement) * 4);
+	m.focals[0].element = Sets_copyElement(A, ATOM_NB);
+	m.focals[0].beliefValue = 0.4;
+	m.focals[1].element = Sets_copyElement(B, ATOM_NB);
+	m.focals[1].beliefValue = 0.25;
+	m.focals[2].element = Sets_copyElement(C, ATOM_NB);
+	m.focals[2].beliefValue = 0.2;
+	m.focals[3].element = Sets_copyElement(AuB, ATOM_NB);
+	m.focals[3].beliefValue = 0.15;
+	return m;
+}
+
+START_TEST(approximationsBoundTheFocals) {
+	BF_BeliefFunction m = createFourFocals(), approximated;
+	BF_ApproximationMethod methods[4] = {APPROX_SUMMARIZATION, APPROX_KLX, APPROX_INNER, APPROX_OUTER};
+	float expectedMoved[4] = {0.35, 0.15, 0.15, 0.25};
+	BF_Mass moved;
+	float sum;
+	int i, j;
+	for(i = 0; i < 4; i++){
+		approximated = BF_approximation(m, 3, methods[i], &moved);
+		ck_assert(approximated.nbFocals <= 3);
+		assert_flt_equals(expectedMoved[i], moved, BF_PRECISION);
+		sum = 0;
+		for(j = 0; j < approximated.nbFocals; j++){
+			sum += approximated.focals[j].beliefValue;
+		}
+		assert_flt_equals(1, sum, BF_PRECISION);
+		BF_freeBeliefFunction(&approximated);
+	}
+
+	/* the summarization gives the smallest masses to the union of their elements: */
+	approximated = BF_approximation(m, 3, APPROX_SUMMARIZATION, NULL);
+	assert_flt_equals(0.4, BF_m(approximated, A), BF_PRECISION);
+	assert_flt_equals(0.25, BF_m(approximated, B), BF_PRECISION);
+	assert_flt_equals(0.35, BF_m(approximated, AuBuC), BF_PRECISION);
+	BF_freeBeliefFunction(&approximated);
+	/* the outer approximation merges B into AuB: */
+	approximated = BF_approximation(m, 3, APPROX_OUTER, NULL);
+	assert_flt_equals(0.4, BF_m(approximated, AuB), BF_PRECISION);
+	BF_freeBeliefFunction(&approximated);
+	/* k-l-x removes the smallest masses as long as they do not exceed x: */
+	approximated = BF_klxApproximation(m, 1, 4, 0.4, &moved);
+	ck_assert_int_eq(2, approximated.nbFocals);
+	assert_flt_equals(0.35, moved, BF_PRECISION);
+	assert_flt_equals(0.4 / 0.65, BF_m(approximated, A), BF_PRECISION);
+	BF_freeBeliefFunction(&approximated);
+	/* nothing moves if there are few enough focals: */
+	approximated = BF_approximation(m, 4, APPROX_SUMMARIZATION, &moved);
+	ck_assert_int_eq(4, approximated.nbFocals);
+	assert_flt_equals(0, moved, 0);
+	BF_freeBeliefFunction(&approximated);
+
+	BF_freeBeliefFunction(&m);
+}
+END_TEST
+
 TCase* createManipulationTestCase() {
 TCase* testCaseManipulation = tcase_create("Manipulation");
 tcase_add_checked_fixture(testCaseManipulation, setup, teardown);
@@ -187,6 +630,21 @@ tcase_add_test(testCaseManipulation, getListMaxMassReturnsTheRightNumberOfValues
 tcase_add_test(testCaseManipulation, getListMaxMassReturnsTheRightFocals);
 tcase_add_test(testCaseManipulation, getListMinMassReturnsTheRightNumberOfValues);
 tcase_add_test(testCaseManipulation, getListMinMassReturnsTheRightFocals);
+tcase_add_test(testCaseManipulation, getMaxInViewReturnsTheSameAsGetMax);
+tcase_add_test(testCaseManipulation, getMinListInViewReturnsTheSameAsGetMinList);
+tcase_add_test(testCaseManipulation, conditioningValuesAreOk);
+tcase_add_test(testCaseManipulation, conditioningOnTransfersTheMasses);
+tcase_add_test(testCaseManipulation, inPlaceOperationsValuesAreOk);
+tcase_add_test(testCaseManipulation, distanceValuesAreOk);
+tcase_add_test(testCaseManipulation, distanceInContextReturnsTheSameAsDistance);
+tcase_add_test(testCaseManipulation, distanceMatrixReturnsTheSameAsDistance);
+tcase_add_test(testCaseManipulation, denseFunctionsReturnTheSameAsSparse);
+tcase_add_test(testCaseManipulation, denseTransformsReturnTheSameAsSparse);
+tcase_add_test(testCaseManipulation, indexedFunctionsReturnTheSameAsNotIndexed);
+tcase_add_test(testCaseManipulation, compactFunctionsReturnTheSameAsSparse);
+tcase_add_test(testCaseManipulation, measuresValuesAreOk);
+tcase_add_test(testCaseManipulation, measuresReturnTheSameAsSingleCalls);
+tcase_add_test(testCaseManipulation, approximationsBoundTheFocals);
 return testCaseManipulation;
 }
 
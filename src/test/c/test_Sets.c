@@ -38,6 +38,43 @@ START_TEST(testCreationFromArray){
 }
 END_TEST
 
+START_TEST(testRefListIndex) {
+	/*
+	 * positions and elements with an indexed list and with a list built by hand
+	 */
+	const char *worlds[] = {"Paris", "Rennes", "Lyon", "Brest", "Nantes"};
+	const char *values[] = {"Brest", "Paris", "Brest"};
+	char *byHandValues[] = {"Paris", "Rennes", "Lyon", "Brest", "Nantes"};
+	Sets_ReferenceList refList = Sets_createRefListFromArray(worlds, 5);
+	Sets_ReferenceList byHand = {byHandValues, 5, NULL};
+	Sets_Element e = {NULL, 0}, expected = {NULL, 0};
+	char bits[] = {1, 0, 0, 1, 0};
+	int i = 0;
+
+	ck_assert(refList.index != NULL);
+	for(i = 0; i < 5; i++){
+		ck_assert_int_eq(i, Sets_getRefListPosition(refList, worlds[i]));
+		ck_assert_int_eq(i, Sets_getRefListPosition(byHand, worlds[i]));
+	}
+	ck_assert_int_eq(-1, Sets_getRefListPosition(refList, "Marseille"));
+	ck_assert_int_eq(-1, Sets_getRefListPosition(byHand, "Marseille"));
+
+	expected = Sets_createElementFromBits(bits, 5);
+	e = Sets_createElementFromStrings(values, 3, refList);
+	ck_assert(Sets_equals(expected, e, 5));
+	ck_assert_int_eq(2, e.card);
+	Sets_freeElement(&e);
+	e = Sets_createElementFromStrings(values, 3, byHand);
+	ck_assert(Sets_equals(expected, e, 5));
+	ck_assert_int_eq(2, e.card);
+	Sets_freeElement(&e);
+	ck_assert(Sets_packedFromStrings(values, 3, refList) == Sets_packedFromBits(bits, 5));
+
+	Sets_freeElement(&expected);
+	Sets_freeReferenceList(&refList);
+}
+END_TEST
+
 START_TEST(testDisjunction1) {
 	/*
 	 * union of A and B should give AuB
@@ -58,19 +95,270 @@ START_TEST(testDisjunction2) {
 }
 END_TEST
 
+START_TEST(testOperationsInto) {
+	/*
+	 * the same temporary element reused for several operations,
+	 * including operations where it is also an operand
+	 */
+	Sets_Element tmp = Sets_getEmptyElement(ATOM_NB);
+	Sets_conjunctionInto(&tmp, AuB, AuC, ATOM_NB);
+	ck_assert_msg(Sets_equals(tmp, A, ATOM_NB), "Sets_conjunctionInto(AuB,AuC) did not equal A");
+	ck_assert_int_eq(1, tmp.card);
+	Sets_disjunctionInto(&tmp, tmp, B, ATOM_NB);
+	ck_assert_msg(Sets_equals(tmp, AuB, ATOM_NB), "Sets_disjunctionInto(A,B) did not equal AuB");
+	ck_assert_int_eq(2, tmp.card);
+	Sets_getOppositeInto(&tmp, tmp, ATOM_NB);
+	ck_assert_msg(Sets_equals(tmp, C, ATOM_NB), "Sets_getOppositeInto(AuB) did not equal C");
+	ck_assert_int_eq(1, tmp.card);
+	Sets_getCompleteElementInto(&tmp, ATOM_NB);
+	ck_assert_msg(Sets_equals(tmp, AuBuC, ATOM_NB), "Sets_getCompleteElementInto() did not equal AuBuC");
+	Sets_copyElementInto(&tmp, B, ATOM_NB);
+	ck_assert_msg(Sets_equals(tmp, B, ATOM_NB), "Sets_copyElementInto(B) did not equal B");
+	Sets_getEmptyElementInto(&tmp, ATOM_NB);
+	ck_assert_int_eq(0, tmp.card);
+	Sets_freeElement(&tmp);
+}
+END_TEST
+
+START_TEST(testPackElement) {
+	/*
+	 * the atom i is stored in the bit i and unpacking gives the element back
+	 */
+	Sets_Element unpacked = Sets_unpackElement(Sets_packElement(AuC, ATOM_NB), ATOM_NB);
+	ck_assert_int_eq(0, Sets_packElement(VOID, ATOM_NB));
+	ck_assert_int_eq(1, Sets_packElement(A, ATOM_NB));
+	ck_assert_int_eq(5, Sets_packElement(AuC, ATOM_NB));
+	ck_assert_int_eq(7, Sets_packedCompleteElement(ATOM_NB));
+	ck_assert_msg(Sets_equals(unpacked, AuC, ATOM_NB), "Sets_unpackElement(Sets_packElement(AuC)) did not equal AuC");
+	Sets_freeElement(&unpacked);
+}
+END_TEST
+
+START_TEST(testPackLargeElement) {
+	/*
+	 * packing must give the same bits as the byte representation on 64 atoms
+	 */
+	char bits[64];
+	Sets_Element e = {bits, 0};
+	Sets_PackedElement packed = 0;
+	int i = 0;
+	for (i = 0; i < 64; ++i) {
+		bits[i] = (i % 3 == 0) || (i == 63);
+		e.card += bits[i];
+	}
+	packed = Sets_packElement(e, 64);
+	for (i = 0; i < 64; ++i) {
+		ck_assert_int_eq(bits[i], (packed >> i) & 1);
+	}
+	ck_assert_int_eq(e.card, Sets_packedCard(packed));
+	ck_assert_int_eq(64, Sets_packedCard(Sets_packedCompleteElement(64)));
+}
+END_TEST
+
+START_TEST(testPackedConversions) {
+	const char *worlds[] = {"A", "B", "C"};
+	const char *values[] = {"C", "A"};
+	const char bits[] = {1, 0, 1};
+	Sets_ReferenceList refList = Sets_createRefListFromArray(worlds, 3);
+	char* str = NULL;
+	ck_assert_int_eq(Sets_packElement(AuC, ATOM_NB), Sets_packedFromStrings(values, 2, refList));
+	ck_assert_int_eq(Sets_packElement(AuC, ATOM_NB), Sets_packedFromBits(bits, ATOM_NB));
+	ck_assert_int_eq(Sets_numberFromElement(AuC, ATOM_NB), Sets_packElement(AuC, ATOM_NB));
+	str = Sets_packedToString(Sets_packElement(AuC, ATOM_NB), refList);
+	ck_assert_str_eq("{A u C}", str);
+	free(str);
+	str = Sets_packedToString(0, refList);
+	ck_assert_str_eq("{void}", str);
+	free(str);
+	str = Sets_packedToBitString(Sets_packElement(AuC, ATOM_NB), ATOM_NB);
+	ck_assert_str_eq("101", str);
+	free(str);
+	Sets_freeReferenceList(&refList);
+}
+END_TEST
+
+START_TEST(testNumberConversions) {
+	/*
+	 * element numbers are the packed codes (exact integers, whatever the size)
+	 */
+	Sets_Element e = Sets_elementFromNumber(0x40000005, 31);
+	Sets_Set powerset = Sets_generatePowerSet(10);
+	int i = 0;
+	ck_assert_int_eq(3, e.card);
+	ck_assert(e.values[0] && e.values[2] && e.values[30]);
+	ck_assert_int_eq(0x40000005, Sets_numberFromElement(e, 31));
+	ck_assert_int_eq(1024, powerset.card);
+	for(i = 0; i < powerset.card; i++){
+		ck_assert_int_eq(i, Sets_numberFromElement(powerset.elements[i], 10));
+	}
+	Sets_freeSet(&powerset);
+	Sets_freeElement(&e);
+}
+END_TEST
+
+START_TEST(testNumberConversionsBeyondAWord) {
+	/*
+	 * the digits past the bits of the number are 0, even beyond 64 digits
+	 */
+	Sets_Element e = Sets_elementFromNumber(5, 70);
+	int i = 0, nbSet = 0;
+	for(i = 0; i < 70; i++){
+		nbSet += e.values[i];
+	}
+	ck_assert_int_eq(2, e.card);
+	ck_assert_int_eq(2, nbSet);
+	ck_assert(e.values[0] && e.values[2]);
+	ck_assert_int_eq(5, Sets_packElement(e, 70));
+	Sets_freeElement(&e);
+}
+END_TEST
+
+START_TEST(testPackedOperations) {
+	Sets_PackedElement a = Sets_packElement(A, ATOM_NB);
+	Sets_PackedElement b = Sets_packElement(B, ATOM_NB);
+	Sets_PackedElement auc = Sets_packElement(AuC, ATOM_NB);
+	ck_assert_int_eq(Sets_packElement(AuB, ATOM_NB), Sets_packedDisjunction(a, b));
+	ck_assert_int_eq(a, Sets_packedConjunction(auc, Sets_packElement(AuB, ATOM_NB)));
+	ck_assert_int_eq(Sets_packElement(BuC, ATOM_NB), Sets_packedOpposite(a, ATOM_NB));
+	ck_assert(Sets_packedEquals(auc, Sets_packedDisjunction(a, Sets_packElement(C, ATOM_NB))));
+	ck_assert(Sets_packedIsSubset(a, auc));
+	ck_assert(!Sets_packedIsSubset(b, auc));
+	ck_assert_int_eq(2, Sets_packedCard(auc));
+}
+END_TEST
+
+START_TEST(testPowerSetView) {
+	/*
+	 * the whole view gives the subsets in the same order as a generated powerset
+	 */
+	Sets_Set powerset = Sets_generatePowerSet(ATOM_NB);
+	Sets_PowerSetIterator it = Sets_iteratePowerSet(Sets_getPowerSetView(ATOM_NB));
+	int i = 0;
+	while(Sets_nextSubset(&it)){
+		ck_assert(i < powerset.card);
+		ck_assert(Sets_equals(powerset.elements[i], it.element, ATOM_NB));
+		ck_assert_int_eq(powerset.elements[i].card, it.element.card);
+		i++;
+	}
+	ck_assert_int_eq(powerset.card, i);
+	ck_assert(!Sets_nextSubset(&it));
+	Sets_freePowerSetIterator(&it);
+	Sets_freeSet(&powerset);
+}
+END_TEST
+
+START_TEST(testRestrictedPowerSetView) {
+	/*
+	 * singletons, then subsets of AuC, then supersets of B
+	 */
+	Sets_PowerSetView view = Sets_restrictToCardinality(Sets_getPowerSetView(ATOM_NB), 1, 1);
+	Sets_PowerSetIterator it = Sets_iteratePowerSet(view);
+	ck_assert(Sets_nextSubset(&it) && Sets_equals(A, it.element, ATOM_NB));
+	ck_assert(Sets_nextSubset(&it) && Sets_equals(B, it.element, ATOM_NB));
+	ck_assert(Sets_nextSubset(&it) && Sets_equals(C, it.element, ATOM_NB));
+	ck_assert(!Sets_nextSubset(&it));
+	Sets_freePowerSetIterator(&it);
+
+	it = Sets_iteratePowerSet(Sets_restrictToSubsetsOf(Sets_getPowerSetView(ATOM_NB), AuC));
+	ck_assert(Sets_nextSubset(&it) && it.element.card == 0);
+	ck_assert(Sets_nextSubset(&it) && Sets_equals(A, it.element, ATOM_NB));
+	ck_assert(Sets_nextSubset(&it) && Sets_equals(C, it.element, ATOM_NB));
+	ck_assert(Sets_nextSubset(&it) && Sets_equals(AuC, it.element, ATOM_NB));
+	ck_assert(!Sets_nextSubset(&it));
+	Sets_freePowerSetIterator(&it);
+
+	it = Sets_iteratePowerSet(Sets_restrictToSupersetsOf(Sets_getPowerSetView(ATOM_NB), B));
+	ck_assert(Sets_nextSubset(&it) && Sets_equals(B, it.element, ATOM_NB));
+	ck_assert(Sets_nextSubset(&it) && Sets_equals(AuB, it.element, ATOM_NB));
+	ck_assert(Sets_nextSubset(&it) && Sets_equals(BuC, it.element, ATOM_NB));
+	ck_assert(Sets_nextSubset(&it) && Sets_equals(AuBuC, it.element, ATOM_NB));
+	ck_assert(!Sets_nextSubset(&it));
+	Sets_freePowerSetIterator(&it);
+}
+END_TEST
+
+START_TEST(testCardinalityBuckets) {
+	/*
+	 * the subsets of 2 to 4 atoms of a frame of 10 atoms: C(10,2) + C(10,3) + C(10,4) = 375
+	 * given by increasing id, and the 120 subsets of exactly 3 atoms
+	 */
+	Sets_PowerSetIterator it = Sets_iteratePowerSet(Sets_restrictToCardinality(Sets_getPowerSetView(10), 2, 4));
+	Sets_PackedElement previous = 0;
+	int nb = 0;
+	while(Sets_nextSubset(&it)){
+		ck_assert(it.element.card >= 2 && it.element.card <= 4);
+		ck_assert_int_eq(it.element.card, Sets_packedCard(it.id));
+		ck_assert(nb == 0 || it.id > previous);
+		previous = it.id;
+		nb++;
+	}
+	ck_assert_int_eq(nb, 375);
+	Sets_freePowerSetIterator(&it);
+
+	it = Sets_iteratePowerSet(Sets_restrictToCardinality(Sets_getPowerSetView(10), 3, 3));
+	nb = 0;
+	while(Sets_nextSubset(&it)){
+		ck_assert_int_eq(it.element.card, 3);
+		nb++;
+	}
+	ck_assert_int_eq(nb, 120);
+	Sets_freePowerSetIterator(&it);
+}
+END_TEST
+
+START_TEST(testContext) {
+	/*
+	 * masks and Jaccard coefficients with and without cache
+	 */
+	Sets_Context ctx = Sets_createContext(ATOM_NB);
+	Sets_PackedElement a = Sets_packElement(AuB, ATOM_NB), b = Sets_packElement(BuC, ATOM_NB);
+	ck_assert(ctx.fullMask == 7);
+	assert_flt_equals(1.0 / 3, Sets_jaccardInContext(&ctx, a, b), 0.00001);
+	assert_flt_equals(1, Sets_jaccardInContext(&ctx, 0, 0), 0.00001);
+	ck_assert(Sets_enableJaccardCache(&ctx));
+	assert_flt_equals(1.0 / 3, Sets_jaccardInContext(&ctx, a, b), 0.00001);
+	assert_flt_equals(0.5, Sets_jaccardInContext(&ctx, a, Sets_packElement(A, ATOM_NB)), 0.00001);
+	assert_flt_equals(1, Sets_jaccardInContext(&ctx, 0, 0), 0.00001);
+	assert_flt_equals(0, Sets_jaccardInContext(&ctx, 0, b), 0.00001);
+	Sets_freeContext(&ctx);
+
+	ctx = Sets_createContext(SETS_JACCARD_CACHE_MAX_SIZE + 1);
+	ck_assert(!Sets_enableJaccardCache(&ctx));
+	Sets_freeContext(&ctx);
+}
+END_TEST
+
 Suite *createSuite(void) {
 	Suite *suite = suite_create("Sets");
 
 	TCase *testCaseCreation = tcase_create("Creation");
 	tcase_add_test(testCaseCreation, testCreationFromArray);
+	tcase_add_test(testCaseCreation, testRefListIndex);
 
 	TCase* testCaseManipulation = tcase_create("Manipulation");
 	tcase_add_test(testCaseManipulation, testDisjunction1);
 	tcase_add_test(testCaseManipulation, testDisjunction2);
+	tcase_add_test(testCaseManipulation, testOperationsInto);
+
+	TCase* testCasePacked = tcase_create("Packed");
+	tcase_add_test(testCasePacked, testPackElement);
+	tcase_add_test(testCasePacked, testPackLargeElement);
+	tcase_add_test(testCasePacked, testPackedOperations);
+	tcase_add_test(testCasePacked, testPackedConversions);
+	tcase_add_test(testCasePacked, testNumberConversions);
+	tcase_add_test(testCasePacked, testNumberConversionsBeyondAWord);
+	tcase_add_test(testCasePacked, testContext);
+
 
+	TCase* testCaseLazy = tcase_create("Lazy powerset");
+	tcase_add_test(testCaseLazy, testPowerSetView);
+	tcase_add_test(testCaseLazy, testRestrictedPowerSetView);
+	tcase_add_test(testCaseLazy, testCardinalityBuckets);
 
 	suite_add_tcase(suite, testCaseCreation);
 	suite_add_tcase(suite, testCaseManipulation);
+	suite_add_tcase(suite, testCasePacked);
+	suite_add_tcase(suite, testCaseLazy);
 	return suite;
 }
 
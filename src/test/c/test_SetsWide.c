@@ -0,0 +1,183 @@
+/*
+ * Copyright 2011-2014, EDF. This software was developed with the collaboration of INRIA (Bastien Pietropaoli)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * test_SetsWide.c
+ *
+ * Checks every set of word kernels against the byte implementation of Sets.
+ */
+
+#include <stdlib.h>
+#include <check.h>
+
+#include "SetsWide.h"
+
+#define NB_ELEMENTS 8
+
+static const int sizes[] = {1, 63, 64, 65, 127, 128, 129, 200, 256, 300, 500, 513, 1100};
+
+/*
+ * Random element of the given size with about one atom out of density.
+ */
+static Sets_Element randomElement(const int size, const int density) {
+	Sets_Element e = Sets_getEmptyElement(size);
+	int i = 0;
+	for (i = 0; i < size; ++i) {
+		e.values[i] = (rand() % density) == 0;
+		e.card += e.values[i];
+	}
+	return e;
+}
+
+static void checkKernels(const Sets_WordKernels kernels) {
+	Sets_Element elements[NB_ELEMENTS], expected, opposite;
+	uint64_t *a = NULL, *b = NULL, *result = NULL, *expectedWords = NULL;
+	int s = 0, i = 0, j = 0, size = 0, nbWords = 0;
+
+	if (!Sets_useWordKernels(kernels)) {
+		/* not supported by this CPU */
+		return;
+	}
+	ck_assert_int_eq(kernels, Sets_getWordKernels());
+	srand(kernels);
+
+	for (s = 0; s < (int) (sizeof(sizes) / sizeof(sizes[0])); ++s) {
+		size = sizes[s];
+		nbWords = SETS_WIDE_NB_WORDS(size);
+		a = malloc(sizeof(uint64_t) * nbWords);
+		b = malloc(sizeof(uint64_t) * nbWords);
+		result = malloc(sizeof(uint64_t) * nbWords);
+		expectedWords = malloc(sizeof(uint64_t) * nbWords);
+
+		for (i = 0; i < NB_ELEMENTS; ++i) {
+			elements[i] = randomElement(size, 1 + i % 4);
+		}
+		/* a subset and an equal element: */
+		Sets_freeElement(&elements[NB_ELEMENTS - 1]);
+		elements[NB_ELEMENTS - 1] = Sets_conjunction(elements[0], elements[1], size);
+		Sets_freeElement(&elements[NB_ELEMENTS - 2]);
+		elements[NB_ELEMENTS - 2] = Sets_copyElement(elements[0], size);
+
+		for (i = 0; i < NB_ELEMENTS; ++i) {
+			Sets_packWords(a, elements[i], size);
+			ck_assert_int_eq(elements[i].card, Sets_wordsCard(a, nbWords));
+
+			for (j = 0; j < NB_ELEMENTS; ++j) {
+				Sets_packWords(b, elements[j], size);
+
+				expected = Sets_conjunction(elements[i], elements[j], size);
+				Sets_packWords(expectedWords, expected, size);
+				Sets_wordsConjunction(result, a, b, nbWords);
+				ck_assert_msg(Sets_wordsEquals(expectedWords, result, nbWords), "conjunction failed on %d atoms", size);
+				ck_assert_int_eq(expected.card, Sets_wordsConjunctionCard(a, b, nbWords));
+				Sets_freeElement(&expected);
+
+				expected = Sets_disjunction(elements[i], elements[j], size);
+				Sets_packWords(expectedWords, expected, size);
+				Sets_wordsDisjunction(result, a, b, nbWords);
+				ck_assert_msg(Sets_wordsEquals(expectedWords, result, nbWords), "disjunction failed on %d atoms", size);
+				Sets_freeElement(&expected);
+
+				opposite = Sets_getOpposite(elements[j], size);
+				expected = Sets_conjunction(elements[i], opposite, size);
+				Sets_packWords(expectedWords, expected, size);
+				Sets_wordsDifference(result, a, b, nbWords);
+				ck_assert_msg(Sets_wordsEquals(expectedWords, result, nbWords), "difference failed on %d atoms", size);
+				Sets_freeElement(&expected);
+				Sets_freeElement(&opposite);
+
+				ck_assert_int_eq(Sets_isSubset(elements[i], elements[j], size), Sets_wordsIsSubset(a, b, nbWords));
+				ck_assert_int_eq(Sets_equals(elements[i], elements[j], size), Sets_wordsEquals(a, b, nbWords));
+			}
+		}
+
+		for (i = 0; i < NB_ELEMENTS; ++i) {
+			Sets_freeElement(&elements[i]);
+		}
+		free(a);
+		free(b);
+		free(result);
+		free(expectedWords);
+	}
+	Sets_useWordKernels(KERNELS_AUTO);
+}
+
+START_TEST(testScalarKernels) {
+	checkKernels(KERNELS_SCALAR);
+}
+END_TEST
+
+START_TEST(testSSEKernels) {
+	checkKernels(KERNELS_SSE);
+}
+END_TEST
+
+START_TEST(testAVX2Kernels) {
+	checkKernels(KERNELS_AVX2);
+}
+END_TEST
+
+START_TEST(testAVX512Kernels) {
+	checkKernels(KERNELS_AVX512);
+}
+END_TEST
+
+START_TEST(testWideElements) {
+	/*
+	 * conversions back and forth on a frame of 130 atoms
+	 */
+	Sets_Element e = randomElement(130, 3), back;
+	Sets_WideElement w = Sets_wideFromElement(e, 130), conj;
+	ck_assert_int_eq(e.card, w.card);
+	back = Sets_elementFromWide(w, 130);
+	ck_assert(Sets_equals(e, back, 130));
+	conj = Sets_wideConjunction(w, w, 130);
+	ck_assert(Sets_wideEquals(w, conj, 130));
+	ck_assert(Sets_wideIsSubset(conj, w, 130));
+	Sets_freeWideElement(&conj);
+	Sets_freeWideElement(&w);
+	Sets_freeElement(&back);
+	Sets_freeElement(&e);
+}
+END_TEST
+
+Suite *createSuite(void) {
+	Suite *suite = suite_create("SetsWide");
+
+	TCase *testCaseKernels = tcase_create("Kernels");
+	tcase_add_test(testCaseKernels, testScalarKernels);
+	tcase_add_test(testCaseKernels, testSSEKernels);
+	tcase_add_test(testCaseKernels, testAVX2Kernels);
+	tcase_add_test(testCaseKernels, testAVX512Kernels);
+
+	TCase *testCaseElements = tcase_create("Elements");
+	tcase_add_test(testCaseElements, testWideElements);
+
+	suite_add_tcase(suite, testCaseKernels);
+	suite_add_tcase(suite, testCaseElements);
+	return suite;
+}
+
+
+int main() {
+	int numberFailed = 0;
+	Suite *suite = createSuite();
+	SRunner *suiteRunner= srunner_create(suite);
+	srunner_run_all(suiteRunner, CK_NORMAL);
+	numberFailed = srunner_ntests_failed (suiteRunner);
+	srunner_free(suiteRunner);
+	return (numberFailed == 0) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,147 @@
+/*
+ * Copyright 2011-2014, EDF. This software was developed with the collaboration of INRIA (Bastien Pietropaoli)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * test_StringBuffer.c
+ *
+ * Checks the buffers and that the append functions give the same strings
+ * as the conversion functions.
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include <check.h>
+
+#include "StringBuffer.h"
+#include "BeliefFunctions.h"
+#include "unit_tests.h"
+
+START_TEST(testAppend) {
+	/*
+	 * the buffer grows from a capacity of 1
+	 */
+	StringBuffer sb = StringBuffer_create(1);
+	int capacity = 0;
+	ck_assert_str_eq("", sb.str);
+	StringBuffer_append(&sb, "Hello");
+	StringBuffer_appendChar(&sb, ',');
+	StringBuffer_appendFormat(&sb, " %s %d %.2f", "world", 42, 0.5);
+	StringBuffer_appendFormat(&sb, "%100s", "!");
+	ck_assert_int_eq(120, sb.length);
+	ck_assert_int_eq(120, strlen(sb.str));
+	ck_assert(!strncmp("Hello, world 42 0.50 ", sb.str, 21));
+	ck_assert_int_eq('!', sb.str[119]);
+
+	/* reused without allocation: */
+	capacity = sb.capacity;
+	StringBuffer_clear(&sb);
+	ck_assert_str_eq("", sb.str);
+	StringBuffer_appendFormat(&sb, "%d", 7);
+	ck_assert_str_eq("7", sb.str);
+	ck_assert_int_eq(capacity, sb.capacity);
+	StringBuffer_free(&sb);
+}
+END_TEST
+
+START_TEST(testAppendStructures) {
+	/*
+	 * same strings as Sets_elementToString(), Sets_setToBitString() and BF_beliefFunctionToString()
+	 */
+	const char *worlds[] = {"A", "B", "C"};
+	Sets_ReferenceList refList = Sets_createRefListFromArray(worlds, 3);
+	Sets_Element elements[] = {VOID, AuC, AuBuC};
+	Sets_Set set = {elements, 3};
+	BF_FocalElement focals[] = {{A, 0.25}, {AuC, 0.75}};
+	BF_BeliefFunction m = {focals, 2, 3, NULL};
+	StringBuffer sb = StringBuffer_create(0);
+	char* str = NULL;
+
+	Sets_appendElement(&sb, AuC, refList);
+	ck_assert_str_eq("{A u C}", sb.str);
+	StringBuffer_clear(&sb);
+
+	Sets_appendSet(&sb, set, refList);
+	ck_assert_str_eq("{{void}, {A u C}, {A u B u C}}", sb.str);
+	StringBuffer_clear(&sb);
+
+	Sets_appendSetBits(&sb, set, 3);
+	str = Sets_setToBitString(set, 3);
+	ck_assert_str_eq(str, sb.str);
+	ck_assert_str_eq("{000, 101, 111}", sb.str);
+	free(str);
+	StringBuffer_clear(&sb);
+
+	BF_appendBeliefFunction(&sb, m, refList);
+	str = BF_beliefFunctionToString(m, refList);
+	ck_assert_str_eq(str, sb.str);
+	ck_assert_str_eq("m({A}) = 0.250000\nm({A u C}) = 0.750000\n", sb.str);
+	free(str);
+
+	StringBuffer_free(&sb);
+	Sets_freeReferenceList(&refList);
+}
+END_TEST
+
+START_TEST(testFileBuffer) {
+	/*
+	 * written directly into a file
+	 */
+	const char *worlds[] = {"A", "B", "C"};
+	Sets_ReferenceList refList = Sets_createRefListFromArray(worlds, 3);
+	char read[64] = {0};
+	FILE* file = tmpfile();
+	StringBuffer sb = StringBuffer_fromFile(file);
+
+	ck_assert(file != NULL);
+	Sets_appendElement(&sb, BuC, refList);
+	StringBuffer_appendFormat(&sb, " %d", 3);
+	ck_assert(sb.str == NULL);
+	ck_assert_int_eq(9, sb.length);
+	rewind(file);
+	ck_assert(fgets(read, 64, file) != NULL);
+	ck_assert_str_eq("{B u C} 3", read);
+
+	StringBuffer_free(&sb);
+	fclose(file);
+	Sets_freeReferenceList(&refList);
+}
+END_TEST
+
+Suite *createSuite(void) {
+	Suite *suite = suite_create("StringBuffer");
+
+	TCase *testCaseBuffer = tcase_create("Buffer");
+	tcase_add_test(testCaseBuffer, testAppend);
+	tcase_add_test(testCaseBuffer, testFileBuffer);
+
+	TCase *testCaseStructures = tcase_create("Structures");
+	tcase_add_test(testCaseStructures, testAppendStructures);
+
+	suite_add_tcase(suite, testCaseBuffer);
+	suite_add_tcase(suite, testCaseStructures);
+	return suite;
+}
+
+
+int main() {
+	int numberFailed = 0;
+	Suite *suite = createSuite();
+	SRunner *suiteRunner= srunner_create(suite);
+	srunner_run_all(suiteRunner, CK_NORMAL);
+	numberFailed = srunner_ntests_failed (suiteRunner);
+	srunner_free(suiteRunner);
+	return (numberFailed == 0) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
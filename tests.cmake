@@ -20,7 +20,10 @@ if(CHECK_FOUND)
     
     macro(thegame_add_test TEST_NAME) 
         add_executable(${TEST_NAME} EXCLUDE_FROM_ALL src/test/c/${TEST_NAME}.c)
-        target_link_libraries(${TEST_NAME} THEGAME ${CHECK_LIBRARIES})
+        target_link_libraries(${TEST_NAME} THEGAME ${CHECK_LIBRARIES} ${thegame_link_flags})
+        if(THEGAME_OPENMP AND OPENMP_FOUND)
+            set_target_properties(${TEST_NAME} PROPERTIES COMPILE_FLAGS ${OpenMP_C_FLAGS})
+        endif(THEGAME_OPENMP AND OPENMP_FOUND)
         add_test(NAME ${TEST_NAME} COMMAND ${TEST_NAME})
         set(test_binaries ${test_binaries} ${TEST_NAME})
     endmacro(thegame_add_test)
@@ -29,6 +32,9 @@ if(CHECK_FOUND)
     
     
     thegame_add_test(test_Sets)
+    thegame_add_test(test_SetsWide)
+    thegame_add_test(test_StringBuffer)
+    thegame_add_test(test_Arena)
     thegame_add_test(test_BeliefFromSensors)
         thegame_add_test(test_BeliefFromSensorsCreation)
     thegame_add_test(test_BeliefFunctions)